@@ -124,7 +124,10 @@ void LoadTable() {
     ItemPointer tuple_slot_id = hyadapt_table->InsertTuple(&tuple);
     assert(tuple_slot_id.block != INVALID_OID);
     assert(tuple_slot_id.offset != INVALID_OID);
-    txn->RecordInsert(tuple_slot_id);
+    auto tile_group_header = catalog::Manager::GetInstance()
+                                 .GetTileGroup(tuple_slot_id.block)
+                                 ->GetHeader();
+    txn->RecordInsert(tuple_slot_id, tile_group_header);
   }
 
   txn_manager.CommitTransaction();
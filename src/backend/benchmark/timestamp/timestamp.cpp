@@ -0,0 +1,78 @@
+//===----------------------------------------------------------------------===//
+//
+//                         PelotonDB
+//
+// timestamp.cpp
+//
+// Identification: benchmark/timestamp/timestamp.cpp
+//
+// Copyright (c) 2015, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#undef NDEBUG
+
+#include <iostream>
+#include <fstream>
+
+#include "backend/benchmark/timestamp/timestamp_configuration.h"
+#include "backend/benchmark/timestamp/timestamp_workload.h"
+#include "backend/common/logger.h"
+#include "backend/concurrency/epoch_manager.h"
+#include "backend/concurrency/transaction_manager_factory.h"
+
+namespace peloton {
+namespace benchmark {
+namespace timestamp {
+
+configuration state;
+
+std::ofstream out("outputfile.summary");
+
+static void WriteOutput(int backend_count, double stat) {
+  LOG_INFO("----------------------------------------------------------");
+  LOG_INFO("%d %d %d %d :: %lf",
+           state.protocol,
+           state.timestamp_type,
+           state.epoch_length,
+           backend_count,
+           stat);
+
+  out << state.protocol << " ";
+  out << state.timestamp_type << " ";
+  out << state.epoch_length << " ";
+  out << backend_count << " ";
+  out << stat << "\n";
+  out.flush();
+}
+
+// Main Entry Point
+void RunBenchmark() {
+  concurrency::TransactionManagerFactory::Configure(
+      state.protocol, ISOLATION_LEVEL_TYPE_FULL, VERSION_ORDER_TYPE_O2N,
+      state.timestamp_type);
+  concurrency::EpochManagerFactory::GetInstance().SetEpochLength(
+      state.epoch_length);
+
+  // Begin and commit throughput from 1 backend up to the backend count
+  for (int backend_count = 1; backend_count <= state.backend_count;
+       backend_count *= 2) {
+    RunWorkload(backend_count);
+
+    // Emit throughput
+    WriteOutput(backend_count, state.throughput);
+  }
+}
+
+}  // namespace timestamp
+}  // namespace benchmark
+}  // namespace peloton
+
+int main(int argc, char **argv) {
+  peloton::benchmark::timestamp::ParseArguments(
+      argc, argv, peloton::benchmark::timestamp::state);
+
+  peloton::benchmark::timestamp::RunBenchmark();
+
+  return 0;
+}
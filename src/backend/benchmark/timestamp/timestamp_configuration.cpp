@@ -0,0 +1,147 @@
+//===----------------------------------------------------------------------===//
+//
+//                         PelotonDB
+//
+// timestamp_configuration.cpp
+//
+// Identification: benchmark/timestamp/timestamp_configuration.cpp
+//
+// Copyright (c) 2015, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <iomanip>
+#include <algorithm>
+
+#include "backend/benchmark/timestamp/timestamp_configuration.h"
+#include "backend/common/logger.h"
+#include "backend/concurrency/epoch_manager.h"
+
+namespace peloton {
+namespace benchmark {
+namespace timestamp {
+
+void Usage(FILE *out) {
+  fprintf(out,
+          "Command line options : timestamp <options> \n"
+          "   -h --help              :  Print help message \n"
+          "   -b --backend-count     :  largest # of backends \n"
+          "   -d --duration          :  execution duration of a run \n"
+          "   -e --epoch-length      :  length of an epoch (in ms) \n"
+          "   -p --protocol          :  concurrency control protocol \n"
+          "   -t --timestamp         :  0 global counter, 1 epochs \n"
+          );
+}
+
+static struct option opts[] = {
+    {"backend-count", optional_argument, NULL, 'b'},
+    {"duration", optional_argument, NULL, 'd'},
+    {"epoch-length", optional_argument, NULL, 'e'},
+    {"protocol", optional_argument, NULL, 'p'},
+    {"timestamp", optional_argument, NULL, 't'},
+    {NULL, 0, NULL, 0}};
+
+void ValidateProtocol(const configuration &state) {
+  if (state.protocol < CONCURRENCY_TYPE_OPTIMISTIC ||
+      state.protocol > CONCURRENCY_TYPE_OCC_RB) {
+    LOG_ERROR("Invalid protocol :: %d", state.protocol);
+    exit(EXIT_FAILURE);
+  }
+
+  LOG_INFO("%s : %d", "protocol", state.protocol);
+}
+
+void ValidateTimestampType(const configuration &state) {
+  if (state.timestamp_type != TIMESTAMP_TYPE_GLOBAL &&
+      state.timestamp_type != TIMESTAMP_TYPE_EPOCH) {
+    LOG_ERROR("Invalid timestamp_type :: %d", state.timestamp_type);
+    exit(EXIT_FAILURE);
+  }
+
+  LOG_INFO("%s : %d", "timestamp_type", state.timestamp_type);
+}
+
+void ValidateEpochLength(const configuration &state) {
+  if (state.epoch_length <= 0) {
+    LOG_ERROR("Invalid epoch_length :: %d", state.epoch_length);
+    exit(EXIT_FAILURE);
+  }
+
+  LOG_INFO("%s : %d", "epoch_length", state.epoch_length);
+}
+
+void ValidateBackendCount(const configuration &state) {
+  if (state.backend_count <= 0) {
+    LOG_ERROR("Invalid backend_count :: %d", state.backend_count);
+    exit(EXIT_FAILURE);
+  }
+
+  LOG_INFO("%s : %d", "backend_count", state.backend_count);
+}
+
+void ValidateDuration(const configuration &state) {
+  if (state.duration <= 0) {
+    LOG_ERROR("Invalid duration :: %d", state.duration);
+    exit(EXIT_FAILURE);
+  }
+
+  LOG_INFO("%s : %d", "duration", state.duration);
+}
+
+void ParseArguments(int argc, char *argv[], configuration &state) {
+
+  // Default Values
+  state.protocol = CONCURRENCY_TYPE_OPTIMISTIC;
+  state.timestamp_type = TIMESTAMP_TYPE_EPOCH;
+  state.epoch_length = EPOCH_LENGTH;
+  state.backend_count = 64;
+  state.duration = 1000;
+
+  // Parse args
+  while (1) {
+    int idx = 0;
+    int c = getopt_long(argc, argv, "hb:d:e:p:t:", opts, &idx);
+
+    if (c == -1) break;
+
+    switch (c) {
+      case 'b':
+        state.backend_count = atoi(optarg);
+        break;
+      case 'd':
+        state.duration = atoi(optarg);
+        break;
+      case 'e':
+        state.epoch_length = atoi(optarg);
+        break;
+      case 'p':
+        state.protocol = (ConcurrencyType)atoi(optarg);
+        break;
+      case 't':
+        state.timestamp_type = (TimestampType)atoi(optarg);
+        break;
+
+      case 'h':
+        Usage(stderr);
+        exit(EXIT_FAILURE);
+        break;
+
+      default:
+        fprintf(stderr, "\nUnknown option: -%c-\n", c);
+        Usage(stderr);
+        exit(EXIT_FAILURE);
+        break;
+    }
+  }
+
+  // Print configuration
+  ValidateProtocol(state);
+  ValidateTimestampType(state);
+  ValidateEpochLength(state);
+  ValidateBackendCount(state);
+  ValidateDuration(state);
+}
+
+}  // namespace timestamp
+}  // namespace benchmark
+}  // namespace peloton
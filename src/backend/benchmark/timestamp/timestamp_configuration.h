@@ -0,0 +1,66 @@
+//===----------------------------------------------------------------------===//
+//
+//                         PelotonDB
+//
+// timestamp_configuration.h
+//
+// Identification: benchmark/timestamp/timestamp_configuration.h
+//
+// Copyright (c) 2015, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <getopt.h>
+#include <vector>
+#include <sys/time.h>
+#include <iostream>
+
+#include "backend/common/types.h"
+
+namespace peloton {
+namespace benchmark {
+namespace timestamp {
+
+class configuration {
+ public:
+  // concurrency control protocol
+  ConcurrencyType protocol;
+
+  // source of begin and commit ids
+  TimestampType timestamp_type;
+
+  // length of an epoch (in ms)
+  int epoch_length;
+
+  // largest number of backends, the runs double it from 1
+  int backend_count;
+
+  // execution duration of a run (in ms)
+  int duration;
+
+  // throughput of the last run
+  double throughput;
+};
+
+extern configuration state;
+
+void Usage(FILE *out);
+
+void ParseArguments(int argc, char *argv[], configuration &state);
+
+void ValidateProtocol(const configuration &state);
+
+void ValidateTimestampType(const configuration &state);
+
+void ValidateEpochLength(const configuration &state);
+
+void ValidateBackendCount(const configuration &state);
+
+void ValidateDuration(const configuration &state);
+
+}  // namespace timestamp
+}  // namespace benchmark
+}  // namespace peloton
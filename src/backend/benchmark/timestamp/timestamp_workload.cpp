@@ -0,0 +1,89 @@
+//===----------------------------------------------------------------------===//
+//
+//                         PelotonDB
+//
+// timestamp_workload.cpp
+//
+// Identification: benchmark/timestamp/timestamp_workload.cpp
+//
+// Copyright (c) 2015, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#undef NDEBUG
+
+#include "backend/benchmark/timestamp/timestamp_workload.h"
+#include "backend/benchmark/timestamp/timestamp_configuration.h"
+
+#include "backend/common/logger.h"
+#include "backend/concurrency/transaction_manager_factory.h"
+
+namespace peloton {
+namespace benchmark {
+namespace timestamp {
+
+/////////////////////////////////////////////////////////
+// WORKLOAD
+/////////////////////////////////////////////////////////
+
+std::atomic<bool> run_backends(true);
+
+std::vector<uint64_t> transaction_counts;
+
+// The transactions only begin and commit, they measure the cost of the
+// begin and commit ids. An empty transaction commits without a commit id,
+// the backend draws it as a writing transaction would.
+void RunBackend(oid_t thread_id) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  uint64_t committed_transaction_count = 0;
+
+  while (run_backends == true) {
+    txn_manager.BeginTransaction();
+    txn_manager.GetNextCommitId();
+    if (txn_manager.CommitTransaction() == RESULT_SUCCESS) {
+      committed_transaction_count++;
+    }
+  }
+
+  transaction_counts[thread_id] = committed_transaction_count;
+}
+
+void RunWorkload(int backend_count) {
+  std::vector<std::thread> thread_group;
+  oid_t num_threads = backend_count;
+  transaction_counts.assign(num_threads, 0);
+  run_backends = true;
+
+  // Launch a group of threads
+  for (oid_t thread_itr = 0; thread_itr < num_threads; ++thread_itr) {
+    thread_group.push_back(std::move(std::thread(RunBackend, thread_itr)));
+  }
+
+  // Sleep for duration specified by user and then stop the backends
+  auto sleep_period = std::chrono::milliseconds(state.duration);
+  std::this_thread::sleep_for(sleep_period);
+  run_backends = false;
+
+  // Join the threads with the main thread
+  for (oid_t thread_itr = 0; thread_itr < num_threads; ++thread_itr) {
+    thread_group[thread_itr].join();
+  }
+
+  // Compute total committed transactions
+  uint64_t sum_transaction_count = 0;
+  for (auto transaction_count : transaction_counts) {
+    sum_transaction_count += transaction_count;
+  }
+
+  // Compute average throughput
+  state.throughput = (sum_transaction_count * 1000.0) / state.duration;
+}
+
+}  // namespace timestamp
+}  // namespace benchmark
+}  // namespace peloton
@@ -0,0 +1,28 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// timestamp_workload.h
+//
+// Identification: src/backend/benchmark/timestamp_workload.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "backend/benchmark/timestamp/timestamp_configuration.h"
+
+namespace peloton {
+namespace benchmark {
+namespace timestamp {
+
+extern configuration state;
+
+// Run empty transactions on the backends, then set the throughput
+void RunWorkload(int backend_count);
+
+}  // namespace timestamp
+}  // namespace benchmark
+}  // namespace peloton
@@ -28,6 +28,7 @@ void Usage(FILE *out) {
           "   -b --backend_count     :  # of backends \n"
           "   -d --duration          :  execution duration \n"
           "   -k --scale_factor      :  scale factor \n"
+          "   -i --index             :  index type (btree, bwtree, btree_olc) \n"
   );
 }
 
@@ -35,6 +36,7 @@ static struct option opts[] = {
     { "backend_count", optional_argument, NULL, 'b'},
     { "duration", optional_argument, NULL, 'd' },
     { "scale_factor", optional_argument, NULL, 'k' },
+    { "index", optional_argument, NULL, 'i' },
     {NULL, 0, NULL, 0}
 };
 
@@ -65,17 +67,27 @@ void ValidateBackendCount(const configuration &state) {
   LOG_INFO("%s : %d", "backend_count", state.backend_count);
 }
 
+void ValidateIndex(const configuration &state) {
+  if (state.index == INDEX_TYPE_INVALID || state.index == INDEX_TYPE_HASH) {
+    LOG_ERROR("Invalid index");
+    exit(EXIT_FAILURE);
+  }
+
+  LOG_INFO("%s : %s", "index", IndexTypeToString(state.index).c_str());
+}
+
 void ParseArguments(int argc, char *argv[], configuration &state) {
 
   // Default Values
   state.scale_factor = 1;
   state.duration = 1000;
   state.backend_count = 2;
+  state.index = INDEX_TYPE_BTREE;
 
   // Parse args
   while (1) {
     int idx = 0;
-    int c = getopt_long(argc, argv, "ah:b:d:k:", opts, &idx);
+    int c = getopt_long(argc, argv, "ah:b:d:k:i:", opts, &idx);
 
     if (c == -1) break;
 
@@ -89,6 +101,12 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
       case 'k':
         state.scale_factor = atoi(optarg);
         break;
+      case 'i': {
+        std::string index_name(optarg);
+        std::transform(index_name.begin(), index_name.end(),
+                       index_name.begin(), ::toupper);
+        state.index = StringToIndexType(index_name);
+      } break;
 
       case 'h':
         Usage(stderr);
@@ -113,6 +131,7 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   ValidateBackendCount(state);
   ValidateScaleFactor(state);
   ValidateDuration(state);
+  ValidateIndex(state);
 
 }
 
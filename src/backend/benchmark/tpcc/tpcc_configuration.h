@@ -72,6 +72,9 @@ class configuration {
   // execution duration (ms)
   int duration;
 
+  // index type of all the tables
+  IndexType index;
+
   // throughput
   double throughput;
 
@@ -98,6 +101,8 @@ void ValidateBackendCount(const configuration &state);
 
 void ValidateDuration(const configuration &state);
 
+void ValidateIndex(const configuration &state);
+
 void ParseArguments(int argc, char *argv[], configuration &state);
 
 }  // namespace tpcc
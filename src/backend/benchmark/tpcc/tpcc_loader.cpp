@@ -197,7 +197,7 @@ void CreateWarehouseTable() {
   bool unique = true;
 
   index::IndexMetadata *index_metadata = new index::IndexMetadata(
-      "warehouse_pkey", warehouse_table_pkey_index_oid, INDEX_TYPE_BTREE,
+      "warehouse_pkey", warehouse_table_pkey_index_oid, state.index,
       INDEX_CONSTRAINT_TYPE_PRIMARY_KEY, tuple_schema, key_schema, unique);
 
   index::Index *pkey_index = index::IndexFactory::GetInstance(index_metadata);
@@ -271,7 +271,7 @@ void CreateDistrictTable() {
   bool unique = true;
 
   index::IndexMetadata* index_metadata = new index::IndexMetadata(
-    "district_pkey", district_table_pkey_index_oid, INDEX_TYPE_BTREE,
+    "district_pkey", district_table_pkey_index_oid, state.index,
     INDEX_CONSTRAINT_TYPE_PRIMARY_KEY, tuple_schema, key_schema, unique);
 
   index::Index *pkey_index = index::IndexFactory::GetInstance(index_metadata);
@@ -328,7 +328,7 @@ void CreateItemTable() {
   bool unique = true;
 
   index::IndexMetadata* index_metadata = new index::IndexMetadata(
-    "item_pkey", item_table_pkey_index_oid, INDEX_TYPE_BTREE,
+    "item_pkey", item_table_pkey_index_oid, state.index,
     INDEX_CONSTRAINT_TYPE_PRIMARY_KEY, tuple_schema, key_schema, unique);
 
   index::Index *pkey_index = index::IndexFactory::GetInstance(index_metadata);
@@ -437,7 +437,7 @@ void CreateCustomerTable() {
   key_schema->SetIndexedColumns(key_attrs);
 
   index_metadata = new index::IndexMetadata(
-    "customer_pkey", customer_table_pkey_index_oid, INDEX_TYPE_BTREE,
+    "customer_pkey", customer_table_pkey_index_oid, state.index,
     INDEX_CONSTRAINT_TYPE_PRIMARY_KEY, tuple_schema, key_schema, true);
 
   index::Index *pkey_index = index::IndexFactory::GetInstance(index_metadata);
@@ -451,7 +451,7 @@ void CreateCustomerTable() {
   key_schema->SetIndexedColumns(key_attrs);
 
   index_metadata = new index::IndexMetadata(
-    "customer_skey", customer_table_skey_index_oid, INDEX_TYPE_BTREE,
+    "customer_skey", customer_table_skey_index_oid, state.index,
     INDEX_CONSTRAINT_TYPE_INVALID, tuple_schema, key_schema, false);
 
   index::Index *skey_index = index::IndexFactory::GetInstance(index_metadata);
@@ -594,7 +594,7 @@ void CreateStockTable() {
   bool unique = true;
 
   index::IndexMetadata* index_metadata = new index::IndexMetadata(
-    "stock_pkey", stock_table_pkey_index_oid, INDEX_TYPE_BTREE,
+    "stock_pkey", stock_table_pkey_index_oid, state.index,
     INDEX_CONSTRAINT_TYPE_PRIMARY_KEY, tuple_schema, key_schema, unique);
 
   index::Index *pkey_index = index::IndexFactory::GetInstance(index_metadata);
@@ -665,7 +665,7 @@ void CreateOrdersTable() {
   key_schema->SetIndexedColumns(key_attrs);
 
   index_metadata = new index::IndexMetadata(
-    "orders_pkey", orders_table_pkey_index_oid, INDEX_TYPE_BTREE,
+    "orders_pkey", orders_table_pkey_index_oid, state.index,
     INDEX_CONSTRAINT_TYPE_PRIMARY_KEY, tuple_schema, key_schema, true);
 
   index::Index *pkey_index = index::IndexFactory::GetInstance(index_metadata);
@@ -677,7 +677,7 @@ void CreateOrdersTable() {
   key_schema->SetIndexedColumns(key_attrs);
 
   index_metadata = new index::IndexMetadata(
-    "orders_skey", orders_table_skey_index_oid, INDEX_TYPE_BTREE,
+    "orders_skey", orders_table_skey_index_oid, state.index,
     INDEX_CONSTRAINT_TYPE_INVALID, tuple_schema, key_schema, false);
 
   index::Index *skey_index = index::IndexFactory::GetInstance(index_metadata);
@@ -728,7 +728,7 @@ void CreateNewOrderTable() {
   bool unique = true;
 
   index::IndexMetadata* index_metadata = new index::IndexMetadata(
-    "new_order_pkey", new_order_table_pkey_index_oid, INDEX_TYPE_BTREE,
+    "new_order_pkey", new_order_table_pkey_index_oid, state.index,
     INDEX_CONSTRAINT_TYPE_PRIMARY_KEY, tuple_schema, key_schema, unique);
 
   index::Index *pkey_index = index::IndexFactory::GetInstance(index_metadata);
@@ -805,7 +805,7 @@ void CreateOrderLineTable() {
   key_schema->SetIndexedColumns(key_attrs);
 
   index_metadata = new index::IndexMetadata(
-    "order_line_pkey", order_line_table_pkey_index_oid, INDEX_TYPE_BTREE,
+    "order_line_pkey", order_line_table_pkey_index_oid, state.index,
     INDEX_CONSTRAINT_TYPE_PRIMARY_KEY, tuple_schema, key_schema, true);
 
   index::Index *pkey_index = index::IndexFactory::GetInstance(index_metadata);
@@ -817,7 +817,7 @@ void CreateOrderLineTable() {
   key_schema->SetIndexedColumns(key_attrs);
 
   index_metadata = new index::IndexMetadata(
-    "order_line_skey", order_line_table_skey_index_oid, INDEX_TYPE_BTREE,
+    "order_line_skey", order_line_table_skey_index_oid, state.index,
     INDEX_CONSTRAINT_TYPE_INVALID, tuple_schema, key_schema, false);
 
   index::Index *skey_index = index::IndexFactory::GetInstance(index_metadata);
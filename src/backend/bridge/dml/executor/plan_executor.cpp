@@ -163,6 +163,38 @@ cleanup:
 peloton_status PlanExecutor::ExecutePlan(const planner::AbstractPlan *plan,
                                          const std::vector<Value> &params,
                                          TupleDesc tuple_desc) {
+  List *slots = NULL;
+
+  // Collect all the result tuples as slots
+  auto p_status = ExecutePlan(
+      plan, params, [&slots, tuple_desc](executor::LogicalTile *logical_tile) {
+        for (oid_t tuple_id : *logical_tile) {
+          expression::ContainerTuple<executor::LogicalTile> cur_tuple(
+              logical_tile, tuple_id);
+
+          auto slot =
+              TupleTransformer::GetPostgresTuple(&cur_tuple, tuple_desc);
+
+          if (slot != nullptr) {
+            slots = lappend(slots, slot);
+          }
+        }
+      });
+
+  p_status.m_result_slots = slots;
+
+  return p_status;
+}
+
+/**
+ * @brief Build a executor tree and execute it, streaming the result.
+ * Every logical tile is passed to the sink as soon as the root executor
+ * produces it, so the result is never materialized as a whole.
+ * @return status of execution.
+ */
+peloton_status PlanExecutor::ExecutePlan(
+    const planner::AbstractPlan *plan, const std::vector<Value> &params,
+    std::function<void(executor::LogicalTile *)> logical_tile_sink) {
   peloton_status p_status;
 
   if (plan == nullptr) return p_status;
@@ -172,7 +204,6 @@ peloton_status PlanExecutor::ExecutePlan(const planner::AbstractPlan *plan,
   bool status;
   bool init_failure = false;
   bool single_statement_txn = false;
-  List *slots = NULL;
 
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
   auto txn = peloton::concurrency::current_txn;
@@ -225,22 +256,12 @@ peloton_status PlanExecutor::ExecutePlan(const planner::AbstractPlan *plan,
       continue;
     }
 
-    // Go over the logical tile
-    for (oid_t tuple_id : *logical_tile) {
-      expression::ContainerTuple<executor::LogicalTile> cur_tuple(
-          logical_tile.get(), tuple_id);
-
-      auto slot = TupleTransformer::GetPostgresTuple(&cur_tuple, tuple_desc);
-
-      if (slot != nullptr) {
-        slots = lappend(slots, slot);
-      }
-    }
+    // Hand over the tile right away
+    logical_tile_sink(logical_tile.get());
   }
 
   // Set the result
   p_status.m_processed = executor_context->num_processed;
-  p_status.m_result_slots = slots;
 
 // final cleanup
 cleanup:
@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "backend/common/types.h"
 #include "backend/executor/abstract_executor.h"
 
@@ -54,6 +56,15 @@ class PlanExecutor {
                                     const std::vector<Value> &params,
                                     TupleDesc m_tuple_desc);
 
+  /*
+   * @brief Execute the plan and hand over every logical tile to the sink as
+   * soon as the root executor produces it, instead of collecting the result.
+   * The tile is freed once the sink returns.
+   */
+  static peloton_status ExecutePlan(
+      const planner::AbstractPlan *plan, const std::vector<Value> &params,
+      std::function<void(executor::LogicalTile *)> logical_tile_sink);
+
   /*
    * @brief When a peloton node recvs a query plan, this function is invoked
    * @param plan and params
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "backend/bridge/dml/mapper/mapper.h"
+#include "backend/planner/index_scan_plan.h"
 #include "backend/planner/limit_plan.h"
 
 namespace peloton {
@@ -28,7 +29,6 @@ namespace bridge {
  */
 std::unique_ptr<planner::AbstractPlan> PlanTransformer::TransformLimit(
     const LimitPlanState *limit_state) {
-  // TODO: does not do pass down bound to child node
   // TODO: handle no limit and no offset cases
   LOG_TRACE("Flags :: Limit: %d, Offset: %d", limit_state->noLimit,
            limit_state->noOffset);
@@ -39,7 +39,24 @@ std::unique_ptr<planner::AbstractPlan> PlanTransformer::TransformLimit(
   // Resolve child plan
   AbstractPlanState *subplan_state = outerAbstractPlanState(limit_state);
   assert(subplan_state != nullptr);
-  plan_node->AddChild(TransformPlan(subplan_state));
+  auto child_plan = TransformPlan(subplan_state);
+
+  // Pass the bound down to an index scan below, through projections
+  // as they keep the number of tuples
+  if (limit_state->noLimit == false && limit_state->limit > 0) {
+    planner::AbstractPlan *scan_plan = child_plan.get();
+    while (scan_plan->GetPlanNodeType() == PLAN_NODE_TYPE_PROJECTION &&
+           scan_plan->GetChildren().size() == 1) {
+      scan_plan = scan_plan->GetChildren()[0].get();
+    }
+
+    if (scan_plan->GetPlanNodeType() == PLAN_NODE_TYPE_INDEXSCAN) {
+      static_cast<planner::IndexScanPlan *>(scan_plan)
+          ->SetLimit(limit_state->limit + limit_state->offset);
+    }
+  }
+
+  plan_node->AddChild(std::move(child_plan));
 
   return plan_node;
 }
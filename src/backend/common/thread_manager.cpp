@@ -10,7 +10,9 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <cassert>
+#include <exception>
 
 #include "backend/common/thread_manager.h"
 
@@ -111,6 +113,12 @@ ThreadPool &ThreadPool::GetInstance(void) {
   return thread_pool;
 }
 
+ThreadPool &ThreadPool::GetWorkerInstance(void) {
+  static ThreadPool worker_pool(
+      std::max(std::thread::hardware_concurrency(), 1u));
+  return worker_pool;
+}
+
 ThreadPool::ThreadPool(int threads) : cond_(&mutex_), terminate_(false) {
   // Create number of required threads and add them to the thread pool vector.
   for (int i = 0; i < threads; i++) {
@@ -155,6 +163,46 @@ void ThreadPool::AddTask(std::function<void()> f) {
   cond_.Signal();
 }
 
+void ThreadPool::RunTasks(size_t task_count,
+                          const std::function<void()> &task) {
+  struct TaskState {
+    std::mutex mutex;
+    std::condition_variable condition;
+    size_t running_task_count = 0;
+    std::exception_ptr error;
+  };
+
+  auto state = std::make_shared<TaskState>();
+  auto run_task = [state, &task] {
+    try {
+      task();
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      state->error = std::current_exception();
+    }
+
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->running_task_count--;
+    state->condition.notify_all();
+  };
+
+  state->running_task_count = std::max(task_count, (size_t)1);
+  for (size_t task_itr = 1; task_itr < task_count; task_itr++) {
+    AddTask(run_task);
+  }
+
+  run_task();
+
+  // The task is referenced by the queued copies until they are done
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->condition.wait(lock,
+                        [&state] { return state->running_task_count == 0; });
+
+  if (state->error != nullptr) {
+    std::rethrow_exception(state->error);
+  }
+}
+
 /*
  * @Param args
  *                      ThreadPool instance
@@ -82,9 +82,18 @@ class ThreadPool {
   //       global thread pool can lead to starving for client/server
   static ThreadPool &GetInstance(void);
 
+  // pool of the parallel query operators, one thread per core
+  static ThreadPool &GetWorkerInstance(void);
+
   // The main function: add task into the task queue
   void AddTask(std::function<void()> f);
 
+  // Run the task on the calling thread and task_count - 1 threads of the
+  // pool, and wait for all of them. The task should pull its work from
+  // shared state, so that the calling thread can do all of it when the pool
+  // is busy. An exception thrown by the task is rethrown here.
+  void RunTasks(size_t task_count, const std::function<void()> &task);
+
   // TODO: we don't need this API? by Michael
   // bool AttachThread(std::shared_ptr<std::thread> thread);
 
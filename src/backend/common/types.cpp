@@ -29,6 +29,10 @@ FileHandle INVALID_FILE_HANDLE;
 // then no new insertion of new versions or tuples are available in the table.
 int DEFAULT_TUPLES_PER_TILEGROUP = 1000;
 
+// Number of workers the parallel query operators hand their morsels out to,
+// they run on the calling thread alone if it is 1.
+size_t DEFAULT_QUERY_PARALLELISM = 1;
+
 //===--------------------------------------------------------------------===//
 // Type utilities
 //===--------------------------------------------------------------------===//
@@ -352,11 +356,16 @@ BackendType GetBackendType(const LoggingType& logging_type) {
   return backend_type;
 }
 
-void AtomicUpdateItemPointer(ItemPointer *src_ptr, const ItemPointer &value) {
+bool AtomicUpdateItemPointer(ItemPointer *src_ptr, const ItemPointer &old_value,
+                             const ItemPointer &new_value) {
   assert(sizeof(ItemPointer) == sizeof(int64_t));
   int64_t* cast_src_ptr = reinterpret_cast<int64_t*>((void*)src_ptr);
-  int64_t* cast_value_ptr = reinterpret_cast<int64_t*>((void*)&value);
-  __sync_bool_compare_and_swap(cast_src_ptr, *cast_src_ptr, *cast_value_ptr);
+  int64_t* cast_old_value_ptr =
+      reinterpret_cast<int64_t*>((void*)&old_value);
+  int64_t* cast_new_value_ptr =
+      reinterpret_cast<int64_t*>((void*)&new_value);
+  return __sync_bool_compare_and_swap(cast_src_ptr, *cast_old_value_ptr,
+                                      *cast_new_value_ptr);
 }
 
 //===--------------------------------------------------------------------===//
@@ -687,6 +696,9 @@ std::string IndexTypeToString(IndexType type) {
     case INDEX_TYPE_HASH: {
       return "HASH";
     }
+    case INDEX_TYPE_BTREE_OLC: {
+      return "BTREE_OLC";
+    }
   }
   return "INVALID";
 }
@@ -698,6 +710,8 @@ IndexType StringToIndexType(std::string str) {
     return INDEX_TYPE_BTREE;
   } else if (str == "BWTREE") {
     return INDEX_TYPE_BWTREE;
+  } else if (str == "BTREE_OLC") {
+    return INDEX_TYPE_BTREE_OLC;
   }
   return INDEX_TYPE_INVALID;
 }
@@ -1052,6 +1066,9 @@ std::string LogRecordTypeToString(LogRecordType type) {
     case LOGRECORD_TYPE_ITERATION_DELIMITER: {
       return "LOGRECORD_TYPE_ITERATION_DELIMITER";
     }
+    case LOGRECORD_TYPE_LOG_BLOCK: {
+      return "LOGRECORD_TYPE_LOG_BLOCK";
+    }
   }
   return "INVALID";
 }
@@ -51,11 +51,13 @@ enum LoggerMappingStrategyType {
 enum CheckpointType {
   CHECKPOINT_TYPE_INVALID = 0,
   CHECKPOINT_TYPE_NORMAL = 1,
+  CHECKPOINT_TYPE_IMAGE = 2,  // tile group images mapped on recovery
 };
 
 enum GCType {
   GC_TYPE_OFF = 0,
-  GC_TYPE_ON = 1
+  GC_TYPE_ON = 1,           // background gc threads
+  GC_TYPE_COOPERATIVE = 2,  // workers reclaim when transactions end
 };
 
 //===--------------------------------------------------------------------===//
@@ -117,6 +119,8 @@ class Value;
 
 extern int DEFAULT_TUPLES_PER_TILEGROUP;
 
+extern size_t DEFAULT_QUERY_PARALLELISM;
+
 // TODO: Use ThreadLocalPool ?
 // This needs to be >= the VoltType.MAX_VALUE_LENGTH defined in java, currently
 // 1048576.
@@ -379,6 +383,19 @@ enum IsolationLevelType {
   ISOLATION_LEVEL_TYPE_REPEATABLE_READ = 2  // repeatable read
 };
 
+// Order in which the versions of a tuple are reached from its primary index
+// entry, the versions are linked in both directions either way
+enum VersionOrderType {
+  VERSION_ORDER_TYPE_O2N = 0,  // the index points at the oldest version
+  VERSION_ORDER_TYPE_N2O = 1   // the index points at the newest version
+};
+
+// Source of the begin and commit ids of transactions
+enum TimestampType {
+  TIMESTAMP_TYPE_GLOBAL = 0,  // one counter shared by all the workers
+  TIMESTAMP_TYPE_EPOCH = 1    // the epoch and a per worker sequence
+};
+
 enum BackendType {
   BACKEND_TYPE_INVALID = 0,  // invalid backend type
 
@@ -395,9 +412,10 @@ enum BackendType {
 enum IndexType {
   INDEX_TYPE_INVALID = 0,  // invalid index type
 
-  INDEX_TYPE_BTREE = 1,   // btree
-  INDEX_TYPE_BWTREE = 2,  // bwtree
-  INDEX_TYPE_HASH = 3     // hash
+  INDEX_TYPE_BTREE = 1,      // btree
+  INDEX_TYPE_BWTREE = 2,     // bwtree
+  INDEX_TYPE_HASH = 3,       // hash
+  INDEX_TYPE_BTREE_OLC = 4   // btree with optimistic lock coupling
 };
 
 enum IndexConstraintType {
@@ -698,6 +716,9 @@ enum LogRecordType {
   // Record for delimiting transactions
   // includes max persistent commit_id
   LOGRECORD_TYPE_ITERATION_DELIMITER = 41,
+
+  // Compressed block of write ahead log records
+  LOGRECORD_TYPE_LOG_BLOCK = 51,
 };
 
 enum CheckpointStatus {
@@ -843,7 +864,9 @@ bool IsBasedOnWriteBehindLogging(const LoggingType &logging_type);
 
 BackendType GetBackendType(const LoggingType &logging_type);
 
-void AtomicUpdateItemPointer(ItemPointer *src_ptr, const ItemPointer &value);
+// Swing the item pointer to the new value if it still holds the old one
+bool AtomicUpdateItemPointer(ItemPointer *src_ptr, const ItemPointer &old_value,
+                             const ItemPointer &new_value);
 
 //===--------------------------------------------------------------------===//
 // Transformers
@@ -1119,4 +1119,39 @@ Value Value::GetMinValue(ValueType type) {
   }
 }
 
+Value Value::GetMaxValue(ValueType type) {
+  switch (type) {
+    case VALUE_TYPE_TINYINT:
+      return GetTinyIntValue(INT8_MAX);
+    case VALUE_TYPE_SMALLINT:
+      return GetSmallIntValue(INT16_MAX);
+    case VALUE_TYPE_INTEGER:
+      return GetIntegerValue(INT32_MAX);
+    case VALUE_TYPE_BIGINT:
+      return GetBigIntValue(INT64_MAX);
+    case VALUE_TYPE_REAL:
+      return GetDoubleValue(FLT_MAX);
+    case VALUE_TYPE_DOUBLE:
+      return GetDoubleValue(DBL_MAX);
+    case VALUE_TYPE_DATE:
+      return GetIntegerValue(INT32_MAX);
+    case VALUE_TYPE_TIMESTAMP:
+      return GetTimestampValue(INT64_MAX);
+    case VALUE_TYPE_DECIMAL:
+      return GetDecimalValue(DECIMAL_MAX);
+    case VALUE_TYPE_BOOLEAN:
+      return GetTrue();
+
+    // strings have no largest value
+    case VALUE_TYPE_VARCHAR:
+    case VALUE_TYPE_INVALID:
+    case VALUE_TYPE_NULL:
+    case VALUE_TYPE_ADDRESS:
+    case VALUE_TYPE_VARBINARY:
+    default: {
+      throw UnknownTypeException((int)type, "Can't get max value for type");
+    }
+  }
+}
+
 }  // End peloton namespace
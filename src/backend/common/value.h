@@ -332,6 +332,9 @@ class Value {
   /* Serialize this Value to a SerializeOutput */
   void SerializeTo(SerializeOutput &output) const;
 
+  /* Number of bytes SerializeTo writes for this Value */
+  size_t GetSerializedSize() const;
+
   /* Serialize this Value to an Export stream */
   void SerializeToExportWithoutNull(ExportSerializeOutput &) const;
 
@@ -395,6 +398,9 @@ class Value {
   // Get min value
   static Value GetMinValue(ValueType);
 
+  // Get max value
+  static Value GetMaxValue(ValueType);
+
   int GetIntegerForTestsOnly() { return GetInteger(); }
 
   ////////////////////////////////////////////////////////////
@@ -3208,6 +3214,38 @@ inline void Value::SerializeTo(SerializeOutput &output) const {
   }
 }
 
+inline size_t Value::GetSerializedSize() const {
+  const ValueType type = GetValueType();
+  switch (type) {
+    case VALUE_TYPE_VARCHAR:
+    case VALUE_TYPE_VARBINARY: {
+      if (IsNull()) {
+        return sizeof(int32_t);
+      }
+      return sizeof(int32_t) + GetObjectLengthWithoutNull();
+    }
+    case VALUE_TYPE_TINYINT:
+      return sizeof(int8_t);
+    case VALUE_TYPE_SMALLINT:
+      return sizeof(int16_t);
+    case VALUE_TYPE_DATE:
+    case VALUE_TYPE_INTEGER:
+      return sizeof(int32_t);
+    case VALUE_TYPE_TIMESTAMP:
+    case VALUE_TYPE_BIGINT:
+    case VALUE_TYPE_REAL:
+    case VALUE_TYPE_DOUBLE:
+      return sizeof(int64_t);
+    case VALUE_TYPE_DECIMAL:
+      return 2 * sizeof(int64_t);
+    default:
+      throw Exception(
+          "Value::GetSerializedSize() found a column "
+          "with ValueType '%s' that is not handled" +
+          GetValueTypeString());
+  }
+}
+
 inline void Value::SerializeToExportWithoutNull(
     ExportSerializeOutput &io) const {
   assert(IsNull() == false);
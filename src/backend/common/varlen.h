@@ -55,6 +55,11 @@ class Varlen {
   char *Get();
   const char *Get() const;
 
+  /**
+   * @brief Size of the string, including its length prefix.
+   */
+  std::size_t GetSize() const { return varlen_size; }
+
  private:
   Varlen(std::size_t size);
   Varlen(std::size_t size, VarlenPool *data_pool);
@@ -96,24 +96,26 @@ void EagerWriteTxnManager::RemoveReader() {
   auto txn = current_txn;
   auto &rw_set = txn->GetRWSet();
 
-  for (auto &tile_group_entry : rw_set) {
-    oid_t tile_group_id = tile_group_entry.first;
-    auto &manager = catalog::Manager::GetInstance();
-    auto tile_group = manager.GetTileGroup(tile_group_id);
+  // the table may be dropped, look each tile group up once to find out
+  oid_t tile_group_id = INVALID_OID;
+  std::shared_ptr<storage::TileGroup> tile_group;
+  for (auto &entry : rw_set) {
+    if (entry.tile_group_id != tile_group_id) {
+      tile_group_id = entry.tile_group_id;
+      tile_group = catalog::Manager::GetInstance().GetTileGroup(tile_group_id);
+    }
     if (tile_group == nullptr) continue;
 
-    auto tile_group_header = tile_group->GetHeader();
-    for (auto &tuple_entry : tile_group_entry.second) {
-      auto tuple_slot = tuple_entry.first;
+    auto tile_group_header = entry.tile_group_header;
+    auto tuple_slot = entry.tuple_slot;
 
-      // we don't have reader lock on insert
-      if (tuple_entry.second == RW_TYPE_INSERT ||
-          tuple_entry.second == RW_TYPE_INS_DEL) {
-        continue;
-      }
-
-      RemoveReader(tile_group_header, tuple_slot, txn->GetTransactionId());
+    // we don't have reader lock on insert
+    if (entry.type == RW_TYPE_INSERT ||
+        entry.type == RW_TYPE_INS_DEL) {
+      continue;
     }
+
+    RemoveReader(tile_group_header, tuple_slot, txn->GetTransactionId());
   }
   LOG_TRACE("release EWreader finish");
 }
@@ -156,6 +158,14 @@ bool EagerWriteTxnManager::AcquireOwnership(
 
   // Check if we successfully get the write lock
   bool res = (old_tid == INITIAL_TXN_ID);
+
+  // a transaction may have committed a newer version after the caller found
+  // this one ownable, then it is given back
+  if (res && tile_group_header->GetEndCommitId(tuple_id) != MAX_CID) {
+    tile_group_header->SetAtomicTransactionId(tuple_id, current_tid,
+                                              INITIAL_TXN_ID);
+    res = false;
+  }
   if (!res) {
     LOG_TRACE("Fail to acquire write lock. Set txn failure.");
     ReleaseEwReaderLock(tile_group_header, tuple_id);
@@ -199,6 +209,11 @@ bool EagerWriteTxnManager::AcquireOwnership(
 }
 
 bool EagerWriteTxnManager::PerformRead(const ItemPointer &location) {
+  // a READ ONLY transaction reads its snapshot, writers do not wait for it
+  if (current_txn->IsDeclaredReadOnly() == true) {
+    return true;
+  }
+
   oid_t tile_group_id = location.block;
   oid_t tuple_id = location.offset;
 
@@ -207,13 +222,9 @@ bool EagerWriteTxnManager::PerformRead(const ItemPointer &location) {
   auto tile_group = manager.GetTileGroup(tile_group_id);
   auto tile_group_header = tile_group->GetHeader();
 
-  auto &rw_set = current_txn->GetRWSet();
-  auto tuple_map = rw_set.find(tile_group_id);
-  if (tuple_map != rw_set.end()) {
-    if (tuple_map->second.find(tuple_id) != tuple_map->second.end()) {
-      // It was already accessed, don't acquire read lock again
-      return true;
-    }
+  if (current_txn->IsAccessed(location) == true) {
+    // It was already accessed, don't acquire read lock again
+    return true;
   }
 
   if (IsOwner(tile_group_header, tuple_id)) {
@@ -235,7 +246,7 @@ bool EagerWriteTxnManager::PerformRead(const ItemPointer &location) {
 
   AddReader(tile_group_header, tuple_id);
   ReleaseEwReaderLock(tile_group_header, tuple_id);
-  current_txn->RecordRead(location);
+  current_txn->RecordRead(location, tile_group_header);
 
   return true;
 }
@@ -262,7 +273,7 @@ bool EagerWriteTxnManager::PerformInsert(const ItemPointer &location) {
   // no need to set next item pointer.
 
   // Add the new tuple into the insert set
-  current_txn->RecordInsert(location);
+  current_txn->RecordInsert(location, tile_group_header);
   InitTupleReserved(tile_group_id, tuple_id);
   return true;
 }
@@ -301,7 +312,9 @@ void EagerWriteTxnManager::PerformUpdate(const ItemPointer &old_location,
   InitTupleReserved(new_location.block, new_location.offset);
 
   // Add the old tuple into the update set
-  current_txn->RecordUpdate(old_location);
+  current_txn->RecordUpdate(old_location, tile_group_header);
+
+  InstallNewVersion(old_location, new_location);
 }
 
 void EagerWriteTxnManager::PerformUpdate(const ItemPointer &location) {
@@ -322,7 +335,10 @@ void EagerWriteTxnManager::PerformUpdate(const ItemPointer &location) {
   auto old_location = tile_group_header->GetPrevItemPointer(tuple_id);
   if (old_location.IsNull() == false) {
     // update an inserted version
-    current_txn->RecordUpdate(old_location);
+    auto old_tile_group_header = catalog::Manager::GetInstance()
+                                     .GetTileGroup(old_location.block)
+                                     ->GetHeader();
+    current_txn->RecordUpdate(old_location, old_tile_group_header);
   }
 }
 
@@ -354,7 +370,9 @@ void EagerWriteTxnManager::PerformDelete(const ItemPointer &old_location,
   new_tile_group_header->SetEndCommitId(new_location.offset, INVALID_CID);
   InitTupleReserved(new_location.block, new_location.offset);
 
-  current_txn->RecordDelete(old_location);
+  current_txn->RecordDelete(old_location, tile_group_header);
+
+  InstallNewVersion(old_location, new_location);
 }
 
 void EagerWriteTxnManager::PerformDelete(const ItemPointer &location) {
@@ -376,10 +394,13 @@ void EagerWriteTxnManager::PerformDelete(const ItemPointer &location) {
   auto old_location = tile_group_header->GetPrevItemPointer(tuple_id);
   if (old_location.IsNull() == false) {
     // delete an inserted version
-    current_txn->RecordDelete(old_location);
+    auto old_tile_group_header = catalog::Manager::GetInstance()
+                                     .GetTileGroup(old_location.block)
+                                     ->GetHeader();
+    current_txn->RecordDelete(old_location, old_tile_group_header);
   } else {
     // if this version is newly inserted.
-    current_txn->RecordDelete(location);
+    current_txn->RecordDelete(location, tile_group_header);
   }
 }
 
@@ -430,87 +451,84 @@ Result EagerWriteTxnManager::CommitTransaction() {
   log_manager.LogBeginTransaction(end_commit_id);
 
   // install everything.
-  for (auto &tile_group_entry : rw_set) {
-    oid_t tile_group_id = tile_group_entry.first;
-    auto tile_group = manager.GetTileGroup(tile_group_id);
-    auto tile_group_header = tile_group->GetHeader();
-    for (auto &tuple_entry : tile_group_entry.second) {
-      auto tuple_slot = tuple_entry.first;
-      if (tuple_entry.second == RW_TYPE_UPDATE) {
-        // we must guarantee that, at any time point, only one version is
-        // visible.
-        ItemPointer new_version =
-            tile_group_header->GetNextItemPointer(tuple_slot);
-        ItemPointer old_version(tile_group_id, tuple_slot);
+  for (auto &entry : rw_set) {
+    oid_t tile_group_id = entry.tile_group_id;
+    auto tile_group_header = entry.tile_group_header;
+    auto tuple_slot = entry.tuple_slot;
+    if (entry.type == RW_TYPE_UPDATE) {
+      // we must guarantee that, at any time point, only one version is
+      // visible.
+      ItemPointer new_version =
+          tile_group_header->GetNextItemPointer(tuple_slot);
+      ItemPointer old_version(tile_group_id, tuple_slot);
 
-        // logging.
-        log_manager.LogUpdate(end_commit_id, old_version, new_version);
+      // logging.
+      log_manager.LogUpdate(end_commit_id, old_version, new_version);
 
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
+      auto new_tile_group_header =
+          manager.GetTileGroup(new_version.block)->GetHeader();
 
-        new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
-        new_tile_group_header->SetBeginCommitId(new_version.offset,
-                                                end_commit_id);
+      new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
+      new_tile_group_header->SetBeginCommitId(new_version.offset,
+                                              end_commit_id);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
+      tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INITIAL_TXN_ID);
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INITIAL_TXN_ID);
 
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-      } else if (tuple_entry.second == RW_TYPE_DELETE) {
-        ItemPointer new_version =
-            tile_group_header->GetNextItemPointer(tuple_slot);
-        ItemPointer delete_location(tile_group_id, tuple_slot);
+    } else if (entry.type == RW_TYPE_DELETE) {
+      ItemPointer new_version =
+          tile_group_header->GetNextItemPointer(tuple_slot);
+      ItemPointer delete_location(tile_group_id, tuple_slot);
 
-        // logging.
-        log_manager.LogDelete(end_commit_id, delete_location);
+      // logging.
+      log_manager.LogDelete(end_commit_id, delete_location);
 
-        // we do not change begin cid for old tuple.
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
+      // we do not change begin cid for old tuple.
+      auto new_tile_group_header =
+          manager.GetTileGroup(new_version.block)->GetHeader();
 
-        new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
-        new_tile_group_header->SetBeginCommitId(new_version.offset,
-                                                end_commit_id);
+      new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
+      new_tile_group_header->SetBeginCommitId(new_version.offset,
+                                              end_commit_id);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
+      tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INVALID_TXN_ID);
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INVALID_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-      } else if (tuple_entry.second == RW_TYPE_INSERT) {
-        // set the begin commit id to persist insert
-        ItemPointer insert_location(tile_group_id, tuple_slot);
-        log_manager.LogInsert(end_commit_id, insert_location);
+    } else if (entry.type == RW_TYPE_INSERT) {
+      // set the begin commit id to persist insert
+      ItemPointer insert_location(tile_group_id, tuple_slot);
+      log_manager.LogInsert(end_commit_id, insert_location);
 
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
-        tile_group_header->SetBeginCommitId(tuple_slot, end_commit_id);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetBeginCommitId(tuple_slot, end_commit_id);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-      } else if (tuple_entry.second == RW_TYPE_INS_DEL) {
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
-        tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+    } else if (entry.type == RW_TYPE_INS_DEL) {
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        // set the begin commit id to persist insert
-        tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
-      }
+      // set the begin commit id to persist insert
+      tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
     }
   }
   log_manager.LogCommitTransaction(end_commit_id);
@@ -526,76 +544,76 @@ Result EagerWriteTxnManager::AbortTransaction() {
 
   auto &rw_set = current_txn->GetRWSet();
 
-  for (auto &tile_group_entry : rw_set) {
-    oid_t tile_group_id = tile_group_entry.first;
-    auto tile_group = manager.GetTileGroup(tile_group_id);
-    auto tile_group_header = tile_group->GetHeader();
+  for (auto &entry : rw_set) {
+    oid_t tile_group_id = entry.tile_group_id;
+    auto tile_group_header = entry.tile_group_header;
+    auto tuple_slot = entry.tuple_slot;
+    if (entry.type == RW_TYPE_UPDATE) {
+      ItemPointer new_version =
+          tile_group_header->GetNextItemPointer(tuple_slot);
+      UninstallNewVersion(ItemPointer(tile_group_id, tuple_slot),
+                          new_version);
+      auto new_tile_group_header =
+          manager.GetTileGroup(new_version.block)->GetHeader();
+      new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
+      new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
 
-    for (auto &tuple_entry : tile_group_entry.second) {
-      auto tuple_slot = tuple_entry.first;
-      if (tuple_entry.second == RW_TYPE_UPDATE) {
-        ItemPointer new_version =
-            tile_group_header->GetNextItemPointer(tuple_slot);
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
-        new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
-        new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
+      COMPILER_MEMORY_FENCE;
 
-        COMPILER_MEMORY_FENCE;
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
 
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+      // reset the item pointers.
+      tile_group_header->SetNextItemPointer(tuple_slot, INVALID_ITEMPOINTER);
+      new_tile_group_header->SetPrevItemPointer(new_version.offset, INVALID_ITEMPOINTER);
 
-        // reset the item pointers.
-        tile_group_header->SetNextItemPointer(tuple_slot, INVALID_ITEMPOINTER);
-        new_tile_group_header->SetPrevItemPointer(new_version.offset, INVALID_ITEMPOINTER);
+      COMPILER_MEMORY_FENCE;
 
-        COMPILER_MEMORY_FENCE;
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INVALID_TXN_ID);
+      // AtomicSetOnlyTxnId(tile_group_header, tuple_slot, INITIAL_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INVALID_TXN_ID);
-        // AtomicSetOnlyTxnId(tile_group_header, tuple_slot, INITIAL_TXN_ID);
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+    } else if (entry.type == RW_TYPE_DELETE) {
+      ItemPointer new_version =
+          tile_group_header->GetNextItemPointer(tuple_slot);
+      UninstallNewVersion(ItemPointer(tile_group_id, tuple_slot),
+                          new_version);
 
-      } else if (tuple_entry.second == RW_TYPE_DELETE) {
-        ItemPointer new_version =
-            tile_group_header->GetNextItemPointer(tuple_slot);
+      auto new_tile_group_header =
+          manager.GetTileGroup(new_version.block)->GetHeader();
 
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
+      new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
+      new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
 
-        new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
-        new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
+      COMPILER_MEMORY_FENCE;
 
-        COMPILER_MEMORY_FENCE;
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
 
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+      // reset the item pointers.
+      tile_group_header->SetNextItemPointer(tuple_slot, INVALID_ITEMPOINTER);
+      new_tile_group_header->SetPrevItemPointer(new_version.offset, INVALID_ITEMPOINTER);
 
-        // reset the item pointers.
-        tile_group_header->SetNextItemPointer(tuple_slot, INVALID_ITEMPOINTER);
-        new_tile_group_header->SetPrevItemPointer(new_version.offset, INVALID_ITEMPOINTER);
+      COMPILER_MEMORY_FENCE;
 
-        COMPILER_MEMORY_FENCE;
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INVALID_TXN_ID);
+      // AtomicSetOnlyTxnId(tile_group_header, tuple_slot, INITIAL_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INVALID_TXN_ID);
-        // AtomicSetOnlyTxnId(tile_group_header, tuple_slot, INITIAL_TXN_ID);
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+    } else if (entry.type == RW_TYPE_INSERT) {
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
 
-      } else if (tuple_entry.second == RW_TYPE_INSERT) {
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
-        tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+      COMPILER_MEMORY_FENCE;
 
-        COMPILER_MEMORY_FENCE;
+      tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
+    } else if (entry.type == RW_TYPE_INS_DEL) {
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
 
-        tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
-      } else if (tuple_entry.second == RW_TYPE_INS_DEL) {
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
-        tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+      COMPILER_MEMORY_FENCE;
 
-        COMPILER_MEMORY_FENCE;
-
-        tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
-      }
+      tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
     }
   }
 
@@ -86,10 +86,11 @@ class EagerWriteTxnManager : public TransactionManager {
 
   virtual Result AbortTransaction();
 
-  virtual Transaction *BeginTransaction() {
+  virtual Transaction *BeginTransaction(const bool read_only = false) {
     txn_id_t txn_id = GetNextTransactionId();
-    cid_t begin_cid = GetNextCommitId();
-    Transaction *txn = new Transaction(txn_id, begin_cid);
+    size_t eid;
+    cid_t begin_cid = GetNextBeginCommitId(eid, read_only);
+    Transaction *txn = AllocateTransaction(txn_id, begin_cid, read_only);
     current_txn = txn;
 
     EagerWriteTxnContext *txn_ctx = new EagerWriteTxnContext();
@@ -101,8 +102,6 @@ class EagerWriteTxnManager : public TransactionManager {
       running_txn_map_[txn_id] = txn_ctx;
     }
 
-
-    auto eid = EpochManagerFactory::GetInstance().EnterEpoch(begin_cid);
     txn->SetEpochId(eid);
 
     return txn;
@@ -131,10 +130,12 @@ class EagerWriteTxnManager : public TransactionManager {
 
     EpochManagerFactory::GetInstance().ExitEpoch(current_txn->GetEpochId());
 
-    delete current_txn;
+    RecycleTransaction(current_txn);
     delete current_txn_ctx;
     current_txn = nullptr;
     current_txn_ctx = nullptr;
+
+    gc::GCManagerFactory::GetInstance().CooperativeGC();
   }
 
 
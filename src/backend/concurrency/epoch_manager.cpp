@@ -13,10 +13,260 @@
 
 #include "epoch_manager.h"
 
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+
 namespace peloton {
 namespace concurrency {
 
-//  volatile cid_t EpochManager::curr_epoch_ = 1;
+EpochManager::EpochManager()
+    : epoch_slot_high_water_(0),
+      current_epoch_(0),
+      epoch_length_(EPOCH_LENGTH),
+      max_cid_(0),
+      finish_(false) {
+  static_assert(sizeof(EpochSlot) == 64, "epoch slot is not a cache line");
+
+  for (size_t slot_itr = 0; slot_itr < epoch_slot_count_; slot_itr++) {
+    auto &slot = epoch_slots_[slot_itr];
+    slot.version = 0;
+    slot.running_epoch = MAX_EPOCH_ID;
+    slot.running_begin_cid = INVALID_CID;
+    slot.last_epoch = 0;
+    slot.last_epoch_max_cid = 0;
+    slot.earlier_max_cid = 0;
+    slot.running_count = 0;
+    slot.occupied = false;
+  }
+
+  ts_thread_ = std::thread(&EpochManager::Start, this);
+}
+
+EpochManager::~EpochManager() {
+  finish_ = true;
+  ts_thread_.join();
+}
+
+void EpochManager::Reset() {
+  finish_ = true;
+  ts_thread_.join();
+
+  current_epoch_ = 0;
+  max_cid_ = 0;
+
+  // no transaction runs, the cids of the earlier epochs are dropped
+  auto slot_count = epoch_slot_high_water_.load();
+  for (size_t slot_itr = 0; slot_itr < slot_count; slot_itr++) {
+    auto &slot = epoch_slots_[slot_itr];
+    slot.last_epoch = 0;
+    slot.last_epoch_max_cid = 0;
+    slot.earlier_max_cid = 0;
+  }
+
+  finish_ = false;
+  ts_thread_ = std::thread(&EpochManager::Start, this);
+}
+
+EpochManager::ThreadSlot::~ThreadSlot() {
+  if (epoch_manager != nullptr) {
+    epoch_manager->ReleaseThreadSlot(slot_offset);
+  }
+}
+
+EpochManager::EpochSlot &EpochManager::GetThreadSlot() {
+  static thread_local ThreadSlot thread_slot;
+
+  if (thread_slot.epoch_manager == this) {
+    return epoch_slots_[thread_slot.slot_offset];
+  }
+
+  // a thread holds a slot of one epoch manager at a time
+  if (thread_slot.epoch_manager != nullptr) {
+    thread_slot.epoch_manager->ReleaseThreadSlot(thread_slot.slot_offset);
+    thread_slot.epoch_manager = nullptr;
+  }
+
+  // claim a free slot, wait for a thread to exit if there is none
+  size_t slot_offset = 0;
+  while (true) {
+    bool expected = false;
+    if (epoch_slots_[slot_offset].occupied.compare_exchange_strong(
+            expected, true) == true) {
+      break;
+    }
+    slot_offset = (slot_offset + 1) % epoch_slot_count_;
+    if (slot_offset == 0) {
+      std::this_thread::yield();
+    }
+  }
+
+  // the reclaimer looks at the slot before the thread enters an epoch
+  auto high_water = epoch_slot_high_water_.load();
+  while (high_water < slot_offset + 1 &&
+         epoch_slot_high_water_.compare_exchange_weak(
+             high_water, slot_offset + 1) == false) {
+  }
+
+  auto &slot = epoch_slots_[slot_offset];
+  slot.running_count = 0;
+  slot.running_epoch = MAX_EPOCH_ID;
+
+  thread_slot.epoch_manager = this;
+  thread_slot.slot_offset = slot_offset;
+  return slot;
+}
+
+void EpochManager::ReleaseThreadSlot(size_t slot_offset) {
+  auto &slot = epoch_slots_[slot_offset];
+
+  // the cids stay, the next owner carries them on
+  slot.running_count = 0;
+  slot.running_epoch = MAX_EPOCH_ID;
+  slot.occupied = false;
+}
+
+size_t EpochManager::EnterCurrentEpoch() {
+  auto &slot = GetThreadSlot();
+  auto epoch = current_epoch_.load();
+
+  // the oldest running transaction of the thread keeps the slot in its epoch
+  if (slot.running_count++ != 0) {
+    return epoch;
+  }
+
+  // the begin cid is not drawn yet, the reclaimer waits for it
+  slot.running_begin_cid = INVALID_CID;
 
+  // make sure the epoch did not advance before the slot was published
+  while (true) {
+    slot.running_epoch = epoch;
+    auto current_epoch = current_epoch_.load();
+    if (current_epoch == epoch) {
+      return epoch;
+    }
+    epoch = current_epoch;
+  }
+}
+
+void EpochManager::SetEpochMaxCid(size_t epoch, cid_t begin_cid) {
+  auto &slot = GetThreadSlot();
+
+  auto running_begin_cid = slot.running_begin_cid.load();
+  if (running_begin_cid == INVALID_CID || begin_cid < running_begin_cid) {
+    slot.running_begin_cid = begin_cid;
+  }
+
+  slot.version++;
+
+  auto last_epoch = slot.last_epoch.load();
+  if (epoch == last_epoch) {
+    if (begin_cid > slot.last_epoch_max_cid) {
+      slot.last_epoch_max_cid = begin_cid;
+    }
+  } else if (epoch > last_epoch) {
+    if (slot.last_epoch_max_cid > slot.earlier_max_cid) {
+      slot.earlier_max_cid = slot.last_epoch_max_cid.load();
+    }
+    slot.last_epoch = epoch;
+    slot.last_epoch_max_cid = begin_cid;
+  } else if (begin_cid > slot.earlier_max_cid) {
+    slot.earlier_max_cid = begin_cid;
+  }
+
+  slot.version++;
+}
+
+void EpochManager::ExitEpoch(__attribute__((unused)) size_t epoch) {
+  auto &slot = GetThreadSlot();
+
+  assert(slot.running_count > 0);
+  assert(epoch >= slot.running_epoch);
+  assert(epoch <= current_epoch_);
+
+  if (--slot.running_count == 0) {
+    slot.running_epoch = MAX_EPOCH_ID;
+  }
+}
+
+cid_t EpochManager::GetMaxDeadTxnCid() {
+  // The epochs before the oldest running transaction are dead. So are the
+  // epochs before the previous one, a transaction that drew its begin cid
+  // may not have entered the current epoch yet.
+  auto dead_epoch = current_epoch_.load();
+  if (dead_epoch > 0) {
+    dead_epoch--;
+  }
+
+  auto slot_count = epoch_slot_high_water_.load();
+  for (size_t slot_itr = 0; slot_itr < slot_count; slot_itr++) {
+    auto running_epoch = epoch_slots_[slot_itr].running_epoch.load();
+    if (running_epoch < dead_epoch) {
+      dead_epoch = running_epoch;
+    }
+  }
+
+  cid_t max_cid = 0;
+  for (size_t slot_itr = 0; slot_itr < slot_count; slot_itr++) {
+    auto &slot = epoch_slots_[slot_itr];
+
+    size_t last_epoch;
+    cid_t last_epoch_max_cid;
+    cid_t earlier_max_cid;
+    while (true) {
+      auto version = slot.version.load();
+      if ((version & 1) != 0) {
+        _mm_pause();
+        continue;
+      }
+      last_epoch = slot.last_epoch.load();
+      last_epoch_max_cid = slot.last_epoch_max_cid.load();
+      earlier_max_cid = slot.earlier_max_cid.load();
+      if (slot.version.load() == version) {
+        break;
+      }
+    }
+
+    // the begin cids of the slot are dead up to the epoch it last entered
+    if (last_epoch < dead_epoch) {
+      max_cid = std::max(max_cid, std::max(last_epoch_max_cid, earlier_max_cid));
+    } else if (last_epoch == dead_epoch) {
+      max_cid = std::max(max_cid, earlier_max_cid);
+    }
+  }
+
+  // A transaction of a dead epoch may have drawn its begin cid after a
+  // running one, whose versions must stay. The running slots are read after
+  // the cids above, a transaction that enters later draws a larger cid.
+  for (size_t slot_itr = 0; slot_itr < slot_count; slot_itr++) {
+    auto &slot = epoch_slots_[slot_itr];
+    if (slot.running_epoch.load() == MAX_EPOCH_ID) {
+      continue;
+    }
+
+    auto running_begin_cid = slot.running_begin_cid.load();
+    if (running_begin_cid == INVALID_CID) {
+      // the begin cid is being drawn, keep the previous bound
+      return max_cid_.load();
+    }
+    max_cid = std::min(max_cid, running_begin_cid - 1);
+  }
+
+  AtomicMax(max_cid_, max_cid);
+  return max_cid_.load();
+}
+
+void EpochManager::Start() {
+  while (finish_ == false) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(epoch_length_.load()));
+
+    current_epoch_++;
+
+    // a slot keeps the cids of its last two epochs only, fold the dead ones
+    // into the bound before the owner moves on
+    GetMaxDeadTxnCid();
+  }
+}
+
+}
 }
-}
\ No newline at end of file
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 #pragma once
 
+#include <atomic>
 #include <thread>
 #include <vector>
 
@@ -20,214 +21,134 @@
 namespace peloton {
 namespace concurrency {
 
+// default length of an epoch (in ms)
 #define EPOCH_LENGTH 40
 
-  struct Epoch {
-    std::atomic<int> txn_ref_count_;
-    cid_t max_cid_;
+/**
+ * Epochs of the running transactions, garbage collection reclaims the
+ * versions that ended before the begin cids of dead epochs.
+ *
+ * Every worker thread owns a cache-line padded slot. It publishes the oldest
+ * epoch it runs a transaction in, the begin cid of its oldest running
+ * transaction and the largest begin cids it handed out, and only the owner
+ * writes it. The reclaimer computes the minimum over the slots, beginning
+ * and ending a transaction never touches a shared line.
+ *
+ * A transaction enters its epoch before it draws the begin cid. The begin
+ * cids of dead epochs may still be larger than that of a running transaction
+ * that drew its cid earlier, so they are bounded by the running ones.
+ */
+class EpochManager {
+ public:
+  EpochManager();
 
-    Epoch() :txn_ref_count_(0), max_cid_(0){}
+  EpochManager(const EpochManager &) = delete;
+  EpochManager &operator=(const EpochManager &) = delete;
 
-    void Init() {
-      txn_ref_count_ = 0;
-      max_cid_ = 0;
-    }
-  };
+  ~EpochManager();
 
-  class EpochManager {
-  public:
-    EpochManager()
-      : epoch_queue_(epoch_queue_size_), queue_tail_(0), current_epoch_(0), queue_tail_gc(true), max_cid(0), finish_(false) {
-      //ts_thread_.reset(new std::thread(&EpochManager::Start, this));
-      //ts_thread_->detach();
-      ts_thread_ = std::thread(&EpochManager::Start, this);
-    }
+  void Reset();
 
-    void Reset() {
-      finish_ = true;
-      ts_thread_.join();
+  size_t EnterEpoch(cid_t begin_cid) {
+    auto epoch = EnterCurrentEpoch();
 
-      queue_tail_ = 0;
-      current_epoch_ = 0;
-      epoch_queue_[0].Init();
-      queue_tail_gc = true;
-      max_cid = 0;
+    SetEpochMaxCid(epoch, begin_cid);
 
-      finish_ = false;
-      ts_thread_ = std::thread(&EpochManager::Start, this);
-    }
+    return epoch;
+  }
 
-    ~EpochManager() {
-      finish_ = true;
-      ts_thread_.join();
-    }
+  // Enter the current epoch before the begin cid is known, it is derived
+  // from the epoch with epoch timestamps
+  size_t EnterCurrentEpoch();
 
-//    static uint64_t GetEpoch() {
-//
-//      COMPILER_MEMORY_FENCE;
-//
-//      uint64_t ret_ts = curr_epoch_;
-//
-//      COMPILER_MEMORY_FENCE;
-//
-//      return ret_ts;
-//    }
+  // the epoch is not dead while the transaction is in it
+  void SetEpochMaxCid(size_t epoch, cid_t begin_cid);
 
+  size_t GetCurrentEpoch() { return current_epoch_.load(); }
 
-    size_t EnterEpoch(cid_t begin_cid) {
-      auto epoch = current_epoch_.load();
+  void ExitEpoch(size_t epoch);
 
-      size_t epoch_idx = epoch % epoch_queue_size_;
-      epoch_queue_[epoch_idx].txn_ref_count_++;
+  // Largest begin cid of the transactions in dead epochs, below the begin
+  // cids of the running transactions
+  cid_t GetMaxDeadTxnCid();
 
-      // Set the max cid in the tuple
-      auto max_cid_ptr = &(epoch_queue_[epoch_idx].max_cid_);
-      AtomicMax(max_cid_ptr, begin_cid);
+  // Length of an epoch (in ms), it applies from the next epoch on
+  void SetEpochLength(size_t epoch_length) { epoch_length_ = epoch_length; }
 
-      return epoch;
-    }
+  size_t GetEpochLength() const { return epoch_length_.load(); }
 
-    void ExitEpoch(size_t epoch) {
-      assert(epoch >= queue_tail_);
-      assert(epoch <= current_epoch_);
+ private:
+  // padded to a cache line, only the owning thread writes it
+  struct EpochSlot {
+    // odd while the owner updates the epoch and cids below
+    std::atomic<size_t> version;
 
-      auto epoch_idx = epoch % epoch_queue_size_;
+    // oldest epoch with a running transaction of the owner, MAX_EPOCH_ID if
+    // none runs
+    std::atomic<size_t> running_epoch;
 
+    // smallest begin cid of the running transactions of the owner,
+    // INVALID_CID while the first one draws it
+    std::atomic<cid_t> running_begin_cid;
 
+    // epoch of the latest transaction and the largest begin cid in it
+    std::atomic<size_t> last_epoch;
+    std::atomic<cid_t> last_epoch_max_cid;
 
-      epoch_queue_[epoch_idx].txn_ref_count_--;
-    }
-      // assume we store epoch_store max_store previously
-    cid_t GetMaxDeadTxnCid() {
-        // TODO:
-        // change to:
-        // increase tail
-        // return max
-      auto tail = queue_tail_.load();
-      auto head = current_epoch_.load();
-      if (head > 0) {
-        head--;
-      }
-      auto res = max_cid;
-
-      auto dead_num = 0;
-      while (tail < head) {
-        auto idx = tail % epoch_queue_size_;
-        // break when meeting running txn
-        if (epoch_queue_[idx].txn_ref_count_ > 0) {
-          break;
-        }
-
-        if(epoch_queue_[idx].max_cid_ > res) {
-          res = epoch_queue_[idx].max_cid_;
-        }
-        tail++;
-        dead_num++;
-      }
-      if (res > max_cid) {
-        AtomicMax(&max_cid, res);
-      }
-
-      if (dead_num > 32) {
-        IncreaseTail();
-      }
-      return max_cid;
-    }
-
-  private:
-    void Start() {
-      while (!finish_) {
-        // the epoch advances every 40 milliseconds.
-        std::this_thread::sleep_for(std::chrono::milliseconds(EPOCH_LENGTH));
+    // largest begin cid of the transactions in the epochs before it
+    std::atomic<cid_t> earlier_max_cid;
 
+    // running transactions of the owner
+    size_t running_count;
 
+    std::atomic<bool> occupied;
 
-        auto next_idx = (current_epoch_.load() + 1) % epoch_queue_size_;
-        auto tail_idx = queue_tail_.load() % epoch_queue_size_;
-        if(next_idx  == tail_idx) {
-          // overflow
-          // in this case, just increase tail
-          IncreaseTail();
-          continue;
-        }
+    char padding[64 - 7 * sizeof(size_t) - sizeof(std::atomic<bool>)];
+  };
 
-        // we have to init it first, then increase current epoch
-        // otherwise may read dirty data
-        epoch_queue_[next_idx].Init();
-        current_epoch_++;
+  // The slot of a thread, given back when the thread exits
+  struct ThreadSlot {
+    ~ThreadSlot();
 
+    EpochManager *epoch_manager = nullptr;
 
-        IncreaseTail();
-      }
-    }
+    size_t slot_offset = 0;
+  };
 
+  static const size_t MAX_EPOCH_ID = static_cast<size_t>(-1);
 
-  void IncreaseTail() {
-    bool expect = true, desired = false;
-    if(!queue_tail_gc.compare_exchange_weak(expect, desired)){
-      // someone now is increasing tail
-      return;
-    }
+  // threads that hold a slot at the same time
+  static const size_t epoch_slot_count_ = 1024;
 
-    auto current = current_epoch_.load();
-    auto tail = queue_tail_.load();
+  EpochSlot &GetThreadSlot();
 
-    while(true) {
-      if(tail + 1 == current) {
-        break;
-      }
+  void ReleaseThreadSlot(size_t slot_offset);
 
-      auto idx = tail % epoch_queue_size_;
+  void Start();
 
-      // inc tail until we find an epoch that has running txn
-      if(epoch_queue_[idx].txn_ref_count_ > 0) {
-        break;
-      }
-
-      // save max cid
-      auto max = epoch_queue_[idx].max_cid_;
-      AtomicMax(&max_cid, max);
-      tail++;
+  void AtomicMax(std::atomic<cid_t> &max_cid, cid_t cid) {
+    auto old = max_cid.load();
+    while (old < cid && max_cid.compare_exchange_weak(old, cid) == false) {
     }
-
-    queue_tail_ = tail;
-
-    expect = false;
-    desired = true;
-
-    queue_tail_gc.compare_exchange_weak(expect, desired);
-    return;
   }
 
+ private:
+  EpochSlot epoch_slots_[epoch_slot_count_];
 
-  void AtomicMax(cid_t* addr, cid_t max) {
-    while(true) {
-      auto old = *addr;
-      if(old > max) {
-        return;
-      }else if ( __sync_bool_compare_and_swap(addr, old, max) ) {
-        return;
-      }
-    }
-  }
+  // slots that were ever handed out
+  std::atomic<size_t> epoch_slot_high_water_;
 
-  private:
-    // queue size
-    static const size_t epoch_queue_size_ = 2048;
+  std::atomic<size_t> current_epoch_;
 
+  std::atomic<size_t> epoch_length_;
 
-    // Epoch vector
-    std::vector<Epoch> epoch_queue_;
-    std::atomic<size_t> queue_tail_;
-    std::atomic<size_t> current_epoch_;
-    std::atomic<bool> queue_tail_gc;
-    cid_t max_cid;
-    bool finish_;
+  std::atomic<cid_t> max_cid_;
 
-    std::thread ts_thread_;
-  };
+  std::atomic<bool> finish_;
+
+  std::thread ts_thread_;
+};
 
-  
 class EpochManagerFactory {
  public:
   static EpochManager &GetInstance() {
@@ -237,4 +158,4 @@ class EpochManagerFactory {
 };
 
 }
-}
\ No newline at end of file
+}
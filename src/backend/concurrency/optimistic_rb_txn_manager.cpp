@@ -116,11 +116,27 @@ bool OptimisticRbTxnManager::AcquireOwnership(
     SetTransactionResult(Result::RESULT_FAILURE);
     return false;
   }
+
+  // a transaction may have committed the master copy after the caller found
+  // it ownable, then it is given back
+  if (tile_group_header->GetBeginCommitId(tuple_id) >
+          current_txn->GetBeginCommitId() ||
+      tile_group_header->GetEndCommitId(tuple_id) != MAX_CID) {
+    tile_group_header->SetAtomicTransactionId(tuple_id, txn_id,
+                                              INITIAL_TXN_ID);
+    SetTransactionResult(Result::RESULT_FAILURE);
+    return false;
+  }
   return true;
 }
 
 
 bool OptimisticRbTxnManager::PerformRead(const ItemPointer &location) {
+  // a READ ONLY transaction reads its snapshot, nothing to track
+  if (current_txn->IsDeclaredReadOnly() == true) {
+    return true;
+  }
+
   current_txn->RecordRead(location);
   return true;
 }
@@ -146,7 +162,7 @@ bool OptimisticRbTxnManager::PerformInsert(const ItemPointer &location) {
   InitTupleReserved(tile_group_header, tuple_id);
 
   // Add the new tuple into the insert set
-  current_txn->RecordInsert(location);
+  current_txn->RecordInsert(location, tile_group_header);
   return true;
 }
 
@@ -174,7 +190,7 @@ void OptimisticRbTxnManager::PerformUpdateWithRb(const ItemPointer &location, ch
   SetRbSeg(tile_group_header, tuple_id, new_rb_seg);
 
   // Add the location to the update set
-  current_txn->RecordUpdate(location);
+  current_txn->RecordUpdate(location, tile_group_header);
 }
 
 void OptimisticRbTxnManager::PerformDelete(const ItemPointer &location) {
@@ -194,7 +210,7 @@ void OptimisticRbTxnManager::PerformDelete(const ItemPointer &location) {
   SetDeleteFlag(tile_group_header, tuple_id);
 
   // Add the old tuple into the delete set
-  bool ins_del = current_txn->RecordDelete(location);
+  bool ins_del = current_txn->RecordDelete(location, tile_group_header);
 
   // Check if we have INS_DEL, if so, just delete and reclaim the tuple
   if (ins_del) {
@@ -283,39 +299,35 @@ Result OptimisticRbTxnManager::CommitTransaction() {
   // we can optimize read-only transaction.
   if (current_txn->IsReadOnly() == true) {
     // validate read set.
-    for (auto &tile_group_entry : rw_set) {
-      oid_t tile_group_id = tile_group_entry.first;
-      auto tile_group = manager.GetTileGroup(tile_group_id);
-      auto tile_group_header = tile_group->GetHeader();
-      for (auto &tuple_entry : tile_group_entry.second) {
-        auto tuple_slot = tuple_entry.first;
-        // if this tuple is not newly inserted.
-        if (tuple_entry.second == RW_TYPE_READ) {
-          // No one should be writting, I can still read it and the begin commit
-          // id still fall before the end commit id of the tuple
-          //
-          // To give an example why tile_group_header->GetEndCommitId(tuple_slot) >=
-          //    current_txn->GetBeginCommitId() is needed
-          //
-          // T0 begin at 1, delete a tuple, then get end commit 2, but not commit yet
-          // T1 begin at 3, read the same tuple, it should read the master version
-          // T0 now commit, master version has been changed to be visible for (0, 2)
-          // Now the master version is no longer visible for T0.
-          if (tile_group_header->GetTransactionId(tuple_slot) == INITIAL_TXN_ID &&
-            GetActivatedEvidence(tile_group_header, tuple_slot) != nullptr &&
-              tile_group_header->GetEndCommitId(tuple_slot) >=
-              current_txn->GetBeginCommitId()) {
-            // the version is not owned by other txns and is still visible.
-            continue;
-          }
-          LOG_TRACE("Abort in read only txn");
-          // otherwise, validation fails. abort transaction.
-          return AbortTransaction();
-        } else {
-          // It must be a deleted
-          assert(tuple_entry.second == RW_TYPE_INS_DEL);
-          assert(tile_group_header->GetTransactionId(tuple_slot) == INVALID_TXN_ID);
+    for (auto &entry : rw_set) {
+      auto tile_group_header = entry.tile_group_header;
+      auto tuple_slot = entry.tuple_slot;
+      // if this tuple is not newly inserted.
+      if (entry.type == RW_TYPE_READ) {
+        // No one should be writting, I can still read it and the begin commit
+        // id still fall before the end commit id of the tuple
+        //
+        // To give an example why tile_group_header->GetEndCommitId(tuple_slot) >=
+        //    current_txn->GetBeginCommitId() is needed
+        //
+        // T0 begin at 1, delete a tuple, then get end commit 2, but not commit yet
+        // T1 begin at 3, read the same tuple, it should read the master version
+        // T0 now commit, master version has been changed to be visible for (0, 2)
+        // Now the master version is no longer visible for T0.
+        if (tile_group_header->GetTransactionId(tuple_slot) == INITIAL_TXN_ID &&
+          GetActivatedEvidence(tile_group_header, tuple_slot) != nullptr &&
+            tile_group_header->GetEndCommitId(tuple_slot) >=
+            current_txn->GetBeginCommitId()) {
+          // the version is not owned by other txns and is still visible.
+          continue;
         }
+        LOG_TRACE("Abort in read only txn");
+        // otherwise, validation fails. abort transaction.
+        return AbortTransaction();
+      } else {
+        // It must be a deleted
+        assert(entry.type == RW_TYPE_INS_DEL);
+        assert(tile_group_header->GetTransactionId(tuple_slot) == INVALID_TXN_ID);
       }
     }
     
@@ -328,29 +340,25 @@ Result OptimisticRbTxnManager::CommitTransaction() {
   cid_t end_commit_id = GetNextCommitId();
 
   // validate read set.
-  for (auto &tile_group_entry : rw_set) {
-    oid_t tile_group_id = tile_group_entry.first;
-    auto tile_group = manager.GetTileGroup(tile_group_id);
-    auto tile_group_header = tile_group->GetHeader();
-    for (auto &tuple_entry : tile_group_entry.second) {
-      auto tuple_slot = tuple_entry.first;
-      // if this tuple is not newly inserted. Meaning this is either read,
-      // update or deleted.
-      if (tuple_entry.second != RW_TYPE_INSERT &&
-          tuple_entry.second != RW_TYPE_INS_DEL) {
-
-        if (ValidateRead(tile_group_header, tuple_slot, end_commit_id)) {
-          continue;
-        }
-        LOG_TRACE("transaction id=%lu",
-                  tile_group_header->GetTransactionId(tuple_slot));
-        LOG_TRACE("begin commit id=%lu",
-                  tile_group_header->GetBeginCommitId(tuple_slot));
-        LOG_TRACE("end commit id=%lu",
-                  tile_group_header->GetEndCommitId(tuple_slot));
-        // otherwise, validation fails. abort transaction.
-        return AbortTransaction();
+  for (auto &entry : rw_set) {
+    auto tile_group_header = entry.tile_group_header;
+    auto tuple_slot = entry.tuple_slot;
+    // if this tuple is not newly inserted. Meaning this is either read,
+    // update or deleted.
+    if (entry.type != RW_TYPE_INSERT &&
+        entry.type != RW_TYPE_INS_DEL) {
+
+      if (ValidateRead(tile_group_header, tuple_slot, end_commit_id)) {
+        continue;
       }
+      LOG_TRACE("transaction id=%lu",
+                tile_group_header->GetTransactionId(tuple_slot));
+      LOG_TRACE("begin commit id=%lu",
+                tile_group_header->GetBeginCommitId(tuple_slot));
+      LOG_TRACE("end commit id=%lu",
+                tile_group_header->GetEndCommitId(tuple_slot));
+      // otherwise, validation fails. abort transaction.
+      return AbortTransaction();
     }
   }
   //////////////////////////////////////////////////////////
@@ -358,13 +366,12 @@ Result OptimisticRbTxnManager::CommitTransaction() {
 //  auto &log_manager = logging::LogManager::GetInstance();
 //  log_manager.LogBeginTransaction(end_commit_id);
   // install everything.
-  for (auto &tile_group_entry : rw_set) {
-    oid_t tile_group_id = tile_group_entry.first;
+  for (auto &entry : rw_set) {
+    oid_t tile_group_id = entry.tile_group_id;
     auto tile_group = manager.GetTileGroup(tile_group_id);
     auto tile_group_header = tile_group->GetHeader();
-    for (auto &tuple_entry : tile_group_entry.second) {
-      auto tuple_slot = tuple_entry.first;
-      if (tuple_entry.second == RW_TYPE_UPDATE) {
+    auto tuple_slot = entry.tuple_slot;
+    if (entry.type == RW_TYPE_UPDATE) {
 //        // logging.
 //        ItemPointer new_version =
 //          tile_group_header->GetNextItemPointer(tuple_slot);
@@ -374,20 +381,20 @@ Result OptimisticRbTxnManager::CommitTransaction() {
 //        log_manager.LogUpdate(current_txn, end_commit_id, old_version,
 //                              new_version);
 
-        // First set the timestamp of the updated master copy
-        // Since we have the rollback segment, it's safe to do so
-        assert(tile_group_header->GetEndCommitId(tuple_slot) == MAX_CID);
-        tile_group_header->SetBeginCommitId(tuple_slot, end_commit_id);
+      // First set the timestamp of the updated master copy
+      // Since we have the rollback segment, it's safe to do so
+      assert(tile_group_header->GetEndCommitId(tuple_slot) == MAX_CID);
+      tile_group_header->SetBeginCommitId(tuple_slot, end_commit_id);
 
-        // Then we mark all rollback segment's timestamp as our end timestamp
-        InstallRollbackSegments(tile_group_header, tuple_slot, end_commit_id);
+      // Then we mark all rollback segment's timestamp as our end timestamp
+      InstallRollbackSegments(tile_group_header, tuple_slot, end_commit_id);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        // Finally we release the write lock on the original tuple
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      // Finally we release the write lock on the original tuple
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-      } else if (tuple_entry.second == RW_TYPE_DELETE) {
+    } else if (entry.type == RW_TYPE_DELETE) {
 //        ItemPointer new_version =
 //          tile_group_header->GetNextItemPointer(tuple_slot);
 //        ItemPointer delete_location(tile_group_id, tuple_slot);
@@ -395,46 +402,45 @@ Result OptimisticRbTxnManager::CommitTransaction() {
 //        // logging.
 //        log_manager.LogDelete(end_commit_id, delete_location);
 
-        // we do not change begin cid for master copy
-        // First set the timestamp of the master copy
-        assert(tile_group_header->GetEndCommitId(tuple_slot) == MAX_CID);
-        tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
+      // we do not change begin cid for master copy
+      // First set the timestamp of the master copy
+      assert(tile_group_header->GetEndCommitId(tuple_slot) == MAX_CID);
+      tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
 
-        // COMPILER_MEMORY_FENCE;
+      // COMPILER_MEMORY_FENCE;
 
-        // we may have updated this tuple before we delete it, roll it back
-        RollbackTuple(tile_group, tuple_slot);
+      // we may have updated this tuple before we delete it, roll it back
+      RollbackTuple(tile_group, tuple_slot);
 
-        // Reset the deleted bit for safety
-        ClearDeleteFlag(tile_group_header, tuple_slot);
+      // Reset the deleted bit for safety
+      ClearDeleteFlag(tile_group_header, tuple_slot);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        // Finally we release the write lock
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      // Finally we release the write lock
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-        // recycle the newer version.
-        // FIXME: need to delete them in index and free the tuple --jiexi
-        // RecycleTupleSlot(tile_group_id, tuple_slot, START_OID);
+      // recycle the newer version.
+      // FIXME: need to delete them in index and free the tuple --jiexi
+      // RecycleTupleSlot(tile_group_id, tuple_slot, START_OID);
 
-      } else if (tuple_entry.second == RW_TYPE_INSERT) {
-        assert(tile_group_header->GetTransactionId(tuple_slot) ==
-               current_txn->GetTransactionId());
-        // set the begin commit id to persist insert
-        // ItemPointer insert_location(tile_group_id, tuple_slot);
+    } else if (entry.type == RW_TYPE_INSERT) {
+      assert(tile_group_header->GetTransactionId(tuple_slot) ==
+             current_txn->GetTransactionId());
+      // set the begin commit id to persist insert
+      // ItemPointer insert_location(tile_group_id, tuple_slot);
 //        log_manager.LogInsert(current_txn, end_commit_id, insert_location);
 
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
-        tile_group_header->SetBeginCommitId(tuple_slot, end_commit_id);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetBeginCommitId(tuple_slot, end_commit_id);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-      } else if (tuple_entry.second == RW_TYPE_INS_DEL) {
-        assert(tile_group_header->GetTransactionId(tuple_slot) == INVALID_TXN_ID);
-        // Do nothing for INS_DEL
-      }
+    } else if (entry.type == RW_TYPE_INS_DEL) {
+      assert(tile_group_header->GetTransactionId(tuple_slot) == INVALID_TXN_ID);
+      // Do nothing for INS_DEL
     }
   }
 //  log_manager.LogCommitTransaction(end_commit_id);
@@ -451,60 +457,58 @@ Result OptimisticRbTxnManager::AbortTransaction() {
 
   auto &rw_set = current_txn->GetRWSet();
 
-  for (auto &tile_group_entry : rw_set) {
-    oid_t tile_group_id = tile_group_entry.first;
+  for (auto &entry : rw_set) {
+    oid_t tile_group_id = entry.tile_group_id;
     auto tile_group = manager.GetTileGroup(tile_group_id);
     auto tile_group_header = tile_group->GetHeader();
 
-    for (auto &tuple_entry : tile_group_entry.second) {
-      auto tuple_slot = tuple_entry.first;
-      if (tuple_entry.second == RW_TYPE_UPDATE) {
+    auto tuple_slot = entry.tuple_slot;
+    if (entry.type == RW_TYPE_UPDATE) {
 
-        // We do not have new version now, no need to mantain it
-        assert(tile_group_header->GetNextItemPointer(tuple_slot).IsNull());
+      // We do not have new version now, no need to mantain it
+      assert(tile_group_header->GetNextItemPointer(tuple_slot).IsNull());
 
-        // The master copy under updating must be a valid version
-        assert(tile_group_header->GetEndCommitId(tuple_slot) == MAX_CID);
+      // The master copy under updating must be a valid version
+      assert(tile_group_header->GetEndCommitId(tuple_slot) == MAX_CID);
 
-        // Rollback the master copy
-        RollbackTuple(tile_group, tuple_slot);
+      // Rollback the master copy
+      RollbackTuple(tile_group, tuple_slot);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-      } else if (tuple_entry.second == RW_TYPE_DELETE) {
+    } else if (entry.type == RW_TYPE_DELETE) {
 
-        // We do not have new version now, no need to mantain it
-        assert(tile_group_header->GetNextItemPointer(tuple_slot).IsNull());
+      // We do not have new version now, no need to mantain it
+      assert(tile_group_header->GetNextItemPointer(tuple_slot).IsNull());
 
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
 
-        // We may have updated this tuple in the same txn, rollback it
-        RollbackTuple(tile_group, tuple_slot);
+      // We may have updated this tuple in the same txn, rollback it
+      RollbackTuple(tile_group, tuple_slot);
 
-        // Reset the deleted bit before release the write lock
-        ClearDeleteFlag(tile_group_header, tuple_slot);
+      // Reset the deleted bit before release the write lock
+      ClearDeleteFlag(tile_group_header, tuple_slot);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-      } else if (tuple_entry.second == RW_TYPE_INSERT) {
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
-        tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+    } else if (entry.type == RW_TYPE_INSERT) {
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
 
-        tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
 
-        // recycle the newer version.
-        // FIXME: need to delete them in index and free the tuple --jiexi
-        // RecycleTupleSlot(tile_group_id, tuple_slot, START_OID);
+      // recycle the newer version.
+      // FIXME: need to delete them in index and free the tuple --jiexi
+      // RecycleTupleSlot(tile_group_id, tuple_slot, START_OID);
 
-      } else if (tuple_entry.second == RW_TYPE_INS_DEL) {
-        assert(tile_group_header->GetTransactionId(tuple_slot) == INVALID_TXN_ID);
-        // Do nothing for INS_DEL
-        // GC this tuple
-      }
+    } else if (entry.type == RW_TYPE_INS_DEL) {
+      assert(tile_group_header->GetTransactionId(tuple_slot) == INVALID_TXN_ID);
+      // Do nothing for INS_DEL
+      // GC this tuple
     }
   }
 
@@ -152,18 +152,18 @@ class OptimisticRbTxnManager : public TransactionManager {
 
   virtual Result AbortTransaction();
 
-  virtual Transaction *BeginTransaction() {
+  virtual Transaction *BeginTransaction(const bool read_only = false) {
     // Set current transaction
     txn_id_t txn_id = GetNextTransactionId();
-    cid_t begin_cid = GetNextCommitId();
+    size_t eid;
+    cid_t begin_cid = GetNextBeginCommitId(eid, read_only);
 
     LOG_TRACE("Beginning transaction %lu", txn_id);
 
 
-    Transaction *txn = new Transaction(txn_id, begin_cid);
+    Transaction *txn = AllocateTransaction(txn_id, begin_cid, read_only);
     current_txn = txn;
 
-    auto eid = EpochManagerFactory::GetInstance().EnterEpoch(begin_cid);
     txn->SetEpochId(eid);
 
     latest_read_timestamp = begin_cid;
@@ -204,9 +204,11 @@ class OptimisticRbTxnManager : public TransactionManager {
 
     EpochManagerFactory::GetInstance().ExitEpoch(current_txn->GetEpochId());
 
-    delete current_txn;
+    RecycleTransaction(current_txn);
     current_txn = nullptr;
     current_segment_pool = nullptr;
+
+    gc::GCManagerFactory::GetInstance().CooperativeGC();
   }
 
   // Init reserved area of a tuple
@@ -131,6 +131,14 @@ bool PessimisticTxnManager::AcquireOwnership(
   bool res = tile_group_header->SetAtomicTransactionId(
       tuple_id, PACK_TXNID(current_txn_id, 0));
 
+  // a transaction may have committed a newer version after the caller found
+  // this one ownable, then it is given back
+  if (res && tile_group_header->GetEndCommitId(tuple_id) != MAX_CID) {
+    tile_group_header->SetAtomicTransactionId(
+        tuple_id, PACK_TXNID(current_txn_id, 0), INITIAL_TXN_ID);
+    res = false;
+  }
+
   if (res) {
     return true;
   } else {
@@ -172,6 +180,11 @@ void PessimisticTxnManager::ReleaseReadLock(
 }
 
 bool PessimisticTxnManager::PerformRead(const ItemPointer &location) {
+  // a READ ONLY transaction reads its snapshot without read locks
+  if (current_txn->IsDeclaredReadOnly() == true) {
+    return true;
+  }
+
   oid_t tile_group_id = location.block;
   oid_t tuple_id = location.offset;
 
@@ -180,13 +193,9 @@ bool PessimisticTxnManager::PerformRead(const ItemPointer &location) {
   auto tile_group = manager.GetTileGroup(tile_group_id);
   auto tile_group_header = tile_group->GetHeader();
 
-  auto &rw_set = current_txn->GetRWSet();
-  auto tuple_map = rw_set.find(tile_group_id);
-  if (tuple_map != rw_set.end()) {
-    if (tuple_map->second.find(tuple_id) != tuple_map->second.end()) {
-      // It was already accessed, don't acquire read lock again
-      return true;
-    }
+  if (current_txn->IsAccessed(location) == true) {
+    // It was already accessed, don't acquire read lock again
+    return true;
   }
 
   if (IsOwner(tile_group_header, tuple_id)) {
@@ -224,7 +233,7 @@ bool PessimisticTxnManager::PerformRead(const ItemPointer &location) {
     return false;
   }
 
-  current_txn->RecordRead(location);
+  current_txn->RecordRead(location, tile_group_header);
 
   return true;
 }
@@ -249,7 +258,7 @@ bool PessimisticTxnManager::PerformInsert(const ItemPointer &location) {
   // no need to set next item pointer.
 
   // Add the new tuple into the insert set
-  current_txn->RecordInsert(location);
+  current_txn->RecordInsert(location, tile_group_header);
   return true;
 }
 
@@ -288,7 +297,9 @@ void PessimisticTxnManager::PerformUpdate(const ItemPointer &old_location,
   new_tile_group_header->SetTransactionId(new_location.offset, transaction_id);
 
   // Add the old tuple into the update set
-  current_txn->RecordUpdate(old_location);
+  current_txn->RecordUpdate(old_location, tile_group_header);
+
+  InstallNewVersion(old_location, new_location);
 }
 
 void PessimisticTxnManager::PerformUpdate(const ItemPointer &location) {
@@ -308,7 +319,10 @@ void PessimisticTxnManager::PerformUpdate(const ItemPointer &location) {
   auto old_location = tile_group_header->GetPrevItemPointer(tuple_id);
   if (old_location.IsNull() == false) {
     // update an inserted version
-    current_txn->RecordUpdate(old_location);
+    auto old_tile_group_header = catalog::Manager::GetInstance()
+                                     .GetTileGroup(old_location.block)
+                                     ->GetHeader();
+    current_txn->RecordUpdate(old_location, old_tile_group_header);
   }
 }
 
@@ -339,7 +353,9 @@ void PessimisticTxnManager::PerformDelete(const ItemPointer &old_location,
   new_tile_group_header->SetTransactionId(new_location.offset, transaction_id);
   new_tile_group_header->SetEndCommitId(new_location.offset, INVALID_CID);
 
-  current_txn->RecordDelete(old_location);
+  current_txn->RecordDelete(old_location, tile_group_header);
+
+  InstallNewVersion(old_location, new_location);
 }
 
 void PessimisticTxnManager::PerformDelete(const ItemPointer &location) {
@@ -360,10 +376,13 @@ void PessimisticTxnManager::PerformDelete(const ItemPointer &location) {
   auto old_location = tile_group_header->GetPrevItemPointer(tuple_id);
   if (old_location.IsNull() == false) {
     // delete an inserted version
-    current_txn->RecordDelete(old_location);
+    auto old_tile_group_header = catalog::Manager::GetInstance()
+                                     .GetTileGroup(old_location.block)
+                                     ->GetHeader();
+    current_txn->RecordDelete(old_location, old_tile_group_header);
   } else {
     // if this version is newly inserted.
-    current_txn->RecordDelete(location);
+    current_txn->RecordDelete(location, tile_group_header);
   }
 }
 
@@ -378,25 +397,22 @@ Result PessimisticTxnManager::CommitTransaction() {
   // we can optimize read-only transaction.
   if (current_txn->IsReadOnly() == true) {
     // validate read set.
-    for (auto &tile_group_entry : rw_set) {
-      oid_t tile_group_id = tile_group_entry.first;
-      auto tile_group = manager.GetTileGroup(tile_group_id);
-      auto tile_group_header = tile_group->GetHeader();
-      for (auto &tuple_entry : tile_group_entry.second) {
-        auto tuple_slot = tuple_entry.first;
-        // if this tuple is not newly inserted.
-        if (tuple_entry.second == RW_TYPE_READ) {
-          // Release read locks
-          if (pessimistic_released_rdlock.find(tile_group_id) ==
-                  pessimistic_released_rdlock.end() ||
-              pessimistic_released_rdlock[tile_group_id].find(tuple_slot) ==
-                  pessimistic_released_rdlock[tile_group_id].end()) {
-            ReleaseReadLock(tile_group_header, tuple_slot);
-            pessimistic_released_rdlock[tile_group_id].insert(tuple_slot);
-          }
-        } else {
-          assert(tuple_entry.second == RW_TYPE_INS_DEL);
+    for (auto &entry : rw_set) {
+      oid_t tile_group_id = entry.tile_group_id;
+      auto tile_group_header = entry.tile_group_header;
+      auto tuple_slot = entry.tuple_slot;
+      // if this tuple is not newly inserted.
+      if (entry.type == RW_TYPE_READ) {
+        // Release read locks
+        if (pessimistic_released_rdlock.find(tile_group_id) ==
+                pessimistic_released_rdlock.end() ||
+            pessimistic_released_rdlock[tile_group_id].find(tuple_slot) ==
+                pessimistic_released_rdlock[tile_group_id].end()) {
+          ReleaseReadLock(tile_group_header, tuple_slot);
+          pessimistic_released_rdlock[tile_group_id].insert(tuple_slot);
         }
+      } else {
+        assert(entry.type == RW_TYPE_INS_DEL);
       }
     }
     // is it always true???
@@ -414,100 +430,97 @@ Result PessimisticTxnManager::CommitTransaction() {
   log_manager.LogBeginTransaction(end_commit_id);
 
   // install everything.
-  for (auto &tile_group_entry : rw_set) {
-    oid_t tile_group_id = tile_group_entry.first;
-    auto tile_group = manager.GetTileGroup(tile_group_id);
-    auto tile_group_header = tile_group->GetHeader();
-    for (auto &tuple_entry : tile_group_entry.second) {
-      auto tuple_slot = tuple_entry.first;
-      if (tuple_entry.second == RW_TYPE_READ) {
-        // Release read locks
-        if (pessimistic_released_rdlock.find(tile_group_id) ==
-                pessimistic_released_rdlock.end() ||
-            pessimistic_released_rdlock[tile_group_id].find(tuple_slot) ==
-                pessimistic_released_rdlock[tile_group_id].end()) {
-          ReleaseReadLock(tile_group_header, tuple_slot);
-          pessimistic_released_rdlock[tile_group_id].insert(tuple_slot);
-        }
-      } else if (tuple_entry.second == RW_TYPE_UPDATE) {
-        // we must guarantee that, at any time point, only one version is
-        // visible.
-        ItemPointer new_version =
-            tile_group_header->GetNextItemPointer(tuple_slot);
-        ItemPointer old_version(tile_group_id, tuple_slot);
+  for (auto &entry : rw_set) {
+    oid_t tile_group_id = entry.tile_group_id;
+    auto tile_group_header = entry.tile_group_header;
+    auto tuple_slot = entry.tuple_slot;
+    if (entry.type == RW_TYPE_READ) {
+      // Release read locks
+      if (pessimistic_released_rdlock.find(tile_group_id) ==
+              pessimistic_released_rdlock.end() ||
+          pessimistic_released_rdlock[tile_group_id].find(tuple_slot) ==
+              pessimistic_released_rdlock[tile_group_id].end()) {
+        ReleaseReadLock(tile_group_header, tuple_slot);
+        pessimistic_released_rdlock[tile_group_id].insert(tuple_slot);
+      }
+    } else if (entry.type == RW_TYPE_UPDATE) {
+      // we must guarantee that, at any time point, only one version is
+      // visible.
+      ItemPointer new_version =
+          tile_group_header->GetNextItemPointer(tuple_slot);
+      ItemPointer old_version(tile_group_id, tuple_slot);
 
-        // logging.
-        log_manager.LogUpdate(end_commit_id, old_version, new_version);
+      // logging.
+      log_manager.LogUpdate(end_commit_id, old_version, new_version);
 
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
+      auto new_tile_group_header =
+          manager.GetTileGroup(new_version.block)->GetHeader();
 
-        new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
-        new_tile_group_header->SetBeginCommitId(new_version.offset,
-                                                end_commit_id);
+      new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
+      new_tile_group_header->SetBeginCommitId(new_version.offset,
+                                              end_commit_id);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
+      tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INITIAL_TXN_ID);
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INITIAL_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-      } else if (tuple_entry.second == RW_TYPE_DELETE) {
-        ItemPointer new_version =
-            tile_group_header->GetNextItemPointer(tuple_slot);
-        ItemPointer delete_location(tile_group_id, tuple_slot);
+    } else if (entry.type == RW_TYPE_DELETE) {
+      ItemPointer new_version =
+          tile_group_header->GetNextItemPointer(tuple_slot);
+      ItemPointer delete_location(tile_group_id, tuple_slot);
 
-        // logging.
-        log_manager.LogDelete(end_commit_id, delete_location);
+      // logging.
+      log_manager.LogDelete(end_commit_id, delete_location);
 
-        // we do not change begin cid for old tuple.
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
+      // we do not change begin cid for old tuple.
+      auto new_tile_group_header =
+          manager.GetTileGroup(new_version.block)->GetHeader();
 
-        new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
-        new_tile_group_header->SetBeginCommitId(new_version.offset,
-                                                end_commit_id);
+      new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
+      new_tile_group_header->SetBeginCommitId(new_version.offset,
+                                              end_commit_id);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
+      tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INVALID_TXN_ID);
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INVALID_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-      } else if (tuple_entry.second == RW_TYPE_INSERT) {
-        assert(tile_group_header->GetTransactionId(tuple_slot) ==
-               current_txn->GetTransactionId());
-        // set the begin commit id to persist insert
-        ItemPointer insert_location(tile_group_id, tuple_slot);
-        log_manager.LogInsert(end_commit_id, insert_location);
+    } else if (entry.type == RW_TYPE_INSERT) {
+      assert(tile_group_header->GetTransactionId(tuple_slot) ==
+             current_txn->GetTransactionId());
+      // set the begin commit id to persist insert
+      ItemPointer insert_location(tile_group_id, tuple_slot);
+      log_manager.LogInsert(end_commit_id, insert_location);
 
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
-        tile_group_header->SetBeginCommitId(tuple_slot, end_commit_id);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetBeginCommitId(tuple_slot, end_commit_id);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-      } else if (tuple_entry.second == RW_TYPE_INS_DEL) {
-        assert(tile_group_header->GetTransactionId(tuple_slot) ==
-               current_txn->GetTransactionId());
+    } else if (entry.type == RW_TYPE_INS_DEL) {
+      assert(tile_group_header->GetTransactionId(tuple_slot) ==
+             current_txn->GetTransactionId());
 
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
-        tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        // set the begin commit id to persist insert
-        tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
-      }
+      // set the begin commit id to persist insert
+      tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
     }
   }
   log_manager.LogCommitTransaction(end_commit_id);
@@ -523,82 +536,82 @@ Result PessimisticTxnManager::AbortTransaction() {
 
   auto &rw_set = current_txn->GetRWSet();
 
-  for (auto &tile_group_entry : rw_set) {
-    oid_t tile_group_id = tile_group_entry.first;
-    auto tile_group = manager.GetTileGroup(tile_group_id);
-    auto tile_group_header = tile_group->GetHeader();
-
-    for (auto &tuple_entry : tile_group_entry.second) {
-      auto tuple_slot = tuple_entry.first;
-      if (tuple_entry.second == RW_TYPE_READ) {
-        if (pessimistic_released_rdlock.find(tile_group_id) ==
-                pessimistic_released_rdlock.end() ||
-            pessimistic_released_rdlock[tile_group_id].find(tuple_slot) ==
-                pessimistic_released_rdlock[tile_group_id].end()) {
-          ReleaseReadLock(tile_group_header, tuple_slot);
-          pessimistic_released_rdlock[tile_group_id].insert(tuple_slot);
-        }
-      } else if (tuple_entry.second == RW_TYPE_UPDATE) {
-        ItemPointer new_version =
-            tile_group_header->GetNextItemPointer(tuple_slot);
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
-        new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
-        new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
+  for (auto &entry : rw_set) {
+    oid_t tile_group_id = entry.tile_group_id;
+    auto tile_group_header = entry.tile_group_header;
+    auto tuple_slot = entry.tuple_slot;
+    if (entry.type == RW_TYPE_READ) {
+      if (pessimistic_released_rdlock.find(tile_group_id) ==
+              pessimistic_released_rdlock.end() ||
+          pessimistic_released_rdlock[tile_group_id].find(tuple_slot) ==
+              pessimistic_released_rdlock[tile_group_id].end()) {
+        ReleaseReadLock(tile_group_header, tuple_slot);
+        pessimistic_released_rdlock[tile_group_id].insert(tuple_slot);
+      }
+    } else if (entry.type == RW_TYPE_UPDATE) {
+      ItemPointer new_version =
+          tile_group_header->GetNextItemPointer(tuple_slot);
+      UninstallNewVersion(ItemPointer(tile_group_id, tuple_slot),
+                          new_version);
+      auto new_tile_group_header =
+          manager.GetTileGroup(new_version.block)->GetHeader();
+      new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
+      new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
 
-        // reset the item pointers.
-        tile_group_header->SetNextItemPointer(tuple_slot, INVALID_ITEMPOINTER);
-        new_tile_group_header->SetPrevItemPointer(new_version.offset, INVALID_ITEMPOINTER);
+      // reset the item pointers.
+      tile_group_header->SetNextItemPointer(tuple_slot, INVALID_ITEMPOINTER);
+      new_tile_group_header->SetPrevItemPointer(new_version.offset, INVALID_ITEMPOINTER);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INVALID_TXN_ID);
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INVALID_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-      } else if (tuple_entry.second == RW_TYPE_DELETE) {
-        ItemPointer new_version =
-            tile_group_header->GetNextItemPointer(tuple_slot);
+    } else if (entry.type == RW_TYPE_DELETE) {
+      ItemPointer new_version =
+          tile_group_header->GetNextItemPointer(tuple_slot);
+      UninstallNewVersion(ItemPointer(tile_group_id, tuple_slot),
+                          new_version);
 
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
+      auto new_tile_group_header =
+          manager.GetTileGroup(new_version.block)->GetHeader();
 
-        new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
-        new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
+      new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
+      new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
 
-        // reset the item pointers.
-        tile_group_header->SetNextItemPointer(tuple_slot, INVALID_ITEMPOINTER);
-        new_tile_group_header->SetPrevItemPointer(new_version.offset, INVALID_ITEMPOINTER);
+      // reset the item pointers.
+      tile_group_header->SetNextItemPointer(tuple_slot, INVALID_ITEMPOINTER);
+      new_tile_group_header->SetPrevItemPointer(new_version.offset, INVALID_ITEMPOINTER);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INVALID_TXN_ID);
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INVALID_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-      } else if (tuple_entry.second == RW_TYPE_INSERT) {
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
-        tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+    } else if (entry.type == RW_TYPE_INSERT) {
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
-      } else if (tuple_entry.second == RW_TYPE_INS_DEL) {
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
-        tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
+    } else if (entry.type == RW_TYPE_INS_DEL) {
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
-      }
+      tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
     }
   }
 
@@ -63,13 +63,13 @@ class PessimisticTxnManager : public TransactionManager {
 
   virtual Result AbortTransaction();
 
-  virtual Transaction *BeginTransaction() {
+  virtual Transaction *BeginTransaction(const bool read_only = false) {
     txn_id_t txn_id = GetNextTransactionId();
-    cid_t begin_cid = GetNextCommitId();
-    Transaction *txn = new Transaction(txn_id, begin_cid);
+    size_t eid;
+    cid_t begin_cid = GetNextBeginCommitId(eid, read_only);
+    Transaction *txn = AllocateTransaction(txn_id, begin_cid, read_only);
     current_txn = txn;
 
-    auto eid = EpochManagerFactory::GetInstance().EnterEpoch(begin_cid);
     txn->SetEpochId(eid);
     LOG_TRACE("Begin txn %lu", txn_id);
 
@@ -82,10 +82,12 @@ class PessimisticTxnManager : public TransactionManager {
 
     EpochManagerFactory::GetInstance().ExitEpoch(current_txn->GetEpochId());
 
-    delete current_txn;
+    RecycleTransaction(current_txn);
     current_txn = nullptr;
 
     pessimistic_released_rdlock.clear();
+
+    gc::GCManagerFactory::GetInstance().CooperativeGC();
   }
 
  private:
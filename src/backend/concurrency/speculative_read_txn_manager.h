@@ -101,14 +101,14 @@ class SpeculativeReadTxnManager : public TransactionManager {
 
   virtual void PerformDelete(const ItemPointer &location);
 
-  virtual Transaction *BeginTransaction() {
+  virtual Transaction *BeginTransaction(const bool read_only = false) {
     txn_id_t txn_id = GetNextTransactionId();
-    cid_t begin_cid = GetNextCommitId();
-    Transaction *txn = new Transaction(txn_id, begin_cid);
+    size_t eid;
+    cid_t begin_cid = GetNextBeginCommitId(eid, read_only);
+    Transaction *txn = AllocateTransaction(txn_id, begin_cid, read_only);
     current_txn = txn;
     spec_txn_context.SetBeginCid(begin_cid);
 
-    auto eid = EpochManagerFactory::GetInstance().EnterEpoch(begin_cid);
     txn->SetEpochId(eid);
     return txn;
   }
@@ -122,8 +122,10 @@ class SpeculativeReadTxnManager : public TransactionManager {
 
     spec_txn_context.Clear();
 
-    delete current_txn;
+    RecycleTransaction(current_txn);
     current_txn = nullptr;
+
+    gc::GCManagerFactory::GetInstance().CooperativeGC();
   }
 
 
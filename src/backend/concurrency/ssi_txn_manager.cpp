@@ -119,6 +119,14 @@ bool SsiTxnManager::AcquireOwnership(
     return false;
   }
 
+  // a transaction may have committed a newer version after the caller found
+  // this one ownable, then it is given back
+  if (tile_group_header->GetEndCommitId(tuple_id) != MAX_CID) {
+    tile_group_header->SetAtomicTransactionId(tuple_id, txn_id,
+                                              INITIAL_TXN_ID);
+    return false;
+  }
+
   {
     GetReadLock(tile_group_header, tuple_id);
     ReadList *header = GetReaderList(tile_group_header, tuple_id);
@@ -169,7 +177,11 @@ bool SsiTxnManager::AcquireOwnership(
     }
     ReleaseReadLock(tile_group_header, tuple_id);
 
-    if (should_abort) return false;
+    // the version is not recorded as written, so give it back here
+    if (should_abort) {
+      tile_group_header->SetAtomicTransactionId(tuple_id, txn_id, INITIAL_TXN_ID);
+      return false;
+    }
   }
 
   return true;
@@ -177,6 +189,11 @@ bool SsiTxnManager::AcquireOwnership(
 
 
 bool SsiTxnManager::PerformRead(const ItemPointer &location){
+  // a READ ONLY transaction reads its snapshot without SIREAD locks
+  if (current_txn->IsDeclaredReadOnly() == true) {
+    return true;
+  }
+
   auto tile_group_id = location.block;
   auto tuple_id = location.offset;
   // LOG_TRACE("Perform Read %lu %lu", tile_group_id, tuple_id);
@@ -193,9 +210,7 @@ bool SsiTxnManager::PerformRead(const ItemPointer &location){
 
   auto txn_id = current_txn->GetTransactionId();
 
-  auto &rw_set = current_txn->GetRWSet();
-  if (rw_set.count(tile_group_id) == 0 ||
-      rw_set.at(tile_group_id).count(tuple_id) == 0) {
+  if (current_txn->IsAccessed(location) == false) {
     LOG_TRACE("Not read before");
     // Previously, this tuple hasn't been read, add the txn to the reader list
     // of the tuple
@@ -218,7 +233,7 @@ bool SsiTxnManager::PerformRead(const ItemPointer &location){
   }
 
   // existing SI code
-  current_txn->RecordRead(location);
+  current_txn->RecordRead(location, tile_group_header);
 
   // For each new version of the tuple
   {
@@ -313,7 +328,7 @@ bool SsiTxnManager::PerformInsert(const ItemPointer &location) {
   tile_group_header->SetTransactionId(tuple_id, transaction_id);
 
   // No need to set next item pointer.
-  current_txn->RecordInsert(location);
+  current_txn->RecordInsert(location, tile_group_header);
   // Init the creator of this tuple
   InitTupleReserved(current_txn->GetTransactionId(), tile_group_id, tuple_id);
   return true;
@@ -341,9 +356,10 @@ void SsiTxnManager::PerformUpdate(const ItemPointer &old_location,
   new_tile_group_header->SetBeginCommitId(new_location.offset, MAX_CID);
   new_tile_group_header->SetEndCommitId(new_location.offset, MAX_CID);
 
-  current_txn->RecordUpdate(old_location);
+  current_txn->RecordUpdate(old_location, tile_group_header);
 
   InitTupleReserved(transaction_id, new_location.block, new_location.offset);
+  InstallNewVersion(old_location, new_location);
   return true;
 }
 
@@ -366,7 +382,10 @@ void SsiTxnManager::PerformUpdate(const ItemPointer &location) {
   auto old_location = tile_group_header->GetPrevItemPointer(tuple_id);
   if (old_location.IsNull() == false) {
     // Update an inserted version
-    current_txn->RecordUpdate(old_location);
+    auto old_tile_group_header = catalog::Manager::GetInstance()
+                                     .GetTileGroup(old_location.block)
+                                     ->GetHeader();
+    current_txn->RecordUpdate(old_location, old_tile_group_header);
   }
 }
 
@@ -390,8 +409,9 @@ void SsiTxnManager::PerformDelete(const ItemPointer &old_location,
   new_tile_group_header->SetEndCommitId(new_location.offset, INVALID_CID);
 
   // Add the old tuple into the delete set
-  current_txn->RecordDelete(old_location);
+  current_txn->RecordDelete(old_location, tile_group_header);
   InitTupleReserved(transaction_id, new_location.block, new_location.offset);
+  InstallNewVersion(old_location, new_location);
   return true;
 }
 
@@ -411,10 +431,13 @@ void SsiTxnManager::PerformDelete(const ItemPointer &location) {
   auto old_location = tile_group_header->GetPrevItemPointer(tuple_id);
   if (old_location.IsNull() == false) {
     // delete an inserted version
-    current_txn->RecordDelete(old_location);
+    auto old_tile_group_header = catalog::Manager::GetInstance()
+                                     .GetTileGroup(old_location.block)
+                                     ->GetHeader();
+    current_txn->RecordDelete(old_location, old_tile_group_header);
   } else {
     // if this version is newly inserted.
-    current_txn->RecordDelete(location);
+    current_txn->RecordDelete(location, tile_group_header);
   }
 }
 
@@ -456,77 +479,74 @@ Result SsiTxnManager::CommitTransaction() {
   auto &log_manager = logging::LogManager::GetInstance();
   log_manager.LogBeginTransaction(end_commit_id);
   // install everything.
-  for (auto &tile_group_entry : rw_set) {
-    oid_t tile_group_id = tile_group_entry.first;
-    auto tile_group = manager.GetTileGroup(tile_group_id);
-    auto tile_group_header = tile_group->GetHeader();
-    for (auto &tuple_entry : tile_group_entry.second) {
-      auto tuple_slot = tuple_entry.first;
-      if (tuple_entry.second == RW_TYPE_UPDATE) {
-        // we must guarantee that, at any time point, only one version is
-        // visible.
-        // we do not change begin cid for old tuple.
-        tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
-        ItemPointer new_version =
-            tile_group_header->GetNextItemPointer(tuple_slot);
-        ItemPointer old_version(tile_group_id, tuple_slot);
-        log_manager.LogUpdate(end_commit_id, old_version, new_version);
-
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
-        new_tile_group_header->SetBeginCommitId(new_version.offset,
-                                                end_commit_id);
-        new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
-
-        COMPILER_MEMORY_FENCE;
-
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INITIAL_TXN_ID);
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
-      } else if (tuple_entry.second == RW_TYPE_DELETE) {
-        // we do not change begin cid for old tuple.
-        tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
-        ItemPointer new_version =
-            tile_group_header->GetNextItemPointer(tuple_slot);
-        ItemPointer delete_location(tile_group_id, tuple_slot);
-        log_manager.LogDelete(end_commit_id, delete_location);
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
-        new_tile_group_header->SetBeginCommitId(new_version.offset,
-                                                end_commit_id);
-        new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
-
-        COMPILER_MEMORY_FENCE;
-
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INVALID_TXN_ID);
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
-
-      } else if (tuple_entry.second == RW_TYPE_INSERT) {
-        assert(tile_group_header->GetTransactionId(tuple_slot) ==
-               current_txn->GetTransactionId());
-        // set the begin commit id to persist insert
-        ItemPointer insert_location(tile_group_id, tuple_slot);
-        log_manager.LogInsert(end_commit_id, insert_location);
-
-        tile_group_header->SetBeginCommitId(tuple_slot, end_commit_id);
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
-
-        COMPILER_MEMORY_FENCE;
-
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
-      } else if (tuple_entry.second == RW_TYPE_INS_DEL) {
-        assert(tile_group_header->GetTransactionId(tuple_slot) ==
-               current_txn->GetTransactionId());
-
-        // set the begin commit id to persist insert
-        tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
-
-        COMPILER_MEMORY_FENCE;
-
-        tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
-      }
+  for (auto &entry : rw_set) {
+    oid_t tile_group_id = entry.tile_group_id;
+    auto tile_group_header = entry.tile_group_header;
+    auto tuple_slot = entry.tuple_slot;
+    if (entry.type == RW_TYPE_UPDATE) {
+      // we must guarantee that, at any time point, only one version is
+      // visible.
+      // we do not change begin cid for old tuple.
+      tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
+      ItemPointer new_version =
+          tile_group_header->GetNextItemPointer(tuple_slot);
+      ItemPointer old_version(tile_group_id, tuple_slot);
+      log_manager.LogUpdate(end_commit_id, old_version, new_version);
+
+      auto new_tile_group_header =
+          manager.GetTileGroup(new_version.block)->GetHeader();
+      new_tile_group_header->SetBeginCommitId(new_version.offset,
+                                              end_commit_id);
+      new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
+
+      COMPILER_MEMORY_FENCE;
+
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INITIAL_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+    } else if (entry.type == RW_TYPE_DELETE) {
+      // we do not change begin cid for old tuple.
+      tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
+      ItemPointer new_version =
+          tile_group_header->GetNextItemPointer(tuple_slot);
+      ItemPointer delete_location(tile_group_id, tuple_slot);
+      log_manager.LogDelete(end_commit_id, delete_location);
+      auto new_tile_group_header =
+          manager.GetTileGroup(new_version.block)->GetHeader();
+      new_tile_group_header->SetBeginCommitId(new_version.offset,
+                                              end_commit_id);
+      new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
+
+      COMPILER_MEMORY_FENCE;
+
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INVALID_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+
+    } else if (entry.type == RW_TYPE_INSERT) {
+      assert(tile_group_header->GetTransactionId(tuple_slot) ==
+             current_txn->GetTransactionId());
+      // set the begin commit id to persist insert
+      ItemPointer insert_location(tile_group_id, tuple_slot);
+      log_manager.LogInsert(end_commit_id, insert_location);
+
+      tile_group_header->SetBeginCommitId(tuple_slot, end_commit_id);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+
+      COMPILER_MEMORY_FENCE;
+
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+    } else if (entry.type == RW_TYPE_INS_DEL) {
+      assert(tile_group_header->GetTransactionId(tuple_slot) ==
+             current_txn->GetTransactionId());
+
+      // set the begin commit id to persist insert
+      tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+
+      COMPILER_MEMORY_FENCE;
+
+      tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
     }
   }
   log_manager.LogCommitTransaction(end_commit_id);
@@ -536,6 +556,8 @@ Result SsiTxnManager::CommitTransaction() {
   end_txn_table_[current_ssi_txn_ctx->transaction_->GetEndCommitId()] = current_ssi_txn_ctx;
   EpochManagerFactory::GetInstance().ExitEpoch(current_ssi_txn_ctx->transaction_->GetEpochId());
 
+  gc::GCManagerFactory::GetInstance().CooperativeGC();
+
   return ret;
 }
 
@@ -555,60 +577,60 @@ Result SsiTxnManager::AbortTransaction() {
 
   auto &rw_set = current_txn->GetRWSet();
 
-  for (auto &tile_group_entry : rw_set) {
-    oid_t tile_group_id = tile_group_entry.first;
-    auto tile_group = manager.GetTileGroup(tile_group_id);
-    auto tile_group_header = tile_group->GetHeader();
-
-    for (auto &tuple_entry : tile_group_entry.second) {
-      auto tuple_slot = tuple_entry.first;
-      if (tuple_entry.second == RW_TYPE_UPDATE) {
-        // we do not set begin cid for old tuple.
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
-        ItemPointer new_version =
-            tile_group_header->GetNextItemPointer(tuple_slot);
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
-        new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
-        new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
-
-        COMPILER_MEMORY_FENCE;
-
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INVALID_TXN_ID);
-        LOG_TRACE("Txn %lu free %u", current_txn->GetTransactionId(),
-                 tuple_slot);
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
-
-      } else if (tuple_entry.second == RW_TYPE_DELETE) {
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
-        ItemPointer new_version =
-            tile_group_header->GetNextItemPointer(tuple_slot);
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
-        new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
-        new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
-
-        COMPILER_MEMORY_FENCE;
-
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INVALID_TXN_ID);
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
-      } else if (tuple_entry.second == RW_TYPE_INSERT) {
-        tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
-
-        COMPILER_MEMORY_FENCE;
-
-        tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
-      } else if (tuple_entry.second == RW_TYPE_INS_DEL) {
-        tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
-
-        COMPILER_MEMORY_FENCE;
-
-        tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
-      }
+  for (auto &entry : rw_set) {
+    oid_t tile_group_id = entry.tile_group_id;
+    auto tile_group_header = entry.tile_group_header;
+    auto tuple_slot = entry.tuple_slot;
+    if (entry.type == RW_TYPE_UPDATE) {
+      // we do not set begin cid for old tuple.
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+      ItemPointer new_version =
+          tile_group_header->GetNextItemPointer(tuple_slot);
+      UninstallNewVersion(ItemPointer(tile_group_id, tuple_slot),
+                          new_version);
+      auto new_tile_group_header =
+          manager.GetTileGroup(new_version.block)->GetHeader();
+      new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
+      new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
+
+      COMPILER_MEMORY_FENCE;
+
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INVALID_TXN_ID);
+      LOG_TRACE("Txn %lu free %u", current_txn->GetTransactionId(),
+               tuple_slot);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+
+    } else if (entry.type == RW_TYPE_DELETE) {
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+      ItemPointer new_version =
+          tile_group_header->GetNextItemPointer(tuple_slot);
+      UninstallNewVersion(ItemPointer(tile_group_id, tuple_slot),
+                          new_version);
+      auto new_tile_group_header =
+          manager.GetTileGroup(new_version.block)->GetHeader();
+      new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
+      new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
+
+      COMPILER_MEMORY_FENCE;
+
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INVALID_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+    } else if (entry.type == RW_TYPE_INSERT) {
+      tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+
+      COMPILER_MEMORY_FENCE;
+
+      tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
+    } else if (entry.type == RW_TYPE_INS_DEL) {
+      tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+
+      COMPILER_MEMORY_FENCE;
+
+      tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
     }
   }
 
@@ -627,6 +649,8 @@ Result SsiTxnManager::AbortTransaction() {
   // delete current_txn;
   current_txn = nullptr;
 
+  gc::GCManagerFactory::GetInstance().CooperativeGC();
+
   return Result::RESULT_ABORTED;
 }
 
@@ -636,23 +660,25 @@ void SsiTxnManager::RemoveReader(Transaction *txn) {
   // Remove from the read list of accessed tuples
   auto &rw_set = txn->GetRWSet();
 
-  for (auto &tile_group_entry : rw_set) {
-    oid_t tile_group_id = tile_group_entry.first;
-    auto &manager = catalog::Manager::GetInstance();
-    auto tile_group = manager.GetTileGroup(tile_group_id);
+  // the table may be dropped, look each tile group up once to find out
+  oid_t tile_group_id = INVALID_OID;
+  std::shared_ptr<storage::TileGroup> tile_group;
+  for (auto &entry : rw_set) {
+    if (entry.tile_group_id != tile_group_id) {
+      tile_group_id = entry.tile_group_id;
+      tile_group = catalog::Manager::GetInstance().GetTileGroup(tile_group_id);
+    }
     if (tile_group == nullptr) continue;
 
-    auto tile_group_header = tile_group->GetHeader();
-    for (auto &tuple_entry : tile_group_entry.second) {
-      auto tuple_slot = tuple_entry.first;
+    auto tile_group_header = entry.tile_group_header;
+    auto tuple_slot = entry.tuple_slot;
 
-      // we don't have reader lock on insert
-      if (tuple_entry.second == RW_TYPE_INSERT ||
-          tuple_entry.second == RW_TYPE_INS_DEL) {
-        continue;
-      }
-      RemoveSIReader(tile_group_header, tuple_slot, txn->GetTransactionId());
+    // we don't have reader lock on insert
+    if (entry.type == RW_TYPE_INSERT ||
+        entry.type == RW_TYPE_INS_DEL) {
+      continue;
     }
+    RemoveSIReader(tile_group_header, tuple_slot, txn->GetTransactionId());
   }
   LOG_TRACE("release SILock finish");
 }
@@ -691,7 +717,8 @@ void SsiTxnManager::CleanUp() {
 
 void SsiTxnManager::CleanUpBg() {
   while(!stopped) {
-    std::this_thread::sleep_for(std::chrono::milliseconds(EPOCH_LENGTH));
+    std::this_thread::sleep_for(std::chrono::milliseconds(
+        EpochManagerFactory::GetInstance().GetEpochLength()));
     auto max_begin = GetMaxCommittedCid();
     std::unordered_set<cid_t> gc_cids;
     while (gc_cid < max_begin) {
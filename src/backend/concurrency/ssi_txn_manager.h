@@ -107,20 +107,24 @@ class SsiTxnManager : public TransactionManager {
 
   virtual void PerformDelete(const ItemPointer &location);
 
-  virtual Transaction *BeginTransaction() {
+  virtual Transaction *BeginTransaction(const bool read_only = false) {
     // txn_manager_mutex_.WriteLock();
 
     // protect beginTransaction with a global lock
     // to ensure that:
     //    txn_id_a > txn_id_b --> begin_cid_a > begin_cid_b
+    // a READ ONLY transaction draws its begin cid as well for this order
+    // the begin cid is drawn inside the epoch
+    auto &epoch_manager = EpochManagerFactory::GetInstance();
+    auto eid = epoch_manager.EnterCurrentEpoch();
     txn_id_t txn_id = GetNextTransactionId();
     cid_t begin_cid = GetNextCommitId();
-    Transaction *txn = new Transaction(txn_id, begin_cid);
+    epoch_manager.SetEpochMaxCid(eid, begin_cid);
+    Transaction *txn = new Transaction(txn_id, begin_cid, read_only);
 
     current_ssi_txn_ctx = new SsiTxnContext(txn);
     current_txn = txn;
 
-    auto eid = EpochManagerFactory::GetInstance().EnterEpoch(begin_cid);
     txn->SetEpochId(eid);
 
 
@@ -14,7 +14,11 @@
 
 #include "backend/common/logger.h"
 #include "backend/common/platform.h"
+#include "backend/catalog/manager.h"
+#include "backend/storage/tile_group.h"
+#include "backend/storage/tile_group_header.h"
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 #include <iomanip>
@@ -22,102 +26,215 @@
 namespace peloton {
 namespace concurrency {
 
-void Transaction::RecordRead(const ItemPointer &location) {
+namespace {
 
-  oid_t tile_group_id = location.block;
-  oid_t tuple_id = location.offset;
+// entries of the read/write set and of its index a reused transaction
+// keeps memory for
+constexpr size_t max_reused_rw_set_size = 1 << 14;
 
-  if (rw_set_.find(tile_group_id) != rw_set_.end() &&
-      rw_set_.at(tile_group_id).find(tuple_id) !=
-          rw_set_.at(tile_group_id).end()) {
-    assert(rw_set_.at(tile_group_id).at(tuple_id) != RW_TYPE_DELETE &&
-           rw_set_.at(tile_group_id).at(tuple_id) != RW_TYPE_INS_DEL);
-    return;
-  } else {
-    rw_set_[tile_group_id][tuple_id] = RW_TYPE_READ;
-  }
-}
+constexpr size_t max_reused_rw_index_size = 1 << 10;
 
-void Transaction::RecordUpdate(const ItemPointer &location) {
+// key of a tuple in the index of the accessed tuples, never zero
+inline uint64_t GetTupleKey(const oid_t tile_group_id, const oid_t tuple_slot) {
+  return (((uint64_t)tile_group_id << 32) | tuple_slot) + 1;
+}
 
-  oid_t tile_group_id = location.block;
-  oid_t tuple_id = location.offset;
+inline size_t GetTupleHash(const uint64_t key) {
+  return (size_t)((key * 0x9E3779B97F4A7C15ul) >> 17);
+}
 
-  if (rw_set_.find(tile_group_id) != rw_set_.end() &&
-      rw_set_.at(tile_group_id).find(tuple_id) !=
-          rw_set_.at(tile_group_id).end()) {
-    RWType &type = rw_set_.at(tile_group_id).at(tuple_id);
-    if (type == RW_TYPE_READ) {
-      type = RW_TYPE_UPDATE;
-      // record write.
-      is_written_ = true;
-      return;
-    }
-    if (type == RW_TYPE_UPDATE) {
-      return;
-    }
-    if (type == RW_TYPE_INSERT) {
-      return;
+// Return false if the key is in the index already
+bool InsertTupleKey(std::vector<uint64_t> &index, const uint64_t key) {
+  auto mask = index.size() - 1;
+  auto pos = GetTupleHash(key) & mask;
+  while (index[pos] != 0) {
+    if (index[pos] == key) {
+      return false;
     }
-    if (type == RW_TYPE_DELETE) {
-      assert(false);
-      return;
+    pos = (pos + 1) & mask;
+  }
+  index[pos] = key;
+  return true;
+}
+
+// The type of a tuple accessed again by the transaction
+inline RWType MergeRWType(const RWType earlier, const RWType later) {
+  if (later == RW_TYPE_READ) {
+    return earlier;
+  }
+  if (earlier == RW_TYPE_READ || earlier == RW_TYPE_UPDATE) {
+    return later;
+  }
+  if (earlier == RW_TYPE_INSERT) {
+    if (later == RW_TYPE_UPDATE) {
+      return RW_TYPE_INSERT;
     }
-    assert(false);
+    return RW_TYPE_INS_DEL;
+  }
+  // a deleted tuple is not written again
+  assert(false);
+  return earlier;
+}
+
+}  // namespace
+
+void Transaction::Reset(const txn_id_t &txn_id, const cid_t &begin_cid,
+                        const bool declared_read_only) {
+  txn_id_ = txn_id;
+  begin_cid_ = begin_cid;
+  end_cid_ = MAX_CID;
+  result_ = peloton::RESULT_SUCCESS;
+  is_written_ = false;
+  insert_count_ = 0;
+  declared_read_only_ = declared_read_only;
+
+  // a large read/write set gives its memory back
+  if (rw_set_.capacity() > max_reused_rw_set_size) {
+    ReadWriteSet().swap(rw_set_);
+  }
+  rw_set_.clear();
+  rw_set_merged_size_ = 0;
+
+  // so does a large index, a small one is cleared
+  if (rw_index_.size() > max_reused_rw_index_size) {
+    std::vector<uint64_t>().swap(rw_index_);
+  } else if (rw_index_count_ != 0) {
+    std::fill(rw_index_.begin(), rw_index_.end(), 0);
   }
+  rw_set_indexed_size_ = 0;
+  rw_index_count_ = 0;
 }
 
-void Transaction::RecordInsert(const ItemPointer &location) {
+void Transaction::RecordRead(const ItemPointer &location,
+                             storage::TileGroupHeader *tile_group_header) {
+  rw_set_.push_back(RWSetEntry{tile_group_header, location.block,
+                               location.offset, RW_TYPE_READ});
+}
+
+void Transaction::RecordUpdate(const ItemPointer &location,
+                               storage::TileGroupHeader *tile_group_header) {
+  assert(declared_read_only_ == false);
 
-  oid_t tile_group_id = location.block;
-  oid_t tuple_id = location.offset;
+  // the updated version is never one inserted by the transaction
+  rw_set_.push_back(RWSetEntry{tile_group_header, location.block,
+                               location.offset, RW_TYPE_UPDATE});
+  // record write.
+  is_written_ = true;
+}
 
-  if (rw_set_.find(tile_group_id) != rw_set_.end() &&
-      rw_set_.at(tile_group_id).find(tuple_id) !=
-          rw_set_.at(tile_group_id).end()) {
-    // RWType &type = rw_set_.at(tile_group_id).at(tuple_id);
-    assert(false);
-  } else {
-    rw_set_[tile_group_id][tuple_id] = RW_TYPE_INSERT;
-    ++insert_count_;
+void Transaction::RecordInsert(const ItemPointer &location,
+                               storage::TileGroupHeader *tile_group_header) {
+  assert(declared_read_only_ == false);
+
+  rw_set_.push_back(RWSetEntry{tile_group_header, location.block,
+                               location.offset, RW_TYPE_INSERT});
+  ++insert_count_;
+}
+
+bool Transaction::RecordDelete(const ItemPointer &location,
+                               storage::TileGroupHeader *tile_group_header) {
+  assert(declared_read_only_ == false);
+
+  // only a version inserted by the transaction is not committed yet
+  if (tile_group_header->GetBeginCommitId(location.offset) == MAX_CID) {
+    rw_set_.push_back(RWSetEntry{tile_group_header, location.block,
+                                 location.offset, RW_TYPE_INS_DEL});
+    --insert_count_;
+    return true;
   }
+
+  rw_set_.push_back(RWSetEntry{tile_group_header, location.block,
+                               location.offset, RW_TYPE_DELETE});
+  // record write.
+  is_written_ = true;
+  return false;
 }
 
-bool Transaction::RecordDelete(const ItemPointer &location) {
-  oid_t tile_group_id = location.block;
-  oid_t tuple_id = location.offset;
-
-  if (rw_set_.find(tile_group_id) != rw_set_.end() &&
-      rw_set_.at(tile_group_id).find(tuple_id) !=
-          rw_set_.at(tile_group_id).end()) {
-    RWType &type = rw_set_.at(tile_group_id).at(tuple_id);
-    if (type == RW_TYPE_READ) {
-      type = RW_TYPE_DELETE;
-      // record write.
-      is_written_ = true;
-      return false;
+bool Transaction::IsAccessed(const ItemPointer &location) {
+  // add the entries recorded since the last call, keeping the load factor
+  // of the index at most one half
+  auto pending = rw_set_.size() - rw_set_indexed_size_;
+  if (rw_index_.empty() == true ||
+      (rw_index_count_ + pending) * 2 > rw_index_.size()) {
+    size_t capacity = std::max(rw_index_.size(), (size_t)64);
+    while ((rw_index_count_ + pending) * 2 > capacity) {
+      capacity *= 2;
     }
-    if (type == RW_TYPE_UPDATE) {
-      type = RW_TYPE_DELETE;
-      return false;
+    std::vector<uint64_t> old_index(capacity, 0);
+    old_index.swap(rw_index_);
+    for (auto key : old_index) {
+      if (key != 0) {
+        InsertTupleKey(rw_index_, key);
+      }
     }
-    if (type == RW_TYPE_INSERT) {
-      type = RW_TYPE_INS_DEL;
-      --insert_count_;
-      return true;
+  }
+  for (; rw_set_indexed_size_ < rw_set_.size(); ++rw_set_indexed_size_) {
+    auto &entry = rw_set_[rw_set_indexed_size_];
+    if (InsertTupleKey(rw_index_,
+                       GetTupleKey(entry.tile_group_id, entry.tuple_slot))) {
+      ++rw_index_count_;
     }
-    if (type == RW_TYPE_DELETE) {
-      assert(false);
-      return false;
+  }
+
+  auto key = GetTupleKey(location.block, location.offset);
+  auto mask = rw_index_.size() - 1;
+  for (auto pos = GetTupleHash(key) & mask; rw_index_[pos] != 0;
+       pos = (pos + 1) & mask) {
+    if (rw_index_[pos] == key) {
+      return true;
     }
-    assert(false);
-  } else {
-    assert(false);
   }
   return false;
 }
 
-const std::map<oid_t, std::map<oid_t, RWType>> &Transaction::GetRWSet() {
+const ReadWriteSet &Transaction::GetRWSet() {
+  if (rw_set_merged_size_ == rw_set_.size()) {
+    return rw_set_;
+  }
+
+  // a stable sort keeps the accesses to a tuple in order
+  std::stable_sort(rw_set_.begin(), rw_set_.end(),
+                   [](const RWSetEntry &lhs, const RWSetEntry &rhs) {
+                     return lhs.tile_group_id < rhs.tile_group_id ||
+                            (lhs.tile_group_id == rhs.tile_group_id &&
+                             lhs.tuple_slot < rhs.tuple_slot);
+                   });
+
+  size_t merged_size = 0;
+  oid_t tile_group_id = INVALID_OID;
+  storage::TileGroupHeader *tile_group_header = nullptr;
+  for (size_t i = 0; i < rw_set_.size(); ++i) {
+    auto &entry = rw_set_[i];
+    if (entry.tile_group_id != tile_group_id) {
+      tile_group_id = entry.tile_group_id;
+      tile_group_header = nullptr;
+    }
+    if (entry.tile_group_header == nullptr) {
+      if (tile_group_header == nullptr) {
+        tile_group_header = catalog::Manager::GetInstance()
+                                .GetTileGroup(tile_group_id)
+                                ->GetHeader();
+      }
+      entry.tile_group_header = tile_group_header;
+    } else {
+      tile_group_header = entry.tile_group_header;
+    }
+
+    if (merged_size != 0) {
+      auto &last = rw_set_[merged_size - 1];
+      if (last.tile_group_id == entry.tile_group_id &&
+          last.tuple_slot == entry.tuple_slot) {
+        last.type = MergeRWType(last.type, entry.type);
+        continue;
+      }
+    }
+    rw_set_[merged_size++] = entry;
+  }
+  rw_set_.resize(merged_size);
+
+  // the entries moved, the next IsAccessed adds them all again
+  rw_set_merged_size_ = merged_size;
+  rw_set_indexed_size_ = 0;
   return rw_set_;
 }
 
@@ -24,6 +24,11 @@
 #include "backend/common/exception.h"
 
 namespace peloton {
+
+namespace storage {
+class TileGroupHeader;
+}
+
 namespace concurrency {
 
 //===--------------------------------------------------------------------===//
@@ -38,6 +43,19 @@ enum RWType {
   RW_TYPE_INS_DEL  // delete after insert.
 };
 
+// An access of the transaction to a tuple. The header of the tile group is
+// kept, so that commit and abort do not look the tile group up again.
+struct RWSetEntry {
+  storage::TileGroupHeader *tile_group_header;
+  oid_t tile_group_id;
+  oid_t tuple_slot;
+  RWType type;
+};
+
+// The read/write set is appended to on every access and de-duplicated when
+// it is requested, sorted by tile group and slot.
+typedef std::vector<RWSetEntry> ReadWriteSet;
+
 class Transaction : public Printable {
   Transaction(Transaction const &) = delete;
 
@@ -47,24 +65,41 @@ class Transaction : public Printable {
         begin_cid_(INVALID_CID),
         end_cid_(MAX_CID),
         is_written_(false),
-        insert_count_(0) {}
+        insert_count_(0),
+        declared_read_only_(false),
+        rw_set_merged_size_(0),
+        rw_set_indexed_size_(0),
+        rw_index_count_(0) {}
 
   Transaction(const txn_id_t &txn_id)
       : txn_id_(txn_id),
         begin_cid_(INVALID_CID),
         end_cid_(MAX_CID),
         is_written_(false),
-        insert_count_(0) {}
-
-  Transaction(const txn_id_t &txn_id, const cid_t &begin_cid)
+        insert_count_(0),
+        declared_read_only_(false),
+        rw_set_merged_size_(0),
+        rw_set_indexed_size_(0),
+        rw_index_count_(0) {}
+
+  Transaction(const txn_id_t &txn_id, const cid_t &begin_cid,
+              const bool declared_read_only = false)
       : txn_id_(txn_id),
         begin_cid_(begin_cid),
         end_cid_(MAX_CID),
         is_written_(false),
-        insert_count_(0) {}
+        insert_count_(0),
+        declared_read_only_(declared_read_only),
+        rw_set_merged_size_(0),
+        rw_set_indexed_size_(0),
+        rw_index_count_(0) {}
 
   ~Transaction() {}
 
+  // Reuse a finished transaction, the read/write set keeps its capacity
+  void Reset(const txn_id_t &txn_id, const cid_t &begin_cid,
+             const bool declared_read_only);
+
   //===--------------------------------------------------------------------===//
   // Mutators and Accessors
   //===--------------------------------------------------------------------===//
@@ -81,16 +116,22 @@ class Transaction : public Printable {
 
   inline void SetEpochId(const size_t eid) { epoch_id_ = eid; }
 
-  void RecordRead(const ItemPointer &);
+  // Without the header, the tile group is looked up when the read/write set
+  // is requested, once for all the reads of the tile group
+  void RecordRead(const ItemPointer &,
+                  storage::TileGroupHeader * = nullptr);
 
-  void RecordUpdate(const ItemPointer &);
+  void RecordUpdate(const ItemPointer &, storage::TileGroupHeader *);
 
-  void RecordInsert(const ItemPointer &);
+  void RecordInsert(const ItemPointer &, storage::TileGroupHeader *);
 
   // Return true if we detect INS_DEL
-  bool RecordDelete(const ItemPointer &);
+  bool RecordDelete(const ItemPointer &, storage::TileGroupHeader *);
+
+  // Whether the transaction has accessed the tuple before
+  bool IsAccessed(const ItemPointer &);
 
-  const std::map<oid_t, std::map<oid_t, RWType>> &GetRWSet();
+  const ReadWriteSet &GetRWSet();
 
   // Get a string representation for debugging
   const std::string GetInfo() const;
@@ -105,6 +146,10 @@ class Transaction : public Printable {
     return is_written_ == false && insert_count_ == 0;
   }
 
+  // A transaction begun in READ ONLY mode reads a stable snapshot. It never
+  // records its reads and commits without validation.
+  inline bool IsDeclaredReadOnly() const { return declared_read_only_; }
+
  private:
   //===--------------------------------------------------------------------===//
   // Data members
@@ -122,13 +167,26 @@ class Transaction : public Printable {
   // epoch id
   size_t epoch_id_;
 
-  std::map<oid_t, std::map<oid_t, RWType>> rw_set_;
+  ReadWriteSet rw_set_;
 
   // result of the transaction
   Result result_ = peloton::RESULT_SUCCESS;
 
   bool is_written_;
   size_t insert_count_;
+
+  // declared READ ONLY at begin, the transaction must not write
+  bool declared_read_only_;
+
+  // number of entries at the front of the read/write set that are sorted
+  // and de-duplicated
+  size_t rw_set_merged_size_;
+
+  // open addressing hash set of the accessed tuples, built on the first
+  // IsAccessed, and the number of entries added to it
+  std::vector<uint64_t> rw_index_;
+  size_t rw_set_indexed_size_;
+  size_t rw_index_count_;
 };
 
 }  // End concurrency namespace
@@ -12,12 +12,186 @@
 
 #include "transaction_manager.h"
 
+#include <algorithm>
+#include <thread>
+
+#include "backend/common/logger.h"
+#include "backend/concurrency/transaction_manager_factory.h"
+
 namespace peloton {
 namespace concurrency {
 
 // Current transaction for the backend thread
 thread_local Transaction *current_txn;
 
+std::atomic<cid_t> TransactionManager::next_cid_(START_CID);
+
+// Epoch timestamps: a commit id is the base cid, plus the epoch in the high
+// 32 bits, a sequence number of the worker, and the worker slot in the low
+// 8 bits. The workers share the epoch only, it advances every epoch length
+// (EPOCH_LENGTH milliseconds by default). Txn ids are handed out to the
+// workers in batches.
+namespace {
+
+constexpr int epoch_cid_shift = 32;
+
+constexpr int worker_slot_bits = 8;
+
+constexpr cid_t max_worker_sequence =
+    (1ul << (epoch_cid_shift - worker_slot_bits)) - 1;
+
+constexpr txn_id_t txn_id_batch_size = 1024;
+
+std::atomic<cid_t> worker_slot_counter(0);
+
+struct WorkerTimestamps {
+  cid_t slot =
+      worker_slot_counter++ & ((cid_t(1) << worker_slot_bits) - 1);
+
+  size_t epoch = 0;
+
+  cid_t sequence = 0;
+
+  cid_t last_commit_id = INVALID_CID;
+
+  txn_id_t next_txn_id = INVALID_TXN_ID;
+
+  txn_id_t end_txn_id = INVALID_TXN_ID;
+};
+
+thread_local WorkerTimestamps worker_timestamps;
+
+// Finished transactions of the worker
+constexpr size_t max_pooled_transactions = 16;
+
+struct TransactionPool {
+  ~TransactionPool() {
+    for (auto txn : transactions) {
+      delete txn;
+    }
+  }
+
+  std::vector<Transaction *> transactions;
+};
+
+thread_local TransactionPool transaction_pool;
+
+}  // namespace
+
+Transaction *TransactionManager::AllocateTransaction(const txn_id_t &txn_id,
+                                                     const cid_t &begin_cid,
+                                                     const bool read_only) {
+  auto &transactions = transaction_pool.transactions;
+  if (transactions.empty() == true) {
+    return new Transaction(txn_id, begin_cid, read_only);
+  }
+  Transaction *txn = transactions.back();
+  transactions.pop_back();
+  txn->Reset(txn_id, begin_cid, read_only);
+  return txn;
+}
+
+void TransactionManager::RecycleTransaction(Transaction *txn) {
+  auto &transactions = transaction_pool.transactions;
+  if (transactions.size() == max_pooled_transactions) {
+    delete txn;
+    return;
+  }
+  transactions.push_back(txn);
+}
+
+txn_id_t TransactionManager::GetNextTransactionId() {
+  if (TransactionManagerFactory::GetTimestampType() != TIMESTAMP_TYPE_EPOCH) {
+    return next_txn_id_++;
+  }
+
+  auto &worker = worker_timestamps;
+  if (worker.next_txn_id == worker.end_txn_id) {
+    worker.next_txn_id = next_txn_id_.fetch_add(txn_id_batch_size);
+    worker.end_txn_id = worker.next_txn_id + txn_id_batch_size;
+  }
+  return worker.next_txn_id++;
+}
+
+cid_t TransactionManager::GetNextCommitId() {
+  if (TransactionManagerFactory::GetTimestampType() != TIMESTAMP_TYPE_EPOCH) {
+    cid_t temp_cid = next_cid_++;
+    // wait if we do not yet have a grant for this commit id
+    while (temp_cid > maximum_grant_cid_.load())
+      ;
+    return temp_cid;
+  }
+
+  // The commit follows its snapshot and every version the transaction has
+  // read or overwritten, so that conflicting commits stay ordered
+  cid_t lower_bound = INVALID_CID;
+  if (current_txn != nullptr) {
+    lower_bound = current_txn->GetBeginCommitId() + 1;
+    for (auto &entry : current_txn->GetRWSet()) {
+      if (entry.type == RW_TYPE_INSERT || entry.type == RW_TYPE_INS_DEL) {
+        continue;
+      }
+      auto begin_cid =
+          entry.tile_group_header->GetBeginCommitId(entry.tuple_slot);
+      if (begin_cid != MAX_CID) {
+        lower_bound = std::max(lower_bound, begin_cid + 1);
+      }
+    }
+  }
+
+  // a worker running out of sequence numbers waits for the next epoch
+  auto &epoch_manager = EpochManagerFactory::GetInstance();
+  auto &worker = worker_timestamps;
+  auto epoch = epoch_manager.GetCurrentEpoch();
+  while (worker.epoch == epoch && worker.sequence > max_worker_sequence) {
+    std::this_thread::yield();
+    epoch = epoch_manager.GetCurrentEpoch();
+  }
+  if (worker.epoch != epoch) {
+    worker.epoch = epoch;
+    worker.sequence = 0;
+  }
+
+  cid_t commit_id = next_cid_.load() + ((cid_t)epoch << epoch_cid_shift) +
+                    (worker.sequence++ << worker_slot_bits) + worker.slot;
+  commit_id = std::max(commit_id,
+                       std::max(lower_bound, worker.last_commit_id + 1));
+  worker.last_commit_id = commit_id;
+  return commit_id;
+}
+
+cid_t TransactionManager::GetCurrentCommitId() {
+  if (TransactionManagerFactory::GetTimestampType() != TIMESTAMP_TYPE_EPOCH) {
+    return next_cid_.load();
+  }
+  auto epoch = EpochManagerFactory::GetInstance().GetCurrentEpoch();
+  return next_cid_.load() + ((cid_t)epoch << epoch_cid_shift);
+}
+
+cid_t TransactionManager::GetNextBeginCommitId(size_t &epoch_id,
+                                               const bool read_only) {
+  auto &epoch_manager = EpochManagerFactory::GetInstance();
+  if (TransactionManagerFactory::GetTimestampType() != TIMESTAMP_TYPE_EPOCH) {
+    // The counter is read after entering the epoch, so the transactions of
+    // earlier epochs never have a larger begin cid.
+    epoch_id = epoch_manager.EnterCurrentEpoch();
+    cid_t begin_cid = read_only ? next_cid_.load() - 1 : GetNextCommitId();
+    epoch_manager.SetEpochMaxCid(epoch_id, begin_cid);
+    return begin_cid;
+  }
+
+  // The snapshot is taken from the epoch the transaction is in. The
+  // transactions of earlier epochs then never have a larger begin cid,
+  // garbage collection relies on it.
+  epoch_id = epoch_manager.EnterCurrentEpoch();
+  cid_t begin_cid = next_cid_.load() + ((cid_t)epoch_id << epoch_cid_shift) - 1;
+  if (read_only == false) {
+    begin_cid = std::max(begin_cid, worker_timestamps.last_commit_id);
+  }
+  epoch_manager.SetEpochMaxCid(epoch_id, begin_cid);
+  return begin_cid;
+}
+
 bool TransactionManager::IsOccupied(const ItemPointer &position) {
   auto tile_group_header =
       catalog::Manager::GetInstance().GetTileGroup(position.block)->GetHeader();
@@ -76,5 +250,53 @@ bool TransactionManager::IsOccupied(const ItemPointer &position) {
   }
 }
 
+void TransactionManager::InstallNewVersion(const ItemPointer &old_location,
+                                           const ItemPointer &new_location) {
+  if (TransactionManagerFactory::GetVersionOrder() != VERSION_ORDER_TYPE_N2O) {
+    return;
+  }
+
+  auto tile_group =
+      catalog::Manager::GetInstance().GetTileGroup(old_location.block);
+  auto table =
+      dynamic_cast<storage::DataTable *>(tile_group->GetAbstractTable());
+  if (table == nullptr) return;
+
+  if (table->SwingPrimaryIndexEntry(old_location, old_location,
+                                    new_location) == false) {
+    LOG_TRACE("Index entry does not reference version (%u, %u)",
+              old_location.block, old_location.offset);
+  }
+}
+
+void TransactionManager::UninstallNewVersion(const ItemPointer &old_location,
+                                             const ItemPointer &new_location) {
+  if (TransactionManagerFactory::GetVersionOrder() != VERSION_ORDER_TYPE_N2O) {
+    return;
+  }
+
+  auto tile_group =
+      catalog::Manager::GetInstance().GetTileGroup(old_location.block);
+  auto table =
+      dynamic_cast<storage::DataTable *>(tile_group->GetAbstractTable());
+  if (table == nullptr) return;
+
+  // The key is read from the old version, a deleted tuple's new version
+  // is empty
+  if (table->SwingPrimaryIndexEntry(old_location, new_location,
+                                    old_location) == false) {
+    LOG_TRACE("Index entry does not reference version (%u, %u)",
+              new_location.block, new_location.offset);
+  }
+
+  // The old version is the head of the chain again
+  tile_group->GetHeader()->SetNextItemPointer(old_location.offset,
+                                              INVALID_ITEMPOINTER);
+  catalog::Manager::GetInstance()
+      .GetTileGroup(new_location.block)
+      ->GetHeader()
+      ->SetPrevItemPointer(new_location.offset, INVALID_ITEMPOINTER);
+}
+
 }  // End concurrency namespace
 }  // End peloton namespace
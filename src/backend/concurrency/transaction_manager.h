@@ -45,22 +45,26 @@ class TransactionManager {
  public:
   TransactionManager() {
     next_txn_id_ = ATOMIC_VAR_INIT(START_TXN_ID);
-    next_cid_ = ATOMIC_VAR_INIT(START_CID);
     maximum_grant_cid_ = ATOMIC_VAR_INIT(MAX_CID);
   }
 
   virtual ~TransactionManager() {}
 
-  txn_id_t GetNextTransactionId() { return next_txn_id_++; }
+  txn_id_t GetNextTransactionId();
 
-  cid_t GetNextCommitId() {
-	  cid_t temp_cid = next_cid_++;
-	  // wait if we do not yet have a grant for this commit id
-	  while(temp_cid > maximum_grant_cid_.load());
-	  return temp_cid;
-  }
+  cid_t GetNextCommitId();
+
+  // the lowest commit id a transaction committing from now on can get
+  cid_t GetCurrentCommitId();
 
-  cid_t GetCurrentCommitId() { return next_cid_.load(); }
+  // Begin cid of a new transaction, which enters its epoch. With epoch
+  // timestamps the begin cid is a snapshot of the earlier epochs and of the
+  // worker's own commits, the shared counter is not touched.
+  // A READ ONLY transaction never advances the counter, it reads the last
+  // committed cid. With epoch timestamps it reads the base of its epoch
+  // only, the worker's own commits may be ordered after commits of other
+  // workers in the same epoch that are not installed yet.
+  cid_t GetNextBeginCommitId(size_t &epoch_id, const bool read_only = false);
 
   bool IsOccupied(const ItemPointer &position);
 
@@ -111,7 +115,10 @@ class TransactionManager {
 
   void SetMaxGrantCid(cid_t cid){ maximum_grant_cid_ = cid; }
 
-  virtual Transaction *BeginTransaction() = 0;
+  virtual Transaction *BeginTransaction(const bool read_only = false) = 0;
+
+  // A READ ONLY transaction skips read tracking and commit validation
+  Transaction *BeginReadOnlyTransaction() { return BeginTransaction(true); }
 
   virtual void EndTransaction() = 0;
 
@@ -136,7 +143,24 @@ class TransactionManager {
   }
 
  protected:
+  // Transactions are taken from a pool of the worker thread and put back
+  // when they end, so that they keep the memory of their read/write sets
+  Transaction *AllocateTransaction(const txn_id_t &txn_id,
+                                   const cid_t &begin_cid,
+                                   const bool read_only);
+
+  void RecycleTransaction(Transaction *txn);
+
+  // With newest-to-oldest version chains the primary index references the
+  // newest version of a tuple. Once a new version is linked in front of the
+  // old one, the index entry is swung over to it.
+  void InstallNewVersion(const ItemPointer &old_location,
+                         const ItemPointer &new_location);
 
+  // Swing the index entry back to the old version, before an aborted
+  // version is unlinked from the chain
+  void UninstallNewVersion(const ItemPointer &old_location,
+                           const ItemPointer &new_location);
 
   inline bool CidIsInDirtyRange(cid_t cid){
 	  return ((cid > dirty_range_.first) & (cid <= dirty_range_.second));
@@ -148,7 +172,9 @@ class TransactionManager {
 
  private:
   std::atomic<txn_id_t> next_txn_id_;
-  std::atomic<cid_t> next_cid_;
+  // The epoch manager and the garbage collector are shared by every
+  // protocol, so are the commit ids
+  static std::atomic<cid_t> next_cid_;
   std::atomic<cid_t> maximum_grant_cid_;
 
 };
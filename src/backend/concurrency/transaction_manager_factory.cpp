@@ -18,5 +18,9 @@ ConcurrencyType TransactionManagerFactory::protocol_ =
     CONCURRENCY_TYPE_OPTIMISTIC;
 IsolationLevelType TransactionManagerFactory::isolation_level_ =
     ISOLATION_LEVEL_TYPE_FULL;
+VersionOrderType TransactionManagerFactory::version_order_ =
+    VERSION_ORDER_TYPE_O2N;
+TimestampType TransactionManagerFactory::timestamp_type_ =
+    TIMESTAMP_TYPE_GLOBAL;
 }
 }
@@ -46,18 +46,42 @@ class TransactionManagerFactory {
   }
 
   static void Configure(ConcurrencyType protocol,
-                        IsolationLevelType level = ISOLATION_LEVEL_TYPE_FULL) {
+                        IsolationLevelType level = ISOLATION_LEVEL_TYPE_FULL,
+                        VersionOrderType order = VERSION_ORDER_TYPE_O2N,
+                        TimestampType timestamp = TIMESTAMP_TYPE_GLOBAL) {
     protocol_ = protocol;
     isolation_level_ = level;
+    version_order_ = order;
+    timestamp_type_ = timestamp;
   }
 
   static ConcurrencyType GetProtocol() { return protocol_; }
 
   static IsolationLevelType GetIsolationLevel() { return isolation_level_; }
 
+  // The rollback segment protocol updates tuples in place and keeps its
+  // own undo chain, its index entries never move
+  static VersionOrderType GetVersionOrder() {
+    if (protocol_ == CONCURRENCY_TYPE_OCC_RB) return VERSION_ORDER_TYPE_O2N;
+    return version_order_;
+  }
+
+  // Timestamp ordering and speculative reads order transactions by their
+  // begin cid, and SSI by their txn id. They keep the global counter.
+  static TimestampType GetTimestampType() {
+    if (protocol_ == CONCURRENCY_TYPE_TO ||
+        protocol_ == CONCURRENCY_TYPE_SPECULATIVE_READ ||
+        protocol_ == CONCURRENCY_TYPE_SSI) {
+      return TIMESTAMP_TYPE_GLOBAL;
+    }
+    return timestamp_type_;
+  }
+
  private:
   static ConcurrencyType protocol_;
   static IsolationLevelType isolation_level_;
+  static VersionOrderType version_order_;
+  static TimestampType timestamp_type_;
 };
 }
 }
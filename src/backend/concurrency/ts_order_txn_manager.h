@@ -63,13 +63,13 @@ class TsOrderTxnManager : public TransactionManager {
 
   virtual Result AbortTransaction();
 
-  virtual Transaction *BeginTransaction() {
+  virtual Transaction *BeginTransaction(const bool read_only = false) {
     txn_id_t txn_id = GetNextTransactionId();
-    cid_t begin_cid = GetNextCommitId();
-    Transaction *txn = new Transaction(txn_id, begin_cid);
+    size_t eid;
+    cid_t begin_cid = GetNextBeginCommitId(eid, read_only);
+    Transaction *txn = AllocateTransaction(txn_id, begin_cid, read_only);
     current_txn = txn;
 
-    auto eid = EpochManagerFactory::GetInstance().EnterEpoch(begin_cid);
     txn->SetEpochId(eid);
 
     return txn;
@@ -80,8 +80,10 @@ class TsOrderTxnManager : public TransactionManager {
 
     EpochManagerFactory::GetInstance().ExitEpoch(current_txn->GetEpochId());
 
-    delete current_txn;
+    RecycleTransaction(current_txn);
     current_txn = nullptr;
+
+    gc::GCManagerFactory::GetInstance().CooperativeGC();
   }
 
 
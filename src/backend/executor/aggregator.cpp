@@ -160,14 +160,12 @@ HashAggregator::HashAggregator(const planner::AggregatePlan *node,
 }
 
 HashAggregator::~HashAggregator() {
-  for (auto entry : aggregates_map) {
+  for (auto &entry : aggregates_map) {
     // Clean up allocated storage
     for (size_t aggno = 0; aggno < node->GetUniqueAggTerms().size(); aggno++) {
-      delete entry.second->aggregates[aggno];
+      delete entry.value.aggregates[aggno];
     }
-    delete[] entry.second->aggregates;
-
-    delete entry.second;
+    delete[] entry.value.aggregates;
   }
 }
 
@@ -183,13 +181,13 @@ bool HashAggregator::Advance(AbstractTuple *cur_tuple) {
     group_by_key_values.push_back(cur_tuple_val);
   }
 
-  auto map_itr = aggregates_map.find(group_by_key_values);
+  auto map_entry = aggregates_map.FindOrInsert(
+      group_by_key_values, aggregates_map.Hash(group_by_key_values));
+  aggregate_list = &map_entry.first;
 
-  // Group not found. Make a new entry in the hash for this new group.
-  if (map_itr == aggregates_map.end()) {
+  // Group not found. Initialize the new entry in the hash for this new group.
+  if (map_entry.second == true) {
     LOG_TRACE("Group-by key not found. Start a new group.");
-    // Allocate new aggregate list
-    aggregate_list = new AggregateList();
     aggregate_list->aggregates = new Agg *[node->GetUniqueAggTerms().size()];
     // Make a deep copy of the first tuple we meet
     for (size_t col_id = 0; col_id < num_input_columns; col_id++) {
@@ -204,13 +202,6 @@ bool HashAggregator::Advance(AbstractTuple *cur_tuple) {
       bool distinct = node->GetUniqueAggTerms()[aggno].distinct;
       aggregate_list->aggregates[aggno]->SetDistinct(distinct);
     }
-
-    aggregates_map.insert(
-        HashAggregateMapType::value_type(group_by_key_values, aggregate_list));
-  }
-  // Otherwise, the list is the second item of the pair.
-  else {
-    aggregate_list = map_itr->second;
   }
 
   // Update the aggregation calculation
@@ -228,11 +219,11 @@ bool HashAggregator::Advance(AbstractTuple *cur_tuple) {
 }
 
 bool HashAggregator::Finalize() {
-  for (auto entry : aggregates_map) {
+  for (auto &entry : aggregates_map) {
     // Construct a container for the first tuple
     expression::ContainerTuple<std::vector<Value>> first_tuple(
-        &entry.second->first_tuple_values);
-    if (Helper(node, entry.second->aggregates, output_table, &first_tuple,
+        &entry.value.first_tuple_values);
+    if (Helper(node, entry.value.aggregates, output_table, &first_tuple,
                this->executor_context) == false) {
       return false;
     }
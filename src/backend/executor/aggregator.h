@@ -12,11 +12,11 @@
 
 #pragma once
 
-#include <unordered_map>
 #include <unordered_set>
 
 #include "backend/common/value_factory.h"
 #include "backend/executor/abstract_executor.h"
+#include "backend/executor/hash_table.h"
 #include "backend/planner/aggregate_plan.h"
 #include "backend/expression/container_tuple.h"
 
@@ -289,7 +289,7 @@ class HashAggregator : public AbstractAggregator {
     std::vector<Value> first_tuple_values;
 
     // The aggregates for each column for this group
-    Agg **aggregates;
+    Agg **aggregates = nullptr;
   };
 
   /** Hash function of internal hash table */
@@ -305,9 +305,10 @@ class HashAggregator : public AbstractAggregator {
     }
   };
 
-  // Default equal_to should works well
-  typedef std::unordered_map<std::vector<Value>, AggregateList *,
-                             ValueVectorHasher> HashAggregateMapType;
+  // Default equal_to should works well,
+  // the aggregate lists are kept inline in the table
+  typedef HashTable<std::vector<Value>, AggregateList, ValueVectorHasher>
+      HashAggregateMapType;
 
   /** @brief Group by key values used */
   std::vector<Value> group_by_key_values;
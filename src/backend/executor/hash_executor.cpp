@@ -10,11 +10,14 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <atomic>
 #include <utility>
 #include <vector>
 
 #include "backend/common/logger.h"
 #include "backend/common/value.h"
+#include "backend/common/thread_manager.h"
 #include "backend/executor/logical_tile.h"
 #include "backend/executor/hash_executor.h"
 #include "backend/planner/hash_plan.h"
@@ -79,17 +82,10 @@ bool HashExecutor::DExecute() {
 
     // Construct the hash table by going over each child logical tile and
     // hashing
-    for (size_t child_tile_itr = 0; child_tile_itr < child_tiles_.size();
-         child_tile_itr++) {
-      auto tile = child_tiles_[child_tile_itr].get();
-
-      // Go over all tuples in the logical tile
-      for (oid_t tuple_id : *tile) {
-        // Key : container tuple with a subset of tuple attributes
-        // Value : < child_tile offset, tuple offset >
-        hash_table_[HashMapType::key_type(tile, tuple_id, &column_ids_)].insert(
-            std::make_pair(child_tile_itr, tuple_id));
-      }
+    if (node.GetParallelism() > 1 && child_tiles_.size() > 1) {
+      BuildHashTableInParallel(node.GetParallelism());
+    } else {
+      BuildHashTable();
     }
 
     done_ = true;
@@ -111,5 +107,109 @@ bool HashExecutor::DExecute() {
   return false;
 }
 
+void HashExecutor::BuildHashTable() {
+  partition_bits_ = 0;
+  hash_tables_.clear();
+  hash_tables_.resize(1);
+  auto &hash_table = hash_tables_[0];
+
+  // Size the table for unique keys, the common case of the build side
+  size_t tuple_count = 0;
+  for (auto &child_tile : child_tiles_) {
+    tuple_count += child_tile->GetTupleCount();
+  }
+  hash_table.Reserve(tuple_count);
+
+  for (size_t child_tile_itr = 0; child_tile_itr < child_tiles_.size();
+       child_tile_itr++) {
+    auto tile = child_tiles_[child_tile_itr].get();
+
+    // Go over all tuples in the logical tile
+    for (oid_t tuple_id : *tile) {
+      // Key : container tuple with a subset of tuple attributes
+      // Value : < child_tile offset, tuple offset >
+      hash_table[HashMapType::key_type(tile, tuple_id, &column_ids_)]
+          .emplace_back(child_tile_itr, tuple_id);
+    }
+  }
+}
+
+/**
+ * @brief Builds the hash table with several workers. The child tiles are
+ * the morsels: the workers first scatter their tuples to the partitions,
+ * then each partition is filled by a single worker, so that no locks are
+ * needed.
+ */
+void HashExecutor::BuildHashTableInParallel(const size_t parallelism) {
+  size_t worker_count = std::min(parallelism, child_tiles_.size());
+
+  // A few partitions per worker, so that skewed ones even out
+  partition_bits_ = 1;
+  while (((size_t)1 << partition_bits_) < 4 * worker_count) {
+    partition_bits_++;
+  }
+
+  size_t partition_count = (size_t)1 << partition_bits_;
+  hash_tables_.clear();
+  hash_tables_.resize(partition_count);
+
+  LOG_TRACE("Hash Executor : %lu workers, %lu partitions", worker_count,
+            partition_count);
+
+  // < child_tile offset, tuple offset > by worker and partition, along with
+  // the hash of the key so that it is only computed once
+  struct ScatteredLocation {
+    size_t child_tile_itr;
+    oid_t tuple_id;
+    size_t hash;
+  };
+  typedef std::vector<ScatteredLocation> LocationList;
+  std::vector<std::vector<LocationList>> scattered_locations(
+      worker_count, std::vector<LocationList>(partition_count));
+
+  std::atomic<size_t> next_worker_id(0);
+  std::atomic<size_t> next_child_tile_itr(0);
+
+  ThreadPool::GetWorkerInstance().RunTasks(worker_count, [&]() {
+    auto &worker_locations = scattered_locations[next_worker_id++];
+
+    size_t child_tile_itr;
+    while ((child_tile_itr = next_child_tile_itr++) < child_tiles_.size()) {
+      auto tile = child_tiles_[child_tile_itr].get();
+
+      for (oid_t tuple_id : *tile) {
+        HashMapType::key_type key(tile, tuple_id, &column_ids_);
+        size_t hash = hash_tables_[0].Hash(key);
+        worker_locations[GetPartition(hash)].push_back(
+            ScatteredLocation{child_tile_itr, tuple_id, hash});
+      }
+    }
+  });
+
+  std::atomic<size_t> next_partition(0);
+
+  ThreadPool::GetWorkerInstance().RunTasks(worker_count, [&]() {
+    size_t partition;
+    while ((partition = next_partition++) < partition_count) {
+      auto &hash_table = hash_tables_[partition];
+
+      size_t tuple_count = 0;
+      for (auto &worker_locations : scattered_locations) {
+        tuple_count += worker_locations[partition].size();
+      }
+      hash_table.Reserve(tuple_count);
+
+      for (auto &worker_locations : scattered_locations) {
+        for (auto &location : worker_locations[partition]) {
+          auto tile = child_tiles_[location.child_tile_itr].get();
+          HashMapType::key_type key(tile, location.tuple_id, &column_ids_);
+          hash_table.FindOrInsert(key, location.hash)
+              .first.emplace_back(location.child_tile_itr, location.tuple_id);
+        }
+      }
+    }
+  });
+}
+
 } /* namespace executor */
 } /* namespace peloton */
@@ -12,16 +12,15 @@
 
 #pragma once
 
-#include <unordered_map>
-#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "backend/common/types.h"
 #include "backend/executor/abstract_executor.h"
+#include "backend/executor/hash_table.h"
 #include "backend/executor/logical_tile.h"
 #include "backend/expression/container_tuple.h"
 
-#include <boost/functional/hash.hpp>
-
 namespace peloton {
 namespace executor {
 
@@ -39,15 +38,22 @@ class HashExecutor : public AbstractExecutor {
   explicit HashExecutor(const planner::AbstractPlan *node,
                         ExecutorContext *executor_context);
 
-  /** @brief Type definitions for hash table */
-  typedef std::unordered_map<
-      expression::ContainerTuple<LogicalTile>,
-      std::unordered_set<std::pair<size_t, oid_t>,
-                         boost::hash<std::pair<size_t, oid_t>>>,
-      expression::ContainerTupleHasher<LogicalTile>,
-      expression::ContainerTupleComparator<LogicalTile>> HashMapType;
-
-  inline HashMapType &GetHashTable() { return this->hash_table_; }
+  /** @brief Type definitions for hash table,
+   *  the tuples with the same key are kept in insertion order */
+  typedef HashTable<expression::ContainerTuple<LogicalTile>,
+                    std::vector<std::pair<size_t, oid_t>>,
+                    expression::ContainerTupleHasher<LogicalTile>,
+                    expression::ContainerTupleComparator<LogicalTile>>
+      HashMapType;
+
+  /** @brief Tuples of the build side with the same key, nullptr if none */
+  inline const HashMapType::mapped_type *Find(
+      const HashMapType::key_type &key) const {
+    if (hash_tables_.empty()) return nullptr;
+
+    size_t hash = hash_tables_[0].Hash(key);
+    return hash_tables_[GetPartition(hash)].Find(key, hash);
+  }
 
   inline const std::vector<oid_t> &GetHashKeyIds() const {
     return this->column_ids_;
@@ -59,8 +65,21 @@ class HashExecutor : public AbstractExecutor {
   bool DExecute();
 
  private:
-  /** @brief Hash table */
-  HashMapType hash_table_;
+  void BuildHashTable();
+
+  void BuildHashTableInParallel(const size_t parallelism);
+
+  /** @brief Partition of the key, taken from the high bits of its hash,
+   *  the slots within a partition are picked from the low bits */
+  inline size_t GetPartition(const size_t hash) const {
+    if (partition_bits_ == 0) return 0;
+    return hash >> (64 - partition_bits_);
+  }
+
+  /** @brief Hash table, partitioned by key when it is built in parallel */
+  std::vector<HashMapType> hash_tables_;
+
+  size_t partition_bits_ = 0;
 
   /** @brief Input tiles from child node */
   std::vector<std::unique_ptr<LogicalTile>> child_tiles_;
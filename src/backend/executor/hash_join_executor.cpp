@@ -10,10 +10,14 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <atomic>
+#include <utility>
 #include <vector>
 
 #include "backend/common/types.h"
 #include "backend/common/logger.h"
+#include "backend/common/thread_manager.h"
 #include "backend/executor/logical_tile_factory.h"
 #include "backend/executor/hash_join_executor.h"
 #include "backend/expression/abstract_expression.h"
@@ -40,6 +44,9 @@ bool HashJoinExecutor::DInit() {
 
   hash_executor_ = reinterpret_cast<HashExecutor *>(children_[1]);
 
+  const planner::HashJoinPlan &node = GetPlanNode<planner::HashJoinPlan>();
+  parallelism_ = std::max(node.GetParallelism(), (size_t)1);
+
   return true;
 }
 
@@ -78,88 +85,63 @@ bool HashJoinExecutor::DExecute() {
       right_child_done_ = true;
     }
 
-    // Get next tile from LEFT child
-    if (children_[0]->Execute() == false) {
-      LOG_TRACE("Did not get left tile \n");
-      left_child_done_ = true;
-      continue;
+    // Get the next tiles from LEFT child, a morsel for each worker,
+    // there is nothing to probe if the RIGHT child is empty
+    size_t left_tile_count =
+        (right_result_tiles_.size() == 0) ? 1 : parallelism_;
+    size_t left_tile_begin = left_result_tiles_.size();
+    while (left_result_tiles_.size() - left_tile_begin < left_tile_count) {
+      if (children_[0]->Execute() == false) {
+        LOG_TRACE("Did not get left tile \n");
+        left_child_done_ = true;
+        break;
+      }
+
+      BufferLeftTile(children_[0]->GetOutput());
+      LOG_TRACE("Got left tile \n");
     }
 
-    BufferLeftTile(children_[0]->GetOutput());
-    LOG_TRACE("Got left tile \n");
+    size_t left_tile_end = left_result_tiles_.size();
+    if (left_tile_begin == left_tile_end) {
+      continue;
+    }
 
     if (right_result_tiles_.size() == 0) {
       LOG_TRACE("Did not get any right tiles \n");
       return BuildOuterJoinOutput();
     }
 
-    LogicalTile *left_tile = left_result_tiles_.back().get();
-
     //===------------------------------------------------------------------===//
     // Build Join Tile
     //===------------------------------------------------------------------===//
 
-    // Get the hash table from the hash executor
-    auto &hash_table = hash_executor_->GetHashTable();
-    auto &hashed_col_ids = hash_executor_->GetHashKeyIds();
-
-    oid_t prev_tile = INVALID_OID;
-    std::unique_ptr<LogicalTile> output_tile;
-    LogicalTile::PositionListsBuilder pos_lists_builder;
-
-    // Go over the left tile
-    for (auto left_tile_itr : *left_tile) {
-      const expression::ContainerTuple<executor::LogicalTile> left_tuple(
-          left_tile, left_tile_itr, &hashed_col_ids);
-
-      // Find matching tuples in the hash table built on top of the right table
-      auto right_tuples = hash_table.find(left_tuple);
-
-      if (right_tuples != hash_table.end()) {
-        RecordMatchedLeftRow(left_result_tiles_.size() - 1, left_tile_itr);
-
-        // Go over the matching right tuples
-        for (auto &location : right_tuples->second) {
-          // Check if we got a new right tile itr
-          if (prev_tile != location.first) {
-            // Check if we have any join tuples
-            if (pos_lists_builder.Size() > 0) {
-              LOG_TRACE("Join tile size : %lu \n", pos_lists_builder.Size());
-              output_tile->SetPositionListsAndVisibility(
-                  pos_lists_builder.Release());
-              buffered_output_tiles.push_back(output_tile.release());
-            }
-
-            // Get the logical tile from right child
-            LogicalTile *right_tile = right_result_tiles_[location.first].get();
-
-            // Build output logical tile
-            output_tile = BuildOutputLogicalTile(left_tile, right_tile);
-
-            // Build position lists
-            pos_lists_builder =
-                LogicalTile::PositionListsBuilder(left_tile, right_tile);
-
-            pos_lists_builder.SetRightSource(
-                &right_result_tiles_[location.first]->GetPositionLists());
-          }
-
-          // Add join tuple
-          pos_lists_builder.AddRow(left_tile_itr, location.second);
-
-          RecordMatchedRightRow(location.first, location.second);
+    // Probe the hash table with the left tiles in parallel
+    left_tile_count = left_tile_end - left_tile_begin;
+    std::vector<std::vector<std::unique_ptr<LogicalTile>>> output_tiles(
+        left_tile_count);
+    std::vector<std::vector<std::pair<size_t, oid_t>>> matched_right_rows(
+        left_tile_count);
+    std::atomic<size_t> next_left_tile_itr(left_tile_begin);
+
+    ThreadPool::GetWorkerInstance().RunTasks(left_tile_count, [&]() {
+      size_t left_tile_itr;
+      while ((left_tile_itr = next_left_tile_itr++) < left_tile_end) {
+        ProbeLeftTile(left_tile_itr,
+                      output_tiles[left_tile_itr - left_tile_begin],
+                      matched_right_rows[left_tile_itr - left_tile_begin]);
+      }
+    });
 
-          // Cache prev logical tile itr
-          prev_tile = location.first;
-        }
+    // Keep the order of the left tiles
+    for (size_t left_tile_offset = 0; left_tile_offset < left_tile_count;
+         left_tile_offset++) {
+      for (auto &output_tile : output_tiles[left_tile_offset]) {
+        buffered_output_tiles.push_back(output_tile.release());
       }
-    }
 
-    // Check if we have any join tuples
-    if (pos_lists_builder.Size() > 0) {
-      LOG_TRACE("Join tile size : %lu \n", pos_lists_builder.Size());
-      output_tile->SetPositionListsAndVisibility(pos_lists_builder.Release());
-      buffered_output_tiles.push_back(output_tile.release());
+      for (auto &location : matched_right_rows[left_tile_offset]) {
+        RecordMatchedRightRow(location.first, location.second);
+      }
     }
 
     // Check if we have any buffered output tiles
@@ -176,5 +158,83 @@ bool HashJoinExecutor::DExecute() {
   }
 }
 
+/**
+ * @brief Joins a left tile with the matching right tuples in the hash table.
+ * It may run on a worker: the matched right rows are only collected here,
+ * and recorded by the caller.
+ */
+void HashJoinExecutor::ProbeLeftTile(
+    size_t left_tile_itr, std::vector<std::unique_ptr<LogicalTile>> &output_tiles,
+    std::vector<std::pair<size_t, oid_t>> &matched_right_rows) {
+  LogicalTile *left_tile = left_result_tiles_[left_tile_itr].get();
+
+  bool record_right_rows =
+      (join_type_ == JOIN_TYPE_RIGHT || join_type_ == JOIN_TYPE_OUTER);
+
+  // Get the hash table from the hash executor
+  auto &hashed_col_ids = hash_executor_->GetHashKeyIds();
+
+  oid_t prev_tile = INVALID_OID;
+  std::unique_ptr<LogicalTile> output_tile;
+  LogicalTile::PositionListsBuilder pos_lists_builder;
+
+  // Go over the left tile
+  for (auto left_tile_row_itr : *left_tile) {
+    const expression::ContainerTuple<executor::LogicalTile> left_tuple(
+        left_tile, left_tile_row_itr, &hashed_col_ids);
+
+    // Find matching tuples in the hash table built on top of the right table
+    auto right_tuples = hash_executor_->Find(left_tuple);
+
+    if (right_tuples != nullptr) {
+      RecordMatchedLeftRow(left_tile_itr, left_tile_row_itr);
+
+      // Go over the matching right tuples
+      for (auto &location : *right_tuples) {
+        // Check if we got a new right tile itr
+        if (prev_tile != location.first) {
+          // Check if we have any join tuples
+          if (pos_lists_builder.Size() > 0) {
+            LOG_TRACE("Join tile size : %lu \n", pos_lists_builder.Size());
+            output_tile->SetPositionListsAndVisibility(
+                pos_lists_builder.Release());
+            output_tiles.push_back(std::move(output_tile));
+          }
+
+          // Get the logical tile from right child
+          LogicalTile *right_tile = right_result_tiles_[location.first].get();
+
+          // Build output logical tile
+          output_tile = BuildOutputLogicalTile(left_tile, right_tile);
+
+          // Build position lists
+          pos_lists_builder =
+              LogicalTile::PositionListsBuilder(left_tile, right_tile);
+
+          pos_lists_builder.SetRightSource(
+              &right_result_tiles_[location.first]->GetPositionLists());
+        }
+
+        // Add join tuple
+        pos_lists_builder.AddRow(left_tile_row_itr, location.second);
+
+        if (record_right_rows == true) {
+          matched_right_rows.push_back(location);
+        }
+
+        // Cache prev logical tile itr
+        prev_tile = location.first;
+      }
+    }
+  }
+
+  // Check if we have any join tuples
+  if (pos_lists_builder.Size() > 0) {
+    LOG_TRACE("Join tile size : %lu \n", pos_lists_builder.Size());
+    output_tile->SetPositionListsAndVisibility(pos_lists_builder.Release());
+    output_tiles.push_back(std::move(output_tile));
+  }
+}
+
 }  // namespace executor
 }  // namespace peloton
@@ -13,6 +13,8 @@
 #pragma once
 
 #include <deque>
+#include <memory>
+#include <utility>
 #include <vector>
 
 #include "backend/executor/abstract_join_executor.h"
@@ -36,8 +38,15 @@ class HashJoinExecutor : public AbstractJoinExecutor {
   bool DExecute();
 
  private:
+  void ProbeLeftTile(size_t left_tile_itr,
+                     std::vector<std::unique_ptr<LogicalTile>> &output_tiles,
+                     std::vector<std::pair<size_t, oid_t>> &matched_right_rows);
+
   HashExecutor *hash_executor_ = nullptr;
 
+  /** @brief Number of left tiles probed in parallel. */
+  size_t parallelism_ = 1;
+
   bool hashed_ = false;
 
   std::deque<LogicalTile *> buffered_output_tiles;
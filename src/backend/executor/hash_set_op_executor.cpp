@@ -90,11 +90,12 @@ bool HashSetOpExecutor::ExecuteHelper() {
     std::unique_ptr<LogicalTile> tile(children_[1]->GetOutput());
 
     for (oid_t tuple_id : *tile) {
-      auto it = htable_.find(HashSetOpMapType::key_type(tile.get(), tuple_id));
+      auto counters =
+          htable_.Find(HashSetOpMapType::key_type(tile.get(), tuple_id));
       // Do nothing if this key never appears in the left child
       // because it shouldn't show up in the result anyway
-      if (it != htable_.end()) {
-        it->second.right++;
+      if (counters != nullptr) {
+        counters->right++;
       }
     }
   }
@@ -129,15 +130,16 @@ bool HashSetOpExecutor::ExecuteHelper() {
   // 1st round
   for (auto &tile : left_tiles_) {
     for (oid_t tuple_id : *tile) {
-      auto it = htable_.find(HashSetOpMapType::key_type(tile.get(), tuple_id));
+      auto entry =
+          htable_.FindEntry(HashSetOpMapType::key_type(tile.get(), tuple_id));
 
-      assert(it != htable_.end());
+      assert(entry != nullptr);
 
-      if (it->first.GetContainer() == tile.get() &&
-          it->first.GetTupleId() == tuple_id)
+      if (entry->key.GetContainer() == tile.get() &&
+          entry->key.GetTupleId() == tuple_id)
         continue;
-      else if (it->second.left > 0)
-        it->second.left--;
+      else if (entry->value.left > 0)
+        entry->value.left--;
       else
         tile->RemoveVisibility(tuple_id);
     }
@@ -146,9 +148,9 @@ bool HashSetOpExecutor::ExecuteHelper() {
   // 2nd round
   for (auto &item : htable_) {
     // We should have at most one quota left
-    assert(item.second.left == 1 || item.second.left == 0);
-    if (item.second.left == 0) {
-      item.first.GetContainer()->RemoveVisibility(item.first.GetTupleId());
+    assert(item.value.left == 1 || item.value.left == 0);
+    if (item.value.left == 0) {
+      item.key.GetContainer()->RemoveVisibility(item.key.GetTupleId());
     }
   }
 
@@ -167,18 +169,18 @@ bool HashSetOpExecutor::CalculateCopies(HashSetOpMapType &htable) {
   for (auto &item : htable) {
     switch (SETOP) {
       case SETOP_TYPE_INTERSECT:
-        item.second.left = (item.second.right > 0) ? 1 : 0;
+        item.value.left = (item.value.right > 0) ? 1 : 0;
         break;
       case SETOP_TYPE_INTERSECT_ALL:
-        item.second.left = std::min(item.second.left, item.second.right);
+        item.value.left = std::min(item.value.left, item.value.right);
         break;
       case SETOP_TYPE_EXCEPT:
-        item.second.left = (item.second.right > 0) ? 0 : 1;
+        item.value.left = (item.value.right > 0) ? 0 : 1;
         break;
       case SETOP_TYPE_EXCEPT_ALL:
-        item.second.left = (item.second.left > item.second.right)
-                               ? (item.second.left - item.second.right)
-                               : 0;
+        item.value.left = (item.value.left > item.value.right)
+                              ? (item.value.left - item.value.right)
+                              : 0;
         break;
       default:
         return false;
@@ -12,10 +12,9 @@
 
 #pragma once
 
-#include <unordered_map>
-
 #include "backend/common/types.h"
 #include "backend/executor/abstract_executor.h"
+#include "backend/executor/hash_table.h"
 #include "backend/executor/logical_tile.h"
 #include "backend/expression/container_tuple.h"
 
@@ -60,10 +59,10 @@ class HashSetOpExecutor : public AbstractExecutor {
   } counter_pair_t;
 
   /** @brief Type definitions for hash table */
-  typedef std::unordered_map<
-      expression::ContainerTuple<LogicalTile>, counter_pair_t,
-      expression::ContainerTupleHasher<LogicalTile>,
-      expression::ContainerTupleComparator<LogicalTile>> HashSetOpMapType;
+  typedef HashTable<expression::ContainerTuple<LogicalTile>, counter_pair_t,
+                    expression::ContainerTupleHasher<LogicalTile>,
+                    expression::ContainerTupleComparator<LogicalTile>>
+      HashSetOpMapType;
 
   /* Helper functions */
 
@@ -0,0 +1,313 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// hash_table.h
+//
+// Identification: src/backend/executor/hash_table.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace peloton {
+namespace executor {
+
+/**
+ * Hash table of the hash based operators (hash join, hash aggregation and
+ * hash set operations).
+ *
+ * The table is an array of slots probed linearly. A slot holds the full hash
+ * of its key next to a pointer to the entry, so a probe walks a contiguous
+ * array and only dereferences an entry when the hashes match. Keys are not
+ * fixed-width in general (they are tuples of Values), the stored hash is
+ * what filters out the mismatches instead of a key prefix.
+ *
+ * The entries themselves are bump allocated in chunks of growing size. They
+ * never move, so the address of a value stays valid while the table grows,
+ * and they are all freed at once with the table. Entries can't be erased.
+ * Iterating the table visits the entries in insertion order.
+ */
+template <typename KeyType, typename ValueType,
+          typename KeyHasher = std::hash<KeyType>,
+          typename KeyEqualityChecker = std::equal_to<KeyType>>
+class HashTable {
+ public:
+  struct Entry {
+    explicit Entry(const KeyType &key) : key(key), value() {}
+
+    const KeyType key;
+    ValueType value;
+  };
+
+  template <typename EntryType>
+  class Iterator {
+   public:
+    Iterator(const HashTable *table, size_t entry_offset)
+        : table_(table), entry_offset_(entry_offset) {}
+
+    EntryType &operator*() const {
+      return table_->chunks_[chunk_offset_][chunk_entry_offset_];
+    }
+
+    EntryType *operator->() const { return &operator*(); }
+
+    Iterator &operator++() {
+      entry_offset_++;
+      if (++chunk_entry_offset_ == GetChunkCapacity(chunk_offset_)) {
+        chunk_offset_++;
+        chunk_entry_offset_ = 0;
+      }
+      return *this;
+    }
+
+    bool operator==(const Iterator &other) const {
+      return entry_offset_ == other.entry_offset_;
+    }
+
+    bool operator!=(const Iterator &other) const {
+      return entry_offset_ != other.entry_offset_;
+    }
+
+   private:
+    const HashTable *table_;
+
+    size_t entry_offset_;
+
+    size_t chunk_offset_ = 0;
+
+    size_t chunk_entry_offset_ = 0;
+  };
+
+  typedef KeyType key_type;
+  typedef ValueType mapped_type;
+
+  typedef Iterator<Entry> iterator;
+  typedef Iterator<const Entry> const_iterator;
+
+  explicit HashTable(const KeyHasher &key_hasher = KeyHasher(),
+                     const KeyEqualityChecker &key_equality_checker =
+                         KeyEqualityChecker())
+      : key_hasher_(key_hasher), key_equality_checker_(key_equality_checker) {}
+
+  HashTable(const HashTable &) = delete;
+  HashTable &operator=(const HashTable &) = delete;
+  HashTable &operator=(HashTable &&) = delete;
+
+  HashTable(HashTable &&other)
+      : key_hasher_(other.key_hasher_),
+        key_equality_checker_(other.key_equality_checker_),
+        slots_(std::move(other.slots_)),
+        chunks_(std::move(other.chunks_)),
+        last_chunk_size_(other.last_chunk_size_),
+        size_(other.size_) {
+    other.slots_.clear();
+    other.chunks_.clear();
+    other.last_chunk_size_ = 0;
+    other.size_ = 0;
+  }
+
+  ~HashTable() {
+    for (auto &entry : *this) {
+      entry.~Entry();
+    }
+
+    for (auto chunk : chunks_) {
+      ::operator delete(chunk);
+    }
+  }
+
+  //===--------------------------------------------------------------------===//
+  // Accessors
+  //===--------------------------------------------------------------------===//
+
+  // Hash of the key as it is kept in the slots. Callers that already know it
+  // (e.g. to pick a partition) can hand it to the lookups below.
+  inline size_t Hash(const KeyType &key) const {
+    return MixHash(key_hasher_(key));
+  }
+
+  // Value of the key, nullptr if the key is not in the table
+  inline ValueType *Find(const KeyType &key) const {
+    return Find(key, Hash(key));
+  }
+
+  inline ValueType *Find(const KeyType &key, const size_t hash) const {
+    Entry *entry = FindEntry(key, hash);
+    return (entry != nullptr) ? &entry->value : nullptr;
+  }
+
+  // Entry of the key along with the key it was inserted with,
+  // nullptr if the key is not in the table
+  inline Entry *FindEntry(const KeyType &key) const {
+    return FindEntry(key, Hash(key));
+  }
+
+  inline Entry *FindEntry(const KeyType &key, const size_t hash) const {
+    if (slots_.empty()) return nullptr;
+
+    size_t slot_mask = slots_.size() - 1;
+    for (size_t slot_itr = hash & slot_mask;;
+         slot_itr = (slot_itr + 1) & slot_mask) {
+      auto &slot = slots_[slot_itr];
+      if (slot.entry == nullptr) return nullptr;
+
+      if (slot.hash == hash && key_equality_checker_(slot.entry->key, key)) {
+        return slot.entry;
+      }
+    }
+  }
+
+  inline size_t GetSize() const { return size_; }
+
+  inline bool IsEmpty() const { return size_ == 0; }
+
+  // Bytes allocated for the slots and the entries
+  size_t GetMemoryFootprint() const {
+    size_t memory_footprint = slots_.capacity() * sizeof(Slot);
+    for (size_t chunk_itr = 0; chunk_itr < chunks_.size(); chunk_itr++) {
+      memory_footprint += GetChunkCapacity(chunk_itr) * sizeof(Entry);
+    }
+    return memory_footprint;
+  }
+
+  iterator begin() { return iterator(this, 0); }
+  iterator end() { return iterator(this, size_); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, size_); }
+
+  //===--------------------------------------------------------------------===//
+  // Mutators
+  //===--------------------------------------------------------------------===//
+
+  // Value of the key, a default constructed value is inserted first if the
+  // key is not in the table yet
+  inline ValueType &operator[](const KeyType &key) {
+    return FindOrInsert(key, Hash(key)).first;
+  }
+
+  // Same as above, the second member tells whether the key was inserted
+  std::pair<ValueType &, bool> FindOrInsert(const KeyType &key,
+                                            const size_t hash) {
+    // Keep the load factor at most 3/4
+    if (slots_.empty()) {
+      Resize(min_slot_count);
+    } else if ((size_ + 1) * 4 > slots_.size() * 3) {
+      Resize(slots_.size() * 2);
+    }
+
+    size_t slot_mask = slots_.size() - 1;
+    for (size_t slot_itr = hash & slot_mask;;
+         slot_itr = (slot_itr + 1) & slot_mask) {
+      auto &slot = slots_[slot_itr];
+      if (slot.entry == nullptr) {
+        slot.hash = hash;
+        slot.entry = AllocateEntry(key);
+        return std::pair<ValueType &, bool>(slot.entry->value, true);
+      }
+
+      if (slot.hash == hash && key_equality_checker_(slot.entry->key, key)) {
+        return std::pair<ValueType &, bool>(slot.entry->value, false);
+      }
+    }
+  }
+
+  // Make room for the given number of keys up front
+  void Reserve(const size_t key_count) {
+    size_t slot_count = min_slot_count;
+    while (key_count * 4 > slot_count * 3) {
+      slot_count *= 2;
+    }
+
+    if (slot_count > slots_.size()) {
+      Resize(slot_count);
+    }
+  }
+
+ private:
+  struct Slot {
+    size_t hash = 0;
+    Entry *entry = nullptr;
+  };
+
+  static constexpr size_t min_slot_count = 16;
+
+  // Entries of the first chunk, the chunks double up to the largest size
+  static constexpr size_t min_chunk_capacity = 16;
+  static constexpr size_t max_chunk_capacity = 4096;
+
+  // Spread the bits of the hash, the hashes of Values are not well mixed
+  // and the slot is picked from the low bits (finalizer of MurmurHash3)
+  static inline size_t MixHash(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+  }
+
+  static inline size_t GetChunkCapacity(const size_t chunk_offset) {
+    return (chunk_offset >= 8) ? max_chunk_capacity
+                               : (min_chunk_capacity << chunk_offset);
+  }
+
+  Entry *AllocateEntry(const KeyType &key) {
+    if (chunks_.empty() ||
+        last_chunk_size_ == GetChunkCapacity(chunks_.size() - 1)) {
+      chunks_.push_back(static_cast<Entry *>(
+          ::operator new(GetChunkCapacity(chunks_.size()) * sizeof(Entry))));
+      last_chunk_size_ = 0;
+    }
+
+    Entry *entry = new (&chunks_.back()[last_chunk_size_]) Entry(key);
+    last_chunk_size_++;
+    size_++;
+    return entry;
+  }
+
+  // The entries stay where they are, only the slots are rehashed
+  void Resize(const size_t slot_count) {
+    assert((slot_count & (slot_count - 1)) == 0);
+
+    std::vector<Slot> slots(slot_count);
+    size_t slot_mask = slot_count - 1;
+    for (auto &slot : slots_) {
+      if (slot.entry == nullptr) continue;
+
+      size_t slot_itr = slot.hash & slot_mask;
+      while (slots[slot_itr].entry != nullptr) {
+        slot_itr = (slot_itr + 1) & slot_mask;
+      }
+      slots[slot_itr] = slot;
+    }
+
+    slots_.swap(slots);
+  }
+
+  KeyHasher key_hasher_;
+
+  KeyEqualityChecker key_equality_checker_;
+
+  // Power of two number of slots, probed linearly
+  std::vector<Slot> slots_;
+
+  // Entries, in insertion order
+  std::vector<Entry *> chunks_;
+
+  size_t last_chunk_size_ = 0;
+
+  size_t size_ = 0;
+};
+
+}  // End executor namespace
+}  // End peloton namespace
@@ -72,6 +72,7 @@ bool IndexScanExecutor::DInit() {
   values_ = node.GetValues();
   runtime_keys_ = node.GetRunTimeKeys();
   predicate_ = node.GetPredicate();
+  limit_ = node.GetLimit();
 
   if (runtime_keys_.size() != 0) {
     assert(runtime_keys_.size() == values_.size());
@@ -140,11 +141,14 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
 
   assert(index_->GetIndexType() == INDEX_CONSTRAINT_TYPE_PRIMARY_KEY);
 
+  // Without a predicate, the first visible entries are all we need
+  size_t scan_limit = (predicate_ == nullptr) ? limit_ : 0;
+
   if (0 == key_column_ids_.size()) {
     index_->ScanAllKeys(tuple_location_ptrs);
   } else {
     index_->Scan(values_, key_column_ids_, expr_types_,
-                 SCAN_DIRECTION_TYPE_FORWARD, tuple_location_ptrs);
+                 SCAN_DIRECTION_TYPE_FORWARD, tuple_location_ptrs, scan_limit);
   }
 
 
@@ -153,6 +157,11 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
   auto &transaction_manager =
       concurrency::TransactionManagerFactory::GetInstance();
 
+  // the index entries reference the newest versions, walk towards the older
+  bool newest_to_oldest =
+      (concurrency::TransactionManagerFactory::GetVersionOrder() ==
+       VERSION_ORDER_TYPE_N2O);
+
   std::map<oid_t, std::vector<oid_t>> visible_tuples;
   std::vector<ItemPointer> garbage_tuples;
   // for every tuple that is found in the index.
@@ -202,8 +211,26 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
             }
           }
         }
+
+        if (newest_to_oldest == true) {
+          UnlinkOlderVersions(tuple_location, garbage_tuples);
+        }
         break;
       }
+      // if the tuple is not visible, move on to the older version.
+      else if (newest_to_oldest == true) {
+        tuple_location =
+            tile_group_header->GetPrevItemPointer(tuple_location.offset);
+
+        // the tuple was inserted after we started, or its older versions
+        // are already gone, either way there is nothing to read.
+        if (tuple_location.IsNull()) {
+          break;
+        }
+
+        tile_group = manager.GetTileGroup(tuple_location.block);
+        tile_group_header = tile_group.get()->GetHeader();
+      }
       // if the tuple is not visible.
       else {
         ItemPointer old_item = tuple_location;
@@ -232,13 +259,17 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
           if (tile_group_header->SetAtomicTransactionId(old_item.offset, INVALID_TXN_ID) == true) {
 
             // atomically swap item pointer held in the index bucket.
-            AtomicUpdateItemPointer(tuple_location_ptr, tuple_location);
-
-            // currently, let's assume only primary index exists.
-            // gc::GCManagerFactory::GetInstance().RecycleTupleSlot(
-            //     table_->GetOid(), old_item.block, old_item.offset,
-            //     transaction_manager.GetNextCommitId());
-            garbage_tuples.push_back(old_item);
+            // indexes that store item pointers inline may have moved the
+            // entry meanwhile, then the old version stays reachable from
+            // the index and must not be recycled.
+            if (AtomicUpdateItemPointer(tuple_location_ptr, old_item,
+                                        tuple_location) == true) {
+              // currently, let's assume only primary index exists.
+              // gc::GCManagerFactory::GetInstance().RecycleTupleSlot(
+              //     table_->GetOid(), old_item.block, old_item.offset,
+              //     transaction_manager.GetNextCommitId());
+              garbage_tuples.push_back(old_item);
+            }
 
             tile_group = manager.GetTileGroup(tuple_location.block);
             tile_group_header = tile_group.get()->GetHeader();
@@ -270,6 +301,20 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
     }
   }
 
+  // The limited scan ran into versions that are not visible,
+  // scan again without the limit
+  if (scan_limit != 0 && tuple_location_ptrs.size() == scan_limit) {
+    size_t visible_tuple_count = 0;
+    for (auto &tuples : visible_tuples) {
+      visible_tuple_count += tuples.second.size();
+    }
+
+    if (visible_tuple_count < scan_limit) {
+      limit_ = 0;
+      return ExecPrimaryIndexLookup();
+    }
+  }
+
   // Construct a logical tile for each block
   for (auto tuples : visible_tuples) {
     auto &manager = catalog::Manager::GetInstance();
@@ -293,6 +338,54 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
   return true;
 }
 
+void IndexScanExecutor::UnlinkOlderVersions(
+    const ItemPointer &visible_location,
+    std::vector<ItemPointer> &garbage_tuples) {
+  auto &manager = catalog::Manager::GetInstance();
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+
+  auto tile_group_header =
+      manager.GetTileGroup(visible_location.block)->GetHeader();
+  ItemPointer old_item =
+      tile_group_header->GetPrevItemPointer(visible_location.offset);
+  if (old_item.IsNull()) return;
+
+  auto old_tile_group_header = manager.GetTileGroup(old_item.block)->GetHeader();
+  cid_t max_committed_cid = transaction_manager.GetMaxCommittedCid();
+
+  // the older version is visible to some running transaction
+  if (old_tile_group_header->GetEndCommitId(old_item.offset) >
+      max_committed_cid) {
+    return;
+  }
+
+  // whoever claims the older version cuts the chain there
+  if (old_tile_group_header->SetAtomicTransactionId(old_item.offset,
+                                                    INVALID_TXN_ID) == false) {
+    return;
+  }
+
+  tile_group_header->SetPrevItemPointer(visible_location.offset,
+                                        INVALID_ITEMPOINTER);
+
+  // every version behind it ended even earlier
+  while (true) {
+    garbage_tuples.push_back(old_item);
+    old_tile_group_header->SetNextItemPointer(old_item.offset,
+                                              INVALID_ITEMPOINTER);
+
+    old_item = old_tile_group_header->GetPrevItemPointer(old_item.offset);
+    if (old_item.IsNull()) break;
+
+    old_tile_group_header = manager.GetTileGroup(old_item.block)->GetHeader();
+    if (old_tile_group_header->SetAtomicTransactionId(
+            old_item.offset, INVALID_TXN_ID) == false) {
+      break;
+    }
+  }
+}
+
 bool IndexScanExecutor::ExecSecondaryIndexLookup() {
   assert(!done_);
 
@@ -300,11 +393,14 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
 
   assert(index_->GetIndexType() != INDEX_CONSTRAINT_TYPE_PRIMARY_KEY);
 
+  // Without a predicate, the first visible entries are all we need
+  size_t scan_limit = (predicate_ == nullptr) ? limit_ : 0;
+
   if (0 == key_column_ids_.size()) {
     index_->ScanAllKeys(tuple_locations);
   } else {
     index_->Scan(values_, key_column_ids_, expr_types_,
-                 SCAN_DIRECTION_TYPE_FORWARD, tuple_locations);
+                 SCAN_DIRECTION_TYPE_FORWARD, tuple_locations, scan_limit);
   }
 
   LOG_TRACE("Tuple_locations.size(): %lu", tuple_locations.size());
@@ -349,6 +445,20 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
       }
     }
   }
+  // The limited scan ran into versions that are not visible,
+  // scan again without the limit
+  if (scan_limit != 0 && tuple_locations.size() == scan_limit) {
+    size_t visible_tuple_count = 0;
+    for (auto &tuples : visible_tuples) {
+      visible_tuple_count += tuples.second.size();
+    }
+
+    if (visible_tuple_count < scan_limit) {
+      limit_ = 0;
+      return ExecSecondaryIndexLookup();
+    }
+  }
+
   // Construct a logical tile for each block
   for (auto tuples : visible_tuples) {
     auto &manager = catalog::Manager::GetInstance();
@@ -47,6 +47,11 @@ class IndexScanExecutor : public AbstractScanExecutor {
   bool ExecPrimaryIndexLookup();
   bool ExecSecondaryIndexLookup();
 
+  // Newest-to-oldest chains: cut the versions that no transaction can see
+  // anymore off the end of the chain and collect them for the GC.
+  void UnlinkOlderVersions(const ItemPointer &visible_location,
+                           std::vector<ItemPointer> &garbage_tuples);
+
   //===--------------------------------------------------------------------===//
   // Executor State
   //===--------------------------------------------------------------------===//
@@ -81,6 +86,9 @@ class IndexScanExecutor : public AbstractScanExecutor {
 
   std::vector<oid_t> full_column_ids_;
 
+  /** @brief number of visible tuples needed, zero if unbounded. */
+  size_t limit_ = 0;
+
   bool key_ready_ = false;
 };
 
@@ -12,16 +12,22 @@
 
 #include "backend/executor/seq_scan_executor.h"
 
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
 #include <memory>
+#include <mutex>
 #include <utility>
 #include <vector>
 
 #include "backend/common/types.h"
+#include "backend/common/thread_manager.h"
 #include "backend/executor/logical_tile.h"
 #include "backend/executor/logical_tile_factory.h"
 #include "backend/executor/executor_context.h"
 #include "backend/expression/abstract_expression.h"
 #include "backend/expression/container_tuple.h"
+#include "backend/expression/vectorized_predicate.h"
 #include "backend/storage/data_table.h"
 #include "backend/storage/tile_group_header.h"
 #include "backend/storage/tile.h"
@@ -32,6 +38,43 @@
 namespace peloton {
 namespace executor {
 
+/**
+ * @brief The morsels of a parallel scan are whole tile groups. They are
+ * handed out in order, and the workers may only run a few tile groups ahead
+ * of the one the executor returns next. Workers never wait: they go back to
+ * the pool when they run out of tile groups and the executor hands out
+ * more as it moves on. The executor scans a tile group itself if no worker
+ * took it yet.
+ */
+struct SeqScanExecutor::ParallelScanState {
+  std::mutex mutex;
+  std::condition_variable condition;
+
+  /** @brief Next tile group to hand out. */
+  oid_t next_tile_group_offset = START_OID;
+
+  /** @brief Next tile group to return. */
+  oid_t consumer_tile_group_offset = START_OID;
+
+  /** @brief How far ahead of the executor the workers may run. */
+  oid_t window_size = 0;
+
+  /** @brief Tile groups scanned by the workers, by tile group offset. */
+  std::vector<std::shared_ptr<storage::TileGroup>> tile_groups;
+  std::vector<std::vector<oid_t>> position_lists;
+  std::vector<bool> scanned;
+
+  /** @brief Workers stop taking tile groups. */
+  bool stopped = false;
+
+  size_t worker_count = 0;
+
+  size_t running_worker_count = 0;
+
+  /** @brief Error raised by a worker, rethrown by the executor. */
+  std::exception_ptr error;
+};
+
 /**
  * @brief Constructor for seqscan executor.
  * @param node Seqscan node corresponding to this executor.
@@ -40,6 +83,11 @@ SeqScanExecutor::SeqScanExecutor(const planner::AbstractPlan *node,
                                  ExecutorContext *executor_context)
     : AbstractScanExecutor(node, executor_context) {}
 
+SeqScanExecutor::~SeqScanExecutor() {
+  // The workers use the predicate and the table
+  StopParallelScan();
+}
+
 /**
  * @brief Let base class DInit() first, then do mine.
  * @return true on success, false otherwise.
@@ -49,6 +97,8 @@ bool SeqScanExecutor::DInit() {
 
   if (!status) return false;
 
+  StopParallelScan();
+
   // Grab data from plan node.
   const planner::SeqScanPlan &node = GetPlanNode<planner::SeqScanPlan>();
 
@@ -56,6 +106,8 @@ bool SeqScanExecutor::DInit() {
 
   current_tile_group_offset_ = START_OID;
 
+  parallelism_ = node.GetParallelism();
+
   if (target_table_ != nullptr) {
     table_tile_group_count_ = target_table_->GetTileGroupCount();
 
@@ -63,6 +115,16 @@ bool SeqScanExecutor::DInit() {
       column_ids_.resize(target_table_->GetSchema()->GetColumnCount());
       std::iota(column_ids_.begin(), column_ids_.end(), 0);
     }
+
+    // Evaluate the predicate a column at a time when we can.
+    // The rollback segment protocol keeps the visible values out of the
+    // tile, so its tuples are always evaluated one at a time.
+    if (predicate_ != nullptr &&
+        concurrency::TransactionManagerFactory::GetProtocol() !=
+            CONCURRENCY_TYPE_OCC_RB) {
+      vectorized_predicate_.reset(expression::VectorizedPredicate::Compile(
+          predicate_, target_table_->GetSchema(), executor_context_));
+    }
   }
 
   return true;
@@ -113,54 +175,30 @@ bool SeqScanExecutor::DExecute() {
     assert(target_table_ != nullptr);
     assert(column_ids_.size() > 0);
 
-    // Force to use occ txn manager if dirty read is forbidden
-    concurrency::TransactionManager &transaction_manager =
-        concurrency::TransactionManagerFactory::GetInstance();
-
-    // LOG_TRACE("Number of tuples: %f",
-    // target_table_->GetIndex(0)->GetNumberOfTuples());
+    // Hand the tile groups out to the workers
+    if (parallelism_ > 1 && table_tile_group_count_ > 1 &&
+        parallel_scan_state_ == nullptr) {
+      StartParallelScan();
+    }
 
     // Retrieve next tile group.
     while (current_tile_group_offset_ < table_tile_group_count_) {
-      auto tile_group =
-          target_table_->GetTileGroup(current_tile_group_offset_++);
-      auto tile_group_header = tile_group->GetHeader();
-
-      oid_t active_tuple_count = tile_group->GetNextTupleSlot();
-
+      std::shared_ptr<storage::TileGroup> tile_group;
 
       // Construct position list by looping through tile group
       // and applying the predicate.
       std::vector<oid_t> position_list;
-      for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
-
-        ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
-
-        // check transaction visibility
-        if (transaction_manager.IsVisible(tile_group_header, tuple_id)) {
-          // if the tuple is visible, then perform predicate evaluation.
-          if (predicate_ == nullptr) {
-            position_list.push_back(tuple_id);
-            auto res = transaction_manager.PerformRead(location);
-            if (!res) {
-              transaction_manager.SetTransactionResult(RESULT_FAILURE);
-              return res;
-            }
-          } else {
-            expression::ContainerTuple<storage::TileGroup> tuple(
-                tile_group.get(), tuple_id);
-            auto eval = predicate_->Evaluate(&tuple, nullptr, executor_context_)
-                            .IsTrue();
-            if (eval == true) {
-              position_list.push_back(tuple_id);
-              auto res = transaction_manager.PerformRead(location);
-              if (!res) {
-                transaction_manager.SetTransactionResult(RESULT_FAILURE);
-                return res;
-              }
-            }
-          }
-        }
+
+      if (parallel_scan_state_ != nullptr) {
+        GetNextParallelMorsel(tile_group, position_list);
+      } else {
+        tile_group = target_table_->GetTileGroup(current_tile_group_offset_++);
+        SelectTuples(tile_group.get(), position_list);
+      }
+
+      // The read set of the transaction is only updated by this thread
+      if (ReadTuples(tile_group.get(), position_list) == false) {
+        return false;
       }
 
       // Don't return empty tiles
@@ -181,5 +219,226 @@ bool SeqScanExecutor::DExecute() {
   return false;
 }
 
+/**
+ * @brief Collects the tuples of the tile group that are visible to the
+ * current transaction and satisfy the predicate.
+ */
+void SeqScanExecutor::SelectTuples(storage::TileGroup *tile_group,
+                                   std::vector<oid_t> &position_list) const {
+  concurrency::TransactionManager &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+
+  auto tile_group_header = tile_group->GetHeader();
+  oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+
+  if (vectorized_predicate_ != nullptr) {
+    // Collect the visible tuples first, then filter them a column at a
+    // time
+    for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+      if (transaction_manager.IsVisible(tile_group_header, tuple_id)) {
+        position_list.push_back(tuple_id);
+      }
+    }
+
+    vectorized_predicate_->Evaluate(tile_group, position_list);
+    return;
+  }
+
+  for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+    // check transaction visibility
+    if (transaction_manager.IsVisible(tile_group_header, tuple_id) == false) {
+      continue;
+    }
+
+    // if the tuple is visible, then perform predicate evaluation.
+    if (predicate_ != nullptr) {
+      expression::ContainerTuple<storage::TileGroup> tuple(tile_group,
+                                                           tuple_id);
+      auto eval =
+          predicate_->Evaluate(&tuple, nullptr, executor_context_).IsTrue();
+      if (eval == false) {
+        continue;
+      }
+    }
+
+    position_list.push_back(tuple_id);
+  }
+}
+
+/**
+ * @brief Records the reads of the selected tuples with the transaction.
+ * @return false if the transaction has to abort.
+ */
+bool SeqScanExecutor::ReadTuples(
+    storage::TileGroup *tile_group,
+    const std::vector<oid_t> &position_list) const {
+  concurrency::TransactionManager &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+
+  for (oid_t tuple_id : position_list) {
+    ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
+    auto res = transaction_manager.PerformRead(location);
+    if (!res) {
+      transaction_manager.SetTransactionResult(RESULT_FAILURE);
+      return res;
+    }
+  }
+
+  return true;
+}
+
+//===--------------------------------------------------------------------===//
+// Parallel Scan
+//===--------------------------------------------------------------------===//
+
+void SeqScanExecutor::StartParallelScan() {
+  parallel_scan_state_.reset(new ParallelScanState());
+  auto &state = *parallel_scan_state_;
+
+  state.next_tile_group_offset = current_tile_group_offset_;
+  state.consumer_tile_group_offset = current_tile_group_offset_;
+  state.worker_count = std::min(parallelism_, (size_t)table_tile_group_count_);
+  state.window_size = 2 * state.worker_count;
+  state.tile_groups.resize(table_tile_group_count_);
+  state.position_lists.resize(table_tile_group_count_);
+  state.scanned.resize(table_tile_group_count_, false);
+
+  LOG_TRACE("Parallel seq scan with %lu workers", state.worker_count);
+
+  std::lock_guard<std::mutex> lock(state.mutex);
+  SubmitWorkers();
+}
+
+/**
+ * @brief Puts workers on the tile groups in the window that are not handed
+ * out yet. The state must be locked.
+ */
+void SeqScanExecutor::SubmitWorkers() {
+  auto state = parallel_scan_state_;
+
+  // The workers check visibility with the calling transaction
+  auto transaction = concurrency::current_txn;
+
+  oid_t window_end =
+      std::min(table_tile_group_count_,
+               state->consumer_tile_group_offset + state->window_size);
+  size_t idle_tile_group_count =
+      (state->next_tile_group_offset < window_end)
+          ? window_end - state->next_tile_group_offset
+          : 0;
+
+  while (state->running_worker_count < state->worker_count &&
+         state->running_worker_count < idle_tile_group_count) {
+    state->running_worker_count++;
+    ThreadPool::GetWorkerInstance().AddTask([this, state, transaction] {
+      ScanMorsels(this, state, transaction);
+    });
+  }
+}
+
+void SeqScanExecutor::StopParallelScan() {
+  if (parallel_scan_state_ == nullptr) return;
+
+  // Wait for the running workers to finish their tile groups
+  {
+    std::unique_lock<std::mutex> lock(parallel_scan_state_->mutex);
+    parallel_scan_state_->stopped = true;
+    parallel_scan_state_->condition.wait(lock, [this] {
+      return parallel_scan_state_->running_worker_count == 0;
+    });
+  }
+
+  parallel_scan_state_.reset();
+}
+
+/**
+ * @brief Gets the next tile group from the workers, or scans it here if
+ * no worker took it yet.
+ */
+void SeqScanExecutor::GetNextParallelMorsel(
+    std::shared_ptr<storage::TileGroup> &tile_group,
+    std::vector<oid_t> &position_list) {
+  auto &state = *parallel_scan_state_;
+  oid_t tile_group_offset = current_tile_group_offset_++;
+
+  std::unique_lock<std::mutex> lock(state.mutex);
+
+  if (state.next_tile_group_offset == tile_group_offset) {
+    state.next_tile_group_offset++;
+    lock.unlock();
+
+    tile_group = target_table_->GetTileGroup(tile_group_offset);
+    SelectTuples(tile_group.get(), position_list);
+
+    lock.lock();
+  } else {
+    // A worker is on it
+    state.condition.wait(lock, [&state, tile_group_offset] {
+      return state.scanned[tile_group_offset] == true ||
+             state.error != nullptr;
+    });
+
+    if (state.error != nullptr) {
+      std::rethrow_exception(state.error);
+    }
+
+    tile_group = std::move(state.tile_groups[tile_group_offset]);
+    position_list = std::move(state.position_lists[tile_group_offset]);
+  }
+
+  // Move the window on
+  state.consumer_tile_group_offset = current_tile_group_offset_;
+  SubmitWorkers();
+}
+
+/**
+ * @brief Runs on the workers, scans tile groups until the window is full.
+ */
+void SeqScanExecutor::ScanMorsels(const SeqScanExecutor *executor,
+                                  std::shared_ptr<ParallelScanState> state,
+                                  concurrency::Transaction *transaction) {
+  auto previous_transaction = concurrency::current_txn;
+  concurrency::current_txn = transaction;
+
+  std::unique_lock<std::mutex> lock(state->mutex);
+
+  while (state->stopped == false &&
+         state->next_tile_group_offset < executor->table_tile_group_count_ &&
+         state->next_tile_group_offset <
+             state->consumer_tile_group_offset + state->window_size) {
+    oid_t tile_group_offset = state->next_tile_group_offset++;
+    lock.unlock();
+
+    auto tile_group = executor->target_table_->GetTileGroup(tile_group_offset);
+    std::vector<oid_t> position_list;
+    std::exception_ptr error;
+
+    try {
+      executor->SelectTuples(tile_group.get(), position_list);
+    } catch (...) {
+      error = std::current_exception();
+    }
+
+    lock.lock();
+
+    if (error != nullptr) {
+      state->error = error;
+      state->stopped = true;
+    } else {
+      state->tile_groups[tile_group_offset] = std::move(tile_group);
+      state->position_lists[tile_group_offset] = std::move(position_list);
+      state->scanned[tile_group_offset] = true;
+    }
+
+    state->condition.notify_all();
+  }
+
+  concurrency::current_txn = previous_transaction;
+
+  // The executor may go away once no workers are running
+  state->running_worker_count--;
+  state->condition.notify_all();
+}
+
 }  // namespace executor
 }  // namespace peloton
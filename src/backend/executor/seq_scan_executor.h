@@ -12,8 +12,12 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "backend/planner/seq_scan_plan.h"
 #include "backend/executor/abstract_scan_executor.h"
+#include "backend/expression/vectorized_predicate.h"
 
 namespace peloton {
 namespace executor {
@@ -28,12 +32,39 @@ class SeqScanExecutor : public AbstractScanExecutor {
   explicit SeqScanExecutor(const planner::AbstractPlan *node,
                            ExecutorContext *executor_context);
 
+  ~SeqScanExecutor();
+
  protected:
   bool DInit();
 
   bool DExecute();
 
  private:
+  //===--------------------------------------------------------------------===//
+  // Helper Functions
+  //===--------------------------------------------------------------------===//
+
+  void SelectTuples(storage::TileGroup *tile_group,
+                    std::vector<oid_t> &position_list) const;
+
+  bool ReadTuples(storage::TileGroup *tile_group,
+                  const std::vector<oid_t> &position_list) const;
+
+  void StartParallelScan();
+
+  void SubmitWorkers();
+
+  void StopParallelScan();
+
+  void GetNextParallelMorsel(std::shared_ptr<storage::TileGroup> &tile_group,
+                             std::vector<oid_t> &position_list);
+
+  struct ParallelScanState;
+
+  static void ScanMorsels(const SeqScanExecutor *executor,
+                          std::shared_ptr<ParallelScanState> state,
+                          concurrency::Transaction *transaction);
+
   //===--------------------------------------------------------------------===//
   // Executor State
   //===--------------------------------------------------------------------===//
@@ -44,12 +75,21 @@ class SeqScanExecutor : public AbstractScanExecutor {
   /** @brief Keeps track of the number of tile groups to scan. */
   oid_t table_tile_group_count_ = INVALID_OID;
 
+  /** @brief Tile groups handed out to the workers of a parallel scan. */
+  std::shared_ptr<ParallelScanState> parallel_scan_state_;
+
   //===--------------------------------------------------------------------===//
   // Plan Info
   //===--------------------------------------------------------------------===//
 
   /** @brief Pointer to table to scan from. */
   storage::DataTable *target_table_ = nullptr;
+
+  /** @brief Predicate evaluated a column at a time, if it can be. */
+  std::unique_ptr<expression::VectorizedPredicate> vectorized_predicate_;
+
+  /** @brief Number of workers scanning the tile groups. */
+  size_t parallelism_ = 1;
 };
 
 }  // namespace executor
@@ -55,6 +55,30 @@ bool UpdateExecutor::DInit() {
   return true;
 }
 
+/**
+ * @brief Overwrites the columns in the target list of the tuple, the columns
+ * that are mapped directly stay untouched.
+ */
+void UpdateExecutor::UpdateInPlace(storage::TileGroup *tile_group,
+                                   const oid_t tuple_id) {
+  expression::ContainerTuple<storage::TileGroup> old_tuple(tile_group,
+                                                           tuple_id);
+  auto &target_list = project_info_->GetTargetList();
+
+  // All the targets see the old values, evaluate them before writing any
+  std::vector<Value> values;
+  values.reserve(target_list.size());
+  for (auto &target : target_list) {
+    values.push_back(
+        target.second->Evaluate(&old_tuple, nullptr, executor_context_));
+  }
+
+  for (size_t target_itr = 0; target_itr < target_list.size(); target_itr++) {
+    tile_group->SetValue(values[target_itr], tuple_id,
+                         target_list[target_itr].first);
+  }
+}
+
 /**
  * @brief updates a set of columns
  * @return true on success, false otherwise.
@@ -99,35 +123,35 @@ bool UpdateExecutor::DExecute() {
       // Make a copy of the original tuple and allocate a new tuple
       expression::ContainerTuple<storage::TileGroup> old_tuple(
           tile_group, physical_tuple_id);
-      // Create a temp copy
-      std::unique_ptr<storage::Tuple> new_tuple(new storage::Tuple(target_table_->GetSchema(), true));
-      // Execute the projections
-      // FIXME: reduce memory copy by doing inplace update
-      project_info_->Evaluate(new_tuple.get(), &old_tuple, nullptr,
-                              executor_context_);
 
       // Check if we are using rollback segment
       if (concurrency_protocol == CONCURRENCY_TYPE_OCC_RB) {
         auto rb_txn_manager = (concurrency::OptimisticRbTxnManager*)&transaction_manager;
 
         if (rb_txn_manager->IsInserted(tile_group_header, physical_tuple_id) == false) {
-          // If it's not an inserted tuple,
-          // create a new rollback segment based on the old one and the old tuple
+          // If it's not an inserted tuple, save the columns that our
+          // earlier rollback segments don't hold yet
           auto rb_seg = rb_txn_manager->GetSegmentPool()->CreateSegmentFromTuple(
-            schema, project_info_->GetTargetList(), &old_tuple);
+            schema, project_info_->GetTargetList(), &old_tuple,
+            rb_txn_manager->GetRbSeg(tile_group_header, physical_tuple_id));
 
-          // TODO: rb_seg == nullptr may be resulted from an optimization to be done
-          // when creating rollback segment
+          // rb_seg is nullptr if all the columns are saved already
           if (rb_seg != nullptr) {
             // Ask the txn manager to add the a new rollback segment
             rb_txn_manager->PerformUpdateWithRb(old_location, rb_seg);
           }
         }
 
-        // Overwrite the master copy
-        tile_group->CopyTuple(new_tuple.get(), physical_tuple_id);
+        // Overwrite the updated columns of the master copy
+        UpdateInPlace(tile_group, physical_tuple_id);
 
       } else {
+        // Create a temp copy
+        std::unique_ptr<storage::Tuple> new_tuple(new storage::Tuple(target_table_->GetSchema(), true));
+        // Execute the projections
+        project_info_->Evaluate(new_tuple.get(), &old_tuple, nullptr,
+                                executor_context_);
+
         // Current rb segment is OK, just overwrite the tuple in place
         tile_group->CopyTuple(new_tuple.get(), physical_tuple_id);
         transaction_manager.PerformUpdate(old_location);
@@ -146,29 +170,32 @@ bool UpdateExecutor::DExecute() {
       }
       // if it is the latest version and not locked by other threads, then
       // insert a new version.
-      std::unique_ptr<storage::Tuple> new_tuple(new storage::Tuple(target_table_->GetSchema(), true));
 
       // Make a copy of the original tuple and allocate a new tuple
       expression::ContainerTuple<storage::TileGroup> old_tuple(
           tile_group, physical_tuple_id);
-      // Execute the projections
-      project_info_->Evaluate(new_tuple.get(), &old_tuple, nullptr,
-                              executor_context_);
 
       if ( concurrency_protocol == CONCURRENCY_TYPE_OCC_RB) {
         // For rollback segment implementation
         auto rb_txn_manager = (concurrency::OptimisticRbTxnManager*)&transaction_manager;
 
-        // Create a rollback segment based on the old tuple
+        // Create a rollback segment based on the old tuple, it only holds
+        // the before image of the updated columns
         auto rb_seg = rb_txn_manager->GetSegmentPool()->CreateSegmentFromTuple(
           schema, project_info_->GetTargetList(), &old_tuple);
 
         // Ask the txn manager to append the rollback segment
         rb_txn_manager->PerformUpdateWithRb(old_location, rb_seg);
 
-        // Overwrite the master copy
-        tile_group->CopyTuple(new_tuple.get(), old_location.offset);
+        // Overwrite the updated columns of the master copy
+        UpdateInPlace(tile_group, old_location.offset);
       } else {
+        std::unique_ptr<storage::Tuple> new_tuple(new storage::Tuple(target_table_->GetSchema(), true));
+
+        // Execute the projections
+        project_info_->Evaluate(new_tuple.get(), &old_tuple, nullptr,
+                                executor_context_);
+
         // finally insert updated tuple into the table
         ItemPointer new_location = target_table_->InsertVersion(new_tuple.get());
 
@@ -35,6 +35,10 @@ class UpdateExecutor : public AbstractExecutor {
   bool DExecute();
 
  private:
+  // Rollback segment protocol: write the new values of the updated columns
+  // onto the master copy
+  void UpdateInPlace(storage::TileGroup *tile_group, const oid_t tuple_id);
+
   storage::DataTable *target_table_ = nullptr;
   const planner::ProjectInfo *project_info_ = nullptr;
 };
@@ -0,0 +1,326 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// simd_filter.cpp
+//
+// Identification: src/backend/expression/simd_filter.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "backend/expression/simd_filter.h"
+
+#include <algorithm>
+
+#include <immintrin.h>
+
+namespace peloton {
+namespace expression {
+
+namespace {
+
+// Append the offsets of the values whose bits are set in the mask
+inline size_t AppendPositions(uint32_t mask, const oid_t base,
+                              oid_t *positions) {
+  size_t count = 0;
+  while (mask != 0) {
+    positions[count++] = base + __builtin_ctz(mask);
+    mask &= mask - 1;
+  }
+  return count;
+}
+
+//===--------------------------------------------------------------------===//
+// Scalar kernels
+//===--------------------------------------------------------------------===//
+
+template <typename T>
+size_t FilterRangeScalar(const T *column, const oid_t begin, const oid_t end,
+                         const T lower, const T upper, oid_t *positions) {
+  size_t count = 0;
+  for (oid_t offset = begin; offset < end; offset++) {
+    T value = column[offset];
+    positions[count] = offset;
+    count += (value >= lower) & (value <= upper);
+  }
+  return count;
+}
+
+template <int LowerType, int UpperType>
+size_t FilterDoubleRangeScalar(const double *column, const oid_t begin,
+                               const oid_t end, const double lower,
+                               const double upper, oid_t *positions) {
+  size_t count = 0;
+  for (oid_t offset = begin; offset < end; offset++) {
+    positions[count] = offset;
+    count += SimdFilter::InRange(column[offset], (RangeBoundType)LowerType,
+                                 lower, (RangeBoundType)UpperType, upper);
+  }
+  return count;
+}
+
+//===--------------------------------------------------------------------===//
+// SSE4.2 kernels
+//===--------------------------------------------------------------------===//
+
+__attribute__((target("sse4.2"))) size_t FilterRangeSse42(
+    const int32_t *column, const oid_t begin, const oid_t end,
+    const int32_t lower, const int32_t upper, oid_t *positions) {
+  const __m128i lower_vector = _mm_set1_epi32(lower);
+  const __m128i upper_vector = _mm_set1_epi32(upper);
+
+  size_t count = 0;
+  oid_t offset = begin;
+  for (; offset + 4 <= end; offset += 4) {
+    __m128i values =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(column + offset));
+    __m128i outside = _mm_or_si128(_mm_cmpgt_epi32(lower_vector, values),
+                                   _mm_cmpgt_epi32(values, upper_vector));
+    uint32_t mask = ~_mm_movemask_ps(_mm_castsi128_ps(outside)) & 0xF;
+    count += AppendPositions(mask, offset, positions + count);
+  }
+
+  return count + FilterRangeScalar(column, offset, end, lower, upper,
+                                   positions + count);
+}
+
+__attribute__((target("sse4.2"))) size_t FilterRangeSse42(
+    const int64_t *column, const oid_t begin, const oid_t end,
+    const int64_t lower, const int64_t upper, oid_t *positions) {
+  const __m128i lower_vector = _mm_set1_epi64x(lower);
+  const __m128i upper_vector = _mm_set1_epi64x(upper);
+
+  size_t count = 0;
+  oid_t offset = begin;
+  for (; offset + 2 <= end; offset += 2) {
+    __m128i values =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(column + offset));
+    __m128i outside = _mm_or_si128(_mm_cmpgt_epi64(lower_vector, values),
+                                   _mm_cmpgt_epi64(values, upper_vector));
+    uint32_t mask = ~_mm_movemask_pd(_mm_castsi128_pd(outside)) & 0x3;
+    count += AppendPositions(mask, offset, positions + count);
+  }
+
+  return count + FilterRangeScalar(column, offset, end, lower, upper,
+                                   positions + count);
+}
+
+template <int LowerType, int UpperType>
+__attribute__((target("sse4.2"))) size_t FilterDoubleRangeSse42(
+    const double *column, const oid_t begin, const oid_t end,
+    const double lower, const double upper, oid_t *positions) {
+  const __m128d null_vector = _mm_set1_pd(DOUBLE_NULL);
+  const __m128d lower_vector = _mm_set1_pd(lower);
+  const __m128d upper_vector = _mm_set1_pd(upper);
+
+  size_t count = 0;
+  oid_t offset = begin;
+  for (; offset + 2 <= end; offset += 2) {
+    __m128d values = _mm_loadu_pd(column + offset);
+
+    // The unordered comparisons hold for NaN, the ordered ones don't
+    __m128d inside = _mm_cmpnle_pd(values, null_vector);
+    if (LowerType == RANGE_BOUND_INCLUSIVE) {
+      inside = _mm_and_pd(inside, _mm_cmpge_pd(values, lower_vector));
+    } else if (LowerType == RANGE_BOUND_EXCLUSIVE) {
+      inside = _mm_and_pd(inside, _mm_cmpgt_pd(values, lower_vector));
+    }
+    if (UpperType == RANGE_BOUND_INCLUSIVE) {
+      inside = _mm_and_pd(inside, _mm_cmpngt_pd(values, upper_vector));
+    } else if (UpperType == RANGE_BOUND_EXCLUSIVE) {
+      inside = _mm_and_pd(inside, _mm_cmpnge_pd(values, upper_vector));
+    }
+
+    uint32_t mask = _mm_movemask_pd(inside);
+    count += AppendPositions(mask, offset, positions + count);
+  }
+
+  return count + FilterDoubleRangeScalar<LowerType, UpperType>(
+                     column, offset, end, lower, upper, positions + count);
+}
+
+//===--------------------------------------------------------------------===//
+// AVX2 kernels
+//===--------------------------------------------------------------------===//
+
+__attribute__((target("avx2"))) size_t FilterRangeAvx2(
+    const int32_t *column, const oid_t begin, const oid_t end,
+    const int32_t lower, const int32_t upper, oid_t *positions) {
+  const __m256i lower_vector = _mm256_set1_epi32(lower);
+  const __m256i upper_vector = _mm256_set1_epi32(upper);
+
+  size_t count = 0;
+  oid_t offset = begin;
+  for (; offset + 8 <= end; offset += 8) {
+    __m256i values = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i *>(column + offset));
+    __m256i outside =
+        _mm256_or_si256(_mm256_cmpgt_epi32(lower_vector, values),
+                        _mm256_cmpgt_epi32(values, upper_vector));
+    uint32_t mask = ~_mm256_movemask_ps(_mm256_castsi256_ps(outside)) & 0xFF;
+    count += AppendPositions(mask, offset, positions + count);
+  }
+
+  return count + FilterRangeScalar(column, offset, end, lower, upper,
+                                   positions + count);
+}
+
+__attribute__((target("avx2"))) size_t FilterRangeAvx2(
+    const int64_t *column, const oid_t begin, const oid_t end,
+    const int64_t lower, const int64_t upper, oid_t *positions) {
+  const __m256i lower_vector = _mm256_set1_epi64x(lower);
+  const __m256i upper_vector = _mm256_set1_epi64x(upper);
+
+  size_t count = 0;
+  oid_t offset = begin;
+  for (; offset + 4 <= end; offset += 4) {
+    __m256i values = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i *>(column + offset));
+    __m256i outside =
+        _mm256_or_si256(_mm256_cmpgt_epi64(lower_vector, values),
+                        _mm256_cmpgt_epi64(values, upper_vector));
+    uint32_t mask = ~_mm256_movemask_pd(_mm256_castsi256_pd(outside)) & 0xF;
+    count += AppendPositions(mask, offset, positions + count);
+  }
+
+  return count + FilterRangeScalar(column, offset, end, lower, upper,
+                                   positions + count);
+}
+
+template <int LowerType, int UpperType>
+__attribute__((target("avx2"))) size_t FilterDoubleRangeAvx2(
+    const double *column, const oid_t begin, const oid_t end,
+    const double lower, const double upper, oid_t *positions) {
+  const __m256d null_vector = _mm256_set1_pd(DOUBLE_NULL);
+  const __m256d lower_vector = _mm256_set1_pd(lower);
+  const __m256d upper_vector = _mm256_set1_pd(upper);
+
+  size_t count = 0;
+  oid_t offset = begin;
+  for (; offset + 4 <= end; offset += 4) {
+    __m256d values = _mm256_loadu_pd(column + offset);
+
+    // The unordered comparisons hold for NaN, the ordered ones don't
+    __m256d inside = _mm256_cmp_pd(values, null_vector, _CMP_NLE_UQ);
+    if (LowerType == RANGE_BOUND_INCLUSIVE) {
+      inside = _mm256_and_pd(inside,
+                             _mm256_cmp_pd(values, lower_vector, _CMP_GE_OQ));
+    } else if (LowerType == RANGE_BOUND_EXCLUSIVE) {
+      inside = _mm256_and_pd(inside,
+                             _mm256_cmp_pd(values, lower_vector, _CMP_GT_OQ));
+    }
+    if (UpperType == RANGE_BOUND_INCLUSIVE) {
+      inside = _mm256_and_pd(inside,
+                             _mm256_cmp_pd(values, upper_vector, _CMP_NGT_UQ));
+    } else if (UpperType == RANGE_BOUND_EXCLUSIVE) {
+      inside = _mm256_and_pd(inside,
+                             _mm256_cmp_pd(values, upper_vector, _CMP_NGE_UQ));
+    }
+
+    uint32_t mask = _mm256_movemask_pd(inside);
+    count += AppendPositions(mask, offset, positions + count);
+  }
+
+  return count + FilterDoubleRangeScalar<LowerType, UpperType>(
+                     column, offset, end, lower, upper, positions + count);
+}
+
+//===--------------------------------------------------------------------===//
+// Double kernel tables, indexed by instruction set and bound types
+//===--------------------------------------------------------------------===//
+
+typedef size_t (*DoubleRangeKernel)(const double *, const oid_t, const oid_t,
+                                    const double, const double, oid_t *);
+
+#define DOUBLE_RANGE_KERNELS(kernel)            \
+  {                                             \
+    {kernel<0, 0>, kernel<0, 1>, kernel<0, 2>}, \
+    {kernel<1, 0>, kernel<1, 1>, kernel<1, 2>}, \
+    {kernel<2, 0>, kernel<2, 1>, kernel<2, 2>}  \
+  }
+
+const DoubleRangeKernel double_range_kernels[3][3][3] = {
+    DOUBLE_RANGE_KERNELS(FilterDoubleRangeScalar),
+    DOUBLE_RANGE_KERNELS(FilterDoubleRangeSse42),
+    DOUBLE_RANGE_KERNELS(FilterDoubleRangeAvx2)};
+
+#undef DOUBLE_RANGE_KERNELS
+
+}  // namespace
+
+//===--------------------------------------------------------------------===//
+// SIMD Filter
+//===--------------------------------------------------------------------===//
+
+SimdLevel SimdFilter::simd_level_ = SimdFilter::DetectSimdLevel();
+
+SimdLevel SimdFilter::DetectSimdLevel() {
+  // May run before the constructors of libgcc
+  __builtin_cpu_init();
+
+  if (__builtin_cpu_supports("avx2")) {
+    return SIMD_LEVEL_AVX2;
+  } else if (__builtin_cpu_supports("sse4.2")) {
+    return SIMD_LEVEL_SSE42;
+  }
+
+  return SIMD_LEVEL_SCALAR;
+}
+
+void SimdFilter::SetSimdLevel(const SimdLevel simd_level) {
+  simd_level_ = std::min(simd_level, DetectSimdLevel());
+}
+
+size_t SimdFilter::FilterRange(const int32_t *column, const oid_t begin,
+                               const oid_t end, const int32_t lower,
+                               const int32_t upper, oid_t *positions) {
+  // The null sentinel is the smallest value
+  const int32_t non_null_lower = std::max(lower, INT32_NULL + 1);
+
+  switch (simd_level_) {
+    case SIMD_LEVEL_AVX2:
+      return FilterRangeAvx2(column, begin, end, non_null_lower, upper,
+                             positions);
+    case SIMD_LEVEL_SSE42:
+      return FilterRangeSse42(column, begin, end, non_null_lower, upper,
+                              positions);
+    case SIMD_LEVEL_SCALAR:
+    default:
+      return FilterRangeScalar(column, begin, end, non_null_lower, upper,
+                               positions);
+  }
+}
+
+size_t SimdFilter::FilterRange(const int64_t *column, const oid_t begin,
+                               const oid_t end, const int64_t lower,
+                               const int64_t upper, oid_t *positions) {
+  // The null sentinel is the smallest value
+  const int64_t non_null_lower = std::max(lower, INT64_NULL + 1);
+
+  switch (simd_level_) {
+    case SIMD_LEVEL_AVX2:
+      return FilterRangeAvx2(column, begin, end, non_null_lower, upper,
+                             positions);
+    case SIMD_LEVEL_SSE42:
+      return FilterRangeSse42(column, begin, end, non_null_lower, upper,
+                              positions);
+    case SIMD_LEVEL_SCALAR:
+    default:
+      return FilterRangeScalar(column, begin, end, non_null_lower, upper,
+                               positions);
+  }
+}
+
+size_t SimdFilter::FilterRange(const double *column, const oid_t begin,
+                               const oid_t end, const RangeBoundType lower_type,
+                               const double lower,
+                               const RangeBoundType upper_type,
+                               const double upper, oid_t *positions) {
+  auto kernel = double_range_kernels[simd_level_][lower_type][upper_type];
+  return kernel(column, begin, end, lower, upper, positions);
+}
+
+}  // End expression namespace
+}  // End peloton namespace
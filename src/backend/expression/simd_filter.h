@@ -0,0 +1,98 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// simd_filter.h
+//
+// Identification: src/backend/expression/simd_filter.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+
+#include "backend/common/types.h"
+
+namespace peloton {
+namespace expression {
+
+// Instruction sets the filter kernels can use
+enum SimdLevel {
+  SIMD_LEVEL_SCALAR = 0,
+  SIMD_LEVEL_SSE42 = 1,
+  SIMD_LEVEL_AVX2 = 2
+};
+
+// Bound of a range of doubles
+enum RangeBoundType {
+  RANGE_BOUND_NONE = 0,
+  RANGE_BOUND_INCLUSIVE = 1,
+  RANGE_BOUND_EXCLUSIVE = 2
+};
+
+//===--------------------------------------------------------------------===//
+// SIMD Filter
+//===--------------------------------------------------------------------===//
+
+/**
+ * Compare-and-compact kernels over densely packed fixed-width columns.
+ *
+ * Every kernel checks the values at [begin, end) of the column against a
+ * range, writes the offsets of the values within it to the position list
+ * and returns their number. =, <, <=, >, >= and BETWEEN are all ranges.
+ * Null values are never within a range.
+ *
+ * The instruction set is picked by CPU feature detection at startup,
+ * the scalar kernels are the fallback.
+ */
+class SimdFilter {
+ public:
+  // Integer ranges are inclusive on both ends
+  static size_t FilterRange(const int32_t *column, const oid_t begin,
+                            const oid_t end, const int32_t lower,
+                            const int32_t upper, oid_t *positions);
+
+  static size_t FilterRange(const int64_t *column, const oid_t begin,
+                            const oid_t end, const int64_t lower,
+                            const int64_t upper, oid_t *positions);
+
+  // NaN is ordered below every other double, as in Value
+  static size_t FilterRange(const double *column, const oid_t begin,
+                            const oid_t end, const RangeBoundType lower_type,
+                            const double lower, const RangeBoundType upper_type,
+                            const double upper, oid_t *positions);
+
+  // Check a single double against the range
+  static inline bool InRange(const double value, const RangeBoundType lower_type,
+                             const double lower,
+                             const RangeBoundType upper_type,
+                             const double upper) {
+    // null doubles are stored at or below the null sentinel
+    if (value <= DOUBLE_NULL) return false;
+
+    // NaN is below any lower bound but also below any upper bound
+    if (lower_type == RANGE_BOUND_INCLUSIVE && !(value >= lower)) return false;
+    if (lower_type == RANGE_BOUND_EXCLUSIVE && !(value > lower)) return false;
+    if (upper_type == RANGE_BOUND_INCLUSIVE && value > upper) return false;
+    if (upper_type == RANGE_BOUND_EXCLUSIVE && value >= upper) return false;
+
+    return true;
+  }
+
+  // Instruction set picked at startup
+  static SimdLevel GetSimdLevel() { return simd_level_; }
+
+  // Use a lower instruction set, the detected one is the highest allowed
+  static void SetSimdLevel(const SimdLevel simd_level);
+
+  static SimdLevel DetectSimdLevel();
+
+ private:
+  static SimdLevel simd_level_;
+};
+
+}  // End expression namespace
+}  // End peloton namespace
@@ -0,0 +1,550 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// vectorized_predicate.cpp
+//
+// Identification: src/backend/expression/vectorized_predicate.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "backend/expression/vectorized_predicate.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+#include "backend/catalog/schema.h"
+#include "backend/common/exception.h"
+#include "backend/common/logger.h"
+#include "backend/common/value_peeker.h"
+#include "backend/expression/abstract_expression.h"
+#include "backend/expression/tuple_value_expression.h"
+#include "backend/storage/tile.h"
+#include "backend/storage/tile_group.h"
+
+namespace peloton {
+namespace expression {
+
+namespace {
+
+//===--------------------------------------------------------------------===//
+// Comparison kernels
+//===--------------------------------------------------------------------===//
+
+// Null values are stored as sentinels, see Value::InitFromTupleStorage
+inline bool IsNullValue(int8_t value) { return value == INT8_NULL; }
+inline bool IsNullValue(int16_t value) { return value == INT16_NULL; }
+inline bool IsNullValue(int32_t value) { return value == INT32_NULL; }
+inline bool IsNullValue(int64_t value) { return value == INT64_NULL; }
+inline bool IsNullValue(double value) { return value <= DOUBLE_NULL; }
+
+// Keep the selected tuples whose column value passes the check.
+// The selection is compacted in place without branching on the outcome.
+template <typename ColumnType, class Check>
+void FilterColumn(const char *column, const size_t stride, const Check &check,
+                  std::vector<oid_t> &selection) {
+  size_t selected_count = 0;
+  const size_t selection_size = selection.size();
+
+  for (size_t selection_itr = 0; selection_itr < selection_size;
+       selection_itr++) {
+    oid_t tuple_id = selection[selection_itr];
+    ColumnType value =
+        *reinterpret_cast<const ColumnType *>(column + tuple_id * stride);
+
+    selection[selected_count] = tuple_id;
+    selected_count += check(value);
+  }
+
+  selection.resize(selected_count);
+}
+
+// The range excludes the null sentinel of the column type
+template <typename ColumnType>
+void FilterIntegerColumn(const char *column, const size_t stride,
+                         const bool not_equal, const int64_t lower,
+                         const int64_t upper, std::vector<oid_t> &selection) {
+  if (not_equal == true) {
+    FilterColumn<ColumnType>(column, stride, [lower](const ColumnType value) {
+      return (IsNullValue(value) == false) && (value != lower);
+    }, selection);
+  } else {
+    FilterColumn<ColumnType>(column, stride, [lower, upper](
+                                                 const ColumnType value) {
+      return (value >= lower) & (value <= upper);
+    }, selection);
+  }
+}
+
+void FilterDoubleColumn(const char *column, const size_t stride,
+                        const bool not_equal, const RangeBoundType lower_type,
+                        const double lower, const RangeBoundType upper_type,
+                        const double upper, std::vector<oid_t> &selection) {
+  if (not_equal == true) {
+    FilterColumn<double>(column, stride, [lower](const double value) {
+      return (IsNullValue(value) == false) && (value != lower);
+    }, selection);
+  } else {
+    FilterColumn<double>(column, stride, [=](const double value) {
+      return SimdFilter::InRange(value, lower_type, lower, upper_type, upper);
+    }, selection);
+  }
+}
+
+//===--------------------------------------------------------------------===//
+// Compilation helpers
+//===--------------------------------------------------------------------===//
+
+bool IsComparison(const ExpressionType expression_type) {
+  switch (expression_type) {
+    case EXPRESSION_TYPE_COMPARE_EQUAL:
+    case EXPRESSION_TYPE_COMPARE_NOTEQUAL:
+    case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+    case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+    case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+    case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// The comparison with its operands swapped
+ExpressionType CommuteComparison(const ExpressionType expression_type) {
+  switch (expression_type) {
+    case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+      return EXPRESSION_TYPE_COMPARE_GREATERTHAN;
+    case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+      return EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO;
+    case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+      return EXPRESSION_TYPE_COMPARE_LESSTHAN;
+    case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+      return EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO;
+    default:
+      return expression_type;
+  }
+}
+
+bool IsColumnReference(const AbstractExpression *expression) {
+  return expression->GetExpressionType() == EXPRESSION_TYPE_VALUE_TUPLE &&
+         static_cast<const TupleValueExpression *>(expression)
+                 ->GetTupleIdx() == 0;
+}
+
+bool IsConstant(const AbstractExpression *expression,
+                executor::ExecutorContext *context) {
+  switch (expression->GetExpressionType()) {
+    case EXPRESSION_TYPE_VALUE_CONSTANT:
+      return true;
+    case EXPRESSION_TYPE_VALUE_PARAMETER:
+      return (context != nullptr);
+    default:
+      return false;
+  }
+}
+
+bool IsIntegerType(const ValueType value_type) {
+  switch (value_type) {
+    case VALUE_TYPE_TINYINT:
+    case VALUE_TYPE_SMALLINT:
+    case VALUE_TYPE_INTEGER:
+    case VALUE_TYPE_BIGINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool IsDoubleType(const ValueType value_type) {
+  return (value_type == VALUE_TYPE_REAL || value_type == VALUE_TYPE_DOUBLE);
+}
+
+// Non-null values an integer column can hold
+void GetIntegerTypeRange(const ValueType value_type, int64_t &min_value,
+                         int64_t &max_value) {
+  switch (value_type) {
+    case VALUE_TYPE_TINYINT:
+      min_value = INT8_NULL + 1;
+      max_value = INT8_MAX;
+      break;
+    case VALUE_TYPE_SMALLINT:
+      min_value = INT16_NULL + 1;
+      max_value = INT16_MAX;
+      break;
+    case VALUE_TYPE_INTEGER:
+      min_value = INT32_NULL + 1;
+      max_value = INT32_MAX;
+      break;
+    case VALUE_TYPE_BIGINT:
+    default:
+      min_value = INT64_NULL + 1;
+      max_value = INT64_MAX;
+      break;
+  }
+}
+
+// Convert a whole double to an integer bound, leaving room to step past it
+int64_t ClampToBigInt(const double value) {
+  const double limit = 9e18;
+  if (value <= -limit) return -(int64_t)limit;
+  if (value >= limit) return (int64_t)limit;
+  return (int64_t)value;
+}
+
+}  // namespace
+
+//===--------------------------------------------------------------------===//
+// Vectorized Predicate
+//===--------------------------------------------------------------------===//
+
+VectorizedPredicate *VectorizedPredicate::Compile(
+    const AbstractExpression *predicate, const catalog::Schema *schema,
+    executor::ExecutorContext *context) {
+  if (predicate == nullptr) return nullptr;
+
+  std::unique_ptr<VectorizedPredicate> vectorized_predicate(
+      new VectorizedPredicate());
+  auto expression_type = predicate->GetExpressionType();
+  vectorized_predicate->expression_type = expression_type;
+
+  // Conjunction
+  if (expression_type == EXPRESSION_TYPE_CONJUNCTION_AND ||
+      expression_type == EXPRESSION_TYPE_CONJUNCTION_OR) {
+    vectorized_predicate->left.reset(
+        Compile(predicate->GetLeft(), schema, context));
+    if (vectorized_predicate->left == nullptr) return nullptr;
+
+    vectorized_predicate->right.reset(
+        Compile(predicate->GetRight(), schema, context));
+    if (vectorized_predicate->right == nullptr) return nullptr;
+
+    // Comparisons on the same column are checked in one pass
+    if (expression_type == EXPRESSION_TYPE_CONJUNCTION_AND &&
+        vectorized_predicate->left->IntersectRange(
+            *vectorized_predicate->right) == true) {
+      return vectorized_predicate->left.release();
+    }
+
+    return vectorized_predicate.release();
+  }
+
+  // Comparison of a column with a constant
+  if (IsComparison(expression_type) == false) return nullptr;
+
+  auto left = predicate->GetLeft();
+  auto right = predicate->GetRight();
+  if (left == nullptr || right == nullptr) return nullptr;
+
+  // Keep the column on the left side
+  if (IsColumnReference(right) && IsConstant(left, context)) {
+    std::swap(left, right);
+    expression_type = CommuteComparison(expression_type);
+    vectorized_predicate->expression_type = expression_type;
+  }
+
+  if (IsColumnReference(left) == false || IsConstant(right, context) == false) {
+    return nullptr;
+  }
+
+  auto column_id = static_cast<const TupleValueExpression *>(left)
+                       ->GetColumnId();
+  if (column_id < 0 || (oid_t)column_id >= schema->GetColumnCount()) {
+    return nullptr;
+  }
+
+  auto column_type = schema->GetType(column_id);
+  if (IsIntegerType(column_type) == false &&
+      IsDoubleType(column_type) == false) {
+    return nullptr;
+  }
+
+  vectorized_predicate->column_id = column_id;
+  vectorized_predicate->column_type = column_type;
+  vectorized_predicate->not_equal =
+      (expression_type == EXPRESSION_TYPE_COMPARE_NOTEQUAL);
+
+  // Constants and parameters don't depend on the tuple
+  Value constant = right->Evaluate(nullptr, nullptr, context);
+  auto constant_type = constant.GetValueType();
+
+  // Comparisons with null are never true
+  if (constant.IsNull()) {
+    vectorized_predicate->always_false = true;
+    return vectorized_predicate.release();
+  }
+
+  if (IsIntegerType(constant_type) == false &&
+      IsDoubleType(constant_type) == false) {
+    return nullptr;
+  }
+
+  // Double columns, compared as doubles like Value does
+  if (IsDoubleType(column_type)) {
+    double double_constant =
+        ValuePeeker::PeekDouble(constant.CastAs(VALUE_TYPE_DOUBLE));
+    if (std::isnan(double_constant)) return nullptr;
+
+    auto &lower_type = vectorized_predicate->double_lower_type;
+    auto &upper_type = vectorized_predicate->double_upper_type;
+    vectorized_predicate->double_lower = double_constant;
+    vectorized_predicate->double_upper = double_constant;
+
+    switch (expression_type) {
+      case EXPRESSION_TYPE_COMPARE_EQUAL:
+        lower_type = RANGE_BOUND_INCLUSIVE;
+        upper_type = RANGE_BOUND_INCLUSIVE;
+        break;
+      case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+        upper_type = RANGE_BOUND_EXCLUSIVE;
+        break;
+      case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+        upper_type = RANGE_BOUND_INCLUSIVE;
+        break;
+      case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+        lower_type = RANGE_BOUND_EXCLUSIVE;
+        break;
+      case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+        lower_type = RANGE_BOUND_INCLUSIVE;
+        break;
+      default:
+        break;
+    }
+
+    return vectorized_predicate.release();
+  }
+
+  // Integer columns, the range is narrowed down to whole numbers
+  int64_t min_value, max_value;
+  GetIntegerTypeRange(column_type, min_value, max_value);
+  int64_t lower = min_value, upper = max_value;
+
+  if (IsIntegerType(constant_type)) {
+    int64_t integer_constant = ValuePeeker::PeekAsBigInt(constant);
+
+    switch (expression_type) {
+      case EXPRESSION_TYPE_COMPARE_EQUAL:
+      case EXPRESSION_TYPE_COMPARE_NOTEQUAL:
+        lower = upper = integer_constant;
+        break;
+      case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+        // the constant is not null, so it is above INT64_MIN
+        upper = integer_constant - 1;
+        break;
+      case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+        upper = integer_constant;
+        break;
+      case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+        if (integer_constant == INT64_MAX) {
+          vectorized_predicate->always_false = true;
+        } else {
+          lower = integer_constant + 1;
+        }
+        break;
+      case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+        lower = integer_constant;
+        break;
+      default:
+        break;
+    }
+  } else {
+    double double_constant =
+        ValuePeeker::PeekDouble(constant.CastAs(VALUE_TYPE_DOUBLE));
+    if (std::isnan(double_constant)) return nullptr;
+
+    // Not a range of whole numbers
+    if (expression_type == EXPRESSION_TYPE_COMPARE_NOTEQUAL) return nullptr;
+
+    switch (expression_type) {
+      case EXPRESSION_TYPE_COMPARE_EQUAL:
+        if (std::floor(double_constant) != double_constant) {
+          vectorized_predicate->always_false = true;
+        }
+        lower = upper = ClampToBigInt(double_constant);
+        break;
+      case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+        upper = ClampToBigInt(std::ceil(double_constant)) - 1;
+        break;
+      case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+        upper = ClampToBigInt(std::floor(double_constant));
+        break;
+      case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+        lower = ClampToBigInt(std::floor(double_constant)) + 1;
+        break;
+      case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+        lower = ClampToBigInt(std::ceil(double_constant));
+        break;
+      default:
+        break;
+    }
+  }
+
+  if (vectorized_predicate->not_equal == false) {
+    lower = std::max(lower, min_value);
+    upper = std::min(upper, max_value);
+    if (lower > upper) {
+      vectorized_predicate->always_false = true;
+    }
+  }
+
+  vectorized_predicate->integer_lower = lower;
+  vectorized_predicate->integer_upper = upper;
+
+  LOG_TRACE("Vectorized comparison on column %u", column_id);
+
+  return vectorized_predicate.release();
+}
+
+bool VectorizedPredicate::IntersectRange(const VectorizedPredicate &other) {
+  // Both must be ranges on the same column
+  if (IsComparison(expression_type) == false ||
+      IsComparison(other.expression_type) == false) {
+    return false;
+  }
+
+  if (column_id != other.column_id || not_equal == true ||
+      other.not_equal == true) {
+    return false;
+  }
+
+  always_false = (always_false || other.always_false);
+
+  // Integer ranges
+  if (IsIntegerType(column_type)) {
+    integer_lower = std::max(integer_lower, other.integer_lower);
+    integer_upper = std::min(integer_upper, other.integer_upper);
+    if (integer_lower > integer_upper) {
+      always_false = true;
+    }
+    return true;
+  }
+
+  // Double ranges, keep the tighter bound on each side
+  if (other.double_lower_type != RANGE_BOUND_NONE &&
+      (double_lower_type == RANGE_BOUND_NONE ||
+       other.double_lower > double_lower ||
+       (other.double_lower == double_lower &&
+        other.double_lower_type == RANGE_BOUND_EXCLUSIVE))) {
+    double_lower_type = other.double_lower_type;
+    double_lower = other.double_lower;
+  }
+
+  if (other.double_upper_type != RANGE_BOUND_NONE &&
+      (double_upper_type == RANGE_BOUND_NONE ||
+       other.double_upper < double_upper ||
+       (other.double_upper == double_upper &&
+        other.double_upper_type == RANGE_BOUND_EXCLUSIVE))) {
+    double_upper_type = other.double_upper_type;
+    double_upper = other.double_upper;
+  }
+
+  return true;
+}
+
+void VectorizedPredicate::Evaluate(storage::TileGroup *tile_group,
+                                   std::vector<oid_t> &selection) const {
+  switch (expression_type) {
+    case EXPRESSION_TYPE_CONJUNCTION_AND: {
+      left->Evaluate(tile_group, selection);
+      if (selection.empty() == false) {
+        right->Evaluate(tile_group, selection);
+      }
+    } break;
+
+    case EXPRESSION_TYPE_CONJUNCTION_OR: {
+      std::vector<oid_t> right_selection(selection);
+      left->Evaluate(tile_group, selection);
+      right->Evaluate(tile_group, right_selection);
+
+      // Both sides are sorted subsets of the input
+      std::vector<oid_t> union_selection;
+      union_selection.reserve(selection.size() + right_selection.size());
+      std::set_union(selection.begin(), selection.end(),
+                     right_selection.begin(), right_selection.end(),
+                     std::back_inserter(union_selection));
+      selection.swap(union_selection);
+    } break;
+
+    default:
+      EvaluateComparison(tile_group, selection);
+      break;
+  }
+}
+
+void VectorizedPredicate::EvaluateComparison(
+    storage::TileGroup *tile_group, std::vector<oid_t> &selection) const {
+  if (always_false == true) {
+    selection.clear();
+    return;
+  }
+
+  if (selection.empty() == true) return;
+
+  // Locate the column in the tile group layout
+  oid_t tile_offset, tile_column_id;
+  tile_group->LocateTileAndColumn(column_id, tile_offset, tile_column_id);
+  auto tile = tile_group->GetTile(tile_offset);
+  auto tile_schema = tile->GetSchema();
+
+  const char *column =
+      tile->GetTupleLocation(0) + tile_schema->GetOffset(tile_column_id);
+  const size_t stride = tile_schema->GetLength();
+
+  // The SIMD kernels need the column to be densely packed (as in the column
+  // layout) and every tuple up to the last one to be selected
+  const oid_t tuple_count = selection.size();
+  bool simd = (not_equal == false && selection.back() + 1 == tuple_count);
+
+  switch (column_type) {
+    case VALUE_TYPE_TINYINT:
+      FilterIntegerColumn<int8_t>(column, stride, not_equal, integer_lower,
+                                  integer_upper, selection);
+      break;
+    case VALUE_TYPE_SMALLINT:
+      FilterIntegerColumn<int16_t>(column, stride, not_equal, integer_lower,
+                                   integer_upper, selection);
+      break;
+    case VALUE_TYPE_INTEGER:
+      if (simd == true && stride == sizeof(int32_t)) {
+        selection.resize(SimdFilter::FilterRange(
+            reinterpret_cast<const int32_t *>(column), 0, tuple_count,
+            (int32_t)integer_lower, (int32_t)integer_upper, selection.data()));
+      } else {
+        FilterIntegerColumn<int32_t>(column, stride, not_equal, integer_lower,
+                                     integer_upper, selection);
+      }
+      break;
+    case VALUE_TYPE_BIGINT:
+      if (simd == true && stride == sizeof(int64_t)) {
+        selection.resize(SimdFilter::FilterRange(
+            reinterpret_cast<const int64_t *>(column), 0, tuple_count,
+            integer_lower, integer_upper, selection.data()));
+      } else {
+        FilterIntegerColumn<int64_t>(column, stride, not_equal, integer_lower,
+                                     integer_upper, selection);
+      }
+      break;
+    // REAL is stored as DOUBLE
+    case VALUE_TYPE_REAL:
+    case VALUE_TYPE_DOUBLE:
+      if (simd == true && stride == sizeof(double)) {
+        selection.resize(SimdFilter::FilterRange(
+            reinterpret_cast<const double *>(column), 0, tuple_count,
+            double_lower_type, double_lower, double_upper_type, double_upper,
+            selection.data()));
+      } else {
+        FilterDoubleColumn(column, stride, not_equal, double_lower_type,
+                           double_lower, double_upper_type, double_upper,
+                           selection);
+      }
+      break;
+    default:
+      throw Exception("Unsupported vectorized column type : " +
+                      ValueTypeToString(column_type));
+  }
+}
+
+}  // End expression namespace
+}  // End peloton namespace
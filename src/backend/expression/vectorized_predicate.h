@@ -0,0 +1,120 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// vectorized_predicate.h
+//
+// Identification: src/backend/expression/vectorized_predicate.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "backend/common/types.h"
+#include "backend/common/value.h"
+#include "backend/expression/simd_filter.h"
+
+namespace peloton {
+
+namespace catalog {
+class Schema;
+}
+
+namespace executor {
+class ExecutorContext;
+}
+
+namespace storage {
+class TileGroup;
+}
+
+namespace expression {
+
+class AbstractExpression;
+
+//===--------------------------------------------------------------------===//
+// Vectorized Predicate
+//===--------------------------------------------------------------------===//
+
+/**
+ * Evaluates a predicate over a tile group a column at a time.
+ *
+ * Only conjunctions of comparisons between a fixed-width numeric column and
+ * a constant (or parameter) are supported. Instead of building a tuple and
+ * boxing every column into a Value, each comparison runs a tight loop over
+ * the raw column storage and narrows down a selection vector of tuple ids.
+ *
+ * Comparisons other than != are kept as ranges of values, and the
+ * comparisons of a conjunction on the same column are merged into a single
+ * range (e.g. for BETWEEN). Densely packed INTEGER, BIGINT and DOUBLE
+ * columns are filtered with the SIMD kernels when every tuple of the tile
+ * group is still selected.
+ */
+class VectorizedPredicate {
+ public:
+  VectorizedPredicate(const VectorizedPredicate &) = delete;
+  VectorizedPredicate &operator=(const VectorizedPredicate &) = delete;
+  VectorizedPredicate(VectorizedPredicate &&) = delete;
+  VectorizedPredicate &operator=(VectorizedPredicate &&) = delete;
+
+  // Returns nullptr if the predicate can not be vectorized
+  static VectorizedPredicate *Compile(const AbstractExpression *predicate,
+                                      const catalog::Schema *schema,
+                                      executor::ExecutorContext *context);
+
+  // Keep only the tuples of the tile group that satisfy the predicate,
+  // the selection must be sorted by tuple id
+  void Evaluate(storage::TileGroup *tile_group,
+                std::vector<oid_t> &selection) const;
+
+ private:
+  VectorizedPredicate() {}
+
+  void EvaluateComparison(storage::TileGroup *tile_group,
+                          std::vector<oid_t> &selection) const;
+
+  // Narrow down the range to the values also within the other range,
+  // returns false if the comparisons can't be merged
+  bool IntersectRange(const VectorizedPredicate &other);
+
+  //===--------------------------------------------------------------------===//
+  // Members
+  //===--------------------------------------------------------------------===//
+
+  // conjunction or comparison
+  ExpressionType expression_type = EXPRESSION_TYPE_INVALID;
+
+  // children of a conjunction
+  std::unique_ptr<VectorizedPredicate> left;
+  std::unique_ptr<VectorizedPredicate> right;
+
+  // column compared against the constant, with the column on the left side
+  oid_t column_id = INVALID_OID;
+  ValueType column_type = VALUE_TYPE_INVALID;
+
+  // the comparison is never true, e.g. with null
+  bool always_false = false;
+
+  // != is the only comparison that is not a range,
+  // the constant is then kept as the lower bound
+  bool not_equal = false;
+
+  // range of values of integer columns, inclusive on both ends and within
+  // the values the column type can hold
+  int64_t integer_lower = 0;
+  int64_t integer_upper = 0;
+
+  // range of values of double columns
+  RangeBoundType double_lower_type = RANGE_BOUND_NONE;
+  double double_lower = 0;
+  RangeBoundType double_upper_type = RANGE_BOUND_NONE;
+  double double_upper = 0;
+};
+
+}  // End expression namespace
+}  // End peloton namespace
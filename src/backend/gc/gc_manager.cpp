@@ -13,16 +13,22 @@
 #include "backend/common/types.h"
 #include "backend/gc/gc_manager.h"
 #include "backend/index/index.h"
+#include "backend/storage/data_table.h"
+#include "backend/storage/tile_group.h"
+#include "backend/storage/tuple.h"
 #include "backend/concurrency/transaction_manager_factory.h"
 namespace peloton {
 namespace gc {
 
 void GCManager::StartGC() {
   LOG_TRACE("Starting GC");
-  if (this->gc_type_ == GC_TYPE_OFF) {
+  // cooperative gc runs on the workers, there is no separate thread
+  if (this->gc_type_ != GC_TYPE_ON) {
     return;
   }
-  gc_thread_.reset(new std::thread(&GCManager::Running, this));
+  for (size_t i = 0; i < gc_thread_count_; ++i) {
+    gc_threads_.emplace_back(new std::thread(&GCManager::Running, this, i));
+  }
 }
 
 void GCManager::StopGC() {
@@ -31,14 +37,60 @@ void GCManager::StopGC() {
     return;
   }
   this->is_running_ = false;
-  this->gc_thread_->join();
+  for (auto &gc_thread : gc_threads_) {
+    gc_thread->join();
+  }
+  gc_threads_.clear();
   ClearGarbage();
 }
 
-void GCManager::ResetTuple(const TupleMetadata &tuple_metadata) {
+// The tile group must not be reused yet, the keys are built from the tuple
+void GCManager::DeleteTupleFromIndexes(const TupleMetadata &tuple_metadata) {
+  auto &manager = catalog::Manager::GetInstance();
+  auto tile_group = manager.GetTileGroup(tuple_metadata.tile_group_id);
+  assert(tile_group != nullptr);
+
+  auto table =
+      dynamic_cast<storage::DataTable *>(tile_group->GetAbstractTable());
+  if (table == nullptr || table->GetIndexCount() == 0) {
+    return;
+  }
+
+  auto schema = table->GetSchema();
+  std::unique_ptr<storage::Tuple> tuple(new storage::Tuple(schema, true));
+  tile_group->CopyTuple(tuple_metadata.tuple_slot_id, tuple.get());
+
+  ItemPointer location(tuple_metadata.tile_group_id,
+                       tuple_metadata.tuple_slot_id);
+
+  // Only the entries of the version go. A primary entry that was swung to a
+  // newer version does not match the location and stays.
+  auto index_count = table->GetIndexCount();
+  for (oid_t index_itr = 0; index_itr < index_count; index_itr++) {
+    auto index = table->GetIndex(index_itr);
+    if (index == nullptr) {
+      continue;
+    }
+    auto index_schema = index->GetKeySchema();
+    auto indexed_columns = index_schema->GetIndexedColumns();
+    std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
+    key->SetFromTuple(tuple.get(), indexed_columns, index->GetPool());
+
+    index->DeleteEntry(key.get(), location);
+  }
+}
+
+bool GCManager::ResetTuple(const TupleMetadata &tuple_metadata) {
   auto &manager = catalog::Manager::GetInstance();
-  auto tile_group_header =
-      manager.GetTileGroup(tuple_metadata.tile_group_id)->GetHeader();
+  auto tile_group = manager.GetTileGroup(tuple_metadata.tile_group_id);
+  // the table was dropped, the slot is gone with its tile group
+  if (tile_group == nullptr) {
+    return false;
+  }
+  auto tile_group_header = tile_group->GetHeader();
+
+  // no reader can reach the version any more, drop its index entries
+  DeleteTupleFromIndexes(tuple_metadata);
 
   // Reset the header
   tile_group_header->SetTransactionId(tuple_metadata.tuple_slot_id,
@@ -53,62 +105,81 @@ void GCManager::ResetTuple(const TupleMetadata &tuple_metadata) {
       tile_group_header->GetReservedFieldRef(tuple_metadata.tuple_slot_id), 0,
       storage::TileGroupHeader::GetReserverdSize());
   // TODO: set the unused 2 boolean value
+  return true;
 }
 
-void GCManager::Running() {
-  // Check if we can move anything from the possibly free list to the free list.
+void GCManager::AddToRecycleMap(const TupleMetadata &tuple_metadata) {
+  std::shared_ptr<LockfreeQueue<TupleMetadata>> recycle_queue;
+  // if the entry for table_id exists.
+  if (recycle_queue_map_.find(tuple_metadata.table_id, recycle_queue) ==
+      true) {
+    // if the entry for tuple_metadata.table_id exists.
+    recycle_queue->Enqueue(tuple_metadata);
+  } else {
+    // if the entry for tuple_metadata.table_id does not exist.
+    recycle_queue.reset(new LockfreeQueue<TupleMetadata>(MAX_QUEUE_LENGTH));
+    bool ret =
+        recycle_queue_map_.insert(tuple_metadata.table_id, recycle_queue);
+    if (ret == true) {
+      recycle_queue->Enqueue(tuple_metadata);
+    } else {
+      recycle_queue_map_.find(tuple_metadata.table_id, recycle_queue);
+      recycle_queue->Enqueue(tuple_metadata);
+    }
+  }
+}
 
-  while (true) {
-    std::this_thread::sleep_for(
-        std::chrono::milliseconds(GC_PERIOD_MILLISECONDS));
+int GCManager::Reclaim(const size_t queue_id, const size_t attempt_count) {
+  auto &reclaim_queue = *reclaim_queues_[queue_id];
 
-    LOG_TRACE("reclaim tuple thread...");
+  TupleMetadata tuple_metadata;
+  // nothing to do, skip the scan of the running epochs
+  if (reclaim_queue.Dequeue(tuple_metadata) == false) {
+    return 0;
+  }
 
-    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
-    auto max_cid = txn_manager.GetMaxCommittedCid();
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto max_cid = txn_manager.GetMaxCommittedCid();
 
-    assert(max_cid != MAX_CID);
+  assert(max_cid != MAX_CID);
 
-    int tuple_counter = 0;
+  int tuple_counter = 0;
 
-    // every time we garbage collect at most MAX_ATTEMPT_COUNT tuples.
-    for (size_t i = 0; i < MAX_ATTEMPT_COUNT; ++i) {
-      TupleMetadata tuple_metadata;
+  // every time we garbage collect at most attempt_count tuples.
+  for (size_t i = 0; i < attempt_count; ++i) {
+    if (i != 0 && reclaim_queue.Dequeue(tuple_metadata) == false) {
       // if there's no more tuples in the queue, then break.
-      if (reclaim_queue_.Dequeue(tuple_metadata) == false) {
-        break;
-      }
+      break;
+    }
 
-      if (tuple_metadata.tuple_end_cid <= max_cid) {
-        ResetTuple(tuple_metadata);
-
-        // Add to the recycle map
-        std::shared_ptr<LockfreeQueue<TupleMetadata>> recycle_queue;
-        // if the entry for table_id exists.
-        if (recycle_queue_map_.find(tuple_metadata.table_id, recycle_queue) ==
-            true) {
-          // if the entry for tuple_metadata.table_id exists.
-          recycle_queue->Enqueue(tuple_metadata);
-        } else {
-          // if the entry for tuple_metadata.table_id does not exist.
-          recycle_queue.reset(
-              new LockfreeQueue<TupleMetadata>(MAX_QUEUE_LENGTH));
-          bool ret =
-              recycle_queue_map_.insert(tuple_metadata.table_id, recycle_queue);
-          if (ret == true) {
-            recycle_queue->Enqueue(tuple_metadata);
-          } else {
-            recycle_queue_map_.find(tuple_metadata.table_id, recycle_queue);
-            recycle_queue->Enqueue(tuple_metadata);
-          }
-        }
-
-        tuple_counter++;
-      } else {
-        // if a tuple cannot be reclaimed, then add it back to the list.
-        reclaim_queue_.Enqueue(tuple_metadata);
+    if (tuple_metadata.tuple_end_cid <= max_cid) {
+      if (ResetTuple(tuple_metadata) == false) {
+        continue;
       }
-    }  // end for
+
+      AddToRecycleMap(tuple_metadata);
+
+      tuple_counter++;
+    } else {
+      // if a tuple cannot be reclaimed, then add it back to the list.
+      reclaim_queue.Enqueue(tuple_metadata);
+    }
+  }  // end for
+
+  return tuple_counter;
+}
+
+void GCManager::Running(const size_t thread_id) {
+  // Check if we can move anything from the possibly free list to the free list.
+
+  while (true) {
+    std::this_thread::sleep_for(
+        std::chrono::milliseconds(GC_PERIOD_MILLISECONDS));
+
+    LOG_TRACE("reclaim tuple thread %lu...", thread_id);
+
+    __attribute__((unused)) auto tuple_counter =
+        Reclaim(thread_id, MAX_ATTEMPT_COUNT);
 
     LOG_TRACE("Marked %d tuples as garbage", tuple_counter);
 
@@ -118,6 +189,21 @@ void GCManager::Running() {
   }
 }
 
+void GCManager::CooperativeGC() {
+  if (this->gc_type_ != GC_TYPE_COOPERATIVE) {
+    return;
+  }
+
+  // the workers take turns over the queues
+  static thread_local size_t next_queue_id = 0;
+  auto queue_id = next_queue_id++ % gc_thread_count_;
+
+  __attribute__((unused)) auto tuple_counter =
+      Reclaim(queue_id, COOPERATIVE_ATTEMPT_COUNT);
+
+  LOG_TRACE("Marked %d tuples as garbage", tuple_counter);
+}
+
 // called by transaction manager.
 void GCManager::RecycleTupleSlot(const oid_t &table_id,
                                  const oid_t &tile_group_id,
@@ -133,7 +219,9 @@ void GCManager::RecycleTupleSlot(const oid_t &table_id,
   tuple_metadata.tuple_slot_id = tuple_id;
   tuple_metadata.tuple_end_cid = tuple_end_cid;
 
-  reclaim_queue_.Enqueue(tuple_metadata);
+  // spread the versions over the queues of the gc threads
+  auto queue_id = (tile_group_id + tuple_id) % gc_thread_count_;
+  reclaim_queues_[queue_id]->Enqueue(tuple_metadata);
 
   LOG_TRACE("Marked tuple(%u, %u) in table %u as possible garbage",
            tuple_metadata.tile_group_id, tuple_metadata.tuple_slot_id,
@@ -150,8 +238,13 @@ ItemPointer GCManager::ReturnFreeSlot(const oid_t &table_id) {
   std::shared_ptr<LockfreeQueue<TupleMetadata>> recycle_queue;
   // if there exists recycle_queue
   if (recycle_queue_map_.find(table_id, recycle_queue) == true) {
+    auto &manager = catalog::Manager::GetInstance();
     TupleMetadata tuple_metadata;
-    if (recycle_queue->Dequeue(tuple_metadata) == true) {
+    while (recycle_queue->Dequeue(tuple_metadata) == true) {
+      // skip the slots of a dropped table that had the same table id
+      if (manager.GetTileGroup(tuple_metadata.tile_group_id) == nullptr) {
+        continue;
+      }
       LOG_TRACE("Reuse tuple(%u, %u) in table %u", tuple_metadata.tile_group_id,
                tuple_metadata.tuple_slot_id, table_id);
       return ItemPointer(tuple_metadata.tile_group_id,
@@ -167,28 +260,13 @@ ItemPointer GCManager::ReturnFreeSlot(const oid_t &table_id) {
 void GCManager::ClearGarbage() {
   // iterate reclaim queue and reclaim every thing because it's the end of the world now.
   TupleMetadata tuple_metadata;
-  while (reclaim_queue_.Dequeue(tuple_metadata) == true) {
-    ResetTuple(tuple_metadata);
-
-    // Add to the recycle map
-    std::shared_ptr<LockfreeQueue<TupleMetadata>> recycle_queue;
-    // if the entry for table_id exists.
-    if (recycle_queue_map_.find(tuple_metadata.table_id, recycle_queue) ==
-        true) {
-      // if the entry for tuple_metadata.table_id exists.
-      recycle_queue->Enqueue(tuple_metadata);
-    } else {
-      // if the entry for tuple_metadata.table_id does not exist.
-      recycle_queue.reset(
-        new LockfreeQueue<TupleMetadata>(MAX_QUEUE_LENGTH));
-      bool ret =
-        recycle_queue_map_.insert(tuple_metadata.table_id, recycle_queue);
-      if (ret == true) {
-        recycle_queue->Enqueue(tuple_metadata);
-      } else {
-        recycle_queue_map_.find(tuple_metadata.table_id, recycle_queue);
-        recycle_queue->Enqueue(tuple_metadata);
+  for (auto &reclaim_queue : reclaim_queues_) {
+    while (reclaim_queue->Dequeue(tuple_metadata) == true) {
+      if (ResetTuple(tuple_metadata) == false) {
+        continue;
       }
+
+      AddToRecycleMap(tuple_metadata);
     }
   }
 }
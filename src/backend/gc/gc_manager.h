@@ -15,6 +15,8 @@
 #include <thread>
 #include <unordered_map>
 #include <map>
+#include <memory>
+#include <vector>
 
 #include "backend/common/types.h"
 #include "backend/common/lockfree_queue.h"
@@ -33,6 +35,13 @@ namespace gc {
 
 #define GC_PERIOD_MILLISECONDS 100
 
+// default number of gc threads, each drains its own reclaim queue
+#define GC_THREAD_COUNT 1
+
+// versions a worker tries to reclaim when its transaction ends with
+// cooperative gc
+#define COOPERATIVE_ATTEMPT_COUNT 64
+
 class GCManager {
  public:
   GCManager(const GCManager &) = delete;
@@ -40,10 +49,14 @@ class GCManager {
   GCManager(GCManager &&) = delete;
   GCManager &operator=(GCManager &&) = delete;
 
-  GCManager(const GCType type)
+  GCManager(const GCType type, const size_t thread_count = GC_THREAD_COUNT)
       : is_running_(true),
         gc_type_(type),
-        reclaim_queue_(MAX_QUEUE_LENGTH) {
+        gc_thread_count_(thread_count > 0 ? thread_count : 1) {
+    for (size_t i = 0; i < gc_thread_count_; ++i) {
+      reclaim_queues_.emplace_back(
+          new LockfreeQueue<TupleMetadata>(MAX_QUEUE_LENGTH));
+    }
     StartGC();
   }
 
@@ -61,11 +74,22 @@ class GCManager {
 
   ItemPointer ReturnFreeSlot(const oid_t &table_id);
 
+  // Called by the workers when a transaction ends, reclaims a few versions
+  // with cooperative gc
+  void CooperativeGC();
+
  private:
-  void Running();
-  //void DeleteTupleFromIndexes(const TupleMetadata &);
+  void Running(const size_t thread_id);
+
+  // reclaim at most attempt_count versions of a queue, returns the count
+  int Reclaim(const size_t queue_id, const size_t attempt_count);
 
-  void ResetTuple(const TupleMetadata &);
+  void DeleteTupleFromIndexes(const TupleMetadata &);
+
+  // false if the tile group of the tuple was dropped
+  bool ResetTuple(const TupleMetadata &);
+
+  void AddToRecycleMap(const TupleMetadata &);
 
  private:
   //===--------------------------------------------------------------------===//
@@ -79,10 +103,13 @@ class GCManager {
   volatile bool is_running_;
   GCType gc_type_;
 
-  std::unique_ptr<std::thread> gc_thread_;
+  size_t gc_thread_count_;
+
+  std::vector<std::unique_ptr<std::thread>> gc_threads_;
 
+  // one queue per gc thread, a version goes to the queue of its slot
   // TODO: use shared pointer to reduce memory copy
-  LockfreeQueue<TupleMetadata> reclaim_queue_;
+  std::vector<std::unique_ptr<LockfreeQueue<TupleMetadata>>> reclaim_queues_;
 
   // TODO: use shared pointer to reduce memory copy
   cuckoohash_map<oid_t, std::shared_ptr<LockfreeQueue<TupleMetadata>>>
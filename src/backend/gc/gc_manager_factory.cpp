@@ -13,5 +13,9 @@
 #include "gc_manager_factory.h"
 
 namespace peloton {
-namespace gc { GCType GCManagerFactory::gc_type_ = GC_TYPE_ON; }
+namespace gc {
+GCType GCManagerFactory::gc_type_ = GC_TYPE_ON;
+
+size_t GCManagerFactory::gc_thread_count_ = GC_THREAD_COUNT;
+}
 }
@@ -19,16 +19,25 @@ namespace gc {
 class GCManagerFactory {
  public:
   static GCManager &GetInstance() {
-    static GCManager gc_manager(GC_TYPE_ON);
+    static GCManager gc_manager(gc_type_, gc_thread_count_);
     return gc_manager;
   }
 
-  static void Configure(GCType gc_type) { gc_type_ = gc_type; }
+  // takes effect if called before the first GetInstance
+  static void Configure(GCType gc_type,
+                        size_t gc_thread_count = GC_THREAD_COUNT) {
+    gc_type_ = gc_type;
+    gc_thread_count_ = gc_thread_count;
+  }
 
   static GCType GetGCType() { return gc_type_; }
 
+  static size_t GetGCThreadCount() { return gc_thread_count_; }
+
  private:
   static GCType gc_type_;
+
+  static size_t gc_thread_count_;
 };
 }
 }
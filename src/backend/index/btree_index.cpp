@@ -144,86 +144,111 @@ bool BTreeIndex<KeyType, ValueType, KeyComparator,
 
 template <typename KeyType, typename ValueType, class KeyComparator,
           class KeyEqualityChecker>
-void BTreeIndex<KeyType, ValueType, KeyComparator, KeyEqualityChecker>::Scan(
+void BTreeIndex<KeyType, ValueType, KeyComparator,
+                KeyEqualityChecker>::ScanEntries(
     const std::vector<Value> &values, const std::vector<oid_t> &key_column_ids,
     const std::vector<ExpressionType> &expr_types,
-    const ScanDirectionType &scan_direction, std::vector<ItemPointer> &result) {
+    const ScanDirectionType &scan_direction, const size_t limit,
+    std::function<void(ItemPointer *)> visitor) {
   KeyType index_key;
+  std::unique_ptr<storage::Tuple> bound_key(
+      new storage::Tuple(metadata->GetKeySchema(), true));
 
-  // Check if we have leading (leftmost) column equality
+  // The bounds of the leading key columns delimit the range to scan
   // refer : http://www.postgresql.org/docs/8.2/static/indexes-multicolumn.html
-  oid_t leading_column_id = 0;
-  auto key_column_ids_itr = std::find(key_column_ids.begin(),
-                                      key_column_ids.end(), leading_column_id);
-
-  // SPECIAL CASE : leading column id is one of the key column ids
-  // and is involved in a equality constraint
-  bool special_case = false;
-  if (key_column_ids_itr != key_column_ids.end()) {
-    auto offset = std::distance(key_column_ids.begin(), key_column_ids_itr);
-    if (expr_types[offset] == EXPRESSION_TYPE_COMPARE_EQUAL) {
-      special_case = true;
+  std::vector<Value> lower_bound_prefix;
+  std::vector<Value> upper_bound_prefix;
+  ConstructBoundPrefix(values, key_column_ids, expr_types, false,
+                       lower_bound_prefix);
+  ConstructBoundPrefix(values, key_column_ids, expr_types, true,
+                       upper_bound_prefix);
+
+  LOG_TRACE("Bounded columns : %lu %lu", lower_bound_prefix.size(),
+            upper_bound_prefix.size());
+
+  size_t match_count = 0;
+
+  // Visit an entry, returns false if no further entry can match
+  auto visit_entry = [&](const KeyType &key, ItemPointer *item_pointer,
+                         const std::vector<Value> &end_prefix) {
+    auto scan_current_key = key;
+    auto tuple =
+        scan_current_key.GetTupleForComparison(metadata->GetKeySchema());
+
+    if (IsPastScanEnd(tuple, end_prefix, scan_direction) == true) {
+      return false;
     }
-  }
-
-  LOG_TRACE("Special case : %d ", special_case);
-
-  {
-    index_lock.ReadLock();
 
-    auto scan_begin_itr = container.begin();
-    std::unique_ptr<storage::Tuple> start_key;
-    bool all_constraints_are_equal = false;
-
-    // If it is a special case, we can figure out the range to scan in the index
-    if (special_case == true) {
-      start_key.reset(new storage::Tuple(metadata->GetKeySchema(), true));
-
-      // Construct the lower bound key tuple
-      all_constraints_are_equal = ConstructLowerBoundTuple(
-          start_key.get(), values, key_column_ids, expr_types);
-      LOG_TRACE("All constraints are equal : %d ", all_constraints_are_equal);
-      index_key.SetFromKey(start_key.get());
+    // Compare the current key in the scan with "values" based on
+    // "expression types"
+    // For instance, "5" EXPR_GREATER_THAN "2" is true
+    if (Compare(tuple, key_column_ids, expr_types, values) == true) {
+      visitor(item_pointer);
+      match_count++;
+    }
 
-      index_key.SetFromKey(start_key.get());
+    return (limit == 0 || match_count < limit);
+  };
+
+  switch (scan_direction) {
+    case SCAN_DIRECTION_TYPE_FORWARD: {
+      // Seek to the lower bound
+      auto scan_itr = container.begin();
+      if (lower_bound_prefix.empty() == false) {
+        ConstructLowerBoundTuple(bound_key.get(), values, key_column_ids,
+                                 expr_types);
+        index_key.SetFromKey(bound_key.get());
+        scan_itr = container.lower_bound(index_key);
+      }
 
-      // Set scan begin iterator
-      scan_begin_itr = container.equal_range(index_key).first;
-    }
+      for (; scan_itr != container.end(); scan_itr++) {
+        if (visit_entry(scan_itr->first, scan_itr->second,
+                        upper_bound_prefix) == false) {
+          break;
+        }
+      }
+    } break;
+
+    case SCAN_DIRECTION_TYPE_BACKWARD: {
+      // Seek past the upper bound, unless some column can not be bounded
+      auto scan_itr = container.end();
+      if (upper_bound_prefix.empty() == false &&
+          ConstructUpperBoundTuple(bound_key.get(), values, key_column_ids,
+                                   expr_types) == true) {
+        index_key.SetFromKey(bound_key.get());
+        scan_itr = container.upper_bound(index_key);
+      }
 
-    switch (scan_direction) {
-      case SCAN_DIRECTION_TYPE_FORWARD:
-      case SCAN_DIRECTION_TYPE_BACKWARD: {
-        // Scan the index entries in forward direction
-        for (auto scan_itr = scan_begin_itr; scan_itr != container.end();
-             scan_itr++) {
-          auto scan_current_key = scan_itr->first;
-          auto tuple =
-              scan_current_key.GetTupleForComparison(metadata->GetKeySchema());
-
-          // Compare the current key in the scan with "values" based on
-          // "expression types"
-          // For instance, "5" EXPR_GREATER_THAN "2" is true
-          if (Compare(tuple, key_column_ids, expr_types, values) == true) {
-
-            ItemPointer item_pointer = *(scan_itr->second);
-
-            result.push_back(item_pointer);
-          } else {
-            // We can stop scanning if we know that all constraints are equal
-            if (all_constraints_are_equal == true) {
-              break;
-            }
-          }
+      while (scan_itr != container.begin()) {
+        scan_itr--;
+        if (visit_entry(scan_itr->first, scan_itr->second,
+                        lower_bound_prefix) == false) {
+          break;
         }
+      }
+    } break;
 
-      } break;
+    case SCAN_DIRECTION_TYPE_INVALID:
+    default:
+      throw Exception("Invalid scan direction \n");
+      break;
+  }
+}
 
-      case SCAN_DIRECTION_TYPE_INVALID:
-      default:
-        throw Exception("Invalid scan direction \n");
-        break;
-    }
+template <typename KeyType, typename ValueType, class KeyComparator,
+          class KeyEqualityChecker>
+void BTreeIndex<KeyType, ValueType, KeyComparator, KeyEqualityChecker>::Scan(
+    const std::vector<Value> &values, const std::vector<oid_t> &key_column_ids,
+    const std::vector<ExpressionType> &expr_types,
+    const ScanDirectionType &scan_direction, std::vector<ItemPointer> &result,
+    const size_t limit) {
+  {
+    index_lock.ReadLock();
+
+    ScanEntries(values, key_column_ids, expr_types, scan_direction, limit,
+                [&result](ItemPointer *item_pointer) {
+                  result.push_back(*item_pointer);
+                });
 
     index_lock.Unlock();
   }
@@ -284,81 +309,14 @@ void BTreeIndex<KeyType, ValueType, KeyComparator, KeyEqualityChecker>::Scan(
     const std::vector<Value> &values, const std::vector<oid_t> &key_column_ids,
     const std::vector<ExpressionType> &expr_types,
     const ScanDirectionType &scan_direction,
-    std::vector<ItemPointer *> &result) {
-  KeyType index_key;
-
-  // Check if we have leading (leftmost) column equality
-  // refer : http://www.postgresql.org/docs/8.2/static/indexes-multicolumn.html
-  oid_t leading_column_id = 0;
-  auto key_column_ids_itr = std::find(key_column_ids.begin(),
-                                      key_column_ids.end(), leading_column_id);
-
-  // SPECIAL CASE : leading column id is one of the key column ids
-  // and is involved in a equality constraint
-  bool special_case = false;
-  if (key_column_ids_itr != key_column_ids.end()) {
-    auto offset = std::distance(key_column_ids.begin(), key_column_ids_itr);
-    if (expr_types[offset] == EXPRESSION_TYPE_COMPARE_EQUAL) {
-      special_case = true;
-    }
-  }
-
-  LOG_TRACE("Special case : %d ", special_case);
-
+    std::vector<ItemPointer *> &result, const size_t limit) {
   {
     index_lock.ReadLock();
 
-    auto scan_begin_itr = container.begin();
-    std::unique_ptr<storage::Tuple> start_key;
-    bool all_constraints_are_equal = false;
-
-    // If it is a special case, we can figure out the range to scan in the index
-    if (special_case == true) {
-      start_key.reset(new storage::Tuple(metadata->GetKeySchema(), true));
-
-      // Construct the lower bound key tuple
-      all_constraints_are_equal = ConstructLowerBoundTuple(
-          start_key.get(), values, key_column_ids, expr_types);
-      LOG_TRACE("All constraints are equal : %d ", all_constraints_are_equal);
-      index_key.SetFromKey(start_key.get());
-
-      index_key.SetFromKey(start_key.get());
-
-      // Set scan begin iterator
-      scan_begin_itr = container.equal_range(index_key).first;
-    }
-
-    switch (scan_direction) {
-      case SCAN_DIRECTION_TYPE_FORWARD:
-      case SCAN_DIRECTION_TYPE_BACKWARD: {
-        // Scan the index entries in forward direction
-        for (auto scan_itr = scan_begin_itr; scan_itr != container.end();
-             scan_itr++) {
-          auto scan_current_key = scan_itr->first;
-          auto tuple =
-              scan_current_key.GetTupleForComparison(metadata->GetKeySchema());
-
-          // Compare the current key in the scan with "values" based on
-          // "expression types"
-          // For instance, "5" EXPR_GREATER_THAN "2" is true
-          if (Compare(tuple, key_column_ids, expr_types, values) == true) {
-            ItemPointer *location_header = scan_itr->second;
-            result.push_back(location_header);
-          } else {
-            // We can stop scanning if we know that all constraints are equal
-            if (all_constraints_are_equal == true) {
-              break;
-            }
-          }
-        }
-
-      } break;
-
-      case SCAN_DIRECTION_TYPE_INVALID:
-      default:
-        throw Exception("Invalid scan direction \n");
-        break;
-    }
+    ScanEntries(values, key_column_ids, expr_types, scan_direction, limit,
+                [&result](ItemPointer *item_pointer) {
+                  result.push_back(item_pointer);
+                });
 
     index_lock.Unlock();
   }
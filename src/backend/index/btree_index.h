@@ -54,7 +54,7 @@ class BTreeIndex : public Index {
             const std::vector<oid_t> &key_column_ids,
             const std::vector<ExpressionType> &expr_types,
             const ScanDirectionType &scan_direction,
-            std::vector<ItemPointer> &);
+            std::vector<ItemPointer> &, const size_t limit);
 
   void ScanAllKeys(std::vector<ItemPointer> &);
 
@@ -64,7 +64,7 @@ class BTreeIndex : public Index {
             const std::vector<oid_t> &key_column_ids,
             const std::vector<ExpressionType> &exprs,
             const ScanDirectionType &scan_direction,
-            std::vector<ItemPointer *> &result);
+            std::vector<ItemPointer *> &result, const size_t limit);
 
   void ScanAllKeys(std::vector<ItemPointer *> &result);
 
@@ -78,6 +78,14 @@ class BTreeIndex : public Index {
   size_t GetMemoryFootprint() { return container.GetMemoryFootprint(); }
 
  protected:
+  // Visit the item pointers of the entries matching the predicates in the
+  // scan direction, the caller holds the index lock
+  void ScanEntries(const std::vector<Value> &values,
+                   const std::vector<oid_t> &key_column_ids,
+                   const std::vector<ExpressionType> &expr_types,
+                   const ScanDirectionType &scan_direction, const size_t limit,
+                   std::function<void(ItemPointer *)> visitor);
+
   MapType container;
 
   // equality checker and comparator
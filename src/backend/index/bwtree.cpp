@@ -10,12 +10,134 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <thread>
+
 #include "backend/index/bwtree.h"
 
 namespace peloton {
 namespace index {
 
-// Add your function definitions here
+BWTreeEpochManager::BWTreeEpochManager()
+    : global_epoch_(0), garbage_head_(nullptr), garbage_count_(0) {
+  for (size_t slot_itr = 0; slot_itr < epoch_slot_count_; slot_itr++) {
+    epoch_slots_[slot_itr].active_count[0] = 0;
+    epoch_slots_[slot_itr].active_count[1] = 0;
+  }
+  reclaim_flag_.clear();
+}
+
+BWTreeEpochManager::~BWTreeEpochManager() {
+  // No thread can be registered any more
+  FreeGarbageList(garbage_head_.exchange(nullptr));
+}
+
+BWTreeEpochManager::EpochSlot &BWTreeEpochManager::GetThreadSlot() {
+  static thread_local size_t slot_offset =
+      std::hash<std::thread::id>()(std::this_thread::get_id()) %
+      epoch_slot_count_;
+
+  return epoch_slots_[slot_offset];
+}
+
+uint64_t BWTreeEpochManager::EnterEpoch() {
+  auto &slot = GetThreadSlot();
+
+  while (true) {
+    auto epoch = global_epoch_.load();
+    slot.active_count[epoch & 1].fetch_add(1);
+
+    // Make sure the epoch did not advance before we were counted
+    if (global_epoch_.load() == epoch) return epoch;
+
+    slot.active_count[epoch & 1].fetch_sub(1);
+  }
+}
+
+void BWTreeEpochManager::ExitEpoch(uint64_t epoch) {
+  GetThreadSlot().active_count[epoch & 1].fetch_sub(1);
+}
+
+void BWTreeEpochManager::Retire(void *object, Deleter deleter) {
+  auto garbage = new GarbageNode();
+  garbage->object = object;
+  garbage->deleter = deleter;
+  garbage->epoch = global_epoch_.load();
+
+  garbage->next = garbage_head_.load();
+  while (garbage_head_.compare_exchange_weak(garbage->next, garbage) ==
+         false) {
+  }
+
+  garbage_count_++;
+}
+
+void BWTreeEpochManager::MaybeReclaim() {
+  if (garbage_count_.load() >= reclaim_threshold_) {
+    Reclaim();
+  }
+}
+
+void BWTreeEpochManager::Reclaim() {
+  // Only one reclaimer at a time, others simply move on
+  if (reclaim_flag_.test_and_set() == true) return;
+
+  // The epoch can only advance once nobody is left in the previous one,
+  // which shares its counters with the next one
+  auto epoch = global_epoch_.load();
+  int64_t previous_count = 0;
+  for (size_t slot_itr = 0; slot_itr < epoch_slot_count_; slot_itr++) {
+    previous_count += epoch_slots_[slot_itr].active_count[(epoch + 1) & 1];
+  }
+
+  if (previous_count == 0) {
+    epoch++;
+    global_epoch_ = epoch;
+  }
+
+  // Whatever was retired two epochs ago cannot be referenced any more
+  GarbageNode *garbage = garbage_head_.exchange(nullptr);
+  GarbageNode *expired = nullptr;
+  GarbageNode *pending = nullptr;
+  GarbageNode *pending_tail = nullptr;
+  size_t expired_count = 0;
+
+  while (garbage != nullptr) {
+    auto next = garbage->next;
+    if (garbage->epoch + 2 <= epoch) {
+      garbage->next = expired;
+      expired = garbage;
+      expired_count++;
+    } else {
+      garbage->next = pending;
+      if (pending == nullptr) pending_tail = garbage;
+      pending = garbage;
+    }
+    garbage = next;
+  }
+
+  // Put back what we could not free yet
+  if (pending != nullptr) {
+    pending_tail->next = garbage_head_.load();
+    while (garbage_head_.compare_exchange_weak(pending_tail->next, pending) ==
+           false) {
+    }
+  }
+
+  garbage_count_ -= expired_count;
+
+  reclaim_flag_.clear();
+
+  FreeGarbageList(expired);
+}
+
+void BWTreeEpochManager::FreeGarbageList(GarbageNode *garbage) {
+  while (garbage != nullptr) {
+    auto next = garbage->next;
+    garbage->deleter(garbage->object);
+    delete garbage;
+    garbage = next;
+  }
+}
 
 }  // End index namespace
-}  // End peloton namespace
\ No newline at end of file
+}  // End peloton namespace
@@ -12,16 +12,1484 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "backend/common/exception.h"
+
 namespace peloton {
 namespace index {
 
-// Look up the stx btree interface for background.
-// peloton/third_party/stx/btree.h
+//===--------------------------------------------------------------------===//
+// BWTree Epoch Manager
+//===--------------------------------------------------------------------===//
+
+/**
+ * Epoch-based reclamation for the latch-free BWTree.
+ *
+ * Threads register in the current global epoch before touching any node and
+ * deregister afterwards. Unlinked nodes are tagged with the epoch in which
+ * they were retired and are only freed once the global epoch has advanced
+ * twice, at which point no registered thread can still hold a reference.
+ *
+ * Registration counters are striped across cache-line padded slots so that
+ * concurrent readers do not bounce a single shared counter.
+ */
+class BWTreeEpochManager {
+ public:
+  typedef void (*Deleter)(void *);
+
+  BWTreeEpochManager();
+
+  BWTreeEpochManager(const BWTreeEpochManager &) = delete;
+  BWTreeEpochManager &operator=(const BWTreeEpochManager &) = delete;
+
+  // Frees everything that is still pending
+  ~BWTreeEpochManager();
+
+  // Register the calling thread, returns the epoch it joined
+  uint64_t EnterEpoch();
+
+  // Deregister the calling thread from the given epoch
+  void ExitEpoch(uint64_t epoch);
+
+  // Hand over an unlinked object, deleter is invoked once it is safe
+  void Retire(void *object, Deleter deleter);
+
+  // Try to advance the epoch and free garbage if enough has piled up
+  void MaybeReclaim();
+
+  // Try to advance the epoch and free whatever is safe to free
+  void Reclaim();
+
+ private:
+  struct GarbageNode {
+    void *object;
+    Deleter deleter;
+    uint64_t epoch;
+    GarbageNode *next;
+  };
+
+  // padded to a cache line
+  struct EpochSlot {
+    // registered threads, indexed by epoch parity
+    std::atomic<int64_t> active_count[2];
+    char padding[64 - 2 * sizeof(std::atomic<int64_t>)];
+  };
+
+  static const size_t epoch_slot_count_ = 32;
+
+  // number of retired objects that triggers a reclamation attempt
+  static const size_t reclaim_threshold_ = 64;
+
+  EpochSlot &GetThreadSlot();
+
+  void FreeGarbageList(GarbageNode *garbage);
+
+  EpochSlot epoch_slots_[epoch_slot_count_];
+
+  std::atomic<uint64_t> global_epoch_;
+
+  std::atomic<GarbageNode *> garbage_head_;
+
+  std::atomic<size_t> garbage_count_;
+
+  std::atomic_flag reclaim_flag_;
+};
+
+//===--------------------------------------------------------------------===//
+// BWTree
+//===--------------------------------------------------------------------===//
+
+// Default value helpers, values are compared by equality and never freed
+template <typename ValueType>
+struct BWTreeNoOpValueDeleter {
+  inline void operator()(__attribute__((unused)) const ValueType &value) const {
+  }
+};
+
+/**
+ * Latch-free multimap based on the Bw-tree (Levandoski et al., ICDE 2013).
+ *
+ * All nodes are reached through a mapping table that translates logical
+ * page ids (PIDs) into physical pointers, so every structural change is a
+ * single CAS on one mapping table slot.
+ *
+ * Leaf pages are updated by prepending insert / delete delta records and are
+ * consolidated into a new base page once the delta chain gets too long.
+ * Inner pages are small and rarely written, so they are updated by
+ * copy-on-write and installed with a CAS on their mapping table slot.
+ *
+ * Structure modifications:
+ *  - Split: a new right sibling is installed first, then a split delta on the
+ *    left page narrows its key range and links the sibling (B-link style).
+ *    The separator is posted to the parent afterwards. Any thread that finds
+ *    an unfinished split helps to post it.
+ *  - Merge: an underfull leaf is first announced in its parent, then frozen
+ *    with a remove delta, absorbed by its left sibling through a merge delta,
+ *    and finally its separator is dropped from the parent. Any thread that
+ *    finds a frozen page or an announced merge helps to finish it.
+ *
+ * Inner pages are never merged and the root never shrinks.
+ *
+ * Unlinked pages (and values dropped during consolidation) are reclaimed
+ * through the epoch manager.
+ */
 template <typename KeyType, typename ValueType, typename KeyComparator,
-          typename KeyEqualityChecker>
+          typename KeyEqualityChecker,
+          typename ValueEqualityChecker = std::equal_to<ValueType>,
+          typename ValueDeleter = BWTreeNoOpValueDeleter<ValueType>>
 class BWTree {
-  // Add your declarations here
+ public:
+  typedef uint64_t PID;
+  typedef std::pair<KeyType, ValueType> KeyValuePair;
+
+  static const PID INVALID_PID = UINT64_MAX;
+
+  BWTree(const KeyComparator &key_comparator,
+         const KeyEqualityChecker &key_equality_checker,
+         const ValueEqualityChecker &value_equality_checker =
+             ValueEqualityChecker());
+
+  BWTree(const BWTree &) = delete;
+  BWTree &operator=(const BWTree &) = delete;
+
+  ~BWTree();
+
+  //===--------------------------------------------------------------------===//
+  // Mutators
+  //===--------------------------------------------------------------------===//
+
+  // Insert a key value pair, duplicates are allowed
+  void Insert(const KeyType &key, const ValueType &value);
+
+  // Insert a key value pair only if none of the values already stored
+  // for the key satisfies the predicate, returns false otherwise
+  bool ConditionalInsert(const KeyType &key, const ValueType &value,
+                         std::function<bool(const ValueType &)> predicate);
+
+  // Delete all the pairs matching key and value,
+  // returns false if there was nothing to delete
+  bool Delete(const KeyType &key, const ValueType &value);
+
+  //===--------------------------------------------------------------------===//
+  // Accessors
+  //===--------------------------------------------------------------------===//
+
+  // Collect all the values stored for the key
+  void GetValue(const KeyType &key, std::vector<ValueType> &result);
+
+  // Visit pairs in key order starting at start_key (or at the smallest key
+  // if start_key is null) until the callback returns false
+  void ScanFrom(const KeyType *start_key,
+                std::function<bool(const KeyType &, const ValueType &)>
+                    callback);
+
+  // Free unlinked nodes that are no longer reachable by any thread
+  void PerformGarbageCollection();
+
+ private:
+  //===--------------------------------------------------------------------===//
+  // Nodes
+  //===--------------------------------------------------------------------===//
+
+  enum NodeType {
+    NODE_TYPE_INNER,
+    NODE_TYPE_LEAF,
+    NODE_TYPE_LEAF_INSERT,
+    NODE_TYPE_LEAF_DELETE,
+    NODE_TYPE_LEAF_SPLIT,
+    NODE_TYPE_LEAF_REMOVE,
+    NODE_TYPE_LEAF_MERGE
+  };
+
+  // Common header of every page image and delta record.
+  // Key bounds point into the node that owns them (base page, split delta or
+  // merged page), nullptr stands for -inf (low) and +inf (high).
+  struct Node {
+    Node(NodeType type, uint32_t level) : type(type), level(level) {}
+
+    virtual ~Node() {}
+
+    NodeType type;
+
+    // 0 for leaf pages
+    uint32_t level;
+
+    // number of delta records above the base page
+    uint32_t depth = 0;
+
+    // approximate number of pairs in the page
+    size_t item_count = 0;
+
+    const KeyType *low_key = nullptr;
+    const KeyType *high_key = nullptr;
+
+    // right sibling
+    PID next_pid = INVALID_PID;
+
+    // copy bounds, sibling and counters from the node below in the chain
+    void InheritFrom(const Node *child) {
+      depth = child->depth + 1;
+      item_count = child->item_count;
+      low_key = child->low_key;
+      high_key = child->high_key;
+      next_pid = child->next_pid;
+    }
+  };
+
+  // Owns the bounds of a consolidated page
+  struct BoundedNode : public Node {
+    BoundedNode(NodeType type, uint32_t level, const KeyType *low,
+                const KeyType *high, PID next)
+        : Node(type, level) {
+      if (low != nullptr) {
+        low_key_storage = *low;
+        this->low_key = &low_key_storage;
+      }
+      if (high != nullptr) {
+        high_key_storage = *high;
+        this->high_key = &high_key_storage;
+      }
+      this->next_pid = next;
+    }
+
+    KeyType low_key_storage;
+    KeyType high_key_storage;
+  };
+
+  struct LeafNode : public BoundedNode {
+    LeafNode(const KeyType *low, const KeyType *high, PID next)
+        : BoundedNode(NODE_TYPE_LEAF, 0, low, high, next) {}
+
+    // sorted by key
+    std::vector<KeyValuePair> items;
+  };
+
+  struct LeafInsertDelta : public Node {
+    LeafInsertDelta(const KeyType &key, const ValueType &value,
+                    const Node *child)
+        : Node(NODE_TYPE_LEAF_INSERT, 0), item(key, value), child(child) {
+      this->InheritFrom(child);
+      this->item_count++;
+    }
+
+    KeyValuePair item;
+    const Node *child;
+  };
+
+  struct LeafDeleteDelta : public Node {
+    LeafDeleteDelta(const KeyType &key, const ValueType &value,
+                    const Node *child)
+        : Node(NODE_TYPE_LEAF_DELETE, 0), item(key, value), child(child) {
+      this->InheritFrom(child);
+      if (this->item_count > 0) this->item_count--;
+    }
+
+    KeyValuePair item;
+    const Node *child;
+  };
+
+  // Narrows the page to [low, split_key) and links the new right sibling
+  struct LeafSplitDelta : public Node {
+    LeafSplitDelta(const KeyType &split_key, PID right_pid, size_t right_count,
+                   const Node *child)
+        : Node(NODE_TYPE_LEAF_SPLIT, 0), split_key(split_key), child(child) {
+      this->InheritFrom(child);
+      this->high_key = &this->split_key;
+      this->next_pid = right_pid;
+      this->item_count -= right_count;
+    }
+
+    KeyType split_key;
+    const Node *child;
+  };
+
+  // Freezes a page that is being merged into its left sibling
+  struct LeafRemoveDelta : public Node {
+    LeafRemoveDelta(const Node *child) : Node(NODE_TYPE_LEAF_REMOVE, 0),
+                                         child(child) {
+      this->InheritFrom(child);
+    }
+
+    const Node *child;
+  };
+
+  // Absorbs the frozen right sibling, keys >= merge key live in merged_node
+  struct LeafMergeDelta : public Node {
+    LeafMergeDelta(const Node *merged_node, const Node *child)
+        : Node(NODE_TYPE_LEAF_MERGE, 0),
+          merge_key(merged_node->low_key),
+          merged_node(merged_node),
+          child(child) {
+      this->InheritFrom(child);
+      this->depth += merged_node->depth;
+      this->item_count += merged_node->item_count;
+      this->high_key = merged_node->high_key;
+      this->next_pid = merged_node->next_pid;
+    }
+
+    const KeyType *merge_key;
+    const Node *merged_node;
+    const Node *child;
+  };
+
+  struct InnerNode : public BoundedNode {
+    InnerNode(uint32_t level, const KeyType *low, const KeyType *high,
+              PID next)
+        : BoundedNode(NODE_TYPE_INNER, level, low, high, next) {}
+
+    // the key of the first child is unused, it is covered by the low key
+    std::vector<std::pair<KeyType, PID>> children;
+
+    // split that has not been posted to the parent yet
+    bool split_pending = false;
+    PID split_right_pid = INVALID_PID;
+
+    // merge of two adjacent children that has not been finished yet
+    bool merge_pending = false;
+    PID merge_left_pid = INVALID_PID;
+    PID merge_right_pid = INVALID_PID;
+  };
+
+  // An unlinked chain plus the values that became unreachable with it
+  struct RetiredChain {
+    const Node *head;
+    std::vector<ValueType> dropped_values;
+  };
+
+  //===--------------------------------------------------------------------===//
+  // Epoch guard
+  //===--------------------------------------------------------------------===//
+
+  class EpochGuard {
+   public:
+    EpochGuard(BWTreeEpochManager &epoch_manager)
+        : epoch_manager_(epoch_manager),
+          epoch_(epoch_manager.EnterEpoch()) {}
+
+    ~EpochGuard() { epoch_manager_.ExitEpoch(epoch_); }
+
+   private:
+    BWTreeEpochManager &epoch_manager_;
+    uint64_t epoch_;
+  };
+
+  //===--------------------------------------------------------------------===//
+  // Mapping table
+  //===--------------------------------------------------------------------===//
+
+  // The mapping table is a lazily allocated two-level array
+  static const size_t mapping_chunk_bits_ = 12;
+  static const size_t mapping_chunk_size_ = 1 << mapping_chunk_bits_;
+  static const size_t mapping_directory_size_ = 4096;
+
+  std::atomic<const Node *> &GetMappingSlot(PID pid);
+
+  const Node *GetNode(PID pid) { return GetMappingSlot(pid).load(); }
+
+  bool InstallNode(PID pid, const Node *expected, const Node *desired) {
+    return GetMappingSlot(pid).compare_exchange_strong(expected, desired);
+  }
+
+  PID AllocatePid(const Node *node);
+
+  //===--------------------------------------------------------------------===//
+  // Key helpers
+  //===--------------------------------------------------------------------===//
+
+  inline bool KeyLess(const KeyType &lhs, const KeyType &rhs) const {
+    return key_comparator_(lhs, rhs);
+  }
+
+  inline bool KeyEqual(const KeyType &lhs, const KeyType &rhs) const {
+    return key_equality_checker_(lhs, rhs);
+  }
+
+  inline bool ValueEqual(const ValueType &lhs, const ValueType &rhs) const {
+    return value_equality_checker_(lhs, rhs);
+  }
+
+  // key < high key of the node
+  inline bool BelowHighKey(const Node *node, const KeyType &key) const {
+    return node->high_key == nullptr || KeyLess(key, *node->high_key);
+  }
+
+  // key >= low key of the node
+  inline bool AboveLowKey(const Node *node, const KeyType &key) const {
+    return node->low_key == nullptr || !KeyLess(key, *node->low_key);
+  }
+
+  // index of the child that covers the key
+  size_t GetChildIndex(const InnerNode *node, const KeyType &key) const;
+
+  //===--------------------------------------------------------------------===//
+  // Traversal
+  //===--------------------------------------------------------------------===//
+
+  // Find the leaf page covering the key (or the leftmost one).
+  // Helps to finish any structure modification found on the way.
+  void FindLeaf(const KeyType *key, PID &leaf_pid, const Node *&leaf_head);
+
+  // Find the inner page at the given level covering the key,
+  // returns INVALID_PID if the tree is not that tall yet
+  PID FindInnerNode(const KeyType &key, uint32_t level);
+
+  // Values stored for the key in the given leaf chain
+  void CollectValues(const Node *node, const KeyType &key,
+                     std::vector<ValueType> &result) const;
+
+  // Rebuild the sorted contents of a leaf chain
+  void MaterializeLeaf(const Node *node, std::vector<KeyValuePair> &items,
+                       std::vector<ValueType> &dropped_values) const;
+
+  //===--------------------------------------------------------------------===//
+  // Structure modifications
+  //===--------------------------------------------------------------------===//
+
+  // Replace a long delta chain with a new base page
+  void ConsolidateLeaf(PID pid);
+
+  // Split a freshly consolidated leaf page
+  void SplitLeaf(PID pid, const LeafNode *leaf);
+
+  // Split an oversized inner page image
+  void SplitInner(PID pid, const InnerNode *node);
+
+  // Post the separator of a finished split to the parent (idempotent)
+  void CompleteSplit(uint32_t level, const KeyType &split_key, PID left_pid,
+                     PID right_pid);
+
+  // Announce the merge of an underfull leaf with its left sibling
+  void TryMergeLeaf(PID pid, const LeafNode *leaf);
+
+  // Finish an announced merge (idempotent)
+  void CompleteMerge(PID parent_pid, const InnerNode *parent);
+
+  // Finish the merge that froze the given leaf page
+  void HelpRemovedLeaf(const Node *removed);
+
+  // Finish all pending modifications of an inner page before rewriting it
+  bool HelpInnerNode(PID pid, const InnerNode *node);
+
+  // Copy an inner page image without its pending flags
+  InnerNode *CopyInnerNode(const InnerNode *node) const;
+
+  // Drop the pending split flag once the separator has been posted
+  void ClearSplitPending(PID pid, const InnerNode *node);
+
+  //===--------------------------------------------------------------------===//
+  // Reclamation
+  //===--------------------------------------------------------------------===//
+
+  void RetireChain(const Node *head, std::vector<ValueType> &&dropped_values);
+
+  void RetireInnerNode(const InnerNode *node);
+
+  static void DeleteRetiredChain(void *object);
+
+  static void DeleteInnerNode(void *object);
+
+  // Free a chain including the pages merged into it
+  static void FreeChain(const Node *node);
+
+  //===--------------------------------------------------------------------===//
+  // Data members
+  //===--------------------------------------------------------------------===//
+
+  // delta chain length that triggers a consolidation
+  static const uint32_t max_delta_chain_length_ = 8;
+
+  // page sizes that trigger splits and merges
+  static const size_t leaf_node_max_size_ = 128;
+  static const size_t leaf_node_min_size_ = 16;
+  static const size_t inner_node_max_size_ = 128;
+
+  KeyComparator key_comparator_;
+  KeyEqualityChecker key_equality_checker_;
+  ValueEqualityChecker value_equality_checker_;
+
+  std::atomic<PID> root_pid_;
+
+  std::atomic<PID> next_pid_;
+
+  std::atomic<std::atomic<const Node *> *> mapping_table_
+      [mapping_directory_size_];
+
+  BWTreeEpochManager epoch_manager_;
 };
 
+//===--------------------------------------------------------------------===//
+// Implementation
+//===--------------------------------------------------------------------===//
+
+#define BWTREE_TEMPLATE_ARGUMENTS                                            \
+  template <typename KeyType, typename ValueType, typename KeyComparator,   \
+            typename KeyEqualityChecker, typename ValueEqualityChecker,    \
+            typename ValueDeleter>
+
+#define BWTREE_TYPE                                               \
+  BWTree<KeyType, ValueType, KeyComparator, KeyEqualityChecker, \
+         ValueEqualityChecker, ValueDeleter>
+
+BWTREE_TEMPLATE_ARGUMENTS
+BWTREE_TYPE::BWTree(const KeyComparator &key_comparator,
+                    const KeyEqualityChecker &key_equality_checker,
+                    const ValueEqualityChecker &value_equality_checker)
+    : key_comparator_(key_comparator),
+      key_equality_checker_(key_equality_checker),
+      value_equality_checker_(value_equality_checker),
+      root_pid_(INVALID_PID),
+      next_pid_(0) {
+  for (size_t chunk_itr = 0; chunk_itr < mapping_directory_size_;
+       chunk_itr++) {
+    mapping_table_[chunk_itr] = nullptr;
+  }
+
+  // The tree starts out as a single empty leaf page
+  root_pid_ = AllocatePid(new LeafNode(nullptr, nullptr, INVALID_PID));
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+BWTREE_TYPE::~BWTree() {
+  // No other thread can access the tree any more,
+  // so we can free every page still in the mapping table
+  ValueDeleter value_deleter;
+  auto pid_count = next_pid_.load();
+
+  for (PID pid = 0; pid < pid_count; pid++) {
+    auto node = GetNode(pid);
+    if (node == nullptr) continue;
+
+    if (node->type == NODE_TYPE_INNER) {
+      delete node;
+      continue;
+    }
+
+    // Values are shared between split siblings until consolidation,
+    // so only release the ones that belong to this page
+    std::vector<KeyValuePair> items;
+    std::vector<ValueType> dropped_values;
+    MaterializeLeaf(node, items, dropped_values);
+    for (auto &item : items) value_deleter(item.second);
+    for (auto &value : dropped_values) value_deleter(value);
+
+    FreeChain(node);
+  }
+
+  for (size_t chunk_itr = 0; chunk_itr < mapping_directory_size_;
+       chunk_itr++) {
+    delete[] mapping_table_[chunk_itr].load();
+  }
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+std::atomic<const typename BWTREE_TYPE::Node *> &BWTREE_TYPE::GetMappingSlot(
+    PID pid) {
+  auto chunk_id = pid >> mapping_chunk_bits_;
+  auto chunk_offset = pid & (mapping_chunk_size_ - 1);
+
+  auto chunk = mapping_table_[chunk_id].load();
+  if (chunk == nullptr) {
+    auto new_chunk = new std::atomic<const Node *>[mapping_chunk_size_];
+    for (size_t slot_itr = 0; slot_itr < mapping_chunk_size_; slot_itr++) {
+      new_chunk[slot_itr] = nullptr;
+    }
+
+    if (mapping_table_[chunk_id].compare_exchange_strong(chunk, new_chunk)) {
+      chunk = new_chunk;
+    } else {
+      // someone else installed the chunk
+      delete[] new_chunk;
+    }
+  }
+
+  return chunk[chunk_offset];
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+typename BWTREE_TYPE::PID BWTREE_TYPE::AllocatePid(const Node *node) {
+  auto pid = next_pid_.fetch_add(1);
+  if (pid >= mapping_directory_size_ * mapping_chunk_size_) {
+    throw IndexException("BWTree mapping table is full");
+  }
+
+  GetMappingSlot(pid).store(node);
+  return pid;
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+size_t BWTREE_TYPE::GetChildIndex(const InnerNode *node,
+                                  const KeyType &key) const {
+  // first child whose separator is greater than the key
+  auto itr = std::upper_bound(
+      node->children.begin() + 1, node->children.end(), key,
+      [this](const KeyType &lhs, const std::pair<KeyType, PID> &rhs) {
+        return KeyLess(lhs, rhs.first);
+      });
+
+  return std::distance(node->children.begin(), itr) - 1;
+}
+
+//===--------------------------------------------------------------------===//
+// Mutators
+//===--------------------------------------------------------------------===//
+
+BWTREE_TEMPLATE_ARGUMENTS
+void BWTREE_TYPE::Insert(const KeyType &key, const ValueType &value) {
+  {
+    EpochGuard guard(epoch_manager_);
+
+    PID leaf_pid;
+    const Node *leaf_head;
+    const Node *delta;
+
+    while (true) {
+      FindLeaf(&key, leaf_pid, leaf_head);
+
+      delta = new LeafInsertDelta(key, value, leaf_head);
+      if (InstallNode(leaf_pid, leaf_head, delta) == true) break;
+
+      delete delta;
+    }
+
+    if (delta->depth >= max_delta_chain_length_) {
+      ConsolidateLeaf(leaf_pid);
+    }
+  }
+
+  epoch_manager_.MaybeReclaim();
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+bool BWTREE_TYPE::ConditionalInsert(
+    const KeyType &key, const ValueType &value,
+    std::function<bool(const ValueType &)> predicate) {
+  bool inserted = false;
+
+  {
+    EpochGuard guard(epoch_manager_);
+
+    PID leaf_pid;
+    const Node *leaf_head;
+    const Node *delta = nullptr;
+    std::vector<ValueType> values;
+
+    while (true) {
+      FindLeaf(&key, leaf_pid, leaf_head);
+
+      // The check and the insert are atomic as we install the delta
+      // on top of the exact chain we have checked
+      values.clear();
+      CollectValues(leaf_head, key, values);
+
+      bool satisfied = false;
+      for (auto &existing_value : values) {
+        if (predicate(existing_value) == true) {
+          satisfied = true;
+          break;
+        }
+      }
+      if (satisfied == true) break;
+
+      delta = new LeafInsertDelta(key, value, leaf_head);
+      if (InstallNode(leaf_pid, leaf_head, delta) == true) {
+        inserted = true;
+        break;
+      }
+
+      delete delta;
+    }
+
+    if (inserted == true && delta->depth >= max_delta_chain_length_) {
+      ConsolidateLeaf(leaf_pid);
+    }
+  }
+
+  epoch_manager_.MaybeReclaim();
+  return inserted;
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+bool BWTREE_TYPE::Delete(const KeyType &key, const ValueType &value) {
+  bool deleted = false;
+
+  {
+    EpochGuard guard(epoch_manager_);
+
+    PID leaf_pid;
+    const Node *leaf_head;
+    const Node *delta = nullptr;
+    std::vector<ValueType> values;
+
+    while (true) {
+      FindLeaf(&key, leaf_pid, leaf_head);
+
+      // Skip the delta record if there is nothing to delete
+      values.clear();
+      CollectValues(leaf_head, key, values);
+
+      bool found = false;
+      for (auto &existing_value : values) {
+        if (ValueEqual(existing_value, value) == true) {
+          found = true;
+          break;
+        }
+      }
+      if (found == false) break;
+
+      delta = new LeafDeleteDelta(key, value, leaf_head);
+      if (InstallNode(leaf_pid, leaf_head, delta) == true) {
+        deleted = true;
+        break;
+      }
+
+      delete delta;
+    }
+
+    if (deleted == true && delta->depth >= max_delta_chain_length_) {
+      ConsolidateLeaf(leaf_pid);
+    }
+  }
+
+  epoch_manager_.MaybeReclaim();
+  return deleted;
+}
+
+//===--------------------------------------------------------------------===//
+// Accessors
+//===--------------------------------------------------------------------===//
+
+BWTREE_TEMPLATE_ARGUMENTS
+void BWTREE_TYPE::GetValue(const KeyType &key,
+                           std::vector<ValueType> &result) {
+  EpochGuard guard(epoch_manager_);
+
+  PID leaf_pid;
+  const Node *leaf_head;
+  FindLeaf(&key, leaf_pid, leaf_head);
+
+  CollectValues(leaf_head, key, result);
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+void BWTREE_TYPE::ScanFrom(
+    const KeyType *start_key,
+    std::function<bool(const KeyType &, const ValueType &)> callback) {
+  EpochGuard guard(epoch_manager_);
+
+  PID leaf_pid;
+  const Node *leaf_head;
+  FindLeaf(start_key, leaf_pid, leaf_head);
+
+  std::vector<KeyValuePair> items;
+  std::vector<ValueType> dropped_values;
+
+  // Keys below resume_key have already been visited
+  KeyType resume_key;
+  bool resume = false;
+  if (start_key != nullptr) {
+    resume_key = *start_key;
+    resume = true;
+  }
+
+  while (true) {
+    items.clear();
+    dropped_values.clear();
+    MaterializeLeaf(leaf_head, items, dropped_values);
+
+    for (auto &item : items) {
+      if (resume == true && KeyLess(item.first, resume_key)) continue;
+
+      if (callback(item.first, item.second) == false) return;
+    }
+
+    if (leaf_head->high_key == nullptr) return;
+
+    // Re-descend instead of following the sibling link,
+    // as the sibling might have been split or merged meanwhile
+    resume_key = *leaf_head->high_key;
+    resume = true;
+    FindLeaf(&resume_key, leaf_pid, leaf_head);
+  }
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+void BWTREE_TYPE::PerformGarbageCollection() { epoch_manager_.Reclaim(); }
+
+//===--------------------------------------------------------------------===//
+// Traversal
+//===--------------------------------------------------------------------===//
+
+BWTREE_TEMPLATE_ARGUMENTS
+void BWTREE_TYPE::FindLeaf(const KeyType *key, PID &leaf_pid,
+                           const Node *&leaf_head) {
+restart:
+  PID pid = root_pid_.load();
+
+  while (true) {
+    const Node *node = GetNode(pid);
+
+    // The page was merged away after we read its parent
+    if (node == nullptr) goto restart;
+
+    if (node->type == NODE_TYPE_LEAF_REMOVE) {
+      HelpRemovedLeaf(node);
+      goto restart;
+    }
+
+    // Leftmost descent
+    if (key == nullptr) {
+      if (node->low_key != nullptr) goto restart;
+    } else {
+      // Stale parent, should not happen unless we raced with a merge
+      if (AboveLowKey(node, *key) == false) goto restart;
+
+      // Move right if the page has been split (B-link)
+      if (BelowHighKey(node, *key) == false) {
+        pid = node->next_pid;
+        continue;
+      }
+    }
+
+    if (node->type == NODE_TYPE_INNER) {
+      auto inner_node = static_cast<const InnerNode *>(node);
+
+      // Finish structure modifications we run into
+      if (inner_node->merge_pending == true) {
+        CompleteMerge(pid, inner_node);
+        goto restart;
+      }
+      if (inner_node->split_pending == true) {
+        CompleteSplit(inner_node->level, *inner_node->high_key, pid,
+                      inner_node->split_right_pid);
+        ClearSplitPending(pid, inner_node);
+      }
+
+      if (key == nullptr) {
+        pid = inner_node->children.front().second;
+      } else {
+        pid = inner_node->children[GetChildIndex(inner_node, *key)].second;
+      }
+      continue;
+    }
+
+    if (node->type == NODE_TYPE_LEAF_SPLIT) {
+      auto split_delta = static_cast<const LeafSplitDelta *>(node);
+      CompleteSplit(0, split_delta->split_key, pid, split_delta->next_pid);
+    }
+
+    leaf_pid = pid;
+    leaf_head = node;
+    return;
+  }
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+typename BWTREE_TYPE::PID BWTREE_TYPE::FindInnerNode(const KeyType &key,
+                                                     uint32_t level) {
+  PID pid = root_pid_.load();
+
+  while (true) {
+    const Node *node = GetNode(pid);
+    if (node == nullptr) {
+      pid = root_pid_.load();
+      continue;
+    }
+
+    if (node->level < level) return INVALID_PID;
+
+    if (BelowHighKey(node, key) == false) {
+      pid = node->next_pid;
+      continue;
+    }
+
+    if (node->level == level) return pid;
+
+    auto inner_node = static_cast<const InnerNode *>(node);
+    pid = inner_node->children[GetChildIndex(inner_node, key)].second;
+  }
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+void BWTREE_TYPE::CollectValues(const Node *node, const KeyType &key,
+                                std::vector<ValueType> &result) const {
+  // Deletes mask every matching pair below them in the chain
+  std::vector<ValueType> deleted_values;
+
+  auto is_deleted = [this, &deleted_values](const ValueType &value) {
+    for (auto &deleted_value : deleted_values) {
+      if (ValueEqual(deleted_value, value) == true) return true;
+    }
+    return false;
+  };
+
+  while (true) {
+    switch (node->type) {
+      case NODE_TYPE_LEAF: {
+        auto leaf = static_cast<const LeafNode *>(node);
+        auto itr = std::lower_bound(
+            leaf->items.begin(), leaf->items.end(), key,
+            [this](const KeyValuePair &lhs, const KeyType &rhs) {
+              return KeyLess(lhs.first, rhs);
+            });
+
+        for (; itr != leaf->items.end() && KeyEqual(itr->first, key);
+             itr++) {
+          if (is_deleted(itr->second) == false) result.push_back(itr->second);
+        }
+        return;
+      }
+
+      case NODE_TYPE_LEAF_INSERT: {
+        auto delta = static_cast<const LeafInsertDelta *>(node);
+        if (KeyEqual(delta->item.first, key) &&
+            is_deleted(delta->item.second) == false) {
+          result.push_back(delta->item.second);
+        }
+        node = delta->child;
+      } break;
+
+      case NODE_TYPE_LEAF_DELETE: {
+        auto delta = static_cast<const LeafDeleteDelta *>(node);
+        if (KeyEqual(delta->item.first, key)) {
+          deleted_values.push_back(delta->item.second);
+        }
+        node = delta->child;
+      } break;
+
+      case NODE_TYPE_LEAF_SPLIT:
+        node = static_cast<const LeafSplitDelta *>(node)->child;
+        break;
+
+      case NODE_TYPE_LEAF_REMOVE:
+        node = static_cast<const LeafRemoveDelta *>(node)->child;
+        break;
+
+      case NODE_TYPE_LEAF_MERGE: {
+        auto delta = static_cast<const LeafMergeDelta *>(node);
+        if (KeyLess(key, *delta->merge_key)) {
+          node = delta->child;
+        } else {
+          node = delta->merged_node;
+        }
+      } break;
+
+      default:
+        throw IndexException("Unexpected node type in BWTree leaf chain");
+    }
+  }
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+void BWTREE_TYPE::MaterializeLeaf(const Node *node,
+                                  std::vector<KeyValuePair> &items,
+                                  std::vector<ValueType> &dropped_values)
+    const {
+  // Replay the chain bottom-up
+  std::vector<const Node *> chain;
+  while (node->type != NODE_TYPE_LEAF) {
+    chain.push_back(node);
+    switch (node->type) {
+      case NODE_TYPE_LEAF_INSERT:
+        node = static_cast<const LeafInsertDelta *>(node)->child;
+        break;
+      case NODE_TYPE_LEAF_DELETE:
+        node = static_cast<const LeafDeleteDelta *>(node)->child;
+        break;
+      case NODE_TYPE_LEAF_SPLIT:
+        node = static_cast<const LeafSplitDelta *>(node)->child;
+        break;
+      case NODE_TYPE_LEAF_REMOVE:
+        node = static_cast<const LeafRemoveDelta *>(node)->child;
+        break;
+      case NODE_TYPE_LEAF_MERGE:
+        node = static_cast<const LeafMergeDelta *>(node)->child;
+        break;
+      default:
+        throw IndexException("Unexpected node type in BWTree leaf chain");
+    }
+  }
+
+  auto base = static_cast<const LeafNode *>(node);
+  items.insert(items.end(), base->items.begin(), base->items.end());
+
+  for (auto chain_itr = chain.rbegin(); chain_itr != chain.rend();
+       chain_itr++) {
+    auto delta_node = *chain_itr;
+
+    switch (delta_node->type) {
+      case NODE_TYPE_LEAF_INSERT:
+        items.push_back(
+            static_cast<const LeafInsertDelta *>(delta_node)->item);
+        break;
+
+      case NODE_TYPE_LEAF_DELETE: {
+        auto &deleted_item =
+            static_cast<const LeafDeleteDelta *>(delta_node)->item;
+        auto new_end = std::remove_if(
+            items.begin(), items.end(),
+            [this, &deleted_item, &dropped_values](const KeyValuePair &item) {
+              if (KeyEqual(item.first, deleted_item.first) &&
+                  ValueEqual(item.second, deleted_item.second)) {
+                dropped_values.push_back(item.second);
+                return true;
+              }
+              return false;
+            });
+        items.erase(new_end, items.end());
+        dropped_values.push_back(deleted_item.second);
+      } break;
+
+      case NODE_TYPE_LEAF_SPLIT: {
+        // The upper half lives in the right sibling now
+        auto &split_key =
+            static_cast<const LeafSplitDelta *>(delta_node)->split_key;
+        auto new_end = std::remove_if(
+            items.begin(), items.end(),
+            [this, &split_key](const KeyValuePair &item) {
+              return KeyLess(item.first, split_key) == false;
+            });
+        items.erase(new_end, items.end());
+      } break;
+
+      case NODE_TYPE_LEAF_MERGE:
+        MaterializeLeaf(
+            static_cast<const LeafMergeDelta *>(delta_node)->merged_node,
+            items, dropped_values);
+        break;
+
+      default:
+        break;
+    }
+  }
+
+  std::stable_sort(items.begin(), items.end(),
+                   [this](const KeyValuePair &lhs, const KeyValuePair &rhs) {
+                     return KeyLess(lhs.first, rhs.first);
+                   });
+}
+
+//===--------------------------------------------------------------------===//
+// Structure modifications
+//===--------------------------------------------------------------------===//
+
+BWTREE_TEMPLATE_ARGUMENTS
+void BWTREE_TYPE::ConsolidateLeaf(PID pid) {
+  const Node *head = GetNode(pid);
+  if (head == nullptr || head->type == NODE_TYPE_LEAF ||
+      head->type == NODE_TYPE_LEAF_REMOVE) {
+    return;
+  }
+
+  // Consolidation erases split deltas, so their separators
+  // must reach the parent first
+  std::vector<const Node *> pending_nodes = {head};
+  while (pending_nodes.empty() == false) {
+    auto node = pending_nodes.back();
+    pending_nodes.pop_back();
+
+    while (node->type != NODE_TYPE_LEAF) {
+      switch (node->type) {
+        case NODE_TYPE_LEAF_INSERT:
+          node = static_cast<const LeafInsertDelta *>(node)->child;
+          break;
+        case NODE_TYPE_LEAF_DELETE:
+          node = static_cast<const LeafDeleteDelta *>(node)->child;
+          break;
+        case NODE_TYPE_LEAF_REMOVE:
+          node = static_cast<const LeafRemoveDelta *>(node)->child;
+          break;
+        case NODE_TYPE_LEAF_SPLIT: {
+          auto split_delta = static_cast<const LeafSplitDelta *>(node);
+          CompleteSplit(0, split_delta->split_key, pid,
+                        split_delta->next_pid);
+          node = split_delta->child;
+        } break;
+        case NODE_TYPE_LEAF_MERGE: {
+          auto merge_delta = static_cast<const LeafMergeDelta *>(node);
+          pending_nodes.push_back(merge_delta->merged_node);
+          node = merge_delta->child;
+        } break;
+        default:
+          throw IndexException("Unexpected node type in BWTree leaf chain");
+      }
+    }
+  }
+
+  auto leaf = new LeafNode(head->low_key, head->high_key, head->next_pid);
+  std::vector<ValueType> dropped_values;
+  MaterializeLeaf(head, leaf->items, dropped_values);
+  leaf->item_count = leaf->items.size();
+
+  if (InstallNode(pid, head, leaf) == false) {
+    // Someone else changed the page, it will be consolidated later
+    delete leaf;
+    return;
+  }
+
+  RetireChain(head, std::move(dropped_values));
+
+  if (leaf->items.size() > leaf_node_max_size_) {
+    SplitLeaf(pid, leaf);
+  } else if (leaf->items.size() < leaf_node_min_size_) {
+    TryMergeLeaf(pid, leaf);
+  }
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+void BWTREE_TYPE::SplitLeaf(PID pid, const LeafNode *leaf) {
+  auto &items = leaf->items;
+
+  // Keep all the pairs of a key on the same page
+  size_t split_itr = items.size() / 2;
+  while (split_itr < items.size() &&
+         KeyEqual(items[split_itr].first, items[split_itr - 1].first)) {
+    split_itr++;
+  }
+  if (split_itr == items.size()) {
+    split_itr = items.size() / 2;
+    while (split_itr > 0 &&
+           KeyEqual(items[split_itr].first, items[split_itr - 1].first)) {
+      split_itr--;
+    }
+    // Every pair has the same key
+    if (split_itr == 0) return;
+  }
+
+  const KeyType &split_key = items[split_itr].first;
+
+  auto right_leaf = new LeafNode(&split_key, leaf->high_key, leaf->next_pid);
+  right_leaf->items.assign(items.begin() + split_itr, items.end());
+  right_leaf->item_count = right_leaf->items.size();
+  auto right_pid = AllocatePid(right_leaf);
+
+  auto split_delta = new LeafSplitDelta(split_key, right_pid,
+                                        right_leaf->item_count, leaf);
+
+  if (InstallNode(pid, leaf, split_delta) == false) {
+    // The right page was never visible to anyone else
+    GetMappingSlot(right_pid).store(nullptr);
+    delete split_delta;
+    delete right_leaf;
+    return;
+  }
+
+  CompleteSplit(0, split_delta->split_key, pid, right_pid);
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+void BWTREE_TYPE::SplitInner(PID pid, const InnerNode *node) {
+  auto split_itr = node->children.size() / 2;
+  const KeyType &split_key = node->children[split_itr].first;
+
+  auto right_node =
+      new InnerNode(node->level, &split_key, node->high_key, node->next_pid);
+  right_node->children.assign(node->children.begin() + split_itr,
+                              node->children.end());
+  auto right_pid = AllocatePid(right_node);
+
+  auto left_node =
+      new InnerNode(node->level, node->low_key, &split_key, right_pid);
+  left_node->children.assign(node->children.begin(),
+                             node->children.begin() + split_itr);
+  left_node->split_pending = true;
+  left_node->split_right_pid = right_pid;
+
+  if (InstallNode(pid, node, left_node) == false) {
+    GetMappingSlot(right_pid).store(nullptr);
+    delete left_node;
+    delete right_node;
+    return;
+  }
+
+  RetireInnerNode(node);
+
+  CompleteSplit(left_node->level, *left_node->high_key, pid, right_pid);
+  ClearSplitPending(pid, left_node);
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+void BWTREE_TYPE::CompleteSplit(uint32_t level, const KeyType &split_key,
+                                PID left_pid, PID right_pid) {
+  while (true) {
+    auto parent_pid = FindInnerNode(split_key, level + 1);
+
+    // The split page is the root, grow the tree
+    if (parent_pid == INVALID_PID) {
+      if (root_pid_.load() != left_pid) continue;
+
+      auto root_node = new InnerNode(level + 1, nullptr, nullptr, INVALID_PID);
+      root_node->children.emplace_back(split_key, left_pid);
+      root_node->children.emplace_back(split_key, right_pid);
+      auto root_pid = AllocatePid(root_node);
+
+      PID expected_pid = left_pid;
+      if (root_pid_.compare_exchange_strong(expected_pid, root_pid)) return;
+
+      GetMappingSlot(root_pid).store(nullptr);
+      delete root_node;
+      continue;
+    }
+
+    auto parent = static_cast<const InnerNode *>(GetNode(parent_pid));
+    if (HelpInnerNode(parent_pid, parent) == false) continue;
+
+    // Already posted
+    auto child_itr = GetChildIndex(parent, split_key);
+    if (parent->children[child_itr].second == right_pid) return;
+
+    // Posted and merged away since
+    auto right_node = GetNode(right_pid);
+    if (right_node == nullptr || right_node->type == NODE_TYPE_LEAF_REMOVE) {
+      return;
+    }
+
+    auto new_parent = CopyInnerNode(parent);
+    new_parent->children.emplace(new_parent->children.begin() + child_itr + 1,
+                                 split_key, right_pid);
+
+    if (InstallNode(parent_pid, parent, new_parent) == false) {
+      delete new_parent;
+      continue;
+    }
+
+    RetireInnerNode(parent);
+
+    if (new_parent->children.size() > inner_node_max_size_) {
+      SplitInner(parent_pid, new_parent);
+    }
+    return;
+  }
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+void BWTREE_TYPE::TryMergeLeaf(PID pid, const LeafNode *leaf) {
+  // The leftmost page has no left sibling to merge into
+  if (leaf->low_key == nullptr) return;
+
+  auto parent_pid = FindInnerNode(*leaf->low_key, 1);
+  if (parent_pid == INVALID_PID) return;
+
+  auto parent = static_cast<const InnerNode *>(GetNode(parent_pid));
+  if (parent->split_pending == true || parent->merge_pending == true) return;
+
+  // Only merge siblings sharing the same parent
+  auto child_itr = GetChildIndex(parent, *leaf->low_key);
+  if (child_itr == 0 || parent->children[child_itr].second != pid) return;
+
+  auto left_pid = parent->children[child_itr - 1].second;
+  auto left_node = GetNode(left_pid);
+  if (left_node == nullptr ||
+      left_node->item_count + leaf->item_count > leaf_node_max_size_) {
+    return;
+  }
+
+  auto new_parent = CopyInnerNode(parent);
+  new_parent->merge_pending = true;
+  new_parent->merge_left_pid = left_pid;
+  new_parent->merge_right_pid = pid;
+
+  if (InstallNode(parent_pid, parent, new_parent) == false) {
+    delete new_parent;
+    return;
+  }
+
+  RetireInnerNode(parent);
+
+  CompleteMerge(parent_pid, new_parent);
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+void BWTREE_TYPE::CompleteMerge(PID parent_pid, const InnerNode *parent) {
+  auto left_pid = parent->merge_left_pid;
+  auto right_pid = parent->merge_right_pid;
+
+  // Freeze the right page
+  const Node *removed = nullptr;
+  while (true) {
+    auto right_head = GetNode(right_pid);
+    if (right_head == nullptr) return;
+
+    if (right_head->type == NODE_TYPE_LEAF_REMOVE) {
+      removed = right_head;
+      break;
+    }
+
+    auto remove_delta = new LeafRemoveDelta(right_head);
+    if (InstallNode(right_pid, right_head, remove_delta) == true) {
+      removed = remove_delta;
+      break;
+    }
+    delete remove_delta;
+  }
+
+  const KeyType &merge_key = *removed->low_key;
+
+  // Let the left sibling absorb it. The left page may have been split
+  // since, so move right until we reach the page adjacent to it.
+  PID pid = left_pid;
+  while (true) {
+    auto left_head = GetNode(pid);
+    if (left_head == nullptr) return;
+
+    // Already absorbed
+    if (BelowHighKey(left_head, merge_key) == true) break;
+
+    if (left_head->next_pid != right_pid) {
+      pid = left_head->next_pid;
+      continue;
+    }
+
+    auto merge_delta = new LeafMergeDelta(removed, left_head);
+    if (InstallNode(pid, left_head, merge_delta) == true) break;
+    delete merge_delta;
+  }
+
+  // Drop the separator of the right page from the parent
+  while (true) {
+    if (parent->merge_pending == false ||
+        parent->merge_right_pid != right_pid) {
+      return;
+    }
+
+    auto new_parent = CopyInnerNode(parent);
+    auto child_itr = GetChildIndex(new_parent, merge_key);
+    if (new_parent->children[child_itr].second == right_pid) {
+      new_parent->children.erase(new_parent->children.begin() + child_itr);
+    }
+
+    if (InstallNode(parent_pid, parent, new_parent) == true) {
+      RetireInnerNode(parent);
+      // The frozen chain is owned by the left sibling now
+      GetMappingSlot(right_pid).store(nullptr);
+      return;
+    }
+
+    delete new_parent;
+    parent = static_cast<const InnerNode *>(GetNode(parent_pid));
+  }
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+void BWTREE_TYPE::HelpRemovedLeaf(const Node *removed) {
+  auto parent_pid = FindInnerNode(*removed->low_key, 1);
+  if (parent_pid == INVALID_PID) return;
+
+  auto parent = static_cast<const InnerNode *>(GetNode(parent_pid));
+  if (parent->merge_pending == true) {
+    CompleteMerge(parent_pid, parent);
+  }
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+bool BWTREE_TYPE::HelpInnerNode(PID pid, const InnerNode *node) {
+  if (node->merge_pending == true) {
+    CompleteMerge(pid, node);
+    return false;
+  }
+
+  if (node->split_pending == true) {
+    CompleteSplit(node->level, *node->high_key, pid, node->split_right_pid);
+  }
+
+  return true;
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+typename BWTREE_TYPE::InnerNode *BWTREE_TYPE::CopyInnerNode(
+    const InnerNode *node) const {
+  auto new_node = new InnerNode(node->level, node->low_key, node->high_key,
+                                node->next_pid);
+  new_node->children = node->children;
+  return new_node;
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+void BWTREE_TYPE::ClearSplitPending(PID pid, const InnerNode *node) {
+  auto new_node = CopyInnerNode(node);
+  if (InstallNode(pid, node, new_node) == true) {
+    RetireInnerNode(node);
+  } else {
+    // The image was rewritten meanwhile, which drops the flag anyway
+    delete new_node;
+  }
+}
+
+//===--------------------------------------------------------------------===//
+// Reclamation
+//===--------------------------------------------------------------------===//
+
+BWTREE_TEMPLATE_ARGUMENTS
+void BWTREE_TYPE::RetireChain(const Node *head,
+                              std::vector<ValueType> &&dropped_values) {
+  auto retired_chain = new RetiredChain();
+  retired_chain->head = head;
+  retired_chain->dropped_values = std::move(dropped_values);
+
+  epoch_manager_.Retire(retired_chain, &BWTREE_TYPE::DeleteRetiredChain);
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+void BWTREE_TYPE::RetireInnerNode(const InnerNode *node) {
+  epoch_manager_.Retire(const_cast<InnerNode *>(node),
+                        &BWTREE_TYPE::DeleteInnerNode);
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+void BWTREE_TYPE::DeleteRetiredChain(void *object) {
+  auto retired_chain = static_cast<RetiredChain *>(object);
+
+  ValueDeleter value_deleter;
+  for (auto &value : retired_chain->dropped_values) value_deleter(value);
+
+  FreeChain(retired_chain->head);
+  delete retired_chain;
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+void BWTREE_TYPE::DeleteInnerNode(void *object) {
+  delete static_cast<InnerNode *>(object);
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+void BWTREE_TYPE::FreeChain(const Node *node) {
+  while (node != nullptr) {
+    const Node *child = nullptr;
+
+    switch (node->type) {
+      case NODE_TYPE_LEAF_INSERT:
+        child = static_cast<const LeafInsertDelta *>(node)->child;
+        break;
+      case NODE_TYPE_LEAF_DELETE:
+        child = static_cast<const LeafDeleteDelta *>(node)->child;
+        break;
+      case NODE_TYPE_LEAF_SPLIT:
+        child = static_cast<const LeafSplitDelta *>(node)->child;
+        break;
+      case NODE_TYPE_LEAF_REMOVE:
+        child = static_cast<const LeafRemoveDelta *>(node)->child;
+        break;
+      case NODE_TYPE_LEAF_MERGE: {
+        auto merge_delta = static_cast<const LeafMergeDelta *>(node);
+        FreeChain(merge_delta->merged_node);
+        child = merge_delta->child;
+      } break;
+      default:
+        break;
+    }
+
+    delete node;
+    node = child;
+  }
+}
+
+#undef BWTREE_TEMPLATE_ARGUMENTS
+#undef BWTREE_TYPE
+
 }  // End index namespace
-}  // End peloton namespace
\ No newline at end of file
+}  // End peloton namespace
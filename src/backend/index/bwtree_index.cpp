@@ -22,92 +22,248 @@ template <typename KeyType, typename ValueType, class KeyComparator,
           class KeyEqualityChecker>
 BWTreeIndex<KeyType, ValueType, KeyComparator, KeyEqualityChecker>::BWTreeIndex(
     IndexMetadata *metadata)
-    : Index(metadata), equals(metadata), comparator(metadata) {
-  // Add your implementation here
-}
+    : Index(metadata),
+      container(KeyComparator(metadata), KeyEqualityChecker(metadata)),
+      equals(metadata),
+      comparator(metadata) {}
 
 template <typename KeyType, typename ValueType, class KeyComparator,
           class KeyEqualityChecker>
 BWTreeIndex<KeyType, ValueType, KeyComparator,
             KeyEqualityChecker>::~BWTreeIndex() {
-  // Add your implementation here
+  // the container owns the item pointers and frees them on destruction
 }
 
 template <typename KeyType, typename ValueType, class KeyComparator,
           class KeyEqualityChecker>
 bool BWTreeIndex<KeyType, ValueType, KeyComparator,
-                 KeyEqualityChecker>::InsertEntry(__attribute__((unused)) const
-                                                  storage::Tuple *key,
-                                                  __attribute__((unused)) const
-                                                  ItemPointer &location) {
-  // Add your implementation here
-  return false;
+                 KeyEqualityChecker>::InsertEntry(const storage::Tuple *key,
+                                                  const ItemPointer &location) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  // Insert the key, val pair
+  container.Insert(index_key, new ItemPointer(location));
+
+  return true;
 }
 
 template <typename KeyType, typename ValueType, class KeyComparator,
           class KeyEqualityChecker>
 bool BWTreeIndex<KeyType, ValueType, KeyComparator,
-                 KeyEqualityChecker>::DeleteEntry(__attribute__((unused)) const
-                                                  storage::Tuple *key,
-                                                  __attribute__((unused)) const
-                                                  ItemPointer &location) {
-  // Add your implementation here
-  return false;
+                 KeyEqualityChecker>::DeleteEntry(const storage::Tuple *key,
+                                                  const ItemPointer &location) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  // Delete all the < key, location > pairs.
+  // The delete delta keeps the value, so it is handed over to the container.
+  auto value = new ItemPointer(location);
+  if (container.Delete(index_key, value) == false) {
+    delete value;
+  }
+
+  return true;
 }
 
 template <typename KeyType, typename ValueType, class KeyComparator,
           class KeyEqualityChecker>
 bool BWTreeIndex<KeyType, ValueType, KeyComparator,
                  KeyEqualityChecker>::CondInsertEntry(
-    __attribute__((unused)) const storage::Tuple *key,
-    __attribute__((unused)) const ItemPointer &location, __attribute__((unused))
+    const storage::Tuple *key, const ItemPointer &location,
     std::function<bool(const ItemPointer &)> predicate) {
-  return false;
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  auto value = new ItemPointer(location);
+  auto inserted = container.ConditionalInsert(
+      index_key, value, [&predicate](ItemPointer *const &item_pointer) {
+        return predicate(*item_pointer);
+      });
+
+  // this key is already visible or dirty in the index
+  if (inserted == false) {
+    delete value;
+  }
+
+  return inserted;
+}
+
+template <typename KeyType, typename ValueType, class KeyComparator,
+          class KeyEqualityChecker>
+void BWTreeIndex<KeyType, ValueType, KeyComparator,
+                 KeyEqualityChecker>::ScanEntries(
+    const std::vector<Value> &values, const std::vector<oid_t> &key_column_ids,
+    const std::vector<ExpressionType> &expr_types,
+    const ScanDirectionType &scan_direction, const size_t limit,
+    std::function<void(ItemPointer *)> visitor) {
+  KeyType index_key;
+  KeyType *scan_begin_key = nullptr;
+  std::unique_ptr<storage::Tuple> start_key;
+
+  // The bounds of the leading key columns delimit the range to scan
+  // refer : http://www.postgresql.org/docs/8.2/static/indexes-multicolumn.html
+  std::vector<Value> lower_bound_prefix;
+  std::vector<Value> upper_bound_prefix;
+  ConstructBoundPrefix(values, key_column_ids, expr_types, false,
+                       lower_bound_prefix);
+  ConstructBoundPrefix(values, key_column_ids, expr_types, true,
+                       upper_bound_prefix);
+
+  LOG_TRACE("Bounded columns : %lu %lu", lower_bound_prefix.size(),
+            upper_bound_prefix.size());
+
+  // Seek to the lower bound
+  if (lower_bound_prefix.empty() == false) {
+    start_key.reset(new storage::Tuple(metadata->GetKeySchema(), true));
+    ConstructLowerBoundTuple(start_key.get(), values, key_column_ids,
+                             expr_types);
+
+    index_key.SetFromKey(start_key.get());
+    scan_begin_key = &index_key;
+  }
+
+  // The container only iterates forward, so a backward scan collects the
+  // whole range first and visits it in reverse
+  bool backward = (scan_direction == SCAN_DIRECTION_TYPE_BACKWARD);
+  std::vector<ItemPointer *> matches;
+  size_t match_count = 0;
+
+  container.ScanFrom(scan_begin_key, [&](const KeyType &key,
+                                         ItemPointer *const &item_pointer) {
+    auto scan_current_key = key;
+    auto tuple =
+        scan_current_key.GetTupleForComparison(metadata->GetKeySchema());
+
+    // No key past the upper bound can match
+    if (IsPastScanEnd(tuple, upper_bound_prefix,
+                      SCAN_DIRECTION_TYPE_FORWARD) == true) {
+      return false;
+    }
+
+    // Compare the current key in the scan with "values" based on
+    // "expression types"
+    // For instance, "5" EXPR_GREATER_THAN "2" is true
+    if (Compare(tuple, key_column_ids, expr_types, values) == false) {
+      return true;
+    }
+
+    if (backward == true) {
+      matches.push_back(item_pointer);
+      return true;
+    }
+
+    visitor(item_pointer);
+    match_count++;
+    return (limit == 0 || match_count < limit);
+  });
+
+  for (auto match_itr = matches.rbegin(); match_itr != matches.rend() &&
+                                          (limit == 0 || match_count < limit);
+       match_itr++) {
+    visitor(*match_itr);
+    match_count++;
+  }
 }
 
 template <typename KeyType, typename ValueType, class KeyComparator,
           class KeyEqualityChecker>
 void BWTreeIndex<KeyType, ValueType, KeyComparator, KeyEqualityChecker>::Scan(
-    __attribute__((unused)) const std::vector<Value> &values,
-    __attribute__((unused)) const std::vector<oid_t> &key_column_ids,
-    __attribute__((unused)) const std::vector<ExpressionType> &expr_types,
-    __attribute__((unused)) const ScanDirectionType &scan_direction,
-    __attribute__((unused)) std::vector<ItemPointer> &result) {}
+    const std::vector<Value> &values, const std::vector<oid_t> &key_column_ids,
+    const std::vector<ExpressionType> &expr_types,
+    const ScanDirectionType &scan_direction, std::vector<ItemPointer> &result,
+    const size_t limit) {
+  switch (scan_direction) {
+    case SCAN_DIRECTION_TYPE_FORWARD:
+    case SCAN_DIRECTION_TYPE_BACKWARD: {
+      ScanEntries(values, key_column_ids, expr_types, scan_direction, limit,
+                  [&result](ItemPointer *item_pointer) {
+                    result.push_back(*item_pointer);
+                  });
+    } break;
+
+    case SCAN_DIRECTION_TYPE_INVALID:
+    default:
+      throw Exception("Invalid scan direction \n");
+      break;
+  }
+}
 
 template <typename KeyType, typename ValueType, class KeyComparator,
           class KeyEqualityChecker>
 void
 BWTreeIndex<KeyType, ValueType, KeyComparator, KeyEqualityChecker>::ScanAllKeys(
-    __attribute__((unused)) std::vector<ItemPointer> &result) {}
+    std::vector<ItemPointer> &result) {
+  container.ScanFrom(nullptr, [&result](const KeyType &,
+                                        ItemPointer *const &item_pointer) {
+    result.push_back(*item_pointer);
+    return true;
+  });
+}
 
 template <typename KeyType, typename ValueType, class KeyComparator,
           class KeyEqualityChecker>
 void
 BWTreeIndex<KeyType, ValueType, KeyComparator, KeyEqualityChecker>::ScanKey(
-    __attribute__((unused)) const storage::Tuple *key,
-    __attribute__((unused)) std::vector<ItemPointer> &result) {}
+    const storage::Tuple *key, std::vector<ItemPointer> &result) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  std::vector<ValueType> values;
+  container.GetValue(index_key, values);
+
+  for (auto item_pointer : values) {
+    result.push_back(*item_pointer);
+  }
+}
+
+///////////////////////////////////////////////////////////////////////
 
 template <typename KeyType, typename ValueType, class KeyComparator,
           class KeyEqualityChecker>
 void BWTreeIndex<KeyType, ValueType, KeyComparator, KeyEqualityChecker>::Scan(
-    __attribute__((unused)) const std::vector<Value> &values,
-    __attribute__((unused)) const std::vector<oid_t> &key_column_ids,
-    __attribute__((unused)) const std::vector<ExpressionType> &expr_types,
-    __attribute__((unused)) const ScanDirectionType &scan_direction,
-    __attribute__((unused)) std::vector<ItemPointer *> &result) {}
+    const std::vector<Value> &values, const std::vector<oid_t> &key_column_ids,
+    const std::vector<ExpressionType> &expr_types,
+    const ScanDirectionType &scan_direction,
+    std::vector<ItemPointer *> &result, const size_t limit) {
+  switch (scan_direction) {
+    case SCAN_DIRECTION_TYPE_FORWARD:
+    case SCAN_DIRECTION_TYPE_BACKWARD: {
+      ScanEntries(values, key_column_ids, expr_types, scan_direction, limit,
+                  [&result](ItemPointer *item_pointer) {
+                    result.push_back(item_pointer);
+                  });
+    } break;
+
+    case SCAN_DIRECTION_TYPE_INVALID:
+    default:
+      throw Exception("Invalid scan direction \n");
+      break;
+  }
+}
 
 template <typename KeyType, typename ValueType, class KeyComparator,
           class KeyEqualityChecker>
 void
 BWTreeIndex<KeyType, ValueType, KeyComparator, KeyEqualityChecker>::ScanAllKeys(
-    __attribute__((unused)) std::vector<ItemPointer *> &result) {}
+    std::vector<ItemPointer *> &result) {
+  container.ScanFrom(nullptr, [&result](const KeyType &,
+                                        ItemPointer *const &item_pointer) {
+    result.push_back(item_pointer);
+    return true;
+  });
+}
 
 template <typename KeyType, typename ValueType, class KeyComparator,
           class KeyEqualityChecker>
 void
 BWTreeIndex<KeyType, ValueType, KeyComparator, KeyEqualityChecker>::ScanKey(
-    __attribute__((unused)) const storage::Tuple *key,
-    __attribute__((unused)) std::vector<ItemPointer *> &result) {}
+    const storage::Tuple *key, std::vector<ItemPointer *> &result) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  container.GetValue(index_key, result);
+}
 
 template <typename KeyType, typename ValueType, class KeyComparator,
           class KeyEqualityChecker>
@@ -29,6 +29,8 @@ namespace index {
 /**
  * BW tree-based index implementation.
  *
+ * The tree is latch-free, so none of the operations takes an index lock.
+ *
  * @see Index
  */
 template <typename KeyType, typename ValueType, typename KeyComparator,
@@ -36,7 +38,8 @@ template <typename KeyType, typename ValueType, typename KeyComparator,
 class BWTreeIndex : public Index {
   friend class IndexFactory;
 
-  typedef BWTree<KeyType, ValueType, KeyComparator, KeyEqualityChecker> MapType;
+  typedef BWTree<KeyType, ValueType, KeyComparator, KeyEqualityChecker,
+                 ItemPointerEqualityChecker, ItemPointerDeleter> MapType;
 
  public:
   BWTreeIndex(IndexMetadata *metadata);
@@ -54,7 +57,7 @@ class BWTreeIndex : public Index {
             const std::vector<oid_t> &key_column_ids,
             const std::vector<ExpressionType> &expr_types,
             const ScanDirectionType &scan_direction,
-            std::vector<ItemPointer> &);
+            std::vector<ItemPointer> &, const size_t limit);
 
   void ScanAllKeys(std::vector<ItemPointer> &);
 
@@ -64,7 +67,7 @@ class BWTreeIndex : public Index {
             const std::vector<oid_t> &key_column_ids,
             const std::vector<ExpressionType> &exprs,
             const ScanDirectionType &scan_direction,
-            std::vector<ItemPointer *> &result);
+            std::vector<ItemPointer *> &result, const size_t limit);
 
   void ScanAllKeys(std::vector<ItemPointer *> &result);
 
@@ -73,22 +76,29 @@ class BWTreeIndex : public Index {
 
   std::string GetTypeName() const;
 
-  // TODO: Implement this
-  bool Cleanup() { return true; }
+  bool Cleanup() {
+    container.PerformGarbageCollection();
+    return true;
+  }
 
   // TODO: Implement this
   size_t GetMemoryFootprint() { return 0; }
 
  protected:
+  // Visit the item pointers of the entries matching the predicates in the
+  // scan direction
+  void ScanEntries(const std::vector<Value> &values,
+                   const std::vector<oid_t> &key_column_ids,
+                   const std::vector<ExpressionType> &expr_types,
+                   const ScanDirectionType &scan_direction, const size_t limit,
+                   std::function<void(ItemPointer *)> visitor);
+
   // container
   MapType container;
 
   // equality checker and comparator
   KeyEqualityChecker equals;
   KeyComparator comparator;
-
-  // synch helper
-  RWLock index_lock;
 };
 
 }  // End index namespace
@@ -138,27 +138,18 @@ bool Index::ConstructLowerBoundTuple(
   auto col_count = schema->GetColumnCount();
   bool all_constraints_equal = true;
 
+  for (auto expr_type : expr_types) {
+    if (expr_type != EXPRESSION_TYPE_COMPARE_EQUAL) {
+      all_constraints_equal = false;
+    }
+  }
+
   // Go over each column in the key tuple
-  // Setting either the placeholder or the min value
+  // Setting either the tightest lower bound or the min value
   for (oid_t column_itr = 0; column_itr < col_count; column_itr++) {
-    auto key_column_itr =
-        std::find(key_column_ids.begin(), key_column_ids.end(), column_itr);
-    bool placeholder = false;
     Value value;
-
-    // This column is part of the key column ids
-    if (key_column_itr != key_column_ids.end()) {
-      auto offset = std::distance(key_column_ids.begin(), key_column_itr);
-      // Equality constraint
-      if (expr_types[offset] == EXPRESSION_TYPE_COMPARE_EQUAL) {
-        placeholder = true;
-        value = values[offset];
-      }
-          // Not all expressions / constraints are equal
-          else {
-        all_constraints_equal = false;
-      }
-    }
+    bool placeholder = GetColumnBound(column_itr, values, key_column_ids,
+                                      expr_types, false, value);
 
     LOG_TRACE("Column itr : %u  Placeholder : %d ", column_itr, placeholder);
 
@@ -166,8 +157,8 @@ bool Index::ConstructLowerBoundTuple(
     if (placeholder == true) {
       index_key->SetValue(column_itr, value, GetPool());
     }
-        // Fill in the min value
-        else {
+    // Fill in the min value
+    else {
       auto value_type = schema->GetType(column_itr);
       index_key->SetValue(column_itr, Value::GetMinValue(value_type),
                           GetPool());
@@ -180,6 +171,118 @@ bool Index::ConstructLowerBoundTuple(
   return all_constraints_equal;
 }
 
+bool Index::ConstructUpperBoundTuple(
+    storage::Tuple *index_key, const std::vector<peloton::Value> &values,
+    const std::vector<oid_t> &key_column_ids,
+    const std::vector<ExpressionType> &expr_types) {
+  auto schema = index_key->GetSchema();
+  auto col_count = schema->GetColumnCount();
+
+  // Go over each column in the key tuple
+  // Setting either the tightest upper bound or the max value
+  for (oid_t column_itr = 0; column_itr < col_count; column_itr++) {
+    Value value;
+    bool placeholder = GetColumnBound(column_itr, values, key_column_ids,
+                                      expr_types, true, value);
+
+    // Fill in the placeholder
+    if (placeholder == true) {
+      index_key->SetValue(column_itr, value, GetPool());
+      continue;
+    }
+
+    // Fill in the max value
+    auto value_type = schema->GetType(column_itr);
+    if (value_type == VALUE_TYPE_VARCHAR ||
+        value_type == VALUE_TYPE_VARBINARY) {
+      return false;
+    }
+
+    index_key->SetValue(column_itr, Value::GetMaxValue(value_type), GetPool());
+  }
+
+  LOG_TRACE("Upper Bound Tuple :: %s", index_key->GetInfo().c_str());
+  return true;
+}
+
+void Index::ConstructBoundPrefix(const std::vector<Value> &values,
+                                 const std::vector<oid_t> &key_column_ids,
+                                 const std::vector<ExpressionType> &expr_types,
+                                 const bool upper_bound,
+                                 std::vector<Value> &bound_prefix) {
+  bound_prefix.clear();
+
+  // Keys are ordered by their leading columns first, so the bounds of a
+  // column only narrow the range if all the columns before it are bounded
+  Value bound;
+  for (oid_t column_itr = 0; GetColumnBound(column_itr, values, key_column_ids,
+                                            expr_types, upper_bound, bound);
+       column_itr++) {
+    bound_prefix.push_back(bound);
+  }
+}
+
+bool Index::IsPastScanEnd(const AbstractTuple &index_key,
+                          const std::vector<Value> &end_prefix,
+                          const ScanDirectionType &scan_direction) {
+  auto past_end_diff = (scan_direction == SCAN_DIRECTION_TYPE_BACKWARD)
+                           ? VALUE_COMPARE_LESSTHAN
+                           : VALUE_COMPARE_GREATERTHAN;
+
+  // Compare the leading columns of the key with the prefix
+  for (oid_t column_itr = 0; column_itr < end_prefix.size(); column_itr++) {
+    auto diff = index_key.GetValue(column_itr).Compare(end_prefix[column_itr]);
+    if (diff != VALUE_COMPARE_EQUAL) {
+      return (diff == past_end_diff);
+    }
+  }
+
+  return false;
+}
+
+bool Index::GetColumnBound(const oid_t column_id,
+                           const std::vector<Value> &values,
+                           const std::vector<oid_t> &key_column_ids,
+                           const std::vector<ExpressionType> &expr_types,
+                           const bool upper_bound, Value &bound) {
+  bool found_bound = false;
+  auto looser_diff =
+      upper_bound ? VALUE_COMPARE_GREATERTHAN : VALUE_COMPARE_LESSTHAN;
+
+  // The same column may carry several constraints, e.g. for BETWEEN
+  for (oid_t key_column_itr = 0; key_column_itr < key_column_ids.size();
+       key_column_itr++) {
+    if (key_column_ids[key_column_itr] != column_id) continue;
+
+    switch (expr_types[key_column_itr]) {
+      case EXPRESSION_TYPE_COMPARE_EQUAL:
+        break;
+
+      case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+      case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+        if (upper_bound == false) continue;
+        break;
+
+      case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+      case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+        if (upper_bound == true) continue;
+        break;
+
+      default:
+        continue;
+    }
+
+    // Keep the tightest bound, strict ones are enforced by Compare
+    const Value &value = values[key_column_itr];
+    if (found_bound == false || bound.Compare(value) == looser_diff) {
+      bound = value;
+      found_bound = true;
+    }
+  }
+
+  return found_bound;
+}
+
 Index::Index(IndexMetadata *metadata) : metadata(metadata) {
   index_oid = metadata->GetOid();
   // initialize counters
@@ -31,6 +31,28 @@ namespace storage { class Tuple; }
 
 namespace index {
 
+//===--------------------------------------------------------------------===//
+// Index values
+//===--------------------------------------------------------------------===//
+
+// Index values are item pointers, either heap allocated or stored inline,
+// that are compared by content
+struct ItemPointerEqualityChecker {
+  inline bool operator()(const ItemPointer *lhs,
+                         const ItemPointer *rhs) const {
+    return (lhs->block == rhs->block) && (lhs->offset == rhs->offset);
+  }
+
+  inline bool operator()(const ItemPointer &lhs,
+                         const ItemPointer &rhs) const {
+    return (lhs.block == rhs.block) && (lhs.offset == rhs.offset);
+  }
+};
+
+struct ItemPointerDeleter {
+  inline void operator()(ItemPointer *value) const { delete value; }
+};
+
 //===--------------------------------------------------------------------===//
 // IndexMetadata
 //===--------------------------------------------------------------------===//
@@ -133,12 +155,15 @@ class Index : public Printable {
   //===--------------------------------------------------------------------===//
 
   // scan all keys in the index matching an arbitrary key
-  // used by index scan executor
+  // used by index scan executor.
+  // only visits the key range bounded by the predicates on the leading key
+  // columns, in the scan direction, and stops after limit matches (if the
+  // limit is not zero)
   virtual void Scan(const std::vector<Value> &values,
                     const std::vector<oid_t> &key_column_ids,
                     const std::vector<ExpressionType> &exprs,
                     const ScanDirectionType &scan_direction,
-                    std::vector<ItemPointer> &) = 0;
+                    std::vector<ItemPointer> &, const size_t limit = 0) = 0;
 
   // scan the entire index, working like a sort
   virtual void ScanAllKeys(std::vector<ItemPointer> &) = 0;
@@ -150,7 +175,8 @@ class Index : public Printable {
                     const std::vector<oid_t> &key_column_ids,
                     const std::vector<ExpressionType> &exprs,
                     const ScanDirectionType &scan_direction,
-                    std::vector<ItemPointer *> &result) = 0;
+                    std::vector<ItemPointer *> &result,
+                    const size_t limit = 0) = 0;
 
   virtual void ScanAllKeys(std::vector<ItemPointer *> &result) = 0;
 
@@ -224,6 +250,35 @@ class Index : public Printable {
                                 const std::vector<oid_t> &key_column_ids,
                                 const std::vector<ExpressionType> &expr_types);
 
+  // Set the upper bound tuple for index iteration, returns false if a column
+  // without an upper bound has no max value to fill in
+  bool ConstructUpperBoundTuple(storage::Tuple *index_key,
+                                const std::vector<Value> &values,
+                                const std::vector<oid_t> &key_column_ids,
+                                const std::vector<ExpressionType> &expr_types);
+
+  // Collect the lower (or upper) bounds of the leading key columns, up to
+  // the first column without one
+  static void ConstructBoundPrefix(
+      const std::vector<Value> &values,
+      const std::vector<oid_t> &key_column_ids,
+      const std::vector<ExpressionType> &expr_types, const bool upper_bound,
+      std::vector<Value> &bound_prefix);
+
+  // Whether the key lies past the bound prefix at the end of a scan in the
+  // given direction, then no later key in that direction can match
+  static bool IsPastScanEnd(const AbstractTuple &index_key,
+                            const std::vector<Value> &end_prefix,
+                            const ScanDirectionType &scan_direction);
+
+  // Get the tightest lower (or upper) bound on a key column,
+  // returns false if the column has none
+  static bool GetColumnBound(const oid_t column_id,
+                             const std::vector<Value> &values,
+                             const std::vector<oid_t> &key_column_ids,
+                             const std::vector<ExpressionType> &expr_types,
+                             const bool upper_bound, Value &bound);
+
   //===--------------------------------------------------------------------===//
   //  Data members
   //===--------------------------------------------------------------------===//
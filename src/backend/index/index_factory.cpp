@@ -19,6 +19,7 @@
 #include "backend/index/index_key.h"
 #include "backend/index/bwtree_index.h"
 #include "backend/index/btree_index.h"
+#include "backend/index/olc_btree_index.h"
 
 namespace peloton {
 namespace index {
@@ -179,15 +180,15 @@ Index *IndexFactory::GetInstance(IndexMetadata *metadata) {
     } else if (key_size <= 128) {
       return new BWTreeIndex<GenericKey<128>, ItemPointer *,
                              GenericComparator<128>,
-                             GenericEqualityChecker<128>>(metadata);
+                               GenericEqualityChecker<128>>(metadata);
     } else if (key_size <= 256) {
       return new BWTreeIndex<GenericKey<256>, ItemPointer *,
                              GenericComparator<256>,
-                             GenericEqualityChecker<256>>(metadata);
+                               GenericEqualityChecker<256>>(metadata);
     } else if (key_size <= 512) {
       return new BWTreeIndex<GenericKey<512>, ItemPointer *,
                              GenericComparator<512>,
-                             GenericEqualityChecker<512>>(metadata);
+                               GenericEqualityChecker<512>>(metadata);
     } else {
       return new BWTreeIndex<TupleKey, ItemPointer *,
                              TupleKeyComparator, TupleKeyEqualityChecker>(
@@ -195,6 +196,85 @@ Index *IndexFactory::GetInstance(IndexMetadata *metadata) {
     }
   }
 
+  if (ints_only && (index_type == INDEX_TYPE_BTREE_OLC)) {
+    if (key_size <= sizeof(uint64_t)) {
+      return new OLCBTreeIndex<IntsKey<1>, ItemPointer,
+                               IntsComparator<1>, IntsEqualityChecker<1>>(
+          metadata);
+    } else if (key_size <= sizeof(int64_t) * 2) {
+      return new OLCBTreeIndex<IntsKey<2>, ItemPointer,
+                               IntsComparator<2>, IntsEqualityChecker<2>>(
+          metadata);
+    } else if (key_size <= sizeof(int64_t) * 3) {
+      return new OLCBTreeIndex<IntsKey<3>, ItemPointer,
+                               IntsComparator<3>, IntsEqualityChecker<3>>(
+          metadata);
+    } else if (key_size <= sizeof(int64_t) * 4) {
+      return new OLCBTreeIndex<IntsKey<4>, ItemPointer,
+                               IntsComparator<4>, IntsEqualityChecker<4>>(
+          metadata);
+    } else {
+      throw IndexException("We currently only support tree index on non-unique "
+                           "integer keys of size 32 bytes or smaller...");
+    }
+  }
+
+  if (index_type == INDEX_TYPE_BTREE_OLC) {
+    if (key_size <= 4) {
+      return new OLCBTreeIndex<GenericKey<4>, ItemPointer,
+                               GenericComparator<4>, GenericEqualityChecker<4>>(
+          metadata);
+    } else if (key_size <= 8) {
+      return new OLCBTreeIndex<GenericKey<8>, ItemPointer,
+                               GenericComparator<8>, GenericEqualityChecker<8>>(
+          metadata);
+    } else if (key_size <= 12) {
+      return new OLCBTreeIndex<GenericKey<12>, ItemPointer,
+                               GenericComparator<12>,
+                               GenericEqualityChecker<12>>(metadata);
+    } else if (key_size <= 16) {
+      return new OLCBTreeIndex<GenericKey<16>, ItemPointer,
+                               GenericComparator<16>,
+                               GenericEqualityChecker<16>>(metadata);
+    } else if (key_size <= 24) {
+      return new OLCBTreeIndex<GenericKey<24>, ItemPointer,
+                               GenericComparator<24>,
+                               GenericEqualityChecker<24>>(metadata);
+    } else if (key_size <= 32) {
+      return new OLCBTreeIndex<GenericKey<32>, ItemPointer,
+                               GenericComparator<32>,
+                               GenericEqualityChecker<32>>(metadata);
+    } else if (key_size <= 48) {
+      return new OLCBTreeIndex<GenericKey<48>, ItemPointer,
+                               GenericComparator<48>,
+                               GenericEqualityChecker<48>>(metadata);
+    } else if (key_size <= 64) {
+      return new OLCBTreeIndex<GenericKey<64>, ItemPointer,
+                               GenericComparator<64>,
+                               GenericEqualityChecker<64>>(metadata);
+    } else if (key_size <= 96) {
+      return new OLCBTreeIndex<GenericKey<96>, ItemPointer,
+                               GenericComparator<96>,
+                               GenericEqualityChecker<96>>(metadata);
+    } else if (key_size <= 128) {
+      return new OLCBTreeIndex<GenericKey<128>, ItemPointer,
+                               GenericComparator<128>,
+                               GenericEqualityChecker<128>>(metadata);
+    } else if (key_size <= 256) {
+      return new OLCBTreeIndex<GenericKey<256>, ItemPointer,
+                               GenericComparator<256>,
+                               GenericEqualityChecker<256>>(metadata);
+    } else if (key_size <= 512) {
+      return new OLCBTreeIndex<GenericKey<512>, ItemPointer,
+                               GenericComparator<512>,
+                               GenericEqualityChecker<512>>(metadata);
+    } else {
+      return new OLCBTreeIndex<TupleKey, ItemPointer,
+                               TupleKeyComparator, TupleKeyEqualityChecker>(
+          metadata);
+    }
+  }
+
   throw IndexException("Unsupported index scheme.");
   return NULL;
 }
@@ -0,0 +1,786 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// olc_btree.h
+//
+// Identification: src/backend/index/olc_btree.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "backend/common/platform.h"
+
+namespace peloton {
+namespace index {
+
+// Number of entries that fit into a node of about one page
+constexpr uint32_t OLCBTreeNodeCapacity(size_t entry_size) {
+  return (4096 / entry_size < 16) ? 16
+                                   : static_cast<uint32_t>(4096 / entry_size);
+}
+
+/**
+ * B+tree multimap synchronized with optimistic lock coupling
+ * (Leis et al., "The ART of Practical Synchronization", DaMoN 2016).
+ *
+ * Every node carries a version word whose second lowest bit is its write
+ * latch. Readers never write to a node: they remember the version, read the
+ * node and validate the version afterwards, restarting on a mismatch. Keys
+ * are copied out of a node before they are compared, so a comparison never
+ * runs on a half-written key. Writers descend optimistically as well and
+ * only latch the leaf they modify, plus the parent when a node has to be
+ * split. Full nodes are split eagerly on the way down, so a split never has
+ * to propagate upwards.
+ *
+ * Leaves are chained left to right and a split only moves entries to the
+ * new right sibling, so a reader that reaches a leaf through a stale path
+ * still finds every entry by following the chain.
+ *
+ * Duplicate keys may span several leaves. The separator of a leaf split is
+ * the largest key of the left half, lookups descend to the leftmost leaf
+ * that may contain the key and continue along the chain.
+ *
+ * Nodes are never merged or freed before the tree is destroyed, empty leaves
+ * simply stay in the chain. Nothing a reader may look at is ever freed, so
+ * the tree needs no epochs.
+ *
+ * Values are stored inline in the leaves, next to their keys. A leaf keeps
+ * its keys sorted, but reaches the values through a slot array, so a value
+ * never moves while its entry stays in the leaf and a scan can hand out its
+ * address for in-place updates. The address stays readable for the lifetime
+ * of the tree. When the entry is deleted or moved to a new sibling by a split,
+ * its slot is atomically reset to a default constructed value and may later
+ * be reused by another entry. Updates through the address must therefore be
+ * an atomic compare-and-swap against the value they expect to replace, which
+ * then either lands before the entry moves or fails.
+ */
+template <typename KeyType, typename ValueType, typename KeyComparator,
+          typename KeyEqualityChecker,
+          typename ValueEqualityChecker = std::equal_to<ValueType>>
+class OLCBTree {
+ public:
+  OLCBTree(const KeyComparator &key_comparator,
+           const KeyEqualityChecker &key_equality_checker,
+           const ValueEqualityChecker &value_equality_checker =
+               ValueEqualityChecker());
+
+  OLCBTree(const OLCBTree &) = delete;
+  OLCBTree &operator=(const OLCBTree &) = delete;
+
+  ~OLCBTree();
+
+  //===--------------------------------------------------------------------===//
+  // Mutators
+  //===--------------------------------------------------------------------===//
+
+  // Insert a key value pair, duplicates are allowed
+  void Insert(const KeyType &key, const ValueType &value);
+
+  // Insert a key value pair only if none of the values already stored
+  // for the key satisfies the predicate, returns false otherwise
+  bool ConditionalInsert(const KeyType &key, const ValueType &value,
+                         std::function<bool(const ValueType &)> predicate);
+
+  // Delete all the pairs matching key and value,
+  // returns false if there was nothing to delete
+  bool Delete(const KeyType &key, const ValueType &value);
+
+  //===--------------------------------------------------------------------===//
+  // Accessors
+  //===--------------------------------------------------------------------===//
+
+  // Collect all the values stored for the key
+  void GetValue(const KeyType &key, std::vector<ValueType> &result);
+
+  // Visit pairs in key order starting at start_key (or at the smallest key
+  // if start_key is null) until the callback returns false. The callback
+  // gets a consistent copy of the value along with its slot in the leaf.
+  void ScanFrom(const KeyType *start_key,
+                std::function<bool(const KeyType &, const ValueType &,
+                                   ValueType *)> callback);
+
+  // Bytes allocated for nodes
+  size_t GetMemoryFootprint() const { return memory_footprint_.load(); }
+
+ private:
+  //===--------------------------------------------------------------------===//
+  // Nodes
+  //===--------------------------------------------------------------------===//
+
+  // Nodes are sized to roughly a page, but never hold fewer than 16 entries
+  static const uint32_t leaf_capacity_ = OLCBTreeNodeCapacity(
+      sizeof(KeyType) + sizeof(ValueType) + sizeof(uint16_t));
+
+  static const uint32_t inner_capacity_ =
+      OLCBTreeNodeCapacity(sizeof(KeyType) + sizeof(void *));
+
+  // Set in the version word while a writer holds the node
+  static const uint64_t write_latch_bit_ = 2;
+
+  struct Node {
+    Node(bool is_leaf) : version(0), is_leaf(is_leaf), count(0) {}
+
+    std::atomic<uint64_t> version;
+
+    const bool is_leaf;
+
+    uint32_t count;
+  };
+
+  // Entry i is keys[i] with the value in values[slots[i]]. The slots array
+  // is always a permutation of the value slots, the ones from count onwards
+  // are free.
+  struct LeafNode : public Node {
+    LeafNode() : Node(true), next(nullptr) {
+      for (uint32_t slot_itr = 0; slot_itr < leaf_capacity_; slot_itr++) {
+        slots[slot_itr] = static_cast<uint16_t>(slot_itr);
+      }
+    }
+
+    KeyType keys[leaf_capacity_];
+
+    uint16_t slots[leaf_capacity_];
+
+    ValueType values[leaf_capacity_];
+
+    // right sibling
+    LeafNode *next;
+  };
+
+  // Copy of a leaf entry taken by a reader
+  struct LeafEntry {
+    LeafEntry(const KeyType &key, const ValueType &value, ValueType *location)
+        : key(key), value(value), location(location) {}
+
+    KeyType key;
+
+    ValueType value;
+
+    ValueType *location;
+  };
+
+  // Child i holds the keys that are not greater than keys[i] (and greater
+  // than keys[i - 1]), the last child holds everything above
+  struct InnerNode : public Node {
+    InnerNode() : Node(false) {}
+
+    KeyType keys[inner_capacity_];
+
+    Node *children[inner_capacity_ + 1];
+  };
+
+  //===--------------------------------------------------------------------===//
+  // Version latches
+  //===--------------------------------------------------------------------===//
+
+  // Spin until no writer holds the node, returns the version to validate
+  uint64_t AwaitUnlocked(const Node *node) const;
+
+  // Check that the node did not change since the version was read
+  bool Validate(const Node *node, uint64_t version) const;
+
+  // Latch the node if it is still at the given version
+  bool TryUpgrade(Node *node, uint64_t version);
+
+  void WriteLock(Node *node);
+
+  void WriteUnlock(Node *node);
+
+  //===--------------------------------------------------------------------===//
+  // Helpers
+  //===--------------------------------------------------------------------===//
+
+  inline bool KeyLess(const KeyType &lhs, const KeyType &rhs) const {
+    return key_comparator_(lhs, rhs);
+  }
+
+  inline bool KeyEqual(const KeyType &lhs, const KeyType &rhs) const {
+    return key_equality_checker_(lhs, rhs);
+  }
+
+  inline bool ValueEqual(const ValueType &lhs, const ValueType &rhs) const {
+    return value_equality_checker_(lhs, rhs);
+  }
+
+  // Position of the first separator not less than the key, validated
+  // against the version as the node may change while we read it
+  uint32_t FindChildOptimistic(const InnerNode *node, uint64_t version,
+                               const KeyType &key, bool &need_restart) const;
+
+  // Descend to the leftmost leaf that may hold the key (or the leftmost leaf
+  // if key is null) without latching anything
+  LeafNode *FindLeaf(const KeyType *key) const;
+
+  // Descend to the leftmost leaf that may hold the key and latch it.
+  // Full nodes on the way are split when split_full_nodes is set.
+  LeafNode *FindAndLockLeaf(const KeyType &key, bool split_full_nodes);
+
+  // Split a full node and post the separator into its parent, both are
+  // latched with the versions read during the descent. Returns false if
+  // either of them changed in the meantime.
+  bool SplitNode(InnerNode *parent, uint64_t parent_version, Node *node,
+                 uint64_t version);
+
+  // Copy the entries and the sibling link of a leaf as of one version
+  void SnapshotLeaf(LeafNode *leaf, std::vector<LeafEntry> &entries,
+                    LeafNode *&next) const;
+
+  // Check the values stored for the key with the predicate, starting at a
+  // leaf latched by the caller
+  bool AnyValueSatisfies(
+      const LeafNode *leaf, const KeyType &key,
+      const std::function<bool(const ValueType &)> &predicate) const;
+
+  // Insert into a latched leaf that has room, after existing duplicates
+  void InsertIntoLeaf(LeafNode *leaf, const KeyType &key,
+                      const ValueType &value);
+
+  // Remove the matching pairs from a latched leaf and free their slots,
+  // returns the number of removed pairs
+  uint32_t RemoveFromLeaf(LeafNode *leaf, const KeyType &key,
+                          const ValueType &value);
+
+  void FreeNode(Node *node);
+
+  //===--------------------------------------------------------------------===//
+  // Members
+  //===--------------------------------------------------------------------===//
+
+  std::atomic<Node *> root_;
+
+  std::atomic<size_t> memory_footprint_;
+
+  KeyComparator key_comparator_;
+
+  KeyEqualityChecker key_equality_checker_;
+
+  ValueEqualityChecker value_equality_checker_;
+};
+
+//===--------------------------------------------------------------------===//
+// Implementation
+//===--------------------------------------------------------------------===//
+
+#define OLCBTREE_TEMPLATE_ARGUMENTS                                          \
+  template <typename KeyType, typename ValueType, typename KeyComparator,    \
+            typename KeyEqualityChecker, typename ValueEqualityChecker>
+
+#define OLCBTREE_TYPE                                                       \
+  OLCBTree<KeyType, ValueType, KeyComparator, KeyEqualityChecker,          \
+           ValueEqualityChecker>
+
+OLCBTREE_TEMPLATE_ARGUMENTS
+const uint32_t OLCBTREE_TYPE::leaf_capacity_;
+
+OLCBTREE_TEMPLATE_ARGUMENTS
+const uint32_t OLCBTREE_TYPE::inner_capacity_;
+
+OLCBTREE_TEMPLATE_ARGUMENTS
+const uint64_t OLCBTREE_TYPE::write_latch_bit_;
+
+OLCBTREE_TEMPLATE_ARGUMENTS
+OLCBTREE_TYPE::OLCBTree(const KeyComparator &key_comparator,
+                        const KeyEqualityChecker &key_equality_checker,
+                        const ValueEqualityChecker &value_equality_checker)
+    : root_(new LeafNode()),
+      memory_footprint_(sizeof(LeafNode)),
+      key_comparator_(key_comparator),
+      key_equality_checker_(key_equality_checker),
+      value_equality_checker_(value_equality_checker) {}
+
+OLCBTREE_TEMPLATE_ARGUMENTS
+OLCBTREE_TYPE::~OLCBTree() { FreeNode(root_.load()); }
+
+//===--------------------------------------------------------------------===//
+// Mutators
+//===--------------------------------------------------------------------===//
+
+OLCBTREE_TEMPLATE_ARGUMENTS
+void OLCBTREE_TYPE::Insert(const KeyType &key, const ValueType &value) {
+  auto leaf = FindAndLockLeaf(key, true);
+  InsertIntoLeaf(leaf, key, value);
+  WriteUnlock(leaf);
+}
+
+OLCBTREE_TEMPLATE_ARGUMENTS
+bool OLCBTREE_TYPE::ConditionalInsert(
+    const KeyType &key, const ValueType &value,
+    std::function<bool(const ValueType &)> predicate) {
+  // Every insert of the key goes through this leaf, so holding its latch
+  // makes the check and the insert atomic
+  auto leaf = FindAndLockLeaf(key, true);
+
+  if (AnyValueSatisfies(leaf, key, predicate) == true) {
+    WriteUnlock(leaf);
+    return false;
+  }
+
+  InsertIntoLeaf(leaf, key, value);
+  WriteUnlock(leaf);
+  return true;
+}
+
+OLCBTREE_TEMPLATE_ARGUMENTS
+bool OLCBTREE_TYPE::Delete(const KeyType &key, const ValueType &value) {
+  uint32_t removed_count = 0;
+
+  auto leaf = FindAndLockLeaf(key, false);
+
+  // Duplicates may continue in the right siblings
+  while (true) {
+    removed_count += RemoveFromLeaf(leaf, key, value);
+
+    auto next = leaf->next;
+    if (next == nullptr ||
+        (leaf->count > 0 && KeyLess(key, leaf->keys[leaf->count - 1]))) {
+      WriteUnlock(leaf);
+      break;
+    }
+
+    // Latches are only ever waited for from left to right
+    WriteLock(next);
+    WriteUnlock(leaf);
+    leaf = next;
+  }
+
+  return removed_count > 0;
+}
+
+//===--------------------------------------------------------------------===//
+// Accessors
+//===--------------------------------------------------------------------===//
+
+OLCBTREE_TEMPLATE_ARGUMENTS
+void OLCBTREE_TYPE::GetValue(const KeyType &key,
+                             std::vector<ValueType> &result) {
+  ScanFrom(&key, [this, &key, &result](const KeyType &current_key,
+                                       const ValueType &value, ValueType *) {
+    if (KeyEqual(current_key, key) == false) return false;
+
+    result.push_back(value);
+    return true;
+  });
+}
+
+OLCBTREE_TEMPLATE_ARGUMENTS
+void OLCBTREE_TYPE::ScanFrom(
+    const KeyType *start_key,
+    std::function<bool(const KeyType &, const ValueType &, ValueType *)>
+        callback) {
+  std::vector<LeafEntry> entries;
+  LeafNode *next;
+
+  // Each leaf is visited as of one version together with its sibling link,
+  // so entries moved by a later split are neither missed nor repeated
+  for (auto leaf = FindLeaf(start_key); leaf != nullptr; leaf = next) {
+    SnapshotLeaf(leaf, entries, next);
+
+    for (auto &entry : entries) {
+      if (start_key != nullptr && KeyLess(entry.key, *start_key)) continue;
+
+      if (callback(entry.key, entry.value, entry.location) == false) return;
+    }
+  }
+}
+
+//===--------------------------------------------------------------------===//
+// Version latches
+//===--------------------------------------------------------------------===//
+
+OLCBTREE_TEMPLATE_ARGUMENTS
+uint64_t OLCBTREE_TYPE::AwaitUnlocked(const Node *node) const {
+  auto version = node->version.load(std::memory_order_acquire);
+  while ((version & write_latch_bit_) != 0) {
+    _mm_pause();
+    version = node->version.load(std::memory_order_acquire);
+  }
+  return version;
+}
+
+OLCBTREE_TEMPLATE_ARGUMENTS
+bool OLCBTREE_TYPE::Validate(const Node *node, uint64_t version) const {
+  // Order the preceding reads of the node before the version check
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return node->version.load(std::memory_order_relaxed) == version;
+}
+
+OLCBTREE_TEMPLATE_ARGUMENTS
+bool OLCBTREE_TYPE::TryUpgrade(Node *node, uint64_t version) {
+  return node->version.compare_exchange_strong(version,
+                                               version + write_latch_bit_);
+}
+
+OLCBTREE_TEMPLATE_ARGUMENTS
+void OLCBTREE_TYPE::WriteLock(Node *node) {
+  while (TryUpgrade(node, AwaitUnlocked(node)) == false) {
+  }
+}
+
+OLCBTREE_TEMPLATE_ARGUMENTS
+void OLCBTREE_TYPE::WriteUnlock(Node *node) {
+  // Clears the latch bit and moves on to the next version
+  node->version.fetch_add(write_latch_bit_, std::memory_order_release);
+}
+
+//===--------------------------------------------------------------------===//
+// Helpers
+//===--------------------------------------------------------------------===//
+
+OLCBTREE_TEMPLATE_ARGUMENTS
+uint32_t OLCBTREE_TYPE::FindChildOptimistic(const InnerNode *node,
+                                            uint64_t version,
+                                            const KeyType &key,
+                                            bool &need_restart) const {
+  uint32_t lower = 0;
+  uint32_t upper = std::min(node->count, inner_capacity_);
+
+  while (lower < upper) {
+    auto middle = (lower + upper) / 2;
+
+    // Compare a private copy, and only once we know it is not torn
+    KeyType separator = node->keys[middle];
+    if (Validate(node, version) == false) {
+      need_restart = true;
+      return 0;
+    }
+
+    if (KeyLess(separator, key) == true) {
+      lower = middle + 1;
+    } else {
+      upper = middle;
+    }
+  }
+
+  return lower;
+}
+
+OLCBTREE_TEMPLATE_ARGUMENTS
+typename OLCBTREE_TYPE::LeafNode *OLCBTREE_TYPE::FindLeaf(
+    const KeyType *key) const {
+  while (true) {
+    bool need_restart = false;
+
+    Node *node = root_.load();
+    auto version = AwaitUnlocked(node);
+    if (node != root_.load()) continue;
+
+    while (node->is_leaf == false) {
+      auto inner = static_cast<InnerNode *>(node);
+
+      uint32_t child_offset = 0;
+      if (key != nullptr) {
+        child_offset = FindChildOptimistic(inner, version, *key, need_restart);
+        if (need_restart == true) break;
+      }
+
+      node = inner->children[child_offset];
+      if (Validate(inner, version) == false) {
+        need_restart = true;
+        break;
+      }
+
+      version = AwaitUnlocked(node);
+    }
+
+    if (need_restart == false) return static_cast<LeafNode *>(node);
+  }
+}
+
+OLCBTREE_TEMPLATE_ARGUMENTS
+typename OLCBTREE_TYPE::LeafNode *OLCBTREE_TYPE::FindAndLockLeaf(
+    const KeyType &key, bool split_full_nodes) {
+  while (true) {
+    bool need_restart = false;
+
+    Node *node = root_.load();
+    auto version = AwaitUnlocked(node);
+    if (node != root_.load()) continue;
+
+    InnerNode *parent = nullptr;
+    uint64_t parent_version = 0;
+
+    while (true) {
+      auto capacity = node->is_leaf ? leaf_capacity_ : inner_capacity_;
+      if (split_full_nodes == true && node->count == capacity) {
+        // Restart after the split, whether it worked or not
+        SplitNode(parent, parent_version, node, version);
+        need_restart = true;
+        break;
+      }
+
+      if (node->is_leaf == true) break;
+
+      auto inner = static_cast<InnerNode *>(node);
+      auto child_offset =
+          FindChildOptimistic(inner, version, key, need_restart);
+      if (need_restart == true) break;
+
+      auto child = inner->children[child_offset];
+      if (Validate(inner, version) == false) {
+        need_restart = true;
+        break;
+      }
+
+      parent = inner;
+      parent_version = version;
+      node = child;
+      version = AwaitUnlocked(node);
+
+      // The child might have been split before we got its version
+      if (Validate(parent, parent_version) == false) {
+        need_restart = true;
+        break;
+      }
+    }
+
+    if (need_restart == true) continue;
+
+    if (TryUpgrade(node, version) == false) continue;
+
+    // A root leaf might have been split and replaced meanwhile
+    if (parent == nullptr && node != root_.load()) {
+      WriteUnlock(node);
+      continue;
+    }
+
+    return static_cast<LeafNode *>(node);
+  }
+}
+
+OLCBTREE_TEMPLATE_ARGUMENTS
+bool OLCBTREE_TYPE::SplitNode(InnerNode *parent, uint64_t parent_version,
+                              Node *node, uint64_t version) {
+  if (parent != nullptr && TryUpgrade(parent, parent_version) == false) {
+    return false;
+  }
+
+  if (TryUpgrade(node, version) == false) {
+    if (parent != nullptr) WriteUnlock(parent);
+    return false;
+  }
+
+  // Somebody else grew a new root above the node
+  if (parent == nullptr && node != root_.load()) {
+    WriteUnlock(node);
+    return false;
+  }
+
+  KeyType separator;
+  Node *sibling;
+
+  if (node->is_leaf == true) {
+    auto leaf = static_cast<LeafNode *>(node);
+    auto right = new LeafNode();
+    memory_footprint_ += sizeof(LeafNode);
+
+    // The separator is the largest key on the left,
+    // duplicates of it may continue on the right
+    uint32_t left_count = leaf->count / 2;
+    right->count = leaf->count - left_count;
+    std::copy(leaf->keys + left_count, leaf->keys + leaf->count, right->keys);
+
+    // Empty the old slots as the values move, so that an in-place update
+    // through a stale address cannot get lost. The slots of the moved
+    // entries are already past the new count.
+    ValueType empty_value = ValueType();
+    for (uint32_t entry_itr = left_count; entry_itr < leaf->count;
+         entry_itr++) {
+      __atomic_exchange(&leaf->values[leaf->slots[entry_itr]], &empty_value,
+                        &right->values[entry_itr - left_count],
+                        __ATOMIC_ACQ_REL);
+    }
+    right->next = leaf->next;
+
+    separator = leaf->keys[left_count - 1];
+    leaf->count = left_count;
+    leaf->next = right;
+    sibling = right;
+  } else {
+    auto inner = static_cast<InnerNode *>(node);
+    auto right = new InnerNode();
+    memory_footprint_ += sizeof(InnerNode);
+
+    // The middle separator moves up
+    uint32_t left_count = inner->count / 2;
+    right->count = inner->count - left_count - 1;
+    std::copy(inner->keys + left_count + 1, inner->keys + inner->count,
+              right->keys);
+    std::copy(inner->children + left_count + 1,
+              inner->children + inner->count + 1, right->children);
+
+    separator = inner->keys[left_count];
+    inner->count = left_count;
+    sibling = right;
+  }
+
+  if (parent != nullptr) {
+    // Locate the node by identity, separators may repeat with duplicates
+    uint32_t child_offset = 0;
+    while (parent->children[child_offset] != node) child_offset++;
+
+    std::copy_backward(parent->keys + child_offset,
+                       parent->keys + parent->count,
+                       parent->keys + parent->count + 1);
+    std::copy_backward(parent->children + child_offset + 1,
+                       parent->children + parent->count + 1,
+                       parent->children + parent->count + 2);
+    parent->keys[child_offset] = separator;
+    parent->children[child_offset + 1] = sibling;
+    parent->count++;
+  } else {
+    auto root = new InnerNode();
+    memory_footprint_ += sizeof(InnerNode);
+
+    root->count = 1;
+    root->keys[0] = separator;
+    root->children[0] = node;
+    root->children[1] = sibling;
+    root_.store(root);
+  }
+
+  WriteUnlock(node);
+  if (parent != nullptr) WriteUnlock(parent);
+
+  return true;
+}
+
+OLCBTREE_TEMPLATE_ARGUMENTS
+void OLCBTREE_TYPE::SnapshotLeaf(LeafNode *leaf,
+                                 std::vector<LeafEntry> &entries,
+                                 LeafNode *&next) const {
+  while (true) {
+    auto version = AwaitUnlocked(leaf);
+
+    entries.clear();
+    auto count = std::min(leaf->count, leaf_capacity_);
+    for (uint32_t entry_itr = 0; entry_itr < count; entry_itr++) {
+      // A torn slot number is caught by the validation below
+      auto slot = leaf->slots[entry_itr] % leaf_capacity_;
+      entries.emplace_back(leaf->keys[entry_itr], leaf->values[slot],
+                           &leaf->values[slot]);
+    }
+    next = leaf->next;
+
+    if (Validate(leaf, version) == true) return;
+  }
+}
+
+OLCBTREE_TEMPLATE_ARGUMENTS
+bool OLCBTREE_TYPE::AnyValueSatisfies(
+    const LeafNode *leaf, const KeyType &key,
+    const std::function<bool(const ValueType &)> &predicate) const {
+  // The latched leaf can be read directly
+  for (uint32_t entry_itr = 0; entry_itr < leaf->count; entry_itr++) {
+    if (KeyEqual(leaf->keys[entry_itr], key) &&
+        predicate(leaf->values[leaf->slots[entry_itr]])) {
+      return true;
+    }
+  }
+
+  if (leaf->count > 0 && KeyLess(key, leaf->keys[leaf->count - 1])) {
+    return false;
+  }
+
+  // Older duplicates may live in the right siblings
+  std::vector<LeafEntry> entries;
+  LeafNode *next;
+
+  for (auto sibling = leaf->next; sibling != nullptr; sibling = next) {
+    SnapshotLeaf(sibling, entries, next);
+
+    for (auto &entry : entries) {
+      if (KeyLess(key, entry.key) == true) return false;
+
+      if (KeyEqual(entry.key, key) && predicate(entry.value)) return true;
+    }
+  }
+
+  return false;
+}
+
+OLCBTREE_TEMPLATE_ARGUMENTS
+void OLCBTREE_TYPE::InsertIntoLeaf(LeafNode *leaf, const KeyType &key,
+                                   const ValueType &value) {
+  auto position =
+      std::upper_bound(leaf->keys, leaf->keys + leaf->count, key,
+                       [this](const KeyType &lhs, const KeyType &rhs) {
+                         return KeyLess(lhs, rhs);
+                       }) -
+      leaf->keys;
+
+  // Take the first free slot, only the keys and slot numbers are shifted
+  auto slot = leaf->slots[leaf->count];
+  leaf->values[slot] = value;
+
+  std::copy_backward(leaf->keys + position, leaf->keys + leaf->count,
+                     leaf->keys + leaf->count + 1);
+  std::copy_backward(leaf->slots + position, leaf->slots + leaf->count,
+                     leaf->slots + leaf->count + 1);
+  leaf->keys[position] = key;
+  leaf->slots[position] = slot;
+  leaf->count++;
+}
+
+OLCBTREE_TEMPLATE_ARGUMENTS
+uint32_t OLCBTREE_TYPE::RemoveFromLeaf(LeafNode *leaf, const KeyType &key,
+                                       const ValueType &value) {
+  uint16_t removed_slots[leaf_capacity_];
+  uint32_t removed_count = 0;
+  uint32_t kept_count = 0;
+  ValueType empty_value = ValueType();
+
+  for (uint32_t entry_itr = 0; entry_itr < leaf->count; entry_itr++) {
+    auto slot = leaf->slots[entry_itr];
+    if (KeyEqual(leaf->keys[entry_itr], key) &&
+        ValueEqual(leaf->values[slot], value)) {
+      __atomic_store(&leaf->values[slot], &empty_value, __ATOMIC_RELEASE);
+      removed_slots[removed_count++] = slot;
+      continue;
+    }
+
+    if (kept_count != entry_itr) {
+      leaf->keys[kept_count] = leaf->keys[entry_itr];
+      leaf->slots[kept_count] = slot;
+    }
+    kept_count++;
+  }
+
+  // The freed slots go right after the remaining entries
+  std::copy(removed_slots, removed_slots + removed_count,
+            leaf->slots + kept_count);
+  leaf->count = kept_count;
+
+  return removed_count;
+}
+
+OLCBTREE_TEMPLATE_ARGUMENTS
+void OLCBTREE_TYPE::FreeNode(Node *node) {
+  if (node->is_leaf == true) {
+    delete static_cast<LeafNode *>(node);
+    return;
+  }
+
+  auto inner = static_cast<InnerNode *>(node);
+  for (uint32_t child_itr = 0; child_itr <= inner->count; child_itr++) {
+    FreeNode(inner->children[child_itr]);
+  }
+
+  delete inner;
+}
+
+#undef OLCBTREE_TEMPLATE_ARGUMENTS
+#undef OLCBTREE_TYPE
+
+}  // End index namespace
+}  // End peloton namespace
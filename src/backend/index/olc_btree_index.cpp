@@ -0,0 +1,307 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// olc_btree_index.cpp
+//
+// Identification: src/backend/index/olc_btree_index.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "backend/common/logger.h"
+#include "backend/index/olc_btree_index.h"
+#include "backend/index/index_key.h"
+#include "backend/storage/tuple.h"
+
+namespace peloton {
+namespace index {
+
+template <typename KeyType, typename ValueType, class KeyComparator,
+          class KeyEqualityChecker>
+OLCBTreeIndex<KeyType, ValueType, KeyComparator,
+              KeyEqualityChecker>::OLCBTreeIndex(IndexMetadata *metadata)
+    : Index(metadata),
+      container(KeyComparator(metadata), KeyEqualityChecker(metadata)),
+      equals(metadata),
+      comparator(metadata) {}
+
+template <typename KeyType, typename ValueType, class KeyComparator,
+          class KeyEqualityChecker>
+OLCBTreeIndex<KeyType, ValueType, KeyComparator,
+              KeyEqualityChecker>::~OLCBTreeIndex() {
+  // the item pointers are stored inline, nothing to free
+}
+
+template <typename KeyType, typename ValueType, class KeyComparator,
+          class KeyEqualityChecker>
+bool OLCBTreeIndex<KeyType, ValueType, KeyComparator,
+                   KeyEqualityChecker>::InsertEntry(
+    const storage::Tuple *key, const ItemPointer &location) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  // Insert the key, val pair
+  container.Insert(index_key, location);
+
+  return true;
+}
+
+template <typename KeyType, typename ValueType, class KeyComparator,
+          class KeyEqualityChecker>
+bool OLCBTreeIndex<KeyType, ValueType, KeyComparator,
+                   KeyEqualityChecker>::DeleteEntry(
+    const storage::Tuple *key, const ItemPointer &location) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  // Delete all the < key, location > pairs
+  container.Delete(index_key, location);
+
+  return true;
+}
+
+template <typename KeyType, typename ValueType, class KeyComparator,
+          class KeyEqualityChecker>
+bool OLCBTreeIndex<KeyType, ValueType, KeyComparator,
+                   KeyEqualityChecker>::CondInsertEntry(
+    const storage::Tuple *key, const ItemPointer &location,
+    std::function<bool(const ItemPointer &)> predicate) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  // returns false if this key is already visible or dirty in the index
+  return container.ConditionalInsert(index_key, location, predicate);
+}
+
+template <typename KeyType, typename ValueType, class KeyComparator,
+          class KeyEqualityChecker>
+void OLCBTreeIndex<KeyType, ValueType, KeyComparator,
+                   KeyEqualityChecker>::ScanEntries(
+    const std::vector<Value> &values, const std::vector<oid_t> &key_column_ids,
+    const std::vector<ExpressionType> &expr_types,
+    const ScanDirectionType &scan_direction, const size_t limit,
+    std::function<void(const ItemPointer &, ItemPointer *)> visitor) {
+  KeyType index_key;
+  KeyType *scan_begin_key = nullptr;
+  std::unique_ptr<storage::Tuple> start_key;
+
+  // The bounds of the leading key columns delimit the range to scan
+  // refer : http://www.postgresql.org/docs/8.2/static/indexes-multicolumn.html
+  std::vector<Value> lower_bound_prefix;
+  std::vector<Value> upper_bound_prefix;
+  ConstructBoundPrefix(values, key_column_ids, expr_types, false,
+                       lower_bound_prefix);
+  ConstructBoundPrefix(values, key_column_ids, expr_types, true,
+                       upper_bound_prefix);
+
+  LOG_TRACE("Bounded columns : %lu %lu", lower_bound_prefix.size(),
+            upper_bound_prefix.size());
+
+  // Seek to the lower bound
+  if (lower_bound_prefix.empty() == false) {
+    start_key.reset(new storage::Tuple(metadata->GetKeySchema(), true));
+    ConstructLowerBoundTuple(start_key.get(), values, key_column_ids,
+                             expr_types);
+
+    index_key.SetFromKey(start_key.get());
+    scan_begin_key = &index_key;
+  }
+
+  // The container only iterates forward, so a backward scan collects the
+  // whole range first and visits it in reverse
+  bool backward = (scan_direction == SCAN_DIRECTION_TYPE_BACKWARD);
+  std::vector<std::pair<ItemPointer, ItemPointer *>> matches;
+  size_t match_count = 0;
+
+  container.ScanFrom(scan_begin_key, [&](const KeyType &key,
+                                         const ItemPointer &item_pointer,
+                                         ItemPointer *location) {
+    auto scan_current_key = key;
+    auto tuple =
+        scan_current_key.GetTupleForComparison(metadata->GetKeySchema());
+
+    // No key past the upper bound can match
+    if (IsPastScanEnd(tuple, upper_bound_prefix,
+                      SCAN_DIRECTION_TYPE_FORWARD) == true) {
+      return false;
+    }
+
+    // Compare the current key in the scan with "values" based on
+    // "expression types"
+    // For instance, "5" EXPR_GREATER_THAN "2" is true
+    if (Compare(tuple, key_column_ids, expr_types, values) == false) {
+      return true;
+    }
+
+    if (backward == true) {
+      matches.emplace_back(item_pointer, location);
+      return true;
+    }
+
+    visitor(item_pointer, location);
+    match_count++;
+    return (limit == 0 || match_count < limit);
+  });
+
+  for (auto match_itr = matches.rbegin(); match_itr != matches.rend() &&
+                                          (limit == 0 || match_count < limit);
+       match_itr++) {
+    visitor(match_itr->first, match_itr->second);
+    match_count++;
+  }
+}
+
+template <typename KeyType, typename ValueType, class KeyComparator,
+          class KeyEqualityChecker>
+void OLCBTreeIndex<KeyType, ValueType, KeyComparator, KeyEqualityChecker>::Scan(
+    const std::vector<Value> &values, const std::vector<oid_t> &key_column_ids,
+    const std::vector<ExpressionType> &expr_types,
+    const ScanDirectionType &scan_direction, std::vector<ItemPointer> &result,
+    const size_t limit) {
+  switch (scan_direction) {
+    case SCAN_DIRECTION_TYPE_FORWARD:
+    case SCAN_DIRECTION_TYPE_BACKWARD: {
+      ScanEntries(values, key_column_ids, expr_types, scan_direction, limit,
+                  [&result](const ItemPointer &item_pointer, ItemPointer *) {
+                    result.push_back(item_pointer);
+                  });
+    } break;
+
+    case SCAN_DIRECTION_TYPE_INVALID:
+    default:
+      throw Exception("Invalid scan direction \n");
+      break;
+  }
+}
+
+template <typename KeyType, typename ValueType, class KeyComparator,
+          class KeyEqualityChecker>
+void OLCBTreeIndex<KeyType, ValueType, KeyComparator,
+                   KeyEqualityChecker>::ScanAllKeys(
+    std::vector<ItemPointer> &result) {
+  container.ScanFrom(nullptr, [&result](const KeyType &,
+                                        const ItemPointer &item_pointer,
+                                        ItemPointer *) {
+    result.push_back(item_pointer);
+    return true;
+  });
+}
+
+template <typename KeyType, typename ValueType, class KeyComparator,
+          class KeyEqualityChecker>
+void OLCBTreeIndex<KeyType, ValueType, KeyComparator,
+                   KeyEqualityChecker>::ScanKey(
+    const storage::Tuple *key, std::vector<ItemPointer> &result) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  container.GetValue(index_key, result);
+}
+
+///////////////////////////////////////////////////////////////////////
+
+template <typename KeyType, typename ValueType, class KeyComparator,
+          class KeyEqualityChecker>
+void OLCBTreeIndex<KeyType, ValueType, KeyComparator, KeyEqualityChecker>::Scan(
+    const std::vector<Value> &values, const std::vector<oid_t> &key_column_ids,
+    const std::vector<ExpressionType> &expr_types,
+    const ScanDirectionType &scan_direction,
+    std::vector<ItemPointer *> &result, const size_t limit) {
+  switch (scan_direction) {
+    case SCAN_DIRECTION_TYPE_FORWARD:
+    case SCAN_DIRECTION_TYPE_BACKWARD: {
+      ScanEntries(values, key_column_ids, expr_types, scan_direction, limit,
+                  [&result](const ItemPointer &, ItemPointer *location) {
+                    result.push_back(location);
+                  });
+    } break;
+
+    case SCAN_DIRECTION_TYPE_INVALID:
+    default:
+      throw Exception("Invalid scan direction \n");
+      break;
+  }
+}
+
+template <typename KeyType, typename ValueType, class KeyComparator,
+          class KeyEqualityChecker>
+void OLCBTreeIndex<KeyType, ValueType, KeyComparator,
+                   KeyEqualityChecker>::ScanAllKeys(
+    std::vector<ItemPointer *> &result) {
+  container.ScanFrom(nullptr, [&result](const KeyType &, const ItemPointer &,
+                                        ItemPointer *location) {
+    result.push_back(location);
+    return true;
+  });
+}
+
+template <typename KeyType, typename ValueType, class KeyComparator,
+          class KeyEqualityChecker>
+void OLCBTreeIndex<KeyType, ValueType, KeyComparator,
+                   KeyEqualityChecker>::ScanKey(
+    const storage::Tuple *key, std::vector<ItemPointer *> &result) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  container.ScanFrom(&index_key, [&](const KeyType &current_key,
+                                     const ItemPointer &,
+                                     ItemPointer *location) {
+    if (equals(current_key, index_key) == false) return false;
+
+    result.push_back(location);
+    return true;
+  });
+}
+
+template <typename KeyType, typename ValueType, class KeyComparator,
+          class KeyEqualityChecker>
+std::string OLCBTreeIndex<KeyType, ValueType, KeyComparator,
+                          KeyEqualityChecker>::GetTypeName() const {
+  return "OLCBTree";
+}
+
+// Explicit template instantiation
+template class OLCBTreeIndex<IntsKey<1>, ItemPointer,
+                             IntsComparator<1>, IntsEqualityChecker<1>>;
+template class OLCBTreeIndex<IntsKey<2>, ItemPointer,
+                             IntsComparator<2>, IntsEqualityChecker<2>>;
+template class OLCBTreeIndex<IntsKey<3>, ItemPointer,
+                             IntsComparator<3>, IntsEqualityChecker<3>>;
+template class OLCBTreeIndex<IntsKey<4>, ItemPointer,
+                             IntsComparator<4>, IntsEqualityChecker<4>>;
+
+template class OLCBTreeIndex<GenericKey<4>, ItemPointer,
+                             GenericComparator<4>, GenericEqualityChecker<4>>;
+template class OLCBTreeIndex<GenericKey<8>, ItemPointer,
+                             GenericComparator<8>, GenericEqualityChecker<8>>;
+template class OLCBTreeIndex<GenericKey<12>, ItemPointer,
+                             GenericComparator<12>, GenericEqualityChecker<12>>;
+template class OLCBTreeIndex<GenericKey<16>, ItemPointer,
+                             GenericComparator<16>, GenericEqualityChecker<16>>;
+template class OLCBTreeIndex<GenericKey<24>, ItemPointer,
+                             GenericComparator<24>, GenericEqualityChecker<24>>;
+template class OLCBTreeIndex<GenericKey<32>, ItemPointer,
+                             GenericComparator<32>, GenericEqualityChecker<32>>;
+template class OLCBTreeIndex<GenericKey<48>, ItemPointer,
+                             GenericComparator<48>, GenericEqualityChecker<48>>;
+template class OLCBTreeIndex<GenericKey<64>, ItemPointer,
+                             GenericComparator<64>, GenericEqualityChecker<64>>;
+template class OLCBTreeIndex<GenericKey<96>, ItemPointer,
+                             GenericComparator<96>, GenericEqualityChecker<96>>;
+template class OLCBTreeIndex<GenericKey<128>, ItemPointer,
+                             GenericComparator<128>,
+                             GenericEqualityChecker<128>>;
+template class OLCBTreeIndex<GenericKey<256>, ItemPointer,
+                             GenericComparator<256>,
+                             GenericEqualityChecker<256>>;
+template class OLCBTreeIndex<GenericKey<512>, ItemPointer,
+                             GenericComparator<512>,
+                             GenericEqualityChecker<512>>;
+
+template class OLCBTreeIndex<TupleKey, ItemPointer, TupleKeyComparator,
+                             TupleKeyEqualityChecker>;
+
+}  // End index namespace
+}  // End peloton namespace
\ No newline at end of file
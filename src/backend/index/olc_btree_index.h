@@ -0,0 +1,103 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// olc_btree_index.h
+//
+// Identification: src/backend/index/olc_btree_index.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+#include <string>
+
+#include "backend/catalog/manager.h"
+#include "backend/common/platform.h"
+#include "backend/common/types.h"
+#include "backend/index/index.h"
+
+#include "backend/index/olc_btree.h"
+
+namespace peloton {
+namespace index {
+
+/**
+ * B+tree index with optimistic lock coupling.
+ *
+ * There is no index lock, writers only latch the nodes they modify and
+ * readers do not latch anything. Item pointers are stored inline in the
+ * leaves, the ItemPointer * scans return the addresses of their slots.
+ *
+ * @see Index
+ */
+template <typename KeyType, typename ValueType, typename KeyComparator,
+          typename KeyEqualityChecker>
+class OLCBTreeIndex : public Index {
+  friend class IndexFactory;
+
+  typedef OLCBTree<KeyType, ValueType, KeyComparator, KeyEqualityChecker,
+                   ItemPointerEqualityChecker> MapType;
+
+ public:
+  OLCBTreeIndex(IndexMetadata *metadata);
+
+  ~OLCBTreeIndex();
+
+  bool InsertEntry(const storage::Tuple *key, const ItemPointer &location);
+
+  bool DeleteEntry(const storage::Tuple *key, const ItemPointer &location);
+
+  bool CondInsertEntry(const storage::Tuple *key, const ItemPointer &location,
+                       std::function<bool(const ItemPointer &)> predicate);
+
+  void Scan(const std::vector<Value> &values,
+            const std::vector<oid_t> &key_column_ids,
+            const std::vector<ExpressionType> &expr_types,
+            const ScanDirectionType &scan_direction,
+            std::vector<ItemPointer> &, const size_t limit);
+
+  void ScanAllKeys(std::vector<ItemPointer> &);
+
+  void ScanKey(const storage::Tuple *key, std::vector<ItemPointer> &);
+
+  void Scan(const std::vector<Value> &values,
+            const std::vector<oid_t> &key_column_ids,
+            const std::vector<ExpressionType> &exprs,
+            const ScanDirectionType &scan_direction,
+            std::vector<ItemPointer *> &result, const size_t limit);
+
+  void ScanAllKeys(std::vector<ItemPointer *> &result);
+
+  void ScanKey(const storage::Tuple *key,
+               std::vector<ItemPointer *> &result);
+
+  std::string GetTypeName() const;
+
+  bool Cleanup() { return true; }
+
+  size_t GetMemoryFootprint() { return container.GetMemoryFootprint(); }
+
+ protected:
+  // Visit the item pointers of the entries matching the predicates in the
+  // scan direction, along with the slots they are stored in
+  void ScanEntries(const std::vector<Value> &values,
+                   const std::vector<oid_t> &key_column_ids,
+                   const std::vector<ExpressionType> &expr_types,
+                   const ScanDirectionType &scan_direction, const size_t limit,
+                   std::function<void(const ItemPointer &, ItemPointer *)>
+                       visitor);
+
+  // container
+  MapType container;
+
+  // equality checker and comparator
+  KeyEqualityChecker equals;
+  KeyComparator comparator;
+};
+
+}  // End index namespace
+}  // End peloton namespace
\ No newline at end of file
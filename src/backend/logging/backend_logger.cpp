@@ -10,6 +10,9 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <xmmintrin.h>
+
 #include "backend/common/logger.h"
 #include "backend/logging/backend_logger.h"
 #include "backend/logging/loggers/wal_backend_logger.h"
@@ -20,10 +23,12 @@
 namespace peloton {
 namespace logging {
 
+LogBuffer *const BackendLogger::log_buffer_in_use =
+    reinterpret_cast<LogBuffer *>(1);
+
 // create a backend logger
 BackendLogger::BackendLogger()
-    : log_buffer_(std::unique_ptr<LogBuffer>(nullptr)),
-      available_buffer_pool_(
+    : available_buffer_pool_(
           std::unique_ptr<BufferPool>(new CircularBufferPool())),
       persist_buffer_pool_(
           std::unique_ptr<BufferPool>(new CircularBufferPool())) {
@@ -40,6 +45,10 @@ BackendLogger::~BackendLogger() {
         .get()
         ->RemoveBackendLogger(this);
   }
+  auto log_buffer = log_buffer_.load();
+  if (log_buffer != log_buffer_in_use) {
+    delete log_buffer;
+  }
 }
 
 /**
@@ -68,86 +77,148 @@ void BackendLogger::Log(LogRecord *record) {
   // Enqueue the serialized log record into the queue
   record->Serialize(output_buffer);
 
-  this->log_buffer_lock.Lock();
-  if (!log_buffer_) {
-    LOG_TRACE("Acquire the first log buffer in backend logger");
-    this->log_buffer_lock.Unlock();
-    std::unique_ptr<LogBuffer> new_buff =
-        std::move(available_buffer_pool_->Get());
-    this->log_buffer_lock.Lock();
-    log_buffer_ = std::move(new_buff);
-  }
-  // update max logged commit id
-  if (record->GetType() == LOGRECORD_TYPE_TRANSACTION_COMMIT) {
-    auto new_log_commit_id = record->GetTransactionId();
-    assert(new_log_commit_id > highest_logged_commit_message);
-    highest_logged_commit_message = new_log_commit_id;
-    logging_cid_lower_bound = INVALID_CID;
-  }
-
-  // update the max logged id for the current buffer
-  cid_t cur_log_id = record->GetTransactionId();
-
-  // set if this is the max log_id seen so far
-  if (cur_log_id > max_log_id_buffer) {
-    log_buffer_->SetMaxLogId(cur_log_id);
-    max_log_id_buffer = cur_log_id;
-  }
+  auto log_buffer = AcquireLogBuffer();
 
-  if (!log_buffer_->WriteRecord(record)) {
+  if (!log_buffer->WriteRecord(record)) {
     LOG_TRACE("Log buffer is full - Attempt to acquire a new one");
-    // put back a buffer
-    max_log_id_buffer = 0;  // reset
-    persist_buffer_pool_->Put(std::move(log_buffer_));
-    this->log_buffer_lock.Unlock();
-
-    // get a new one
-    std::unique_ptr<LogBuffer> new_buff =
-        std::move(available_buffer_pool_->Get());
-    this->log_buffer_lock.Lock();
-    log_buffer_ = std::move(new_buff);
+    log_buffer = SwitchLogBuffer(log_buffer);
 
     // write to the new log buffer
-    auto success = log_buffer_->WriteRecord(record);
+    auto success = log_buffer->WriteRecord(record);
     if (!success) {
       LOG_ERROR("Write record to log buffer failed");
-      this->log_buffer_lock.Unlock();
+      ReleaseLogBuffer(log_buffer);
       return;
     }
   }
 
-  this->log_buffer_lock.Unlock();
+  RecordLogged(log_buffer, record->GetType(), record->GetTransactionId());
+  ReleaseLogBuffer(log_buffer);
+}
+
+/**
+ * @brief log a tuple record, going through a heap allocated log record
+ * @param type, commit id and locations of the tuple record
+ */
+void BackendLogger::LogTuple(LogRecordType log_record_type, cid_t commit_id,
+                             storage::TileGroup *tile_group,
+                             ItemPointer insert_location,
+                             ItemPointer delete_location) {
+  std::unique_ptr<LogRecord> record(GetTupleRecord(
+      log_record_type, commit_id, tile_group->GetTableId(),
+      tile_group->GetDatabaseId(), insert_location, delete_location));
+
+  Log(record.get());
+}
+
+LogBuffer *BackendLogger::AcquireLogBuffer() {
+  auto log_buffer = log_buffer_.exchange(log_buffer_in_use);
+  assert(log_buffer != log_buffer_in_use);
+
+  if (log_buffer == nullptr) {
+    LOG_TRACE("Acquire a new log buffer in backend logger");
+    log_buffer = available_buffer_pool_->Get().release();
+    log_buffer->SetSequenceNumber(log_buffer_count_++);
+  }
+
+  return log_buffer;
+}
+
+void BackendLogger::ReleaseLogBuffer(LogBuffer *log_buffer) {
+  log_buffer_.store(log_buffer);
+}
+
+LogBuffer *BackendLogger::SwitchLogBuffer(LogBuffer *log_buffer) {
+  // put back a buffer
+  persist_buffer_pool_->Put(std::unique_ptr<LogBuffer>(log_buffer));
+
+  // get a new one
+  log_buffer = available_buffer_pool_->Get().release();
+  log_buffer->SetSequenceNumber(log_buffer_count_++);
+
+  return log_buffer;
 }
 
-// used by the frontend logger to collect data on the current state of the backend
-// returns a pair of commit ids, the first is the lower bound for values this logger may
-// commit, The second is the maximum id this worker has committed
-std::pair<cid_t, cid_t> BackendLogger::PrepareLogBuffers() {
-  this->log_buffer_lock.Lock();
+void BackendLogger::RecordLogged(LogBuffer *log_buffer,
+                                 LogRecordType log_record_type, cid_t cid) {
+  // update max logged commit id
+  if (log_record_type == LOGRECORD_TYPE_TRANSACTION_COMMIT) {
+    assert(cid > highest_logged_commit_message);
+    highest_logged_commit_message = cid;
+    logging_cid_lower_bound = INVALID_CID;
+
+    // the frontend logger counts the commits of each group it flushes
+    log_buffer->IncrementCommitCount();
+  }
+
+  // set if this is the max log_id seen so far
+  if (cid > log_buffer->GetMaxLogId()) {
+    log_buffer->SetMaxLogId(cid);
+  }
+}
+
+// used by the frontend logger to collect the log buffers and data on the
+// current state of the backend
+// returns a pair of commit ids, the first is the lower bound for values this
+// logger may commit, The second is the maximum id this worker has committed
+std::pair<cid_t, cid_t> BackendLogger::PrepareLogBuffers(
+    std::vector<std::unique_ptr<LogBuffer>> &frontend_queue) {
   std::pair<cid_t, cid_t> ret(INVALID_CID, INVALID_CID);
-  // prepare the cid's seen so far
-  if (logging_cid_lower_bound != INVALID_CID ||
-      (log_buffer_ && log_buffer_->GetSize() > 0)) {
-    ret.second = highest_logged_commit_message;
-    if (logging_cid_lower_bound > highest_logged_commit_message) {
-      ret.first = logging_cid_lower_bound;
+
+  // read the commit ids before collecting, a commit they account for is
+  // then always in a collected buffer
+  cid_t lower_bound = logging_cid_lower_bound.load();
+  cid_t highest_commit_id = highest_logged_commit_message.load();
+
+  // take the current buffer, waiting out the record being written into it
+  auto log_buffer = log_buffer_.load();
+  while (true) {
+    if (log_buffer == log_buffer_in_use) {
+      _mm_pause();
+      log_buffer = log_buffer_.load();
+    } else if (log_buffer_.compare_exchange_weak(log_buffer, nullptr)) {
+      break;
     }
   }
-  if (log_buffer_ && log_buffer_->GetSize() > 0) {
-    // put back a buffer
-    LOG_TRACE(
-        "Move the current log buffer to buffer pool, "
-        "highest_logged_commit_message: %d, logging_cid_lower_bound: %d",
-        (int)highest_logged_commit_message, (int)logging_cid_lower_bound);
-    persist_buffer_pool_->Put(std::move(log_buffer_));
-  }
-  this->log_buffer_lock.Unlock();
 
+  // the full buffers queued before the current one was taken, and maybe a
+  // few newer ones
+  std::vector<std::unique_ptr<LogBuffer>> log_buffers;
   auto num_log_buffer = persist_buffer_pool_->GetSize();
   while (num_log_buffer > 0) {
-    local_queue.push_back(persist_buffer_pool_->Get());
+    log_buffers.push_back(persist_buffer_pool_->Get());
     num_log_buffer--;
   }
+
+  if (log_buffer != nullptr && log_buffer->GetSize() > 0) {
+    LOG_TRACE(
+        "Collect the current log buffer, "
+        "highest_logged_commit_message: %d, logging_cid_lower_bound: %d",
+        (int)highest_commit_id, (int)lower_bound);
+    // keep the buffers in the order the backend filled them
+    auto position = std::find_if(
+        log_buffers.begin(), log_buffers.end(),
+        [log_buffer](const std::unique_ptr<LogBuffer> &queued) {
+          return queued->GetSequenceNumber() > log_buffer->GetSequenceNumber();
+        });
+    log_buffers.insert(position, std::unique_ptr<LogBuffer>(log_buffer));
+  } else if (log_buffer != nullptr) {
+    GrantEmptyBuffer(std::unique_ptr<LogBuffer>(log_buffer));
+  }
+
+  for (auto &queued : log_buffers) {
+    frontend_queue.push_back(std::move(queued));
+  }
+
+  // prepare the cid's seen so far
+
+  if (lower_bound != INVALID_CID || log_buffers.empty() == false) {
+    ret.second = highest_commit_id;
+    if (lower_bound > highest_commit_id) {
+      ret.first = lower_bound;
+    }
+  }
+
   return ret;
 }
 
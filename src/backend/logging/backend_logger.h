@@ -13,10 +13,12 @@
 #pragma once
 
 #include <vector>
+#include <atomic>
 #include <mutex>
 #include <condition_variable>
 
 #include "backend/common/types.h"
+#include "backend/common/value.h"
 #include "backend/logging/logger.h"
 #include "backend/logging/log_record.h"
 #include "backend/logging/log_buffer.h"
@@ -25,6 +27,11 @@
 #include "backend/logging/circular_buffer_pool.h"
 
 namespace peloton {
+
+namespace storage {
+class TileGroup;
+}
+
 namespace logging {
 
 //===--------------------------------------------------------------------===//
@@ -48,6 +55,12 @@ class BackendLogger : public Logger {
   // Log the given record
   virtual void Log(LogRecord *record);
 
+  // Log a tuple record for the given tuple versions
+  virtual void LogTuple(LogRecordType log_record_type, cid_t commit_id,
+                        storage::TileGroup *tile_group,
+                        ItemPointer insert_location,
+                        ItemPointer delete_location);
+
   // Construct a log record with tuple information
   virtual LogRecord *GetTupleRecord(LogRecordType log_record_type,
                                     txn_id_t txn_id, oid_t table_oid,
@@ -55,27 +68,19 @@ class BackendLogger : public Logger {
                                     ItemPointer delete_location,
                                     const void *data = nullptr) = 0;
 
-  void SetLoggingCidLowerBound(cid_t cid) {
-    // XXX bad synchronization practice
-    log_buffer_lock.Lock();
-
-    logging_cid_lower_bound = cid;
-
+  virtual void SetLoggingCidLowerBound(cid_t cid) {
     highest_logged_commit_message = INVALID_CID;
 
-    log_buffer_lock.Unlock();
+    logging_cid_lower_bound = cid;
   }
 
   // FIXME The following methods should be exposed to FrontendLogger only
-  // Collect all log buffers to be persisted
-  std::vector<std::unique_ptr<LogBuffer>> &GetLogBuffers() {
-    return local_queue;
-  }
-
-  // used by the frontend logger to collect data on the current state of the backend
-  // returns a pair of commit ids, the first is the lower bound for values this logger may
-  // commit, The second is the maximum id this worker has committed
-  std::pair<cid_t, cid_t> PrepareLogBuffers();
+  // used by the frontend logger to collect the log buffers to be persisted
+  // and data on the current state of the backend
+  // returns a pair of commit ids, the first is the lower bound for values this
+  // logger may commit, The second is the maximum id this worker has committed
+  virtual std::pair<cid_t, cid_t> PrepareLogBuffers(
+      std::vector<std::unique_ptr<LogBuffer>> &frontend_queue);
 
   // Grant an empty buffer to use
   void GrantEmptyBuffer(std::unique_ptr<LogBuffer>);
@@ -93,29 +98,41 @@ class BackendLogger : public Logger {
   VarlenPool *GetVarlenPool() { return backend_pool.get(); }
 
  protected:
-  // the lock for the buffer being used currently
-  Spinlock log_buffer_lock;
+  // take the log buffer being filled, or a new one if the frontend logger
+  // has collected it
+  LogBuffer *AcquireLogBuffer();
+
+  // hand the current buffer back for the frontend logger to collect
+  void ReleaseLogBuffer(LogBuffer *log_buffer);
+
+  // queue a full buffer to be persisted and get an empty one
+  LogBuffer *SwitchLogBuffer(LogBuffer *log_buffer);
+
+  // update the buffer and the commit bounds after writing a record
+  void RecordLogged(LogBuffer *log_buffer, LogRecordType log_record_type,
+                    cid_t cid);
 
-  // temporary local_queue used by backend
-  std::vector<std::unique_ptr<LogBuffer>> local_queue;
+  // marks the current buffer while the backend is writing a record into it
+  static LogBuffer *const log_buffer_in_use;
 
   // commit id of the highest value committed so far
-  cid_t highest_logged_commit_message = INVALID_CID;
+  std::atomic<cid_t> highest_logged_commit_message{INVALID_CID};
 
   // id of the corresponding frontend logger
   int frontend_logger_id = -1;  // default
 
   // lower bound for values this backend may commit
-  cid_t logging_cid_lower_bound = INVALID_CID;
-
-  // max cid for the current log buffer
-  cid_t max_log_id_buffer = 0;
+  std::atomic<cid_t> logging_cid_lower_bound{INVALID_CID};
 
   // temporary serialization buffer
   CopySerializeOutput output_buffer;
 
-  // the current buffer
-  std::unique_ptr<LogBuffer> log_buffer_;
+  // the current buffer, only exchanged atomically between the backend and
+  // the frontend logger
+  std::atomic<LogBuffer *> log_buffer_{nullptr};
+
+  // number of buffers this backend has started to fill
+  size_t log_buffer_count_ = 0;
 
   // the pool of available buffers
   std::unique_ptr<BufferPool> available_buffer_pool_;
@@ -126,6 +143,9 @@ class BackendLogger : public Logger {
   // varlen pool for serialization
   std::unique_ptr<VarlenPool> backend_pool;
 
+  // values of the tuple being logged, reused across records
+  std::vector<Value> tuple_values_;
+
   // shutdown flag
   bool shutdown = false;
 };
@@ -10,9 +10,13 @@
  *-------------------------------------------------------------------------
  */
 
+#include <dirent.h>
+
 #include "backend/logging/checkpoint.h"
 #include "backend/logging/logging_util.h"
 #include "backend/logging/checkpoint/simple_checkpoint.h"
+#include "backend/logging/checkpoint/image_checkpoint.h"
+#include "backend/concurrency/transaction_manager_factory.h"
 
 namespace peloton {
 namespace logging {
@@ -88,6 +92,39 @@ void Checkpoint::InitDirectory() {
   }
 }
 
+void Checkpoint::InitVersionNumber() {
+  // Get checkpoint version
+  LOG_TRACE("Trying to read checkpoint directory");
+  struct dirent *file;
+  auto dirp = opendir(checkpoint_dir.c_str());
+  if (dirp == nullptr) {
+    LOG_TRACE("Opendir failed: Errno: %d, error: %s", errno, strerror(errno));
+    return;
+  }
+
+  while ((file = readdir(dirp)) != NULL) {
+    if (strncmp(file->d_name, FILE_PREFIX.c_str(), FILE_PREFIX.length()) == 0) {
+      // found a checkpoint file!
+      LOG_TRACE("Found a checkpoint file with name %s", file->d_name);
+      int version = LoggingUtil::ExtractNumberFromFileName(file->d_name);
+      if (version > checkpoint_version) {
+        checkpoint_version = version;
+      }
+    }
+  }
+  closedir(dirp);
+  LOG_TRACE("set checkpoint version to: %d", checkpoint_version);
+}
+
+cid_t Checkpoint::GetSnapshotCommitId(cid_t start_commit_id) {
+  cid_t commit_id = LogManager::GetInstance().GetGlobalMaxFlushedCommitId();
+  if (commit_id == INVALID_CID) {
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    commit_id = txn_manager.GetMaxCommittedCid();
+  }
+  return std::max(commit_id, start_commit_id);
+}
+
 std::unique_ptr<Checkpoint> Checkpoint::GetCheckpoint(
     CheckpointType checkpoint_type, bool disable_file_access) {
   if (checkpoint_type == CHECKPOINT_TYPE_NORMAL) {
@@ -95,6 +132,11 @@ std::unique_ptr<Checkpoint> Checkpoint::GetCheckpoint(
         new SimpleCheckpoint(disable_file_access));
     return std::move(checkpoint);
   }
+  if (checkpoint_type == CHECKPOINT_TYPE_IMAGE) {
+    std::unique_ptr<Checkpoint> checkpoint(
+        new ImageCheckpoint(disable_file_access));
+    return std::move(checkpoint);
+  }
   return std::move(std::unique_ptr<Checkpoint>(nullptr));
 }
 
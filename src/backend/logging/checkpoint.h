@@ -64,6 +64,12 @@ class Checkpoint {
 
   void InitDirectory();
 
+  // find the version of the most recent checkpoint file
+  void InitVersionNumber();
+
+  // the latest durable commit id, never older than start_commit_id
+  cid_t GetSnapshotCommitId(cid_t start_commit_id);
+
   // whether file access is disabled. mainly used for testing
   bool disable_file_access = false;
 
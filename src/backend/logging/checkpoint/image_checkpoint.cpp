@@ -0,0 +1,508 @@
+/*-------------------------------------------------------------------------
+ *
+ * image_checkpoint.cpp
+ * file description
+ *
+ * Copyright(c) 2015, CMU
+ *
+ * /peloton/src/backend/logging/checkpoint/image_checkpoint.cpp
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#include <sys/mman.h>
+#include <stdio.h>
+
+#include "backend/logging/checkpoint/image_checkpoint.h"
+#include "backend/logging/checkpoint_tile_scanner.h"
+#include "backend/logging/logging_util.h"
+
+#include "backend/concurrency/transaction_manager_factory.h"
+#include "backend/concurrency/epoch_manager.h"
+#include "backend/executor/logical_tile.h"
+#include "backend/catalog/manager.h"
+#include "backend/storage/data_table.h"
+#include "backend/storage/tile_group_header.h"
+
+#include "backend/common/logger.h"
+#include "backend/common/thread_manager.h"
+#include "backend/common/varlen.h"
+
+namespace peloton {
+namespace logging {
+
+//===--------------------------------------------------------------------===//
+// Image Checkpoint
+//===--------------------------------------------------------------------===//
+
+ImageCheckpoint::ImageCheckpoint(bool disable_file_access)
+    : Checkpoint(disable_file_access) {
+  InitDirectory();
+  InitVersionNumber();
+}
+
+ImageCheckpoint::~ImageCheckpoint() {}
+
+void ImageCheckpoint::DoCheckpoint() {
+  // Create a new file for checkpoint
+  CreateFile();
+
+  start_commit_id_ = GetSnapshotCommitId(0);
+  tuple_count_ = 0;
+
+  LOG_TRACE("DoCheckpoint cid = %lu", start_commit_id_);
+
+  // The header takes a page of its own
+  CopySerializeOutput header;
+  header.WriteLong(image_magic_);
+  header.WriteLong(start_commit_id_);
+  PadToPage(header);
+  Persist(header);
+
+  auto &catalog_manager = catalog::Manager::GetInstance();
+  auto database_count = catalog_manager.GetDatabaseCount();
+  std::vector<std::pair<storage::DataTable *, oid_t>> tables;
+
+  // loop all databases
+  for (oid_t database_idx = 0; database_idx < database_count; database_idx++) {
+    auto database = catalog_manager.GetDatabase(database_idx);
+    auto table_count = database->GetTableCount();
+    auto database_oid = database->GetOid();
+
+    // loop all tables
+    for (oid_t table_idx = 0; table_idx < table_count; table_idx++) {
+      storage::DataTable *target_table = database->GetTable(table_idx);
+      assert(target_table);
+      tables.emplace_back(target_table, database_oid);
+    }
+  }
+
+  // A table is scanned by one worker, which writes its tile group images
+  auto worker_count = std::min(
+      CheckpointManager::GetInstance().GetCheckpointParallelism(),
+      tables.size());
+  std::atomic<size_t> next_table(0);
+
+  ThreadPool::GetWorkerInstance().RunTasks(worker_count, [&]() {
+    size_t table_itr;
+    while ((table_itr = next_table++) < tables.size()) {
+      Scan(tables[table_itr].first, tables[table_itr].second);
+    }
+  });
+
+  // An image without tile group ends the checkpoint
+  CopySerializeOutput end_image;
+  end_image.WriteLong(page_size_);
+  end_image.WriteLong(INVALID_OID);
+  end_image.WriteLong(INVALID_OID);
+  end_image.WriteLong(INVALID_OID);
+  PadToPage(end_image);
+  Persist(end_image);
+
+  if (!disable_file_access) {
+    LoggingUtil::FFlushFsync(file_handle_);
+  }
+
+  Cleanup();
+  most_recent_checkpoint_cid = start_commit_id_;
+}
+
+cid_t ImageCheckpoint::DoRecovery() {
+  // No checkpoint to recover from
+  if (checkpoint_version < 0) {
+    return 0;
+  }
+  std::string file_name = ConcatFileName(checkpoint_dir, checkpoint_version);
+  bool success =
+      LoggingUtil::InitFileHandle(file_name.c_str(), file_handle_, "rb");
+  if (!success) {
+    return 0;
+  }
+
+  auto size = LoggingUtil::GetLogFileSize(file_handle_);
+  if (size < page_size_) {
+    LOG_ERROR("Checkpoint image is too small");
+    fclose(file_handle_.file);
+    return 0;
+  }
+
+  // Pages are copied on write, and only faulted in when they are touched
+  void *address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                       file_handle_.fd, 0);
+  fclose(file_handle_.file);
+  if (address == MAP_FAILED) {
+    LOG_ERROR("Failed to map checkpoint image: %s", strerror(errno));
+    return 0;
+  }
+  std::shared_ptr<char> mapping(static_cast<char *>(address),
+                                [size](char *mapped) { munmap(mapped, size); });
+
+  ReferenceSerializeInputBE header(mapping.get(), page_size_);
+  if (header.ReadLong() != image_magic_) {
+    LOG_ERROR("Invalid checkpoint image");
+    return 0;
+  }
+  cid_t commit_id = header.ReadLong();
+
+  // Collect the tile group images up to the end image
+  const size_t manifest_prefix_size = 4 * sizeof(int64_t);
+  std::vector<size_t> image_offsets;
+  size_t offset = page_size_;
+  bool reached_end_image = false;
+  while (offset + manifest_prefix_size <= size) {
+    ReferenceSerializeInputBE manifest(mapping.get() + offset,
+                                       manifest_prefix_size);
+    size_t image_size = manifest.ReadLong();
+    manifest.ReadLong();
+    manifest.ReadLong();
+    oid_t tile_group_id = manifest.ReadLong();
+    if (image_size < manifest_prefix_size || offset + image_size > size) {
+      break;
+    }
+    if (tile_group_id == INVALID_OID) {
+      reached_end_image = true;
+      break;
+    }
+    image_offsets.push_back(offset);
+    offset += image_size;
+  }
+
+  if (!reached_end_image) {
+    LOG_ERROR("Torn checkpoint image");
+    return 0;
+  }
+
+  // Tile groups are adopted concurrently, each by one worker
+  auto worker_count = std::min(
+      CheckpointManager::GetInstance().GetCheckpointParallelism(),
+      image_offsets.size());
+  std::atomic<size_t> next_image(0);
+  std::mutex max_mutex;
+  oid_t max_oid = 0;
+  cid_t max_cid = commit_id;
+
+  ThreadPool::GetWorkerInstance().RunTasks(worker_count, [&]() {
+    oid_t worker_max_oid = 0;
+    cid_t worker_max_cid = 0;
+    size_t image_itr;
+    while ((image_itr = next_image++) < image_offsets.size()) {
+      auto image_offset = image_offsets[image_itr];
+      RecoverTileGroup(mapping.get() + image_offset, size - image_offset,
+                       mapping, worker_max_oid, worker_max_cid);
+    }
+
+    std::lock_guard<std::mutex> lock(max_mutex);
+    max_oid = std::max(max_oid, worker_max_oid);
+    max_cid = std::max(max_cid, worker_max_cid);
+  });
+
+  // After finishing recovery, set the next oid with maximum oid
+  // observed during the recovery
+  auto &manager = catalog::Manager::GetInstance();
+  if (max_oid > manager.GetNextOid()) {
+    manager.SetNextOid(max_oid);
+  }
+
+  // FIXME this is not thread safe for concurrent checkpoint recovery
+  concurrency::TransactionManagerFactory::GetInstance().SetNextCid(max_cid);
+  CheckpointManager::GetInstance().SetRecoveredCid(commit_id);
+  return commit_id;
+}
+
+void ImageCheckpoint::Scan(storage::DataTable *target_table,
+                           oid_t database_oid) {
+  auto schema = target_table->GetSchema();
+  assert(schema);
+  std::vector<oid_t> column_ids;
+  column_ids.resize(schema->GetColumnCount());
+  std::iota(column_ids.begin(), column_ids.end(), 0);
+
+  oid_t current_tile_group_offset = START_OID;
+  auto table_tile_group_count = target_table->GetTileGroupCount();
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  CheckpointTileScanner scanner;
+  CopySerializeOutput output;
+
+  while (current_tile_group_offset < table_tile_group_count) {
+    // Every tile group is scanned at the latest durable commit id, with an
+    // epoch pinned only while its image is taken
+    auto epoch_id = epoch_manager.EnterCurrentEpoch();
+    auto snapshot_cid = GetSnapshotCommitId(start_commit_id_);
+    epoch_manager.SetEpochMaxCid(epoch_id, snapshot_cid);
+
+    auto tile_group = target_table->GetTileGroup(current_tile_group_offset);
+    std::unique_ptr<executor::LogicalTile> logical_tile(
+        scanner.Scan(tile_group, column_ids, snapshot_cid));
+
+    if (logical_tile && logical_tile->GetTupleCount() > 0) {
+      SerializeTileGroup(output, tile_group.get(), database_oid, snapshot_cid,
+                         logical_tile->GetPositionList(0));
+    }
+    epoch_manager.ExitEpoch(epoch_id);
+
+    Persist(output);
+    current_tile_group_offset++;
+  }
+}
+
+// Private Functions
+void ImageCheckpoint::CreateFile() {
+  if (disable_file_access) return;
+  // open checkpoint file and file descriptor
+  std::string file_name = ConcatFileName(checkpoint_dir, ++checkpoint_version);
+  bool success =
+      LoggingUtil::InitFileHandle(file_name.c_str(), file_handle_, "wb");
+  if (!success) {
+    assert(false);
+    return;
+  }
+  LOG_TRACE("Created a new checkpoint file: %s", file_name.c_str());
+}
+
+void ImageCheckpoint::SerializeTileGroup(
+    CopySerializeOutput &output, storage::TileGroup *tile_group,
+    oid_t database_oid, cid_t snapshot_cid,
+    const std::vector<oid_t> &visible_slots) {
+  output.Reset();
+
+  // Manifest
+  size_t image_size_position = output.ReserveBytes(sizeof(int64_t));
+  output.WriteLong(database_oid);
+  output.WriteLong(tile_group->GetTableId());
+  output.WriteLong(tile_group->GetTileGroupId());
+  output.WriteLong(snapshot_cid);
+  output.WriteLong(tile_group->GetAllocatedTupleCount());
+
+  auto &column_map = tile_group->GetColumnMap();
+  output.WriteLong(column_map.size());
+  for (auto &entry : column_map) {
+    output.WriteLong(entry.first);
+    output.WriteLong(entry.second.first);
+    output.WriteLong(entry.second.second);
+  }
+
+  output.WriteLong(visible_slots.size());
+  for (auto tuple_slot : visible_slots) {
+    output.WriteInt(tuple_slot);
+  }
+
+  auto tile_count = tile_group->GetTileCount();
+  output.WriteLong(tile_count);
+  std::vector<size_t> data_offset_positions;
+  for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+    auto tile = tile_group->GetTile(tile_itr);
+    output.WriteLong(tile->GetColumnCount());
+    output.WriteLong(tile->GetSchema()->GetLength());
+    data_offset_positions.push_back(output.ReserveBytes(sizeof(int64_t)));
+    output.WriteLong(tile->GetInlinedSize());
+  }
+  size_t varlen_offset_position = output.ReserveBytes(sizeof(int64_t));
+
+  // Raw tile data
+  std::vector<size_t> data_offsets;
+  for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+    auto tile = tile_group->GetTile(tile_itr);
+    PadToPage(output);
+    data_offsets.push_back(output.Position());
+    output.WriteLongAt(data_offset_positions[tile_itr], output.Position());
+    output.WriteBytes(tile->GetTupleLocation(0), tile->GetInlinedSize());
+  }
+
+  // Varlen section, the pointers of the visible tuples are replaced with
+  // the offset of their value in the section plus one, or zero for null
+  size_t varlen_offset = output.Position();
+  output.WriteLongAt(varlen_offset_position, varlen_offset);
+  for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+    auto tile = tile_group->GetTile(tile_itr);
+    auto tile_schema = tile->GetSchema();
+    auto tuple_length = tile_schema->GetLength();
+
+    for (oid_t column_itr = 0; column_itr < tile->GetColumnCount();
+         column_itr++) {
+      if (tile_schema->IsInlined(column_itr)) continue;
+      auto column_offset = tile_schema->GetOffset(column_itr);
+
+      for (auto tuple_slot : visible_slots) {
+        Varlen *varlen = *reinterpret_cast<Varlen **>(
+            tile->GetTupleLocation(tuple_slot) + column_offset);
+        uint64_t varlen_reference = 0;
+        if (varlen != nullptr) {
+          varlen_reference = output.Position() - varlen_offset + 1;
+          output.WriteLong(varlen->GetSize());
+          output.WriteBytes(varlen->Get(), varlen->GetSize());
+        }
+        output.WriteBytesAt(data_offsets[tile_itr] +
+                                tuple_slot * tuple_length + column_offset,
+                            &varlen_reference, sizeof(varlen_reference));
+      }
+    }
+  }
+
+  PadToPage(output);
+  output.WriteLongAt(image_size_position, output.Size());
+  tuple_count_ += visible_slots.size();
+}
+
+bool ImageCheckpoint::RecoverTileGroup(const char *image, size_t image_size,
+                                       const std::shared_ptr<char> &mapping,
+                                       oid_t &max_oid, cid_t &max_cid) {
+  ReferenceSerializeInputBE manifest(image, image_size);
+  manifest.ReadLong();
+  oid_t database_oid = manifest.ReadLong();
+  oid_t table_oid = manifest.ReadLong();
+  oid_t tile_group_id = manifest.ReadLong();
+  cid_t snapshot_cid = manifest.ReadLong();
+  size_t tuple_slot_count = manifest.ReadLong();
+
+  storage::column_map_type column_map;
+  size_t column_count = manifest.ReadLong();
+  for (size_t column_itr = 0; column_itr < column_count; column_itr++) {
+    oid_t column_id = manifest.ReadLong();
+    oid_t tile_id = manifest.ReadLong();
+    oid_t tile_column_id = manifest.ReadLong();
+    column_map[column_id] = std::make_pair(tile_id, tile_column_id);
+  }
+
+  std::vector<oid_t> visible_slots(manifest.ReadLong());
+  for (auto &tuple_slot : visible_slots) {
+    tuple_slot = manifest.ReadInt();
+  }
+
+  size_t tile_count = manifest.ReadLong();
+  std::vector<size_t> tile_column_counts, tuple_lengths, data_offsets,
+      data_sizes;
+  for (size_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+    tile_column_counts.push_back(manifest.ReadLong());
+    tuple_lengths.push_back(manifest.ReadLong());
+    data_offsets.push_back(manifest.ReadLong());
+    data_sizes.push_back(manifest.ReadLong());
+  }
+  const char *varlen_section = image + manifest.ReadLong();
+
+  auto &manager = catalog::Manager::GetInstance();
+  auto database = manager.GetDatabaseWithOid(database_oid);
+  storage::DataTable *table =
+      (database != nullptr) ? database->GetTableWithOid(table_oid) : nullptr;
+  if (table == nullptr) {
+    // the table was deleted
+    return false;
+  }
+
+  if (manager.GetTileGroup(tile_group_id) != nullptr) {
+    LOG_ERROR("Tile group %u already exists", tile_group_id);
+    return false;
+  }
+  table->AddTileGroupWithOidForRecovery(tile_group_id, column_map,
+                                        tuple_slot_count);
+  auto tile_group = manager.GetTileGroup(tile_group_id);
+
+  // The tiles must have the layout they were written with
+  if (tile_group->GetTileCount() != tile_count) {
+    LOG_ERROR("Tile group %u does not match its image", tile_group_id);
+    return false;
+  }
+  for (size_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+    auto tile = tile_group->GetTile(tile_itr);
+    if (tile->GetColumnCount() != tile_column_counts[tile_itr] ||
+        tile->GetSchema()->GetLength() != tuple_lengths[tile_itr] ||
+        tile->GetInlinedSize() != data_sizes[tile_itr] ||
+        data_offsets[tile_itr] + data_sizes[tile_itr] > image_size) {
+      LOG_ERROR("Tile group %u does not match its image", tile_group_id);
+      return false;
+    }
+  }
+
+  for (size_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+    auto tile = tile_group->GetTile(tile_itr);
+    tile->AdoptData(const_cast<char *>(image) + data_offsets[tile_itr],
+                    mapping);
+
+    // Rebuild the varlen values of the visible tuples in the tile's pool
+    auto tile_schema = tile->GetSchema();
+    for (oid_t column_itr = 0; column_itr < tile->GetColumnCount();
+         column_itr++) {
+      if (tile_schema->IsInlined(column_itr)) continue;
+      auto column_offset = tile_schema->GetOffset(column_itr);
+
+      for (auto tuple_slot : visible_slots) {
+        char *field = tile->GetTupleLocation(tuple_slot) + column_offset;
+        uint64_t varlen_reference;
+        std::memcpy(&varlen_reference, field, sizeof(varlen_reference));
+
+        Varlen *varlen = nullptr;
+        if (varlen_reference != 0) {
+          const char *entry = varlen_section + varlen_reference - 1;
+          ReferenceSerializeInputBE entry_input(entry, sizeof(int64_t));
+          size_t varlen_size = entry_input.ReadLong();
+          varlen = Varlen::Create(varlen_size, tile->GetPool());
+          std::memcpy(varlen->Get(), entry + sizeof(int64_t), varlen_size);
+        }
+        std::memcpy(field, &varlen, sizeof(varlen));
+      }
+    }
+  }
+
+  // The visible tuples are committed from the commit id of the image
+  auto tile_group_header = tile_group->GetHeader();
+  for (auto tuple_slot : visible_slots) {
+    tile_group_header->GetEmptyTupleSlot(tuple_slot);
+    tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+    tile_group_header->SetBeginCommitId(tuple_slot, snapshot_cid);
+    tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+    tile_group_header->SetInsertCommit(tuple_slot, false);
+    tile_group_header->SetDeleteCommit(tuple_slot, false);
+    tile_group_header->SetNextItemPointer(tuple_slot, INVALID_ITEMPOINTER);
+  }
+
+  table->GetTileGroupLock().WriteLock();
+  table->IncreaseNumberOfTuplesBy(visible_slots.size());
+  table->GetTileGroupLock().Unlock();
+
+  max_oid = std::max(max_oid, tile_group_id);
+  max_cid = std::max(max_cid, snapshot_cid);
+  tuple_count_ += visible_slots.size();
+  LOG_TRACE("Recovered tile group %u with %lu tuples from checkpoint image",
+            tile_group_id, visible_slots.size());
+  return true;
+}
+
+// Write an image with a single large write
+void ImageCheckpoint::Persist(CopySerializeOutput &output) {
+  if (output.Size() == 0) return;
+  if (!disable_file_access) {
+    assert(file_handle_.file);
+    assert(file_handle_.fd != INVALID_FILE_DESCRIPTOR);
+
+    std::lock_guard<std::mutex> lock(file_mutex_);
+    fwrite(output.Data(), sizeof(char), output.Size(), file_handle_.file);
+  }
+  output.Reset();
+}
+
+void ImageCheckpoint::Cleanup() {
+  if (!disable_file_access) {
+    fclose(file_handle_.file);
+
+    // Remove previous version
+    if (checkpoint_version > 0) {
+      auto previous_version =
+          ConcatFileName(checkpoint_dir, checkpoint_version - 1);
+      if (remove(previous_version.c_str()) != 0) {
+        LOG_TRACE("Failed to remove file %s", previous_version.c_str());
+      }
+    }
+  }
+  // Truncate logs
+  LogManager::GetInstance().TruncateLogs(start_commit_id_);
+}
+
+void ImageCheckpoint::PadToPage(CopySerializeOutput &output) {
+  static const char padding[page_size_] = {0};
+  auto remainder = output.Position() % page_size_;
+  if (remainder != 0) {
+    output.WriteBytes(padding, page_size_ - remainder);
+  }
+}
+
+}  // namespace logging
+}  // namespace peloton
@@ -0,0 +1,109 @@
+/*-------------------------------------------------------------------------
+ *
+ * image_checkpoint.h
+ * file description
+ *
+ * Copyright(c) 2015, CMU
+ *
+ * /peloton/src/backend/logging/checkpoint/image_checkpoint.h
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "backend/logging/checkpoint.h"
+#include "backend/common/serializer.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace peloton {
+namespace logging {
+
+//===--------------------------------------------------------------------===//
+// Image Checkpoint
+//===--------------------------------------------------------------------===//
+
+/**
+ * A checkpoint that mirrors the in-memory layout of the tile groups, so
+ * that recovery maps the file and adopts its tiles instead of inserting
+ * the tuples one at a time.
+ *
+ * Layout :
+ *
+ *  -----------------------------------------------------------------------
+ *  | Header page | Tile group image | ... | Tile group image | End image |
+ *  -----------------------------------------------------------------------
+ *
+ * Every tile group image is page aligned and starts with its manifest :
+ * its size, the database, table and tile group oids, the commit id it was
+ * scanned at, the number of tuple slots, the column map, the layout of
+ * every tile and the visible tuple slots. The raw data of each tile
+ * follows, page aligned, and the varlen section comes last. Uninlined
+ * values are stored as offsets into the varlen section in place of the
+ * Varlen pointers. An image with an invalid tile group oid ends the file.
+ */
+class ImageCheckpoint : public Checkpoint {
+ public:
+  ImageCheckpoint(const ImageCheckpoint &) = delete;
+  ImageCheckpoint &operator=(const ImageCheckpoint &) = delete;
+  ImageCheckpoint(ImageCheckpoint &&) = delete;
+  ImageCheckpoint &operator=(ImageCheckpoint &&) = delete;
+  ImageCheckpoint(bool disable_file_access);
+  ~ImageCheckpoint();
+
+  // Inherited functions
+  void DoCheckpoint();
+
+  cid_t DoRecovery();
+
+  // Internal functions
+  void Scan(storage::DataTable *target_table, oid_t database_oid);
+
+  // Getters and Setters
+  inline void SetStartCommitId(cid_t start_commit_id) {
+    start_commit_id_ = start_commit_id;
+  }
+
+  // number of tuples written by the current checkpoint, or restored by the
+  // recovery
+  inline size_t GetTupleCount() const { return tuple_count_; }
+
+ private:
+  void CreateFile();
+
+  void SerializeTileGroup(CopySerializeOutput &output,
+                          storage::TileGroup *tile_group,
+                          oid_t database_oid, cid_t snapshot_cid,
+                          const std::vector<oid_t> &visible_slots);
+
+  bool RecoverTileGroup(const char *image, size_t image_size,
+                        const std::shared_ptr<char> &mapping,
+                        oid_t &max_oid, cid_t &max_cid);
+
+  void Persist(CopySerializeOutput &output);
+
+  void Cleanup();
+
+  static void PadToPage(CopySerializeOutput &output);
+
+  // images are aligned to this size so that tiles can be mapped in place
+  static constexpr size_t page_size_ = 4096;
+
+  static constexpr int64_t image_magic_ = 0x504c494d47303031;  // PLIMG001
+
+  FileHandle file_handle_ = INVALID_FILE_HANDLE;
+
+  // serializes the image writes of concurrent scans
+  std::mutex file_mutex_;
+
+  std::atomic<size_t> tuple_count_{0};
+
+  // commit id of current checkpoint, every tile group is scanned at this
+  // commit id or a later one
+  cid_t start_commit_id_ = 0;
+};
+
+}  // namespace logging
+}  // namespace peloton
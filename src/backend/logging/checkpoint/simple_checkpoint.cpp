@@ -10,7 +10,6 @@
  *-------------------------------------------------------------------------
  */
 
-#include <dirent.h>
 #include <sys/stat.h>
 #include <sys/mman.h>
 #include <stdio.h>
@@ -26,13 +25,13 @@
 
 #include "backend/concurrency/transaction_manager_factory.h"
 #include "backend/concurrency/transaction_manager.h"
-#include "backend/concurrency/transaction.h"
-#include "backend/executor/executors.h"
-#include "backend/executor/executor_context.h"
-#include "backend/planner/seq_scan_plan.h"
+#include "backend/concurrency/epoch_manager.h"
+#include "backend/executor/logical_tile.h"
+#include "backend/expression/container_tuple.h"
 #include "backend/catalog/manager.h"
 
 #include "backend/common/logger.h"
+#include "backend/common/thread_manager.h"
 #include "backend/common/types.h"
 
 namespace peloton {
@@ -42,45 +41,33 @@ namespace logging {
 //===--------------------------------------------------------------------===//
 
 SimpleCheckpoint::SimpleCheckpoint(bool disable_file_access)
-    : Checkpoint(disable_file_access), logger_(nullptr) {
+    : Checkpoint(disable_file_access) {
   InitDirectory();
   InitVersionNumber();
 }
 
-SimpleCheckpoint::~SimpleCheckpoint() {
-  for (auto &record : records_) {
-    record.reset();
-  }
-  records_.clear();
-}
+SimpleCheckpoint::~SimpleCheckpoint() {}
 
 void SimpleCheckpoint::DoCheckpoint() {
   // TODO split checkpoint file into multiple files in the future
   // Create a new file for checkpoint
   CreateFile();
 
-  auto &log_manager = LogManager::GetInstance();
-  if (logger_ == nullptr) {
-    logger_.reset(BackendLogger::GetBackendLogger(LOGGING_TYPE_NVM_WAL));
-  }
-
-  start_commit_id_ = log_manager.GetGlobalMaxFlushedCommitId();
-  if (start_commit_id_ == INVALID_CID) {
-    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
-    start_commit_id_ = txn_manager.GetMaxCommittedCid();
-  }
+  start_commit_id_ = GetSnapshotCommitId(0);
+  tuple_count_ = 0;
 
   LOG_TRACE("DoCheckpoint cid = %lu", start_commit_id_);
 
   // Add txn begin record
-  std::shared_ptr<LogRecord> begin_record(new TransactionRecord(
-      LOGRECORD_TYPE_TRANSACTION_BEGIN, start_commit_id_));
+  TransactionRecord begin_record(LOGRECORD_TYPE_TRANSACTION_BEGIN,
+                                 start_commit_id_);
   CopySerializeOutput begin_output_buffer;
-  begin_record->Serialize(begin_output_buffer);
-  records_.push_back(begin_record);
+  begin_record.Serialize(begin_output_buffer);
+  Persist(begin_output_buffer);
 
   auto &catalog_manager = catalog::Manager::GetInstance();
   auto database_count = catalog_manager.GetDatabaseCount();
+  std::vector<std::pair<storage::DataTable *, oid_t>> tables;
 
   // loop all databases
   for (oid_t database_idx = 0; database_idx < database_count; database_idx++) {
@@ -95,19 +82,34 @@ void SimpleCheckpoint::DoCheckpoint() {
       assert(target_table);
       LOG_TRACE("SeqScan: database idx %u table idx %u: %s", database_idx,
                 table_idx, target_table->GetName().c_str());
-      Scan(target_table, database_oid);
+      tables.emplace_back(target_table, database_oid);
     }
   }
 
+  // A table is scanned by one worker, which streams its chunks to the file
+  auto worker_count = std::min(
+      CheckpointManager::GetInstance().GetCheckpointParallelism(),
+      tables.size());
+  std::atomic<size_t> next_table(0);
+
+  ThreadPool::GetWorkerInstance().RunTasks(worker_count, [&]() {
+    size_t table_itr;
+    while ((table_itr = next_table++) < tables.size()) {
+      Scan(tables[table_itr].first, tables[table_itr].second);
+    }
+  });
+
   // Add txn commit record
-  std::shared_ptr<LogRecord> commit_record(new TransactionRecord(
-      LOGRECORD_TYPE_TRANSACTION_COMMIT, start_commit_id_));
+  TransactionRecord commit_record(LOGRECORD_TYPE_TRANSACTION_COMMIT,
+                                  start_commit_id_);
   CopySerializeOutput commit_output_buffer;
-  commit_record->Serialize(commit_output_buffer);
-  records_.push_back(commit_record);
+  commit_record.Serialize(commit_output_buffer);
+  Persist(commit_output_buffer);
 
   // TODO Add delimiter record for checkpoint recovery as well
-  Persist();
+  if (!disable_file_access) {
+    LoggingUtil::FFlushFsync(file_handle_);
+  }
 
   Cleanup();
   most_recent_checkpoint_cid = start_commit_id_;
@@ -171,7 +173,8 @@ cid_t SimpleCheckpoint::DoRecovery() {
   }
 
   // FIXME this is not thread safe for concurrent checkpoint recovery
-  concurrency::TransactionManagerFactory::GetInstance().SetNextCid(commit_id);
+  concurrency::TransactionManagerFactory::GetInstance().SetNextCid(
+      std::max(commit_id, max_recovered_cid_));
   CheckpointManager::GetInstance().SetRecoveredCid(commit_id);
   return commit_id;
 }
@@ -200,9 +203,16 @@ void SimpleCheckpoint::InsertTuple(cid_t commit_id) {
     LOG_ERROR("Torn checkpoint write.");
     return;
   }
+  // Tuples are visible from the commit id their tile group was scanned at,
+  // so that replaying the log skips the versions they already reflect
+  auto tuple_commit_id = std::max(commit_id, tuple_record.GetTransactionId());
+  if (max_recovered_cid_ < tuple_commit_id) {
+    max_recovered_cid_ = tuple_commit_id;
+  }
+
   auto target_location = tuple_record.GetInsertLocation();
   auto tile_group_id = target_location.block;
-  RecoverTuple(tuple.get(), table, target_location, commit_id);
+  RecoverTuple(tuple.get(), table, target_location, tuple_commit_id);
   if (max_oid_ < target_location.block) {
     max_oid_ = tile_group_id;
   }
@@ -220,19 +230,29 @@ void SimpleCheckpoint::Scan(storage::DataTable *target_table,
 
   oid_t current_tile_group_offset = START_OID;
   auto table_tile_group_count = target_table->GetTileGroupCount();
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
   CheckpointTileScanner scanner;
+  CopySerializeOutput chunk;
 
-  // TODO scan assigned tile in multi-thread checkpoint
   while (current_tile_group_offset < table_tile_group_count) {
+    // Every tile group is scanned at the latest durable commit id. Pinning
+    // an epoch only for the scan of one tile group keeps the garbage
+    // collector from reclaiming its versions without holding it back for
+    // the whole checkpoint.
+    auto epoch_id = epoch_manager.EnterCurrentEpoch();
+    auto snapshot_cid = GetSnapshotCommitId(start_commit_id_);
+    epoch_manager.SetEpochMaxCid(epoch_id, snapshot_cid);
+
     // Retrieve a tile group
     auto tile_group = target_table->GetTileGroup(current_tile_group_offset);
 
     // Retrieve a logical tile
     std::unique_ptr<executor::LogicalTile> logical_tile(
-        scanner.Scan(tile_group, column_ids, start_commit_id_));
+        scanner.Scan(tile_group, column_ids, snapshot_cid));
 
     // Empty result
     if (!logical_tile) {
+      epoch_manager.ExitEpoch(epoch_id);
       current_tile_group_offset++;
       continue;
     }
@@ -241,44 +261,43 @@ void SimpleCheckpoint::Scan(storage::DataTable *target_table,
                              .base_tile->GetTileGroup()
                              ->GetTileGroupId();
 
-    // Go over the logical tile
+    // Go over the logical tile and serialize the tuples in place
+    auto &position_list = logical_tile->GetPositionList(0);
+    size_t tile_group_tuple_count = 0;
     for (oid_t tuple_id : *logical_tile) {
       expression::ContainerTuple<executor::LogicalTile> cur_tuple(
           logical_tile.get(), tuple_id);
 
-      // Logging
-      {
-        // construct a physical tuple from the logical tuple
-        std::unique_ptr<storage::Tuple> tuple(new storage::Tuple(schema, true));
-        for (auto column_id : column_ids) {
-          tuple->SetValue(column_id, cur_tuple.GetValue(column_id),
-                          this->pool.get());
-        }
-        ItemPointer location(tile_group_id, tuple_id);
-        // TODO is it possible to avoid `new` for checkpoint?
-        std::shared_ptr<LogRecord> record(logger_->GetTupleRecord(
-            LOGRECORD_TYPE_TUPLE_INSERT, INITIAL_TXN_ID, target_table->GetOid(),
-            database_oid, location, INVALID_ITEMPOINTER, tuple.get()));
-        assert(record);
-        CopySerializeOutput output_buffer;
-        record->Serialize(output_buffer);
-        LOG_TRACE("Insert a new record for checkpoint (%u, %u)", tile_group_id,
-                  tuple_id);
-        records_.push_back(record);
+      // the logical tile only holds the visible slots
+      ItemPointer location(tile_group_id, position_list[tuple_id]);
+      TupleRecord record(LOGRECORD_TYPE_WAL_TUPLE_INSERT, snapshot_cid,
+                         target_table->GetOid(), location, INVALID_ITEMPOINTER,
+                         nullptr, database_oid);
+      record.SerializeHeader(chunk);
+
+      // same layout as Tuple::SerializeTo
+      size_t start = chunk.ReserveBytes(sizeof(int32_t));
+      for (auto column_id : column_ids) {
+        cur_tuple.GetValue(column_id).SerializeTo(chunk);
       }
+      chunk.WriteIntAt(start, static_cast<int32_t>(chunk.Position() - start -
+                                                   sizeof(int32_t)));
+
+      LOG_TRACE("Insert a new record for checkpoint (%u, %u)", tile_group_id,
+                tuple_id);
+      tile_group_tuple_count++;
+    }
+    epoch_manager.ExitEpoch(epoch_id);
+    tuple_count_ += tile_group_tuple_count;
+
+    // persist to file once the chunk is large enough
+    if (chunk.Size() >= chunk_size_) {
+      Persist(chunk);
     }
-    // persist to file once per tile
-    Persist();
     current_tile_group_offset++;
   }
-}
-
-void SimpleCheckpoint::SetLogger(BackendLogger *logger) {
-  logger_.reset(logger);
-}
 
-std::vector<std::shared_ptr<LogRecord>> SimpleCheckpoint::GetRecords() {
-  return records_;
+  Persist(chunk);
 }
 
 // Private Functions
@@ -295,31 +314,21 @@ void SimpleCheckpoint::CreateFile() {
   LOG_TRACE("Created a new checkpoint file: %s", file_name.c_str());
 }
 
-// Only called when checkpoint has actual contents
-void SimpleCheckpoint::Persist() {
-  if (disable_file_access) return;
-  assert(file_handle_.file);
-  assert(file_handle_.fd != INVALID_FILE_DESCRIPTOR);
-
-  LOG_TRACE("Persisting %lu checkpoint entries", records_.size());
-  // write all the record in the queue and free them
-  for (auto record : records_) {
-    assert(record);
-    assert(record->GetMessageLength() > 0);
-    fwrite(record->GetMessage(), sizeof(char), record->GetMessageLength(),
-           file_handle_.file);
-    record.reset();
+// Write a chunk of serialized records with a single large write
+void SimpleCheckpoint::Persist(CopySerializeOutput &chunk) {
+  if (chunk.Size() == 0) return;
+  if (!disable_file_access) {
+    assert(file_handle_.file);
+    assert(file_handle_.fd != INVALID_FILE_DESCRIPTOR);
+
+    LOG_TRACE("Persisting %lu bytes of checkpoint entries", chunk.Size());
+    std::lock_guard<std::mutex> lock(file_mutex_);
+    fwrite(chunk.Data(), sizeof(char), chunk.Size(), file_handle_.file);
   }
-  records_.clear();
+  chunk.Reset();
 }
 
 void SimpleCheckpoint::Cleanup() {
-  // Clean up the record queue
-  for (auto record : records_) {
-    record.reset();
-  }
-  records_.clear();
-
   if (!disable_file_access) {
     // Close and sync the current one
     fclose(file_handle_.file);
@@ -337,29 +346,5 @@ void SimpleCheckpoint::Cleanup() {
   LogManager::GetInstance().TruncateLogs(start_commit_id_);
 }
 
-void SimpleCheckpoint::InitVersionNumber() {
-  // Get checkpoint version
-  LOG_TRACE("Trying to read checkpoint directory");
-  struct dirent *file;
-  auto dirp = opendir(checkpoint_dir.c_str());
-  if (dirp == nullptr) {
-    LOG_TRACE("Opendir failed: Errno: %d, error: %s", errno, strerror(errno));
-    return;
-  }
-
-  while ((file = readdir(dirp)) != NULL) {
-    if (strncmp(file->d_name, FILE_PREFIX.c_str(), FILE_PREFIX.length()) == 0) {
-      // found a checkpoint file!
-      LOG_TRACE("Found a checkpoint file with name %s", file->d_name);
-      int version = LoggingUtil::ExtractNumberFromFileName(file->d_name);
-      if (version > checkpoint_version) {
-        checkpoint_version = version;
-      }
-    }
-  }
-  closedir(dirp);
-  LOG_TRACE("set checkpoint version to: %d", checkpoint_version);
-}
-
 }  // namespace logging
 }  // namespace peloton
@@ -14,8 +14,10 @@
 
 #include "backend/logging/checkpoint.h"
 #include "backend/logging/log_record.h"
-#include "backend/executor/seq_scan_executor.h"
+#include "backend/common/serializer.h"
+#include <atomic>
 #include <memory>
+#include <mutex>
 
 #include <thread>
 
@@ -46,34 +48,39 @@ class SimpleCheckpoint : public Checkpoint {
   void Scan(storage::DataTable *target_table, oid_t database_oid);
 
   // Getters and Setters
-  void SetLogger(BackendLogger *logger);
-
-  std::vector<std::shared_ptr<LogRecord>> GetRecords();
-
   inline void SetStartCommitId(cid_t start_commit_id) {
     start_commit_id_ = start_commit_id;
   }
 
+  // number of tuples written by the scans of the current checkpoint
+  inline size_t GetTupleCount() const { return tuple_count_; }
+
  private:
   void CreateFile();
 
-  void Persist();
+  void Persist(CopySerializeOutput &chunk);
 
   void Cleanup();
 
-  void InitVersionNumber();
-
-  std::vector<std::shared_ptr<LogRecord>> records_;
+  // chunks are written once they grow past this size
+  static constexpr size_t chunk_size_ = 1 << 20;
 
   FileHandle file_handle_ = INVALID_FILE_HANDLE;
 
-  std::unique_ptr<BackendLogger> logger_;
+  // serializes the chunk writes of concurrent scans
+  std::mutex file_mutex_;
+
+  std::atomic<size_t> tuple_count_{0};
 
   // Keep tracking max oid for setting next_oid in manager
   // For active processing after recovery
   oid_t max_oid_ = 0;
 
-  // commit id of current checkpoint
+  // max commit id of the recovered tuples
+  cid_t max_recovered_cid_ = 0;
+
+  // commit id of current checkpoint, every tile group is scanned at this
+  // commit id or a later one
   cid_t start_commit_id_ = 0;
 };
 
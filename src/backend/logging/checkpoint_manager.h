@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #pragma once
+#include <algorithm>
 #include <vector>
 #include <memory>
 
@@ -66,6 +67,13 @@ class CheckpointManager {
     num_checkpointers_ = num_checkpointers;
   }
 
+  // number of threads scanning tables during a checkpoint, it is serial if 1
+  void SetCheckpointParallelism(size_t parallelism) {
+    checkpoint_parallelism_ = std::max(parallelism, (size_t)1);
+  }
+
+  size_t GetCheckpointParallelism() const { return checkpoint_parallelism_; }
+
   // remove all checkpointers
   void DestroyCheckpointers();
 
@@ -91,6 +99,8 @@ class CheckpointManager {
 
   cid_t recovered_cid_ = 0;
 
+  size_t checkpoint_parallelism_ = 1;
+
   // used for multiple checkpointer
   // std::atomic<unsigned int> status_change_count_;
 
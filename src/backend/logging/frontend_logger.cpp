@@ -48,12 +48,13 @@ FrontendLogger::~FrontendLogger() {
  * @param logging type can be write ahead logging or write behind logging
  */
 FrontendLogger *FrontendLogger::GetFrontendLogger(LoggingType logging_type,
-                                                  bool test_mode) {
+                                                  bool test_mode,
+                                                  unsigned int stream_id) {
   FrontendLogger *frontend_logger = nullptr;
 
   LOG_TRACE("Logging_type is %d", (int)logging_type);
   if (IsBasedOnWriteAheadLogging(logging_type) == true) {
-    frontend_logger = new WriteAheadFrontendLogger(test_mode);
+    frontend_logger = new WriteAheadFrontendLogger(test_mode, stream_id);
   } else if (IsBasedOnWriteBehindLogging(logging_type) == true) {
     frontend_logger = new WriteBehindFrontendLogger();
   } else {
@@ -136,6 +137,8 @@ void FrontendLogger::MainLoop(void) {
   // LOGGING MODE
   /////////////////////////////////////////////////////////////////////
 
+  logging_start = Clock::now();
+
   // Periodically, wake up and do logging
   while (log_manager.GetLoggingStatus() == LOGGING_STATUS_TYPE_LOGGING) {
     // Collect LogRecords from all backend loggers
@@ -163,6 +166,8 @@ void FrontendLogger::MainLoop(void) {
   /////////////////////////////////////////////////////////////////////
 
   LOG_TRACE("Frontendlogger Sleep Mode");
+  LOG_TRACE("Fsyncs per second : %.2lf, commits per fsync : %.2lf",
+            GetFsyncsPerSecond(), GetCommitsPerFsync());
 
   // Setting frontend logger status to sleep
   log_manager.SetLoggingStatus(LOGGING_STATUS_TYPE_SLEEP);
@@ -188,9 +193,8 @@ void FrontendLogger::CollectLogRecordsFromBackendLoggers() {
     //           backend_loggers.size());
     int i = 0;
     for (auto backend_logger : backend_loggers) {
-      auto cid_pair = backend_logger->PrepareLogBuffers();
-      auto &log_buffers = backend_logger->GetLogBuffers();
-      auto log_buffer_size = log_buffers.size();
+      // Move the log buffers from backend_logger to here
+      auto cid_pair = backend_logger->PrepareLogBuffers(global_queue);
 
       // update max_possible_commit_id with the latest buffer
       cid_t backend_lower_bound = cid_pair.first;
@@ -202,21 +206,6 @@ void FrontendLogger::CollectLogRecordsFromBackendLoggers() {
         LOG_TRACE("bel: %d got lower_bound_cid:%lu", i, backend_lower_bound);
         lower_bound = std::min(lower_bound, backend_lower_bound);
       }
-      // Skip current backend_logger, nothing to do
-      if (log_buffer_size == 0) {
-        i++;
-        continue;
-      }
-
-      // Move the log record from backend_logger to here
-      for (oid_t log_record_itr = 0; log_record_itr < log_buffer_size;
-           log_record_itr++) {
-        // copy to front end logger
-        global_queue.push_back(std::move(log_buffers[log_record_itr]));
-      }
-
-      // cleanup the local queue
-      log_buffers.clear();
       i++;
     }
     cid_t max_possible_commit_id;
@@ -260,6 +249,17 @@ void FrontendLogger::CollectLogRecordsFromBackendLoggers() {
   }
 }
 
+double FrontendLogger::GetCommitsPerFsync() const {
+  if (fsync_count == 0) return 0;
+  return (double)flushed_commit_count / fsync_count;
+}
+
+double FrontendLogger::GetFsyncsPerSecond() const {
+  std::chrono::duration<double> elapsed = Clock::now() - logging_start;
+  if (elapsed.count() <= 0) return 0;
+  return fsync_count / elapsed.count();
+}
+
 cid_t FrontendLogger::GetMaxFlushedCommitId() { return max_flushed_commit_id; }
 
 void FrontendLogger::SetMaxFlushedCommitId(cid_t cid) {
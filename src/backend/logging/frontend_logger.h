@@ -14,6 +14,7 @@
 
 #include <iostream>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <vector>
 #include <unistd.h>
@@ -29,6 +30,13 @@
 
 namespace peloton {
 namespace logging {
+
+typedef std::chrono::high_resolution_clock Clock;
+
+typedef std::chrono::microseconds Micros;
+
+typedef std::chrono::time_point<Clock> TimePoint;
+
 //===--------------------------------------------------------------------===//
 // Frontend Logger
 //===--------------------------------------------------------------------===//
@@ -40,7 +48,8 @@ class FrontendLogger : public Logger {
   ~FrontendLogger();
 
   static FrontendLogger *GetFrontendLogger(LoggingType logging_type,
-                                           bool test_mode = false);
+                                           bool test_mode = false,
+                                           unsigned int stream_id = 0);
 
   void MainLoop(void);
 
@@ -62,8 +71,21 @@ class FrontendLogger : public Logger {
 
   virtual void RecoverIndex(void) = 0;
 
+  //===--------------------------------------------------------------------===//
+  // Group commit stats
+  //===--------------------------------------------------------------------===//
+
+  // number of flushes, each one makes a group of commits durable
   size_t GetFsyncCount() const { return fsync_count; }
 
+  // number of commits made durable
+  size_t GetFlushedCommitCount() const { return flushed_commit_count; }
+
+  double GetCommitsPerFsync() const;
+
+  // since the logger entered logging mode
+  double GetFsyncsPerSecond() const;
+
   void SetTestMode(bool test_mode) { this->test_mode_ = test_mode; }
 
   void ReplayLog(const char *, size_t len);
@@ -90,6 +112,8 @@ class FrontendLogger : public Logger {
     }
 
     fsync_count = 0;
+    flushed_commit_count = 0;
+    logging_start = Clock::now();
     max_flushed_commit_id = 0;
     max_collected_commit_id = 0;
     max_seen_commit_id = 0;
@@ -125,7 +149,12 @@ class FrontendLogger : public Logger {
   // stats
   size_t fsync_count = 0;
 
-  cid_t max_flushed_commit_id = 0;
+  size_t flushed_commit_count = 0;
+
+  TimePoint logging_start = Clock::now();
+
+  // read by the committers of every stream to compute the durable commit id
+  std::atomic<cid_t> max_flushed_commit_id{0};
 
   cid_t max_collected_commit_id = 0;
 
@@ -0,0 +1,382 @@
+/*-------------------------------------------------------------------------
+ *
+ * log_block.cpp
+ * file description
+ *
+ * Copyright(c) 2015, CMU
+ *
+ * /peloton/src/backend/logging/log_block.cpp
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#include "backend/logging/log_block.h"
+#include "backend/logging/log_manager.h"
+#include "backend/common/logger.h"
+#include "backend/common/thread_manager.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#endif
+
+namespace peloton {
+namespace logging {
+
+namespace {
+
+// the codec finds matches of at least 4 bytes within the last 64 KB
+constexpr size_t min_match_length = 4;
+constexpr size_t max_match_offset = 65535;
+constexpr int hash_bits = 14;
+
+inline uint32_t Load32(const char *data) {
+  uint32_t value;
+  memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+inline uint32_t HashSequence(uint32_t sequence) {
+  return (sequence * 2654435761u) >> (32 - hash_bits);
+}
+
+// lengths of 15 and more spill into bytes of 255 and a remainder
+inline bool WriteLength(size_t length, char *destination, size_t &position,
+                        size_t capacity) {
+  for (; length >= 255; length -= 255) {
+    if (position >= capacity) return false;
+    destination[position++] = (char)255;
+  }
+  if (position >= capacity) return false;
+  destination[position++] = (char)length;
+  return true;
+}
+
+inline bool ReadLength(const unsigned char *source, size_t length,
+                       size_t &position, size_t &value) {
+  unsigned char byte;
+  do {
+    if (position >= length) return false;
+    byte = source[position++];
+    value += byte;
+  } while (byte == 255);
+  return true;
+}
+
+// one sequence : a token, the literals, then the match unless it is the last
+bool WriteSequence(const char *literals, size_t literal_length,
+                   size_t match_offset, size_t match_length,
+                   char *destination, size_t &position, size_t capacity) {
+  size_t match_code = (match_length != 0) ? match_length - min_match_length : 0;
+  if (position >= capacity) return false;
+  destination[position++] = (char)((std::min<size_t>(literal_length, 15) << 4) |
+                                   std::min<size_t>(match_code, 15));
+
+  if (literal_length >= 15 &&
+      !WriteLength(literal_length - 15, destination, position, capacity)) {
+    return false;
+  }
+  if (position + literal_length > capacity) return false;
+  memcpy(destination + position, literals, literal_length);
+  position += literal_length;
+
+  if (match_length == 0) return true;
+
+  if (position + 2 > capacity) return false;
+  destination[position++] = (char)(match_offset & 0xff);
+  destination[position++] = (char)(match_offset >> 8);
+  if (match_code >= 15 &&
+      !WriteLength(match_code - 15, destination, position, capacity)) {
+    return false;
+  }
+  return true;
+}
+
+uint32_t Crc32cTable(const char *data, size_t length, uint32_t crc) {
+  static uint32_t table[256];
+  static bool table_ready = [] {
+    for (uint32_t byte = 0; byte < 256; byte++) {
+      uint32_t value = byte;
+      for (int bit = 0; bit < 8; bit++) {
+        value = (value & 1) ? (value >> 1) ^ 0x82f63b78 : (value >> 1);
+      }
+      table[byte] = value;
+    }
+    return true;
+  }();
+  (void)table_ready;
+
+  auto bytes = reinterpret_cast<const unsigned char *>(data);
+  for (size_t i = 0; i < length; i++) {
+    crc = table[(crc ^ bytes[i]) & 0xff] ^ (crc >> 8);
+  }
+  return crc;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("sse4.2"))) uint32_t Crc32cHardware(const char *data,
+                                                           size_t length,
+                                                           uint32_t crc) {
+  uint64_t crc64 = crc;
+  for (; length >= sizeof(uint64_t); length -= sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, data, sizeof(word));
+    crc64 = _mm_crc32_u64(crc64, word);
+    data += sizeof(word);
+  }
+  crc = (uint32_t)crc64;
+  for (; length > 0; length--) {
+    crc = _mm_crc32_u8(crc, (unsigned char)*data++);
+  }
+  return crc;
+}
+#endif
+
+}  // namespace
+
+//===--------------------------------------------------------------------===//
+// Log Block
+//===--------------------------------------------------------------------===//
+
+void LogBlock::Encode(const char *data, size_t length,
+                      CopySerializeOutput &output) {
+  std::vector<char> compressed(max_block_size);
+
+  for (size_t offset = 0; offset < length; offset += max_block_size) {
+    size_t raw_length = std::min(max_block_size, length - offset);
+    const char *raw = data + offset;
+
+    // keep the raw bytes when they do not compress
+    const char *stored = compressed.data();
+    size_t stored_length =
+        Compress(raw, raw_length, compressed.data(), raw_length - 1);
+    if (stored_length == 0) {
+      stored = raw;
+      stored_length = raw_length;
+    }
+
+    int32_t lengths[2] = {(int32_t)raw_length, (int32_t)stored_length};
+    uint32_t crc = Crc32c(stored, stored_length,
+                          Crc32c(reinterpret_cast<const char *>(lengths),
+                                 sizeof(lengths)));
+
+    output.WriteEnumInSingleByte(LOGRECORD_TYPE_LOG_BLOCK);
+    output.WriteInt(lengths[0]);
+    output.WriteInt(lengths[1]);
+    output.WriteInt((int32_t)crc);
+    output.WriteBytes(stored, stored_length);
+  }
+}
+
+void LogBlock::Decode(FILE *file, std::vector<char> &decoded) {
+  // the log is decoded in memory, read the rest of the file
+  std::vector<char> content;
+  char chunk[1 << 16];
+  size_t read_size;
+  while ((read_size = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+    content.insert(content.end(), chunk, chunk + read_size);
+  }
+
+  // Find the blocks, a block cut short by a crash ends the log
+  struct BlockInfo {
+    size_t stored_offset;
+    int32_t raw_length;
+    int32_t stored_length;
+    uint32_t crc;
+    size_t decoded_offset;
+  };
+  std::vector<BlockInfo> blocks;
+  size_t offset = 0, decoded_size = 0;
+  while (offset + header_size <= content.size()) {
+    ReferenceSerializeInputBE input(content.data() + offset, header_size);
+    if ((LogRecordType)input.ReadEnumInSingleByte() !=
+        LOGRECORD_TYPE_LOG_BLOCK) {
+      break;
+    }
+    BlockInfo block;
+    block.raw_length = input.ReadInt();
+    block.stored_length = input.ReadInt();
+    block.crc = (uint32_t)input.ReadInt();
+    block.stored_offset = offset + header_size;
+    block.decoded_offset = decoded_size;
+    if (block.raw_length <= 0 || block.stored_length <= 0 ||
+        block.stored_length > block.raw_length ||
+        block.stored_offset + block.stored_length > content.size()) {
+      break;
+    }
+    blocks.push_back(block);
+    offset = block.stored_offset + block.stored_length;
+    decoded_size += block.raw_length;
+  }
+
+  decoded.resize(decoded_size);
+  if (blocks.empty()) {
+    return;
+  }
+
+  // Verify and decompress the blocks in parallel
+  std::atomic<size_t> next_block(0);
+  std::atomic<size_t> first_bad_block(blocks.size());
+  auto worker_count = std::min(
+      LogManager::GetInstance().GetRecoveryParallelism(), blocks.size());
+
+  ThreadPool::GetWorkerInstance().RunTasks(worker_count, [&]() {
+    size_t block_itr;
+    while ((block_itr = next_block++) < blocks.size()) {
+      auto &block = blocks[block_itr];
+      const char *stored = content.data() + block.stored_offset;
+      char *raw = decoded.data() + block.decoded_offset;
+
+      int32_t lengths[2] = {block.raw_length, block.stored_length};
+      uint32_t crc = Crc32c(stored, block.stored_length,
+                            Crc32c(reinterpret_cast<const char *>(lengths),
+                                   sizeof(lengths)));
+      bool valid = (crc == block.crc);
+      if (valid && block.stored_length == block.raw_length) {
+        memcpy(raw, stored, block.raw_length);
+      } else if (valid) {
+        valid = Decompress(stored, block.stored_length, raw, block.raw_length);
+      }
+
+      if (valid == false) {
+        size_t bad_block = first_bad_block.load();
+        while (block_itr < bad_block &&
+               !first_bad_block.compare_exchange_weak(bad_block, block_itr)) {
+        }
+      }
+    }
+  });
+
+  // the records after a corrupted block are not trusted
+  if (first_bad_block < blocks.size()) {
+    LOG_ERROR("Log block %lu is corrupted, the log is read up to it",
+              first_bad_block.load());
+    decoded.resize(blocks[first_bad_block].decoded_offset);
+  }
+}
+
+bool LogBlock::IsBlockStart(FILE *file) {
+  int next = fgetc(file);
+  if (next == EOF) {
+    return false;
+  }
+  ungetc(next, file);
+  return (next == LOGRECORD_TYPE_LOG_BLOCK);
+}
+
+FILE *LogBlock::OpenDecoded(FILE *file, std::vector<char> &decoded) {
+  Decode(file, decoded);
+  if (decoded.empty()) {
+    return nullptr;
+  }
+  return fmemopen(decoded.data(), decoded.size(), "rb");
+}
+
+uint32_t LogBlock::Crc32c(const char *data, size_t length, uint32_t crc) {
+  crc = ~crc;
+#if defined(__x86_64__)
+  // use the CRC32 instruction of SSE 4.2 when the processor has it
+  static bool hardware_crc = __builtin_cpu_supports("sse4.2");
+  if (hardware_crc) {
+    return ~Crc32cHardware(data, length, crc);
+  }
+#endif
+  return ~Crc32cTable(data, length, crc);
+}
+
+size_t LogBlock::Compress(const char *source, size_t length, char *destination,
+                          size_t capacity) {
+  std::vector<int64_t> positions(1 << hash_bits, -1);
+  size_t position = 0, anchor = 0, output_position = 0;
+
+  while (position + min_match_length <= length) {
+    uint32_t sequence = Load32(source + position);
+    auto &candidate = positions[HashSequence(sequence)];
+    int64_t match = candidate;
+    candidate = position;
+
+    if (match < 0 || position - match > max_match_offset ||
+        Load32(source + match) != sequence) {
+      position++;
+      continue;
+    }
+
+    size_t match_length = min_match_length;
+    while (position + match_length < length &&
+           source[match + match_length] == source[position + match_length]) {
+      match_length++;
+    }
+
+    if (!WriteSequence(source + anchor, position - anchor, position - match,
+                       match_length, destination, output_position, capacity)) {
+      return 0;
+    }
+    position += match_length;
+    anchor = position;
+  }
+
+  // the last sequence only has literals
+  if (!WriteSequence(source + anchor, length - anchor, 0, 0, destination,
+                     output_position, capacity)) {
+    return 0;
+  }
+  return output_position;
+}
+
+bool LogBlock::Decompress(const char *source, size_t length, char *destination,
+                          size_t raw_length) {
+  auto input = reinterpret_cast<const unsigned char *>(source);
+  size_t position = 0, output_position = 0;
+
+  while (position < length) {
+    unsigned char token = input[position++];
+
+    size_t literal_length = token >> 4;
+    if (literal_length == 15 &&
+        !ReadLength(input, length, position, literal_length)) {
+      return false;
+    }
+    if (position + literal_length > length ||
+        output_position + literal_length > raw_length) {
+      return false;
+    }
+    memcpy(destination + output_position, source + position, literal_length);
+    position += literal_length;
+    output_position += literal_length;
+
+    // the last sequence ends the block
+    if (position == length) {
+      break;
+    }
+
+    if (position + 2 > length) {
+      return false;
+    }
+    size_t match_offset = input[position] | (input[position + 1] << 8);
+    position += 2;
+    size_t match_length = token & 15;
+    if (match_length == 15 &&
+        !ReadLength(input, length, position, match_length)) {
+      return false;
+    }
+    match_length += min_match_length;
+    if (match_offset == 0 || match_offset > output_position ||
+        output_position + match_length > raw_length) {
+      return false;
+    }
+
+    // the match may overlap the bytes it produces
+    for (size_t i = 0; i < match_length; i++, output_position++) {
+      destination[output_position] =
+          destination[output_position - match_offset];
+    }
+  }
+
+  return (output_position == raw_length);
+}
+
+}  // namespace logging
+}  // namespace peloton
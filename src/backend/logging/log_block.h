@@ -0,0 +1,75 @@
+/*-------------------------------------------------------------------------
+ *
+ * log_block.h
+ * file description
+ *
+ * Copyright(c) 2015, CMU
+ *
+ * /peloton/src/backend/logging/log_block.h
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <cstdio>
+#include <vector>
+
+#include "backend/common/serializer.h"
+#include "backend/common/types.h"
+
+namespace peloton {
+namespace logging {
+
+//===--------------------------------------------------------------------===//
+// Log Block
+//===--------------------------------------------------------------------===//
+
+/**
+ * Compressed block format of the write ahead log.
+ *
+ *  ------------------------------------------------------------------
+ *  | Type | Raw length | Stored length | CRC32C | Compressed records |
+ *  ------------------------------------------------------------------
+ *
+ * The records of a flush are compressed with a small LZ codec. Data that
+ * does not compress is stored as is, with a stored length equal to the raw
+ * length. The checksum covers both lengths and the stored bytes, so that a
+ * torn or corrupted block is detected before its records are read.
+ */
+class LogBlock {
+ public:
+  // type, raw length, stored length and checksum
+  static constexpr size_t header_size = 1 + 3 * sizeof(int32_t);
+
+  // larger flushes are split, so that recovery decodes them in parallel
+  static constexpr size_t max_block_size = 1 << 20;
+
+  // Append the data to the output as a sequence of blocks
+  static void Encode(const char *data, size_t length,
+                     CopySerializeOutput &output);
+
+  // Verify and decompress the blocks from the current position of the file
+  // to its end. Decoding stops at the first torn or corrupted block.
+  static void Decode(FILE *file, std::vector<char> &decoded);
+
+  // Check whether the next record of the file is a block
+  static bool IsBlockStart(FILE *file);
+
+  // Decode the rest of the file and return a stream reading the decoded
+  // records, nullptr if there is no valid block
+  static FILE *OpenDecoded(FILE *file, std::vector<char> &decoded);
+
+  // CRC32C of the data, it extends the checksum of the data before it
+  static uint32_t Crc32c(const char *data, size_t length, uint32_t crc = 0);
+
+  // return the compressed length, 0 if the data does not get smaller
+  static size_t Compress(const char *source, size_t length, char *destination,
+                         size_t capacity);
+
+  static bool Decompress(const char *source, size_t length, char *destination,
+                         size_t raw_length);
+};
+
+}  // namespace logging
+}  // namespace peloton
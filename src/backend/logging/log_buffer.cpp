@@ -35,8 +35,27 @@ bool LogBuffer::WriteRecord(LogRecord *record) {
   return success;
 }
 
+bool LogBuffer::ReserveRecord(size_t length,
+                              ReferenceSerializeOutput &output) {
+  // Not enough space
+  while (length + size_ > capacity_) {
+    if (size_ == 0) {
+      // double log buffer capacity for empty buffer
+      capacity_ *= 2;
+      elastic_data_.reset(new char[capacity_]);
+    } else {
+      return false;
+    }
+  }
+  assert(length);
+  output.InitializeWithPosition(elastic_data_.get(), size_ + length, size_);
+  size_ += length;
+  return true;
+}
+
 void LogBuffer::ResetData() {
   size_ = 0;
+  commit_count_ = 0;
   memset(elastic_data_.get(), 0, capacity_ * sizeof(char));
 }
 
@@ -36,6 +36,11 @@ class LogBuffer {
   // serialize and write a log record to buffer
   bool WriteRecord(LogRecord *);
 
+  // reserve room for a record of the given length and point the output at
+  // it, so that the record is serialized in place. return false if not
+  // enough space
+  bool ReserveRecord(size_t length, ReferenceSerializeOutput &output);
+
   // clean up and reset content
   void ResetData();
 
@@ -50,6 +55,18 @@ class LogBuffer {
 
   inline cid_t GetMaxLogId() { return max_log_id; }
 
+  // number of transaction commit records in the buffer
+  inline void IncrementCommitCount() { commit_count_++; }
+
+  inline size_t GetCommitCount() { return commit_count_; }
+
+  // order in which the backend logger filled its buffers
+  inline void SetSequenceNumber(size_t sequence_number) {
+    sequence_number_ = sequence_number;
+  }
+
+  inline size_t GetSequenceNumber() { return sequence_number_; }
+
   inline BackendLogger *GetBackendLogger() { return backend_logger_; }
 
  private:
@@ -69,6 +86,11 @@ class LogBuffer {
 
   // maximum log id seen so far
   cid_t max_log_id = 0;
+
+  // commit records written to the buffer
+  size_t commit_count_ = 0;
+
+  size_t sequence_number_ = 0;
 };
 
 }  // namespace logging
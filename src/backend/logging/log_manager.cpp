@@ -33,6 +33,7 @@ thread_local static BackendLogger *backend_logger = nullptr;
 LogManager::LogManager() {
   Configure(peloton_logging_mode, false, DEFAULT_NUM_FRONTEND_LOGGERS,
             LOGGER_MAPPING_ROUND_ROBIN);
+  flush_waiter_lists.emplace_back(new FlushWaiterList());
 }
 
 LogManager::~LogManager() {}
@@ -175,27 +176,11 @@ void LogManager::LogUpdate(cid_t commit_id, const ItemPointer &old_version,
 		const ItemPointer &new_version) {
   if (this->IsInLoggingMode()) {
     auto &manager = catalog::Manager::GetInstance();
-
     auto new_tuple_tile_group = manager.GetTileGroup(new_version.block);
 
     auto logger = this->GetBackendLogger();
-    auto schema = manager.GetTableWithOid(new_tuple_tile_group->GetDatabaseId(),
-                                          new_tuple_tile_group->GetTableId())
-                      ->GetSchema();
-    // Can we avoid allocate tuple in head each time?
-    std::unique_ptr<storage::Tuple> tuple(new storage::Tuple(schema, true));
-    for (oid_t col = 0; col < schema->GetColumnCount(); col++) {
-      tuple->SetValue(col,
-                      new_tuple_tile_group->GetValue(new_version.offset, col),
-                      logger->GetVarlenPool());
-    }
-    std::unique_ptr<LogRecord> record(
-        logger->GetTupleRecord(LOGRECORD_TYPE_TUPLE_UPDATE, commit_id,
-                               new_tuple_tile_group->GetTableId(),
-                               new_tuple_tile_group->GetDatabaseId(),
-                               new_version, old_version, tuple.get()));
-
-    logger->Log(record.get());
+    logger->LogTuple(LOGRECORD_TYPE_TUPLE_UPDATE, commit_id,
+                     new_tuple_tile_group.get(), new_version, old_version);
   }
 }
 
@@ -203,37 +188,11 @@ void LogManager::LogInsert(cid_t commit_id, const ItemPointer &new_location) {
   if (this->IsInLoggingMode()) {
     auto logger = this->GetBackendLogger();
     auto &manager = catalog::Manager::GetInstance();
-
     auto new_tuple_tile_group = manager.GetTileGroup(new_location.block);
 
-    auto tile_group = manager.GetTileGroup(new_location.block);
-    std::unique_ptr<LogRecord> record;
-    std::unique_ptr<storage::Tuple> tuple;
-    if (IsBasedOnWriteAheadLogging(logging_type_)){
-		auto schema =
-			manager.GetTableWithOid(tile_group->GetDatabaseId(),
-									tile_group->GetTableId())->GetSchema();
-		tuple.reset(new storage::Tuple(schema, true));
-		for (oid_t col = 0; col < schema->GetColumnCount(); col++) {
-		  tuple->SetValue(col,
-						  new_tuple_tile_group->GetValue(new_location.offset, col),
-						  logger->GetVarlenPool());
-		}
-
-		record.reset(logger->GetTupleRecord(
-			LOGRECORD_TYPE_TUPLE_INSERT, commit_id, tile_group->GetTableId(),
-			new_tuple_tile_group->GetDatabaseId(), new_location,
-			INVALID_ITEMPOINTER, tuple.get()));
-
-    }else{
-    	// do not construct the tuple for the wbl case
-    	record.reset(logger->GetTupleRecord(
-    				LOGRECORD_TYPE_TUPLE_INSERT, commit_id, tile_group->GetTableId(),
-    				new_tuple_tile_group->GetDatabaseId(), new_location,
-    				INVALID_ITEMPOINTER));
-    }
-    logger->Log(record.get());
-
+    logger->LogTuple(LOGRECORD_TYPE_TUPLE_INSERT, commit_id,
+                     new_tuple_tile_group.get(), new_location,
+                     INVALID_ITEMPOINTER);
   }
 }
 
@@ -243,11 +202,8 @@ void LogManager::LogDelete(cid_t commit_id, const ItemPointer &delete_location)
     auto &manager = catalog::Manager::GetInstance();
     auto tile_group = manager.GetTileGroup(delete_location.block);
 
-    std::unique_ptr<LogRecord> record(logger->GetTupleRecord(
-        LOGRECORD_TYPE_TUPLE_DELETE, commit_id, tile_group->GetTableId(),
-        tile_group->GetDatabaseId(), INVALID_ITEMPOINTER, delete_location));
-
-    logger->Log(record.get());
+    logger->LogTuple(LOGRECORD_TYPE_TUPLE_DELETE, commit_id, tile_group.get(),
+                     INVALID_ITEMPOINTER, delete_location);
   }
 }
 
@@ -304,13 +260,17 @@ void LogManager::InitFrontendLoggers() {
   if (frontend_loggers.size() == 0) {
     for (unsigned int i = 0; i < num_frontend_loggers_; i++) {
       std::unique_ptr<FrontendLogger> frontend_logger(
-          FrontendLogger::GetFrontendLogger(logging_type_, test_mode_));
+          FrontendLogger::GetFrontendLogger(logging_type_, test_mode_, i));
 
       if (frontend_logger.get() != nullptr) {
         frontend_loggers.push_back(std::move(frontend_logger));
       }
     }
   }
+
+  while (flush_waiter_lists.size() < frontend_loggers.size()) {
+    flush_waiter_lists.emplace_back(new FlushWaiterList());
+  }
 }
 
 /**
@@ -367,6 +327,19 @@ std::string LogManager::GetLogDirectoryName(void) {
   return log_directory_name;
 }
 
+void LogManager::SetLogDirectoryNames(
+    const std::vector<std::string> &log_directories) {
+  log_directory_names = log_directories;
+}
+
+std::string LogManager::GetLogDirectoryName(unsigned int stream_id) {
+  if (stream_id < log_directory_names.size() &&
+      log_directory_names[stream_id].empty() == false) {
+    return log_directory_names[stream_id];
+  }
+  return GetLogDirectoryName();
+}
+
 void LogManager::PrepareRecovery() {
   if (prepared_recovery_) {
     return;
@@ -413,6 +386,11 @@ void LogManager::DropFrontendLoggers() {
 void LogManager::TruncateLogs(txn_id_t commit_id) {
   int num_loggers;
 
+  // only the write ahead log is made of log files
+  if (IsBasedOnWriteAheadLogging(logging_type_) == false) {
+    return;
+  }
+
   num_loggers = this->frontend_loggers.size();
 
   for (int i = 0; i < num_loggers; i++) {
@@ -457,25 +435,59 @@ cid_t LogManager::GetPersistentFlushedCommitId() {
 }
 
 void LogManager::FrontendLoggerFlushed() {
-  {
-    std::unique_lock<std::mutex> wait_lock(flush_notify_mutex);
-    flush_notify_cv.notify_all();
+  // a flush of one stream can make the commits of every stream durable
+  cid_t persistent_cid = GetPersistentFlushedCommitId();
+
+  for (auto &flush_waiter_list : flush_waiter_lists) {
+    std::unique_lock<std::mutex> wait_lock(
+        flush_waiter_list->flush_notify_mutex);
+    auto &flush_waiters = flush_waiter_list->flush_waiters;
+
+    // wake up only the committers made durable by this flush
+    auto end = flush_waiters.upper_bound(persistent_cid);
+    for (auto itr = flush_waiters.begin(); itr != end; itr++) {
+      itr->second->durable = true;
+      itr->second->cv.notify_one();
+    }
+    flush_waiters.erase(flush_waiters.begin(), end);
   }
 }
 
 void LogManager::WaitForFlush(cid_t cid) {
   LOG_TRACE("Waiting for flush with %d", (int)cid);
+
+  // the durable commit id is computed without any lock
+  if (this->GetPersistentFlushedCommitId() >= cid) {
+    return;
+  }
+
+  // wait with the committers of the same stream
+  unsigned int stream_id = 0;
+  if (backend_logger != nullptr &&
+      backend_logger->GetFrontendLoggerID() != -1) {
+    stream_id = backend_logger->GetFrontendLoggerID();
+  }
+  auto &flush_waiter_list =
+      flush_waiter_lists[stream_id % flush_waiter_lists.size()];
   {
-    std::unique_lock<std::mutex> wait_lock(flush_notify_mutex);
+    std::unique_lock<std::mutex> wait_lock(
+        flush_waiter_list->flush_notify_mutex);
 
-    while (this->GetPersistentFlushedCommitId() < cid) {
-      LOG_TRACE(
-          "Logs up to %lu cid is flushed. %lu cid is not flushed yet. Wait...",
-          this->GetPersistentFlushedCommitId(), cid);
-      flush_notify_cv.wait(wait_lock);
+    // check again, a flush may have come before the waiter is in the list
+    if (this->GetPersistentFlushedCommitId() >= cid) {
+      return;
+    }
+
+    LOG_TRACE(
+        "Logs up to %lu cid is flushed. %lu cid is not flushed yet. Wait...",
+        this->GetPersistentFlushedCommitId(), cid);
+    FlushWaiter waiter;
+    flush_waiter_list->flush_waiters.emplace(cid, &waiter);
+    while (waiter.durable == false) {
+      waiter.cv.wait(wait_lock);
     }
     LOG_TRACE("Flushes done! Can return! Got persistent flushed commit id as %d",
-             (int)this->GetPersistentFlushedCommitId());
+              (int)this->GetPersistentFlushedCommitId());
   }
 }
 
@@ -488,6 +500,16 @@ void LogManager::NotifyRecoveryDone() {
   if (i == num_frontend_loggers_) {
     LOG_TRACE(
         "This was the last one! Recover Index and change to LOGGING mode.");
+    // the streams are replayed together, in commit order
+    if (IsBasedOnWriteAheadLogging(logging_type_) &&
+        num_frontend_loggers_ > 1) {
+      std::vector<WriteAheadFrontendLogger *> streams;
+      for (auto &frontend_logger : frontend_loggers) {
+        streams.push_back(reinterpret_cast<WriteAheadFrontendLogger *>(
+            frontend_logger.get()));
+      }
+      WriteAheadFrontendLogger::ReplayRecoveredStreams(streams);
+    }
     frontend_loggers[0].get()->RecoverIndex();
     SetLoggingStatus(LOGGING_STATUS_TYPE_LOGGING);
   }
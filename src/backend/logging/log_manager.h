@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <mutex>
 #include <map>
 #include <vector>
@@ -104,6 +105,33 @@ class LogManager {
   // wait for the flush of a frontend logger (for worker thread)
   void WaitForFlush(cid_t cid);
 
+  // group commit thresholds: a frontend logger flushes once this many commits
+  // or bytes are pending, or as soon as the previous flush is done if lower
+  void SetGroupCommitSize(size_t commit_count, size_t byte_count) {
+    group_commit_size_ = commit_count;
+    group_commit_bytes_ = byte_count;
+  }
+
+  size_t GetGroupCommitSize() const { return group_commit_size_; }
+
+  size_t GetGroupCommitBytes() const { return group_commit_bytes_; }
+
+  // number of threads replaying the log and rebuilding the indexes during
+  // recovery, it is serial if 1
+  void SetRecoveryParallelism(size_t parallelism) {
+    recovery_parallelism_ = std::max(parallelism, (size_t)1);
+  }
+
+  size_t GetRecoveryParallelism() const { return recovery_parallelism_; }
+
+  // write the new log files as compressed and checksummed blocks, see
+  // LogBlock. recovery reads both formats
+  void SetLogCompression(bool log_compression) {
+    log_compression_ = log_compression;
+  }
+
+  bool GetLogCompression() const { return log_compression_; }
+
   // get the current persistent flushed commit
   cid_t GetPersistentFlushedCommitId();
 
@@ -142,6 +170,15 @@ class LogManager {
 
   std::string GetLogDirectoryName(void);
 
+  // one directory per WAL stream, typically on independent devices. streams
+  // without one of their own use the log directory
+  void SetLogDirectoryNames(const std::vector<std::string> &log_dirs);
+
+  std::string GetLogDirectoryName(unsigned int stream_id);
+
+  // number of WAL streams, each one is written by its own frontend logger
+  unsigned int GetLogStreamCount() const { return num_frontend_loggers_; }
+
   bool HasPelotonFrontendLogger() const {
     return (peloton_logging_mode == LOGGING_TYPE_NVM_WBL);
   }
@@ -222,6 +259,16 @@ class LogManager {
     log_file_size_limit_ = file_size_limit;
   }
 
+  // get the number of log segments kept for reuse
+  inline unsigned int GetLogSegmentCount() { return log_segment_count_; }
+
+  // log files are then preallocated segments of the file size limit, the
+  // ones older than the last checkpoint are zeroed and reused in a ring.
+  // 0 deletes them and creates every log file anew
+  inline void SetLogSegmentCount(unsigned int segment_count) {
+    log_segment_count_ = segment_count;
+  }
+
   // get the beginning capacity of a log buffer
   inline unsigned int GetLogBufferCapacity() { return log_buffer_capacity_; }
 
@@ -253,6 +300,9 @@ class LogManager {
   // default log file size: 32 MB
   unsigned int log_file_size_limit_ = 32768;
 
+  // zeroed log segments kept for reuse, none by default
+  unsigned int log_segment_count_ = 0;
+
   // default capacity for log buffer
   unsigned int log_buffer_capacity_ = 32768;
 
@@ -269,9 +319,31 @@ class LogManager {
   std::mutex logging_status_mutex;
   std::condition_variable logging_status_cv;
 
-  // To wait for flush
-  std::mutex flush_notify_mutex;
-  std::condition_variable flush_notify_cv;
+  // A committer waiting for its commit id to become durable
+  struct FlushWaiter {
+    bool durable = false;
+    std::condition_variable cv;
+  };
+
+  // To wait for flush, waiters are ordered by commit id so that a flush
+  // wakes up only the ones it made durable
+  struct FlushWaiterList {
+    std::mutex flush_notify_mutex;
+    std::multimap<cid_t, FlushWaiter *> flush_waiters;
+  };
+
+  // one list per stream, a committer only contends with the committers of
+  // its own stream
+  std::vector<std::unique_ptr<FlushWaiterList>> flush_waiter_lists;
+
+  // flush as soon as the previous flush is done by default
+  size_t group_commit_size_ = 1;
+
+  size_t group_commit_bytes_ = 1 << 20;
+
+  size_t recovery_parallelism_ = 1;
+
+  bool log_compression_ = false;
 
   // To update catalog and txn managers
   std::mutex update_managers_mutex;
@@ -290,6 +362,8 @@ class LogManager {
 
   std::string log_directory_name;
 
+  std::vector<std::string> log_directory_names;
+
   // round robin counter for frontend logger assignment
   int frontend_logger_assign_counter;
 
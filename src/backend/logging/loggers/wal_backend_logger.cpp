@@ -15,6 +15,7 @@
 #include <iostream>
 
 #include "backend/logging/records/tuple_record.h"
+#include "backend/storage/tile_group.h"
 #include "backend/logging/log_manager.h"
 #include "backend/logging/frontend_logger.h"
 #include "backend/logging/loggers/wal_backend_logger.h"
@@ -29,6 +30,83 @@ WriteAheadBackendLogger::WriteAheadBackendLogger() : BackendLogger() {
   LOG_TRACE("INSIDE CONSTRUCTOR");
 }
 
+/**
+ * @brief serialize a tuple record straight into the log buffer, without
+ * building the record or the tuple
+ * @param type, commit id and locations of the tuple record
+ */
+void WriteAheadBackendLogger::LogTuple(LogRecordType log_record_type,
+                                       cid_t commit_id,
+                                       storage::TileGroup *tile_group,
+                                       ItemPointer insert_location,
+                                       ItemPointer delete_location) {
+  switch (log_record_type) {
+    case LOGRECORD_TYPE_TUPLE_INSERT: {
+      log_record_type = LOGRECORD_TYPE_WAL_TUPLE_INSERT;
+      break;
+    }
+
+    case LOGRECORD_TYPE_TUPLE_DELETE: {
+      log_record_type = LOGRECORD_TYPE_WAL_TUPLE_DELETE;
+      break;
+    }
+
+    case LOGRECORD_TYPE_TUPLE_UPDATE: {
+      log_record_type = LOGRECORD_TYPE_WAL_TUPLE_UPDATE;
+      break;
+    }
+
+    default: {
+      assert(false);
+      break;
+    }
+  }
+
+  // the record only carries the header fields, it is never serialized on
+  // its own
+  TupleRecord record(log_record_type, commit_id, tile_group->GetTableId(),
+                     insert_location, delete_location, nullptr,
+                     tile_group->GetDatabaseId());
+
+  // gather the values of the new version, the body has the same layout as
+  // Tuple::SerializeTo
+  size_t body_length = 0;
+  tuple_values_.clear();
+  if (log_record_type != LOGRECORD_TYPE_WAL_TUPLE_DELETE) {
+    auto column_count = tile_group->GetColumnMap().size();
+    body_length += sizeof(int32_t);
+    for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+      tuple_values_.push_back(
+          tile_group->GetValue(insert_location.offset, column_itr));
+      body_length += tuple_values_.back().GetSerializedSize();
+    }
+  }
+  size_t record_length = TupleRecord::GetSerializedHeaderSize() + body_length;
+
+  auto log_buffer = AcquireLogBuffer();
+
+  ReferenceSerializeOutput output;
+  if (!log_buffer->ReserveRecord(record_length, output)) {
+    LOG_TRACE("Log buffer is full - Attempt to acquire a new one");
+    log_buffer = SwitchLogBuffer(log_buffer);
+    log_buffer->ReserveRecord(record_length, output);
+  }
+  size_t start = output.Position();
+
+  record.SerializeHeader(output);
+  if (log_record_type != LOGRECORD_TYPE_WAL_TUPLE_DELETE) {
+    output.WriteInt(static_cast<int32_t>(body_length - sizeof(int32_t)));
+    for (auto &value : tuple_values_) {
+      value.SerializeTo(output);
+    }
+  }
+  assert(output.Position() == start + record_length);
+  (void)start;
+
+  RecordLogged(log_buffer, log_record_type, commit_id);
+  ReleaseLogBuffer(log_buffer);
+}
+
 // create a tuple record for this logger
 LogRecord *WriteAheadBackendLogger::GetTupleRecord(
     LogRecordType log_record_type, txn_id_t txn_id, oid_t table_oid,
@@ -31,6 +31,10 @@ class WriteAheadBackendLogger : public BackendLogger {
 
   WriteAheadBackendLogger();
 
+  void LogTuple(LogRecordType log_record_type, cid_t commit_id,
+                storage::TileGroup *tile_group, ItemPointer insert_location,
+                ItemPointer delete_location);
+
   LogRecord *GetTupleRecord(LogRecordType log_record_type, txn_id_t txn_id,
                             oid_t table_oid, oid_t db_oid,
                             ItemPointer insert_location,
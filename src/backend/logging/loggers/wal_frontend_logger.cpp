@@ -15,6 +15,9 @@
 #include <sys/types.h>
 #include <sys/mman.h>
 #include <algorithm>
+#include <atomic>
+#include <memory>
+#include <queue>
 #include <dirent.h>
 
 #include "backend/catalog/manager.h"
@@ -30,6 +33,7 @@
 #include "backend/logging/loggers/wal_frontend_logger.h"
 #include "backend/logging/loggers/wal_backend_logger.h"
 #include "backend/logging/checkpoint_tile_scanner.h"
+#include "backend/logging/log_block.h"
 #include "backend/logging/logging_util.h"
 
 #include "backend/storage/database.h"
@@ -37,6 +41,7 @@
 #include "backend/storage/tile_group.h"
 #include "backend/storage/tuple.h"
 #include "backend/common/logger.h"
+#include "backend/common/thread_manager.h"
 #include "backend/index/index.h"
 #include "backend/executor/executor_context.h"
 #include "backend/planner/seq_scan_plan.h"
@@ -61,7 +66,9 @@ WriteAheadFrontendLogger::WriteAheadFrontendLogger()
 /**
  * @brief Open logfile and file descriptor
  */
-WriteAheadFrontendLogger::WriteAheadFrontendLogger(bool for_testing) {
+WriteAheadFrontendLogger::WriteAheadFrontendLogger(bool for_testing,
+                                                   unsigned int stream_id)
+    : stream_id_(stream_id) {
   test_mode_ = for_testing;
   logging_type = LOGGING_TYPE_NVM_WAL;
 
@@ -139,7 +146,10 @@ void WriteAheadFrontendLogger::FlushLogRecords(void) {
        global_queue_itr++) {
     auto &log_buffer = global_queue[global_queue_itr];
 
-    if (!test_mode_) {
+    if (!test_mode_ && log_compression_file) {
+      log_block_records.insert(log_block_records.end(), log_buffer->GetData(),
+                               log_buffer->GetData() + log_buffer->GetSize());
+    } else if (!test_mode_) {
       fwrite(log_buffer->GetData(), sizeof(char), log_buffer->GetSize(),
              cur_file_handle.file);
     }
@@ -152,68 +162,96 @@ void WriteAheadFrontendLogger::FlushLogRecords(void) {
       LOG_TRACE("Max log id file so far is %d", (int)this->max_log_id_file);
     }
 
+    // the records join the group of the next flush
+    group_commit_bytes += log_buffer->GetSize();
+    group_commit_count += log_buffer->GetCommitCount();
+
     // return empty buffer
     auto backend_logger = log_buffer->GetBackendLogger();
     log_buffer->ResetData();
     backend_logger->GrantEmptyBuffer(std::move(log_buffer));
   }
 
-  bool flushed = false;
-  if (max_collected_commit_id != max_flushed_commit_id) {
+  /* For now, fflush after every iteration of collecting buffers */
+  // Clean up the frontend logger's queue
+  global_queue.clear();
+
+  // Group commit: the transactions that committed while the previous fsync
+  // was running are made durable together by the next one. The group is
+  // flushed right away unless it is configured to grow larger, then it waits
+  // for enough commits or bytes, but no longer than the flush frequency.
+  auto now = Clock::now();
+  if (will_write_to_file == true && group_open == false) {
+    group_open = true;
+    group_start = now;
+  }
+
+  if (max_collected_commit_id == max_flushed_commit_id) {
+    return;
+  }
+
+  auto &log_manager = LogManager::GetInstance();
+  bool flush = (group_commit_count >= log_manager.GetGroupCommitSize() ||
+                group_commit_bytes >= log_manager.GetGroupCommitBytes() ||
+                now >= group_start + flush_frequency);
+  if (flush == false) {
+    return;
+  }
+
+  // The delimiter tells recovery that every transaction up to
+  // max_collected_commit_id is in the log
+  if (!test_mode_) {
     TransactionRecord delimiter_rec(LOGRECORD_TYPE_ITERATION_DELIMITER,
                                     this->max_collected_commit_id);
     delimiter_rec.Serialize(output_buffer);
 
-    if (!test_mode_) {
-      assert(cur_file_handle.fd != -1);
-      if (cur_file_handle.fd != -1) {
-        fwrite(delimiter_rec.GetMessage(), sizeof(char),
-               delimiter_rec.GetMessageLength(), cur_file_handle.file);
-
-        LOG_TRACE("Wrote delimiter to log file with commit_id %ld",
-                 this->max_collected_commit_id);
+    assert(cur_file_handle.fd != -1);
+    if (cur_file_handle.fd != -1 && log_compression_file) {
+      // the records of the flush and its delimiter are compressed together
+      log_block_records.insert(
+          log_block_records.end(), delimiter_rec.GetMessage(),
+          delimiter_rec.GetMessage() + delimiter_rec.GetMessageLength());
+      log_block_output.Reset();
+      LogBlock::Encode(log_block_records.data(), log_block_records.size(),
+                       log_block_output);
+      fwrite(log_block_output.Data(), sizeof(char), log_block_output.Size(),
+             cur_file_handle.file);
+      log_block_records.clear();
+    } else if (cur_file_handle.fd != -1) {
+      fwrite(delimiter_rec.GetMessage(), sizeof(char),
+             delimiter_rec.GetMessageLength(), cur_file_handle.file);
+    }
 
-        // by moving the fflush and sync here, we ensure that this file will
-        // have at least 1 delimiter
-        if (Clock::now() > last_flush + flush_frequency) {
-          LoggingUtil::FFlushFsync(cur_file_handle);
+    if (cur_file_handle.fd != -1) {
 
-          last_flush = Clock::now();
-          if (this->max_collected_commit_id > max_flushed_commit_id) {
-            max_flushed_commit_id = this->max_collected_commit_id;
-          }
+      LOG_TRACE("Wrote delimiter to log file with commit_id %ld",
+               this->max_collected_commit_id);
 
-          fsync_count++;
-          flushed = true;
-        }
+      // by moving the fflush and sync here, we ensure that this file will
+      // have at least 1 delimiter
+      LoggingUtil::FFlushFsync(cur_file_handle);
 
-        if (this->max_collected_commit_id > max_delimiter_file) {
-          max_delimiter_file = this->max_collected_commit_id;
-          LOG_TRACE("Max_delimiter_file is now %d", (int)max_delimiter_file);
-        }
-
-        if (FileSwitchCondIsTrue()) should_create_new_file = true;
+      if (this->max_collected_commit_id > max_delimiter_file) {
+        max_delimiter_file = this->max_collected_commit_id;
+        LOG_TRACE("Max_delimiter_file is now %d", (int)max_delimiter_file);
       }
-    } else {
-      if (Clock::now() > last_flush + flush_frequency) {
-        last_flush = Clock::now();
-        if (this->max_collected_commit_id > max_flushed_commit_id) {
-          max_flushed_commit_id = this->max_collected_commit_id;
-        }
 
-        flushed = true;
-      }
+      if (FileSwitchCondIsTrue()) should_create_new_file = true;
     }
   }
 
-  /* For now, fflush after every iteration of collecting buffers */
-  // Clean up the frontend logger's queue
-  global_queue.clear();
-
-  if (flushed) {
-    // signal that we have flushed
-    LogManager::GetInstance().FrontendLoggerFlushed();
+  if (this->max_collected_commit_id > max_flushed_commit_id) {
+    max_flushed_commit_id = this->max_collected_commit_id;
   }
+
+  fsync_count++;
+  flushed_commit_count += group_commit_count;
+  group_commit_count = 0;
+  group_commit_bytes = 0;
+  group_open = false;
+
+  // signal the transactions that are durable now
+  log_manager.FrontendLoggerFlushed();
 }
 
 //===--------------------------------------------------------------------===//
@@ -230,6 +268,11 @@ void WriteAheadFrontendLogger::DoRecovery() {
   int num_inserts = 0;
   cid_t global_max_flushed_id_for_recovery;
   log_file_cursor_ = 0;
+  bool parallel_replay = (log_manager.GetRecoveryParallelism() > 1);
+  // with several streams, the transactions are replayed once all of them
+  // are read, in commit order across the streams
+  bool merge_streams = (log_manager.GetLogStreamCount() > 1);
+  if (merge_streams) parallel_replay = false;
 
   global_max_flushed_id_for_recovery =
       log_manager.GetGlobalMaxFlushedIdForRecovery();
@@ -258,6 +301,7 @@ void WriteAheadFrontendLogger::DoRecovery() {
         TransactionRecord txn_rec(record_type);
         if (LoggingUtil::ReadTransactionRecordHeader(
                 txn_rec, cur_file_handle) == false) {
+          if (parallel_replay) ReplayQueuedTransactions();
           cur_file_handle = INVALID_FILE_HANDLE;
           return;
         }
@@ -276,6 +320,7 @@ void WriteAheadFrontendLogger::DoRecovery() {
         if (LoggingUtil::ReadTupleRecordHeader(*tuple_record,
                                                cur_file_handle) == false) {
           LOG_ERROR("Could not read tuple record header.");
+          if (parallel_replay) ReplayQueuedTransactions();
           cur_file_handle = INVALID_FILE_HANDLE;
           return;
         }
@@ -294,6 +339,7 @@ void WriteAheadFrontendLogger::DoRecovery() {
         if (recovery_txn_table.find(log_id) == recovery_txn_table.end()) {
           LOG_ERROR("Insert txd id %d not found in recovery txn table",
                     (int)log_id);
+          if (parallel_replay) ReplayQueuedTransactions();
           cur_file_handle = INVALID_FILE_HANDLE;
           return;
         }
@@ -309,6 +355,7 @@ void WriteAheadFrontendLogger::DoRecovery() {
         // Check for torn log write
         if (LoggingUtil::ReadTupleRecordHeader(*tuple_record,
                                                cur_file_handle) == false) {
+          if (parallel_replay) ReplayQueuedTransactions();
           cur_file_handle = INVALID_FILE_HANDLE;
           return;
         }
@@ -322,6 +369,7 @@ void WriteAheadFrontendLogger::DoRecovery() {
         if (recovery_txn_table.find(log_id) == recovery_txn_table.end()) {
           LOG_TRACE("Delete txd id %d not found in recovery txn table",
                     (int)log_id);
+          if (parallel_replay) ReplayQueuedTransactions();
           cur_file_handle = INVALID_FILE_HANDLE;
           return;
         }
@@ -345,7 +393,13 @@ void WriteAheadFrontendLogger::DoRecovery() {
           // reject commit ids that appear
           // after the persistent commit id before coming here (in the switch
           // case above).
-          CommitTransactionRecovery(log_id);
+          if (merge_streams) {
+            KeepTransactionRecovery(log_id);
+          } else if (parallel_replay) {
+            QueueTransactionRecovery(log_id);
+          } else {
+            CommitTransactionRecovery(log_id);
+          }
           break;
 
         case LOGRECORD_TYPE_WAL_TUPLE_INSERT:
@@ -355,10 +409,10 @@ void WriteAheadFrontendLogger::DoRecovery() {
               tuple_record);
           break;
         case LOGRECORD_TYPE_ITERATION_DELIMITER: {
-          // Do nothing if we hit the delimiter, because the delimiters help
-          // us only to find
-          // the max persistent commit id, and should be ignored during actual
-          // recovery
+          // The delimiters help us only to find the max persistent commit id.
+          // In parallel recovery, every transaction committed before a
+          // delimiter is replayed before reading on.
+          if (parallel_replay) ReplayQueuedTransactions();
           break;
         }
 
@@ -369,6 +423,8 @@ void WriteAheadFrontendLogger::DoRecovery() {
     }
   }
 
+  if (parallel_replay) ReplayQueuedTransactions();
+
   // Finally, abort ACTIVE transactions in recovery_txn_table
   AbortActiveTransactions();
 
@@ -388,6 +444,7 @@ void WriteAheadFrontendLogger::RecoverIndex() {
 
   auto &catalog_manager = catalog::Manager::GetInstance();
   auto database_count = catalog_manager.GetDatabaseCount();
+  std::vector<storage::DataTable *> tables;
 
   // loop all databases
   for (oid_t database_idx = 0; database_idx < database_count; database_idx++) {
@@ -401,12 +458,21 @@ void WriteAheadFrontendLogger::RecoverIndex() {
       assert(target_table);
       LOG_TRACE("SeqScan: database oid %u table oid %u: %s", database_idx,
                table_idx, target_table->GetName().c_str());
-
-      if (!RecoverTableIndexHelper(target_table, cid)) {
-        break;
-      }
+      tables.push_back(target_table);
     }
   }
+
+  // The indexes of a table are rebuilt by one worker
+  auto worker_count = std::min(
+      LogManager::GetInstance().GetRecoveryParallelism(), tables.size());
+  std::atomic<size_t> next_table(0);
+
+  ThreadPool::GetWorkerInstance().RunTasks(worker_count, [&]() {
+    size_t table_itr;
+    while ((table_itr = next_table++) < tables.size()) {
+      RecoverTableIndexHelper(tables[table_itr], cid);
+    }
+  });
 }
 
 bool WriteAheadFrontendLogger::RecoverTableIndexHelper(
@@ -420,6 +486,7 @@ bool WriteAheadFrontendLogger::RecoverTableIndexHelper(
   oid_t current_tile_group_offset = START_OID;
   auto table_tile_group_count = target_table->GetTileGroupCount();
   CheckpointTileScanner scanner;
+  size_t tuple_count = 0;
 
   while (current_tile_group_offset < table_tile_group_count) {
     // Retrieve a tile group
@@ -441,6 +508,7 @@ bool WriteAheadFrontendLogger::RecoverTableIndexHelper(
     LOG_TRACE("Retrieved tile group %u", tile_group_id);
 
     // Go over the logical tile
+    auto &position_list = logical_tile->GetPositionList(0);
     for (oid_t tuple_id : *logical_tile) {
       expression::ContainerTuple<executor::LogicalTile> cur_tuple(
           logical_tile.get(), tuple_id);
@@ -454,12 +522,18 @@ bool WriteAheadFrontendLogger::RecoverTableIndexHelper(
                           recovery_pool);
         }
 
-        ItemPointer location(tile_group_id, tuple_id);
+        // the logical tile only holds the visible slots
+        ItemPointer location(tile_group_id, position_list[tuple_id]);
         InsertIndexEntry(tuple.get(), target_table, location);
       }
+      tuple_count++;
     }
     current_tile_group_offset++;
   }
+
+  // Replaying the log over a fuzzy checkpoint may apply a version that the
+  // checkpoint already holds, so the tuple count follows the tuples found
+  target_table->SetNumberOfTuples(tuple_count);
   return true;
 }
 
@@ -535,6 +609,21 @@ void WriteAheadFrontendLogger::CommitTransactionRecovery(cid_t commit_id) {
   recovery_txn_table.erase(commit_id);
 }
 
+/**
+ * @brief keep the tuples of a committed txn until every stream is read, then
+ * ReplayRecoveredStreams replays them in commit order
+ * @param commit id of the txn
+ */
+void WriteAheadFrontendLogger::KeepTransactionRecovery(cid_t commit_id) {
+  std::vector<TupleRecord *> &tuple_records = recovery_txn_table[commit_id];
+  recovered_transactions.emplace_back(commit_id, std::move(tuple_records));
+  recovery_txn_table.erase(commit_id);
+
+  if (commit_id + 1 > max_cid) {
+    max_cid = commit_id + 1;
+  }
+}
+
 void InsertTupleHelper(oid_t &max_tg, cid_t commit_id, oid_t db_id,
                        oid_t table_id, const ItemPointer &insert_loc,
                        storage::Tuple *tuple,
@@ -666,6 +755,173 @@ void WriteAheadFrontendLogger::UpdateTuple(TupleRecord *record) {
                     record->GetTuple());
 }
 
+/**
+ * @brief move the tuples of a committed txn to the replay queue, they are
+ * replayed with the other txns committed before the next delimiter
+ * @param commit id of the txn
+ */
+void WriteAheadFrontendLogger::QueueTransactionRecovery(cid_t commit_id) {
+  std::vector<TupleRecord *> &tuple_records = recovery_txn_table[commit_id];
+  recovery_replay_queue.insert(recovery_replay_queue.end(),
+                               tuple_records.begin(), tuple_records.end());
+  recovery_txn_table.erase(commit_id);
+
+  if (commit_id > recovery_replay_max_cid) {
+    recovery_replay_max_cid = commit_id;
+  }
+
+  // Bound the memory held by the queue when delimiters are far apart
+  if (recovery_replay_queue.size() >= recovery_replay_batch_size) {
+    ReplayQueuedTransactions();
+  }
+}
+
+/**
+ * @brief replay the queued records. The records of a table all go to the
+ * same worker in commit order, so the versions of a tuple are installed in
+ * the order they were committed.
+ */
+void WriteAheadFrontendLogger::ReplayQueuedTransactions() {
+  if (recovery_replay_queue.empty()) {
+    return;
+  }
+
+  // Partition the records by table
+  std::map<std::pair<oid_t, oid_t>, size_t> table_partitions;
+  std::vector<std::vector<TupleRecord *>> partitions;
+  for (auto record : recovery_replay_queue) {
+    auto table_key =
+        std::make_pair(record->GetDatabaseOid(), record->GetTableId());
+    auto itr = table_partitions.find(table_key);
+    if (itr == table_partitions.end()) {
+      itr = table_partitions.emplace(table_key, partitions.size()).first;
+      partitions.emplace_back();
+    }
+    partitions[itr->second].push_back(record);
+  }
+  recovery_replay_queue.clear();
+
+  // Every partition tracks the tile groups it creates on its own
+  std::vector<oid_t> partition_max_oids(partitions.size(), max_oid);
+  auto worker_count = std::min(
+      LogManager::GetInstance().GetRecoveryParallelism(), partitions.size());
+  std::atomic<size_t> next_partition(0);
+
+  ThreadPool::GetWorkerInstance().RunTasks(worker_count, [&]() {
+    size_t partition;
+    while ((partition = next_partition++) < partitions.size()) {
+      oid_t &partition_max_oid = partition_max_oids[partition];
+      for (auto record : partitions[partition]) {
+        switch (record->GetType()) {
+          case LOGRECORD_TYPE_WAL_TUPLE_INSERT:
+            InsertTupleHelper(partition_max_oid, record->GetTransactionId(),
+                              record->GetDatabaseOid(), record->GetTableId(),
+                              record->GetInsertLocation(), record->GetTuple());
+            break;
+          case LOGRECORD_TYPE_WAL_TUPLE_UPDATE:
+            UpdateTupleHelper(partition_max_oid, record->GetTransactionId(),
+                              record->GetDatabaseOid(), record->GetTableId(),
+                              record->GetDeleteLocation(),
+                              record->GetInsertLocation(), record->GetTuple());
+            break;
+          case LOGRECORD_TYPE_WAL_TUPLE_DELETE:
+            DeleteTupleHelper(partition_max_oid, record->GetTransactionId(),
+                              record->GetDatabaseOid(), record->GetTableId(),
+                              record->GetDeleteLocation());
+            break;
+          default:
+            break;
+        }
+        delete record;
+      }
+    }
+  });
+
+  for (auto partition_max_oid : partition_max_oids) {
+    if (partition_max_oid > max_oid) {
+      max_oid = partition_max_oid;
+    }
+  }
+  max_cid = recovery_replay_max_cid + 1;
+}
+
+/**
+ * @brief merge the committed txns kept by every stream by commit id and
+ * replay them through the first stream. A txn is logged by one stream only,
+ * but the txns updating a tuple may be spread over all of them.
+ * @param the frontend loggers of all the streams, after their DoRecovery
+ */
+void WriteAheadFrontendLogger::ReplayRecoveredStreams(
+    const std::vector<WriteAheadFrontendLogger *> &streams) {
+  if (streams.empty()) {
+    return;
+  }
+
+  // every stream is in commit order already unless backends raced on it
+  for (auto stream : streams) {
+    std::stable_sort(stream->recovered_transactions.begin(),
+                     stream->recovered_transactions.end(),
+                     [](const std::pair<cid_t, std::vector<TupleRecord *>> &a,
+                        const std::pair<cid_t, std::vector<TupleRecord *>> &b) {
+                       return a.first < b.first;
+                     });
+  }
+
+  // k-way merge, the heap holds the next txn of every stream
+  typedef std::pair<cid_t, size_t> StreamHead;
+  std::priority_queue<StreamHead, std::vector<StreamHead>,
+                      std::greater<StreamHead>> heads;
+  std::vector<size_t> cursors(streams.size(), 0);
+  for (size_t stream = 0; stream < streams.size(); stream++) {
+    if (streams[stream]->recovered_transactions.empty() == false) {
+      heads.emplace(streams[stream]->recovered_transactions[0].first, stream);
+    }
+  }
+
+  auto replayer = streams[0];
+  for (auto stream : streams) {
+    replayer->max_oid = std::max(replayer->max_oid, stream->max_oid);
+    replayer->max_cid = std::max(replayer->max_cid, stream->max_cid);
+  }
+
+  while (heads.empty() == false) {
+    auto head = heads.top();
+    heads.pop();
+
+    auto &transactions = streams[head.second]->recovered_transactions;
+    auto &cursor = cursors[head.second];
+    auto &tuple_records = transactions[cursor].second;
+    replayer->recovery_replay_queue.insert(
+        replayer->recovery_replay_queue.end(), tuple_records.begin(),
+        tuple_records.end());
+    tuple_records.clear();
+    if (head.first > replayer->recovery_replay_max_cid) {
+      replayer->recovery_replay_max_cid = head.first;
+    }
+
+    if (++cursor < transactions.size()) {
+      heads.emplace(transactions[cursor].first, head.second);
+    }
+
+    if (replayer->recovery_replay_queue.size() >=
+        replayer->recovery_replay_batch_size) {
+      replayer->ReplayQueuedTransactions();
+    }
+  }
+  replayer->ReplayQueuedTransactions();
+
+  for (auto stream : streams) {
+    stream->recovered_transactions.clear();
+  }
+
+  // the tile groups created by the replay were not known at the end of
+  // DoRecovery
+  auto &manager = catalog::Manager::GetInstance();
+  if (replayer->max_oid > manager.GetCurrentOid()) {
+    manager.SetNextOid(replayer->max_oid);
+  }
+}
+
 //===--------------------------------------------------------------------===//
 // Utility functions
 //===--------------------------------------------------------------------===//
@@ -675,8 +931,8 @@ LogRecordType WriteAheadFrontendLogger::GetNextLogRecordTypeForRecovery() {
   bool is_truncated = false;
   int ret;
 
-  if (cur_file_handle.file == nullptr || cur_file_handle.fd == -1)
-    return LOGRECORD_TYPE_INVALID;
+  // a decoded log file is read from memory and has no descriptor
+  if (cur_file_handle.file == nullptr) return LOGRECORD_TYPE_INVALID;
 
   LOG_TRACE("Inside GetNextLogRecordForRecovery");
 
@@ -688,17 +944,18 @@ LogRecordType WriteAheadFrontendLogger::GetNextLogRecordTypeForRecovery() {
     is_truncated = true;
   }
 
-  // Otherwise, read the log record type
+  // Otherwise, read the log record type. The zeros after the records of a
+  // preallocated segment end its log as well.
   if (!is_truncated) {
     ret = fread((void *)&buffer, 1, sizeof(char), cur_file_handle.file);
     if (ret <= 0) {
       LOG_TRACE("Failed an fread");
     }
   }
-  if (is_truncated || ret <= 0) {
+  if (is_truncated || ret <= 0 || buffer == LOGRECORD_TYPE_INVALID) {
     LOG_TRACE("Call OpenNextLogFile");
     OpenNextLogFile();
-    if (cur_file_handle.fd == -1) return LOGRECORD_TYPE_INVALID;
+    if (cur_file_handle.file == nullptr) return LOGRECORD_TYPE_INVALID;
 
     LOG_TRACE("Open succeeded. log_file_fd is %d", (int)cur_file_handle.fd);
 
@@ -755,6 +1012,15 @@ void WriteAheadFrontendLogger::InitLogFilesList() {
 
   // XXX readdir is not thread safe???
   while ((file = readdir(dirp)) != NULL) {
+    if (strncmp(file->d_name, FREE_SEGMENT_PREFIX.c_str(),
+                FREE_SEGMENT_PREFIX.length()) == 0) {
+      // a zeroed segment waiting for reuse
+      int segment_number = LoggingUtil::ExtractNumberFromFileName(file->d_name);
+      free_segment_counter_ = std::max(free_segment_counter_, segment_number + 1);
+      free_segments_.push_back(GetFreeSegmentName(segment_number));
+      continue;
+    }
+
     if (strncmp(file->d_name, base_name.c_str(), base_name.length()) == 0) {
       // found a log file!
       LOG_TRACE("Found a log file with name %s", file->d_name);
@@ -873,6 +1139,8 @@ void WriteAheadFrontendLogger::CreateNewLogFile(bool close_old_file) {
 
   new_file_num = log_file_counter_;
 
+  std::unique_lock<std::mutex> log_files_guard(log_files_lock);
+
   if (close_old_file) {  // must close last opened file
     int file_list_size = log_files_.size();
     LogFile *cur_log_file_object = log_files_[file_list_size - 1];
@@ -915,11 +1183,13 @@ void WriteAheadFrontendLogger::CreateNewLogFile(bool close_old_file) {
     }
   }
 
+  log_files_guard.unlock();
+
   LOG_TRACE("new_file_num is %d", new_file_num);
 
   new_file_name = this->GetFileNameFromVersion(new_file_num);
 
-  FILE *new_log_file = fopen(new_file_name.c_str(), "wb");
+  FILE *new_log_file = OpenLogSegment(new_file_name);
 
   if (new_log_file == NULL) {
     LOG_ERROR("new_log_file is NULL");
@@ -938,6 +1208,8 @@ void WriteAheadFrontendLogger::CreateNewLogFile(bool close_old_file) {
   cur_file_handle.fd = fileno(cur_file_handle.file);
   cur_file_handle.size = 0;
 
+  log_compression_file = LogManager::GetInstance().GetLogCompression();
+
   if (cur_file_handle.fd == -1) {
     LOG_ERROR("cur_file_handle.fd is -1");
   }
@@ -947,7 +1219,9 @@ void WriteAheadFrontendLogger::CreateNewLogFile(bool close_old_file) {
   LogFile *new_log_file_object = new LogFile(
       cur_file_handle, new_file_name, new_file_num, INVALID_CID, INVALID_CID);
 
+  log_files_guard.lock();
   log_files_.push_back(new_log_file_object);
+  log_files_guard.unlock();
 
   log_file_counter_++;  // finally, increment log_file_counter_
 
@@ -955,11 +1229,10 @@ void WriteAheadFrontendLogger::CreateNewLogFile(bool close_old_file) {
 }
 
 bool WriteAheadFrontendLogger::FileSwitchCondIsTrue() {
-  struct stat stat_buf;
   if (cur_file_handle.fd == -1) return false;
 
-  fstat(cur_file_handle.fd, &stat_buf);
-  cur_file_handle.size = stat_buf.st_size;
+  // a preallocated segment is larger than the records written to it
+  cur_file_handle.size = ftell(cur_file_handle.file);
 
   return cur_file_handle.size >
          LogManager::GetInstance().GetLogFileSizeLimit() * 1024;
@@ -1001,6 +1274,11 @@ void WriteAheadFrontendLogger::OpenNextLogFile() {
     LOG_TRACE("Opened new log file for recovery");
   }
 
+  // Read the log in large chunks
+  recovery_read_buffer.resize(recovery_read_buffer_size);
+  setvbuf(cur_file_handle.file, recovery_read_buffer.data(), _IOFBF,
+          recovery_read_buffer.size());
+
   cur_file_handle.fd = fileno(cur_file_handle.file);
 
   LOG_TRACE("FD of opened file is %d", (int)cur_file_handle.fd);
@@ -1036,35 +1314,150 @@ void WriteAheadFrontendLogger::OpenNextLogFile() {
   fstat(cur_file_handle.fd, &stat_buf);
   cur_file_handle.size = stat_buf.st_size;
 
+  // A log file made of blocks is verified and decompressed up front, then
+  // its records are read from memory
+  if (LogBlock::IsBlockStart(cur_file_handle.file)) {
+    FILE *decoded_file =
+        LogBlock::OpenDecoded(cur_file_handle.file, recovery_decoded_log);
+    if (decoded_file != nullptr) {
+      fclose(cur_file_handle.file);
+      cur_file_handle.file = decoded_file;
+      cur_file_handle.fd = INVALID_FILE_DESCRIPTOR;
+      cur_file_handle.size = recovery_decoded_log.size();
+    }
+  }
+
   log_file_cursor_++;
   LOG_TRACE("Cursor is now %d", (int)log_file_cursor_);
 }
 
 void WriteAheadFrontendLogger::TruncateLog(cid_t truncate_log_id) {
   int return_val;
+  std::vector<LogFile *> stale_log_files;
 
-  // delete stale log files except the one currently being used
-  for (int i = 0; i < (int)log_files_.size() - 1; i++) {
-    if (truncate_log_id >= log_files_[i]->GetMaxLogId()) {
-      // XXX Do we need directory prefix before log file name?
-      return_val = remove(log_files_[i]->GetLogFileName().c_str());
-      if (return_val != 0) {
-        LOG_ERROR("Couldn't delete log file: %s error: %s",
-                  log_files_[i]->GetLogFileName().c_str(), strerror(errno));
+  // take stale log files off the list except the one currently being used
+  {
+    std::lock_guard<std::mutex> lock(log_files_lock);
+    for (int i = 0; i < (int)log_files_.size() - 1; i++) {
+      if (truncate_log_id >= log_files_[i]->GetMaxLogId()) {
+        stale_log_files.push_back(log_files_[i]);
+        log_files_.erase(log_files_.begin() + i);
+        i--;  // update cursor
       }
-      // remove entry from list anyway
-      delete log_files_[i];
-      log_files_.erase(log_files_.begin() + i);
-      i--;  // update cursor
     }
   }
+
+  auto segment_count = LogManager::GetInstance().GetLogSegmentCount();
+  for (auto log_file : stale_log_files) {
+    // recycle the file while the ring has room, delete it otherwise
+    if (GetFreeSegmentCount() < segment_count &&
+        RecycleLogSegment(log_file->GetLogFileName())) {
+      delete log_file;
+      continue;
+    }
+
+    // XXX Do we need directory prefix before log file name?
+    return_val = remove(log_file->GetLogFileName().c_str());
+    if (return_val != 0) {
+      LOG_ERROR("Couldn't delete log file: %s error: %s",
+                log_file->GetLogFileName().c_str(), strerror(errno));
+    }
+    delete log_file;
+  }
+}
+
+// Write zeros over the file from its current position, then sync them
+static bool ZeroFillLogSegment(FILE *segment, size_t size) {
+  std::vector<char> zeros(std::min<size_t>(size, 1 << 20), 0);
+  for (size_t written = 0; written < size; written += zeros.size()) {
+    size_t write_size = std::min(zeros.size(), size - written);
+    if (fwrite(zeros.data(), sizeof(char), write_size, segment) != write_size) {
+      return false;
+    }
+  }
+  return (fflush(segment) == 0 && fdatasync(fileno(segment)) == 0);
+}
+
+FILE *WriteAheadFrontendLogger::OpenLogSegment(const std::string &file_name) {
+  auto &log_manager = LogManager::GetInstance();
+  if (log_manager.GetLogSegmentCount() == 0) {
+    return fopen(file_name.c_str(), "wb");
+  }
+
+  // Reuse the oldest free segment, its blocks are already written
+  std::string segment_name;
+  {
+    std::lock_guard<std::mutex> lock(log_files_lock);
+    if (free_segments_.empty() == false) {
+      segment_name = free_segments_.front();
+      free_segments_.pop_front();
+    }
+  }
+  if (segment_name.empty() == false) {
+    if (rename(segment_name.c_str(), file_name.c_str()) == 0) {
+      return fopen(file_name.c_str(), "rb+");
+    }
+    LOG_ERROR("Couldn't reuse log segment: %s error: %s",
+              segment_name.c_str(), strerror(errno));
+  }
+
+  // Otherwise preallocate a new segment, so that syncing the log does not
+  // have to update the file size
+  FILE *segment = fopen(file_name.c_str(), "wb+");
+  if (segment == NULL) {
+    return NULL;
+  }
+  if (ZeroFillLogSegment(segment, log_manager.GetLogFileSizeLimit() * 1024) ==
+      false) {
+    LOG_ERROR("Couldn't preallocate log segment: %s error: %s",
+              file_name.c_str(), strerror(errno));
+  }
+  rewind(segment);
+  return segment;
+}
+
+bool WriteAheadFrontendLogger::RecycleLogSegment(const std::string &file_name) {
+  FILE *segment = fopen(file_name.c_str(), "rb+");
+  if (segment == NULL) {
+    return false;
+  }
+
+  // Recovery reads the records of a segment up to the first zero
+  struct stat segment_stats;
+  fstat(fileno(segment), &segment_stats);
+  bool zeroed = ZeroFillLogSegment(segment, segment_stats.st_size);
+  fclose(segment);
+  if (zeroed == false) {
+    LOG_ERROR("Couldn't zero log segment: %s error: %s", file_name.c_str(),
+              strerror(errno));
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(log_files_lock);
+  std::string segment_name = GetFreeSegmentName(free_segment_counter_);
+  if (rename(file_name.c_str(), segment_name.c_str()) != 0) {
+    LOG_ERROR("Couldn't recycle log file: %s error: %s", file_name.c_str(),
+              strerror(errno));
+    return false;
+  }
+  free_segment_counter_++;
+  free_segments_.push_back(segment_name);
+  return true;
+}
+
+size_t WriteAheadFrontendLogger::GetFreeSegmentCount() {
+  std::lock_guard<std::mutex> lock(log_files_lock);
+  return free_segments_.size();
 }
 
 void WriteAheadFrontendLogger::InitLogDirectory() {
 
   // Get log directory
   auto &log_manager = logging::LogManager::GetInstance();
-  peloton_log_directory = log_manager.GetLogDirectoryName() + wal_directory_path;
+  // the first stream keeps the directory name of a single stream log
+  peloton_log_directory = log_manager.GetLogDirectoryName(stream_id_) +
+                          wal_directory_path +
+                          (stream_id_ > 0 ? std::to_string(stream_id_) : "");
 
   auto success =
       LoggingUtil::CreateDirectory(peloton_log_directory.c_str(), 0700);
@@ -1080,6 +1473,11 @@ std::string WriteAheadFrontendLogger::GetFileNameFromVersion(int version) {
          std::to_string(version) + LOG_FILE_SUFFIX;
 }
 
+std::string WriteAheadFrontendLogger::GetFreeSegmentName(int number) {
+  return peloton_log_directory + "/" + FREE_SEGMENT_PREFIX +
+         std::to_string(number) + LOG_FILE_SUFFIX;
+}
+
 std::pair<cid_t, cid_t>
 WriteAheadFrontendLogger::ExtractMaxLogIdAndMaxDelimFromLogFileRecords(
     FILE *log_file) {
@@ -1094,6 +1492,18 @@ WriteAheadFrontendLogger::ExtractMaxLogIdAndMaxDelimFromLogFileRecords(
   fstat(file_handle.fd, &log_stats);
   file_handle.size = log_stats.st_size;
 
+  // the records of a log file made of blocks are read once decoded
+  std::vector<char> decoded_log;
+  std::unique_ptr<FILE, int (*)(FILE *)> decoded_file(nullptr, fclose);
+  if (LogBlock::IsBlockStart(log_file)) {
+    decoded_file.reset(LogBlock::OpenDecoded(log_file, decoded_log));
+    if (decoded_file == nullptr) {
+      return std::pair<cid_t, cid_t>(max_log_id_so_far, max_delim_so_far);
+    }
+    file_handle.file = decoded_file.get();
+    file_handle.size = decoded_log.size();
+  }
+
   while (reached_end_of_file == false) {
     // Read the first byte to identify log record type
     // If that is not possible, then wrap up recovery
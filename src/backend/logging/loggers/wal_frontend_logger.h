@@ -18,6 +18,8 @@
 #include "backend/executor/executors.h"
 
 #include <dirent.h>
+#include <deque>
+#include <mutex>
 #include <vector>
 #include <set>
 #include <chrono>
@@ -34,11 +36,6 @@ class Transaction;
 
 namespace logging {
 
-typedef std::chrono::high_resolution_clock Clock;
-
-typedef std::chrono::microseconds Micros;
-
-typedef std::chrono::time_point<Clock> TimePoint;
 //===--------------------------------------------------------------------===//
 // Write Ahead Frontend Logger
 //===--------------------------------------------------------------------===//
@@ -47,7 +44,7 @@ class WriteAheadFrontendLogger : public FrontendLogger {
  public:
   WriteAheadFrontendLogger(void);
 
-  WriteAheadFrontendLogger(bool for_testing);
+  WriteAheadFrontendLogger(bool for_testing, unsigned int stream_id = 0);
 
   WriteAheadFrontendLogger(std::string log_dir);
 
@@ -67,6 +64,19 @@ class WriteAheadFrontendLogger : public FrontendLogger {
 
   void CommitTransactionRecovery(cid_t commit_id);
 
+  // Parallel recovery: committed transactions are queued and replayed in
+  // batches, with the records of each table applied by one worker
+  void QueueTransactionRecovery(cid_t commit_id);
+
+  void ReplayQueuedTransactions();
+
+  // Recovery of several streams: every stream keeps its committed
+  // transactions, then they are merged by commit id and replayed
+  void KeepTransactionRecovery(cid_t commit_id);
+
+  static void ReplayRecoveredStreams(
+      const std::vector<WriteAheadFrontendLogger *> &streams);
+
   void InsertTuple(TupleRecord *recovery_txn);
 
   void DeleteTuple(TupleRecord *recovery_txn);
@@ -91,6 +101,16 @@ class WriteAheadFrontendLogger : public FrontendLogger {
 
   std::string GetFileNameFromVersion(int);
 
+  std::string GetFreeSegmentName(int);
+
+  // Ring of log segments: the log files made stale by a checkpoint are
+  // zeroed and kept for reuse, up to the segment count of the log manager
+  FILE *OpenLogSegment(const std::string &file_name);
+
+  bool RecycleLogSegment(const std::string &file_name);
+
+  size_t GetFreeSegmentCount();
+
   std::pair<cid_t, cid_t> ExtractMaxLogIdAndMaxDelimFromLogFileRecords(FILE *);
 
   void SetLoggerID(int);
@@ -105,6 +125,11 @@ class WriteAheadFrontendLogger : public FrontendLogger {
 
   static constexpr auto wal_directory_path = "wal_log";
 
+  // records replayed at once in parallel recovery, at the latest
+  static constexpr size_t recovery_replay_batch_size = 1 << 16;
+
+  static constexpr size_t recovery_read_buffer_size = 1 << 20;
+
  private:
   std::string GetLogFileName(void);
 
@@ -124,6 +149,23 @@ class WriteAheadFrontendLogger : public FrontendLogger {
   // Txn table during recovery
   std::map<txn_id_t, std::vector<TupleRecord *>> recovery_txn_table;
 
+  // Records of the committed transactions waiting for a parallel replay,
+  // in commit order
+  std::vector<TupleRecord *> recovery_replay_queue;
+
+  cid_t recovery_replay_max_cid = INVALID_CID;
+
+  // Committed transactions of this stream waiting for the merge with the
+  // other streams, in the order of the log
+  std::vector<std::pair<cid_t, std::vector<TupleRecord *>>>
+      recovered_transactions;
+
+  // stdio buffer of the log file being recovered, it is read in chunks
+  std::vector<char> recovery_read_buffer;
+
+  // records of the log file being recovered, if it is made of blocks
+  std::vector<char> recovery_decoded_log;
+
   // Keep tracking max oid for setting next_oid in manager
   // For active processing after recovery
   oid_t max_oid = 0;
@@ -136,6 +178,14 @@ class WriteAheadFrontendLogger : public FrontendLogger {
   // abj1 adding code here!
   std::vector<LogFile *> log_files_;
 
+  // segments zeroed and waiting for reuse, oldest first
+  std::deque<std::string> free_segments_;
+
+  int free_segment_counter_ = 0;
+
+  // the checkpointer truncates the log files while this logger adds some
+  std::mutex log_files_lock;
+
   int log_file_counter_;
 
   int log_file_cursor_;
@@ -149,19 +199,41 @@ class WriteAheadFrontendLogger : public FrontendLogger {
 
   std::string LOG_FILE_SUFFIX = ".log";
 
+  std::string FREE_SEGMENT_PREFIX = "peloton_free_segment_";
+
   cid_t max_log_id_file = INVALID_CID;
 
   CopySerializeOutput output_buffer;
 
   int logger_id;
 
+  // the WAL stream this logger writes, it picks the log directory
+  unsigned int stream_id_ = 0;
+
   cid_t max_delimiter_file = 0;
 
   bool should_create_new_file = false;
 
-  TimePoint last_flush = Clock::now();
+  // the current log file is made of compressed blocks, a block holds the
+  // records of a flush
+  bool log_compression_file = false;
+
+  std::vector<char> log_block_records;
+
+  CopySerializeOutput log_block_output;
+
+  // whether records wait for the next flush, and since when
+  bool group_open = false;
 
+  TimePoint group_start = Clock::now();
+
+  // longest time a commit group waits to fill up
   Micros flush_frequency{peloton_flush_frequency_micros};
+
+  // commits and bytes written since the last flush
+  size_t group_commit_count = 0;
+
+  size_t group_commit_bytes = 0;
 };
 
 }  // namespace logging
@@ -26,7 +26,7 @@ void WriteBehindBackendLogger::Log(LogRecord *record) {
   if (record->GetType() == LOGRECORD_TYPE_TRANSACTION_COMMIT){
 	  SyncDataForCommit();
   }
-  log_buffer_lock.Lock();
+  commit_state_lock.Lock();
   switch (record->GetType()) {
     case LOGRECORD_TYPE_TRANSACTION_COMMIT:
       highest_logged_commit_message = record->GetTransactionId();
@@ -58,7 +58,30 @@ void WriteBehindBackendLogger::Log(LogRecord *record) {
       break;
   }
 
-  log_buffer_lock.Unlock();
+  commit_state_lock.Unlock();
+}
+
+void WriteBehindBackendLogger::SetLoggingCidLowerBound(cid_t cid) {
+  commit_state_lock.Lock();
+  BackendLogger::SetLoggingCidLowerBound(cid);
+  commit_state_lock.Unlock();
+}
+
+// write behind logging keeps no log buffers, only report the commit ids
+std::pair<cid_t, cid_t> WriteBehindBackendLogger::PrepareLogBuffers(
+    __attribute__((unused))
+    std::vector<std::unique_ptr<LogBuffer>> &frontend_queue) {
+  commit_state_lock.Lock();
+  std::pair<cid_t, cid_t> ret(INVALID_CID, INVALID_CID);
+  // prepare the cid's seen so far
+  if (logging_cid_lower_bound != INVALID_CID) {
+    ret.second = highest_logged_commit_message;
+    if (logging_cid_lower_bound > highest_logged_commit_message) {
+      ret.first = logging_cid_lower_bound;
+    }
+  }
+  commit_state_lock.Unlock();
+  return ret;
 }
 
 void WriteBehindBackendLogger::SyncDataForCommit(){
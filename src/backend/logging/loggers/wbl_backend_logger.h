@@ -37,6 +37,11 @@ class WriteBehindBackendLogger : public BackendLogger {
 
   void Log(LogRecord *record);
 
+  void SetLoggingCidLowerBound(cid_t cid);
+
+  std::pair<cid_t, cid_t> PrepareLogBuffers(
+      std::vector<std::unique_ptr<LogBuffer>> &frontend_queue);
+
   LogRecord *GetTupleRecord(LogRecordType log_record_type, txn_id_t txn_id,
                             oid_t table_oid, oid_t db_oid,
                             ItemPointer insert_location,
@@ -50,6 +55,9 @@ class WriteBehindBackendLogger : public BackendLogger {
 
  void SyncDataForCommit();
 
+  // the lock for the commit ids reported to the frontend logger
+  Spinlock commit_state_lock;
+
   std::unordered_set<oid_t> tile_groups_to_sync_;
 };
 
@@ -29,10 +29,11 @@ void LoggingUtil::FFlushFsync(FileHandle &file_handle) {
   if (ret != 0) {
     LOG_ERROR("Error occured in fflush(%d)", ret);
   }
-  // Finally, sync
-  ret = fsync(file_handle.fd);
+  // Finally, sync. The times of the file are not needed, its size is still
+  // synced when it changes
+  ret = fdatasync(file_handle.fd);
   if (ret != 0) {
-    LOG_ERROR("Error occured in fsync(%d)", ret);
+    LOG_ERROR("Error occured in fdatasync(%d)", ret);
   }
 }
 
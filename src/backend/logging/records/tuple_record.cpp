@@ -65,7 +65,7 @@ bool TupleRecord::Serialize(CopySerializeOutput &output) {
  * @brief Serialize LogRecordHeader
  * @param output
  */
-void TupleRecord::SerializeHeader(CopySerializeOutput &output) {
+void TupleRecord::SerializeHeader(SerializeOutput &output) {
   // Record LogRecordType first
   output.WriteEnumInSingleByte(log_record_type);
 
@@ -103,6 +103,12 @@ void TupleRecord::DeserializeHeader(CopySerializeInputBE &input) {
   delete_location.offset = (oid_t)(input.ReadLong());
 }
 
+size_t TupleRecord::GetSerializedHeaderSize(void) {
+  // log_record_type + header_length + db_oid + table_oid + txn_id +
+  // insert_location + delete_location
+  return sizeof(char) + sizeof(int32_t) + sizeof(int64_t) * 7;
+}
+
 // Used for write behind logging
 size_t TupleRecord::GetTupleRecordSize(void) {
   // log_record_type + header_legnth + db_oid + table_oid + txn_id +
@@ -63,7 +63,10 @@ class TupleRecord : public LogRecord, Printable {
 
   bool Serialize(CopySerializeOutput &output);
 
-  void SerializeHeader(CopySerializeOutput &output);
+  void SerializeHeader(SerializeOutput &output);
+
+  // length of the header written by SerializeHeader
+  static size_t GetSerializedHeaderSize(void);
 
   void DeserializeHeader(CopySerializeInputBE &input);
 
@@ -61,6 +61,11 @@ class HashJoinPlan : public AbstractJoinPlan {
     return outer_column_ids_;
   }
 
+  // Probe the hash table with this many workers in parallel
+  void SetParallelism(size_t parallelism) { parallelism_ = parallelism; }
+
+  size_t GetParallelism() const { return parallelism_; }
+
   std::unique_ptr<AbstractPlan> Copy() const {
     std::unique_ptr<const expression::AbstractExpression> predicate_copy(
         GetPredicate()->Copy());
@@ -69,11 +74,15 @@ class HashJoinPlan : public AbstractJoinPlan {
     HashJoinPlan *new_plan = new HashJoinPlan(
         GetJoinType(), std::move(predicate_copy),
         std::move(GetProjInfo()->Copy()), schema_copy, outer_column_ids_);
+    new_plan->SetParallelism(parallelism_);
     return std::unique_ptr<AbstractPlan>(new_plan);
   }
 
  private:
   std::vector<oid_t> outer_column_ids_;
+
+  /** @brief number of workers probing the hash table. */
+  size_t parallelism_ = DEFAULT_QUERY_PARALLELISM;
 };
 
 }  // namespace planner
@@ -44,16 +44,26 @@ class HashPlan : public AbstractPlan {
     return this->hash_keys_;
   }
 
+  // Build the hash table with this many workers in parallel
+  void SetParallelism(size_t parallelism) { parallelism_ = parallelism; }
+
+  size_t GetParallelism() const { return parallelism_; }
+
   std::unique_ptr<AbstractPlan> Copy() const {
     std::vector<HashKeyPtrType> copied_hash_keys;
     for (const auto &key : hash_keys_) {
       copied_hash_keys.push_back(std::unique_ptr<HashKeyType>(key->Copy()));
     }
-    return std::unique_ptr<AbstractPlan>(new HashPlan(copied_hash_keys));
+    HashPlan *new_plan = new HashPlan(copied_hash_keys);
+    new_plan->SetParallelism(parallelism_);
+    return std::unique_ptr<AbstractPlan>(new_plan);
   }
 
  private:
   std::vector<HashKeyPtrType> hash_keys_;
+
+  /** @brief number of workers building the hash table. */
+  size_t parallelism_ = DEFAULT_QUERY_PARALLELISM;
 };
 }
 }
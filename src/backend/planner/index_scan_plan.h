@@ -99,6 +99,11 @@ class IndexScanPlan : public AbstractScan {
     return runtime_keys_;
   }
 
+  // Only the first limit visible tuples are needed (if not zero)
+  void SetLimit(size_t limit) { limit_ = limit; }
+
+  size_t GetLimit() const { return limit_; }
+
   inline PlanNodeType GetPlanNodeType() const {
     return PLAN_NODE_TYPE_INDEXSCAN;
   }
@@ -115,6 +120,7 @@ class IndexScanPlan : public AbstractScan {
                        new_runtime_keys);
     IndexScanPlan *new_plan = new IndexScanPlan(
         GetTable(), GetPredicate()->Copy(), GetColumnIds(), desc);
+    new_plan->SetLimit(limit_);
     return std::unique_ptr<AbstractPlan>(new_plan);
   }
 
@@ -131,6 +137,9 @@ class IndexScanPlan : public AbstractScan {
   const std::vector<Value> values_;
 
   const std::vector<expression::AbstractExpression *> runtime_keys_;
+
+  /** @brief number of tuples a parent limit needs, zero if unbounded. */
+  size_t limit_ = 0;
 };
 
 }  // namespace planner
@@ -47,6 +47,11 @@ class SeqScanPlan : public AbstractScan {
 
   const std::string GetInfo() const { return "SeqScan"; }
 
+  // Scan the tile groups with this many workers in parallel
+  void SetParallelism(size_t parallelism) { parallelism_ = parallelism; }
+
+  size_t GetParallelism() const { return parallelism_; }
+
   //===--------------------------------------------------------------------===//
   // Serialization/Deserialization
   //===--------------------------------------------------------------------===//
@@ -57,11 +62,15 @@ class SeqScanPlan : public AbstractScan {
   int SerializeSize();
 
   std::unique_ptr<AbstractPlan> Copy() const {
-    AbstractPlan *new_plan = new SeqScanPlan(
+    SeqScanPlan *new_plan = new SeqScanPlan(
         this->GetTable(), this->GetPredicate()->Copy(), this->GetColumnIds());
+    new_plan->SetParallelism(parallelism_);
     return std::unique_ptr<AbstractPlan>(new_plan);
   }
 
+ private:
+  /** @brief number of workers scanning the tile groups. */
+  size_t parallelism_ = DEFAULT_QUERY_PARALLELISM;
 };
 
 }  // namespace planner
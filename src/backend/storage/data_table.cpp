@@ -347,6 +347,57 @@ bool DataTable::InsertInSecondaryIndexes(const storage::Tuple *tuple,
   return true;
 }
 
+bool DataTable::SwingPrimaryIndexEntry(const ItemPointer &key_location,
+                                       const ItemPointer &expected,
+                                       const ItemPointer &desired) {
+  index::Index *primary_index = nullptr;
+  for (auto index : indexes_) {
+    if (index->GetIndexType() == INDEX_CONSTRAINT_TYPE_PRIMARY_KEY) {
+      primary_index = index;
+      break;
+    }
+  }
+
+  // Without a primary index there is no entry to keep up to date
+  if (primary_index == nullptr) return true;
+
+  std::unique_ptr<storage::Tuple> tuple(new storage::Tuple(schema, true));
+  GetTileGroupById(key_location.block)
+      ->CopyTuple(key_location.offset, tuple.get());
+
+  auto index_schema = primary_index->GetKeySchema();
+  auto indexed_columns = index_schema->GetIndexedColumns();
+  std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
+  key->SetFromTuple(tuple.get(), indexed_columns, primary_index->GetPool());
+
+  // Indexes that store item pointers inline may move the entry while we
+  // swing it, look it up again until the swing lands or the entry is gone
+  for (;;) {
+    std::vector<ItemPointer *> item_pointers;
+    primary_index->ScanKey(key.get(), item_pointers);
+
+    bool found = false;
+    for (auto item_pointer : item_pointers) {
+      ItemPointer current = *item_pointer;
+      if (current.block != expected.block ||
+          current.offset != expected.offset) {
+        continue;
+      }
+
+      found = true;
+      if (AtomicUpdateItemPointer(item_pointer, expected, desired) == true) {
+        return true;
+      }
+    }
+
+    if (found == false) {
+      LOG_TRACE("Primary index entry of (%u, %u) not found", expected.block,
+                expected.offset);
+      return false;
+    }
+  }
+}
+
 /**
  * @brief Check if all the foreign key constraints on this table
  * is satisfied by checking whether the key exist in the referred table
@@ -463,10 +514,21 @@ void DataTable::ResetDirty() { dirty_ = false; }
 
 TileGroup *DataTable::GetTileGroupWithLayout(
     const column_map_type &partitioning) {
-  std::vector<catalog::Schema> schemas;
   oid_t tile_group_id = INVALID_OID;
 
   tile_group_id = catalog::Manager::GetInstance().GetNextOid();
+  auto schemas = GetTileSchemas(partitioning);
+
+  TileGroup *tile_group = TileGroupFactory::GetTileGroup(
+      database_oid, table_oid, tile_group_id, this, schemas, partitioning,
+      tuples_per_tilegroup_);
+
+  return tile_group;
+}
+
+std::vector<catalog::Schema> DataTable::GetTileSchemas(
+    const column_map_type &partitioning) const {
+  std::vector<catalog::Schema> schemas;
 
   // Figure out the columns in each tile in new layout
   std::map<std::pair<oid_t, oid_t>, oid_t> tile_column_map;
@@ -484,11 +546,7 @@ TileGroup *DataTable::GetTileGroupWithLayout(
     schemas.push_back(tile_schema);
   }
 
-  TileGroup *tile_group = TileGroupFactory::GetTileGroup(
-      database_oid, table_oid, tile_group_id, this, schemas, partitioning,
-      tuples_per_tilegroup_);
-
-  return tile_group;
+  return schemas;
 }
 
 column_map_type DataTable::GetTileGroupLayout(LayoutType layout_type) {
@@ -579,10 +637,29 @@ void DataTable::AddTileGroupWithOidForRecovery(const oid_t &tile_group_id) {
       database_oid, table_oid, tile_group_id, this, schemas, column_map,
       tuples_per_tilegroup_));
 
+  AddRecoveredTileGroup(tile_group);
+}
+
+void DataTable::AddTileGroupWithOidForRecovery(
+    const oid_t &tile_group_id, const column_map_type &partitioning,
+    const size_t &tuple_count) {
+  assert(tile_group_id);
+
+  std::shared_ptr<TileGroup> tile_group(TileGroupFactory::GetTileGroup(
+      database_oid, table_oid, tile_group_id, this,
+      GetTileSchemas(partitioning), partitioning, tuple_count));
+
+  AddRecoveredTileGroup(tile_group);
+}
+
+void DataTable::AddRecoveredTileGroup(
+    const std::shared_ptr<TileGroup> &tile_group) {
+  auto tile_group_id = tile_group->GetTileGroupId();
+
   tile_group_lock_.WriteLock();
-  if (std::find(tile_groups_.begin(), tile_groups_.end(),
-                tile_group->GetTileGroupId()) == tile_groups_.end()) {
-    tile_groups_.push_back(tile_group->GetTileGroupId());
+  if (std::find(tile_groups_.begin(), tile_groups_.end(), tile_group_id) ==
+      tile_groups_.end()) {
+    tile_groups_.push_back(tile_group_id);
 
     LOG_TRACE("Added a tile group ");
 
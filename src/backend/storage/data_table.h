@@ -109,6 +109,14 @@ class DataTable : public AbstractTable {
   // insert tuple in table
   ItemPointer InsertTuple(const Tuple *tuple);
 
+  // point the primary index entry that references the expected version at
+  // the desired one, the key is read from the version at key_location.
+  // keeps the entry on the newest version with newest-to-oldest chains.
+  // returns false if no entry references the expected version
+  bool SwingPrimaryIndexEntry(const ItemPointer &key_location,
+                              const ItemPointer &expected,
+                              const ItemPointer &desired);
+
   // delete the tuple at given location
   // bool DeleteTuple(const concurrency::Transaction *transaction,
   //                  ItemPointer location);
@@ -120,6 +128,12 @@ class DataTable : public AbstractTable {
   // coerce into adding a new tile group with a tile group id
   void AddTileGroupWithOidForRecovery(const oid_t &tile_group_id);
 
+  // same, with the layout and the number of tuple slots the tile group had
+  // when it was checkpointed
+  void AddTileGroupWithOidForRecovery(const oid_t &tile_group_id,
+                                      const column_map_type &partitioning,
+                                      const size_t &tuple_count);
+
   // add a tile group to table
   void AddTileGroup(const std::shared_ptr<TileGroup> &tile_group);
 
@@ -234,6 +248,13 @@ class DataTable : public AbstractTable {
   // get a partitioning with given layout type
   column_map_type GetTileGroupLayout(LayoutType layout_type);
 
+  // get the schemas of the tiles of a partitioning
+  std::vector<catalog::Schema> GetTileSchemas(
+      const column_map_type &partitioning) const;
+
+  // record a tile group created for recovery, unless it is already there
+  void AddRecoveredTileGroup(const std::shared_ptr<TileGroup> &tile_group);
+
   // Drop all tile groups of the table. Used by recovery
   void DropTileGroups();
 
@@ -19,26 +19,53 @@ namespace storage {
  * @brief create a rollback segment by selecting columns from a tuple
  * @param target_list The columns to be selected
  * @param tuple The tuple to construct the RB
+ * @param txn_rb_seg Head of the rollback segments the updating transaction
+ * has already created for this tuple (nullptr if none)
  *
- * TODO: Optimization can be done. We can save copying those columns that are already
- * in the rollback segment created by the same transaction. What we need to do is to add
- * a bitmap in the rollback segment indicating columns it contains. After that we
- * can bypass these columns when making a new rollback segment.
+ * Only the before image of a column is worth keeping. The columns that are
+ * already in a rollback segment of the same transaction are skipped, their
+ * values on the master copy are the transaction's own writes. Returns nullptr
+ * if every updated column is covered already.
  */
 RBSegType RollbackSegmentPool::CreateSegmentFromTuple(const catalog::Schema *schema,
                                                 const planner::ProjectInfo::TargetList &target_list,
-                                                const AbstractTuple *tuple) {
+                                                const AbstractTuple *tuple,
+                                                RBSegType txn_rb_seg) {
   assert(schema);
   assert(target_list.size() != 0); 
 
-  size_t col_count = target_list.size();
+  // The segments of the updating transaction are not installed yet, they
+  // are the ones at the head of the chain that still have a MAX_CID timestamp
+  std::vector<oid_t> col_ids;
+  for (auto &target : target_list) {
+    auto col_id = target.first;
+    bool saved = false;
+    for (auto rb_seg = txn_rb_seg;
+         rb_seg != nullptr && GetTimeStamp(rb_seg) == MAX_CID && saved == false;
+         rb_seg = GetNextPtr(rb_seg)) {
+      size_t seg_col_count = GetColCount(rb_seg);
+      for (size_t idx = 0; idx < seg_col_count; ++idx) {
+        if (GetIdOffsetPair(rb_seg, idx)->col_id == col_id) {
+          saved = true;
+          break;
+        }
+      }
+    }
+
+    if (saved == false) {
+      col_ids.push_back(col_id);
+    }
+  }
+
+  if (col_ids.empty()) return nullptr;
+
+  size_t col_count = col_ids.size();
   size_t header_size = pairs_start_offset + col_count * sizeof(ColIdOffsetPair);
   size_t data_size = 0;
   RBSegType rb_seg = nullptr;
 
   // First figure out the total size of the rollback segment data area
-  for (auto &target : target_list) {
-    auto col_id = target.first;
+  for (auto col_id : col_ids) {
     data_size += schema->GetLength(col_id);
   }
 
@@ -53,9 +80,8 @@ RBSegType RollbackSegmentPool::CreateSegmentFromTuple(const catalog::Schema *sch
 
   // Fill in the col_id & offset pair and set the data field
   size_t offset = 0;
-  for (size_t idx = 0; idx < target_list.size(); ++idx) {
-    auto &target = target_list[idx];
-    auto col_id = target.first;
+  for (size_t idx = 0; idx < col_count; ++idx) {
+    auto col_id = col_ids[idx];
 
     const bool is_inlined = schema->IsInlined(col_id);
     const bool is_inbytes = false;
@@ -63,7 +89,7 @@ RBSegType RollbackSegmentPool::CreateSegmentFromTuple(const catalog::Schema *sch
     size_t inline_col_size = schema->GetLength(col_id);
     size_t allocate_col_size = (is_inlined) ? inline_col_size : schema->GetVariableLength(col_id);
 
-    SetColIdOffsetPair(rb_seg, idx, target.first, offset);
+    SetColIdOffsetPair(rb_seg, idx, col_id, offset);
 
     // Set the value
     char *value_location = GetColDataLocation(rb_seg, idx);
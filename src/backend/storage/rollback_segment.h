@@ -24,6 +24,7 @@
 #include <mutex>
 #include <cassert>
 #include <unordered_map>
+#include <vector>
 
 namespace peloton {
 
@@ -158,11 +159,13 @@ public:
     tombstone_ = true;
   }
 
-  // Get a prepared rollback segment from a tuple
-  // TODO: Return nullptr if there is no need to generate a new segment
+  // Get a prepared rollback segment from a tuple, holding the updated columns
+  // that are not in the transaction's own segments yet. Returns nullptr if
+  // there is no need to generate a new segment
   RBSegType CreateSegmentFromTuple(const catalog::Schema *schema,
                             const planner::ProjectInfo::TargetList &target_list,
-                            const AbstractTuple *tuple);
+                            const AbstractTuple *tuple,
+                            RBSegType txn_rb_seg = nullptr);
 
   inline static void SetColIdOffsetPair(char *rb_seg,
                                  size_t idx, oid_t col_id, size_t off) {
@@ -68,8 +68,11 @@ Tile::Tile(BackendType backend_type, TileGroupHeader *tile_header,
 
 Tile::~Tile() {
   // reclaim the tile memory (INLINED data)
-  auto &storage_manager = storage::StorageManager::GetInstance();
-  storage_manager.Release(backend_type, data);
+  if (image == nullptr) {
+    auto &storage_manager = storage::StorageManager::GetInstance();
+    storage_manager.Release(backend_type, data);
+  }
+  image.reset();
   data = NULL;
 
   // reclaim the tile memory (UNINLINED data)
@@ -238,6 +241,20 @@ Tile *Tile::CopyTile(BackendType backend_type) {
   return new_tile;
 }
 
+/**
+ * Adopt the data of a checkpoint image, mapped with the layout of this tile,
+ * in place of the allocated data.
+ */
+void Tile::AdoptData(char *image_data,
+                     const std::shared_ptr<char> &image_mapping) {
+  if (image == nullptr) {
+    auto &storage_manager = storage::StorageManager::GetInstance();
+    storage_manager.Release(backend_type, data);
+  }
+  data = image_data;
+  image = image_mapping;
+}
+
 //===--------------------------------------------------------------------===//
 // Utilities
 //===--------------------------------------------------------------------===//
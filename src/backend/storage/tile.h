@@ -18,6 +18,7 @@
 #include "backend/common/pool.h"
 #include "backend/common/printable.h"
 
+#include <memory>
 #include <mutex>
 
 namespace peloton {
@@ -108,6 +109,10 @@ class Tile : public Printable {
   // Copy current tile in given backend and return new tile
   Tile *CopyTile(BackendType backend_type);
 
+  // Use the data of a mapped checkpoint image instead of the allocated one,
+  // the image stays mapped as long as the tile refers to it
+  void AdoptData(char *image_data, const std::shared_ptr<char> &image_mapping);
+
   //===--------------------------------------------------------------------===//
   // Size Stats
   //===--------------------------------------------------------------------===//
@@ -190,6 +195,9 @@ class Tile : public Printable {
   // set of fixed-length tuple slots
   char *data;
 
+  // checkpoint image holding the data, if it was adopted
+  std::shared_ptr<char> image;
+
   // relevant tile group
   TileGroup *tile_group;
 
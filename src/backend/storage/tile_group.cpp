@@ -102,23 +102,7 @@ void TileGroup::ApplyRollbackSegment(char *rb_seg, const oid_t &tuple_slot_id) {
     auto col_id = storage::RollbackSegmentPool::GetIdOffsetPair(rb_seg, idx)->col_id;
     Value col_value = storage::RollbackSegmentPool::GetValue(rb_seg, table_schema, idx);
 
-    // Get target tile
-    auto tile_id = GetTileIdFromColumnId(col_id);
-    assert(tile_id < GetTileCount());
-    storage::Tile *tile = GetTile(tile_id);
-    assert(tile);
-
-    // Get tile schema
-    auto &tile_schema = tile_schemas[tile_id];
-
-    // Get a tuple wrapper
-    char *tile_tuple_location = tile->GetTupleLocation(tuple_slot_id);
-    assert(tile_tuple_location);
-    storage::Tuple tile_tuple(&tile_schema, tile_tuple_location);
-
-    // Write the value to tuple
-    auto tile_col_idx = GetTileColumnId(col_id);
-    tile_tuple.SetValue(tile_col_idx, col_value, tile->GetPool());
+    SetValue(col_value, tuple_slot_id, col_id);
   }
 }
 
@@ -412,6 +396,19 @@ Value TileGroup::GetValue(oid_t tuple_id, oid_t column_id) {
   return GetTile(tile_offset)->GetValue(tuple_id, tile_column_id);
 }
 
+void TileGroup::SetValue(const Value &value, oid_t tuple_id,
+                         oid_t column_id) {
+  assert(tuple_id < GetNextTupleSlot());
+  oid_t tile_column_id, tile_offset;
+  LocateTileAndColumn(column_id, tile_offset, tile_column_id);
+  Tile *tile = GetTile(tile_offset);
+
+  // Write through a tuple wrapper, it casts the value to the column type
+  storage::Tuple tile_tuple(&tile_schemas[tile_offset],
+                            tile->GetTupleLocation(tuple_id));
+  tile_tuple.SetValue(tile_column_id, value, tile->GetPool());
+}
+
 Tile *TileGroup::GetTile(const oid_t tile_offset) const {
   assert(tile_offset < tile_count);
   Tile *tile = tiles[tile_offset].get();
@@ -45,6 +45,10 @@ namespace storage {
  *  | NextItemPointer (8 bytes) | PrevItemPointer (8 bytes) | IndexCount(4 bytes) | 
  *  | ReservedField (24 bytes) | InsertCommit (1 byte) | DeleteCommit (1 byte)
  *  -----------------------------------------------------------------------------
+ *
+ * The NextItemPointer of a version points at the newer version of the tuple,
+ * the PrevItemPointer at the older one, whatever end of the chain the
+ * primary index references.
  */
 
 #define TUPLE_HEADER_LOCATION data + (tuple_slot_id * header_entry_size)
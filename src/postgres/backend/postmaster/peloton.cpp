@@ -34,6 +34,9 @@
 #include "backend/bridge/ddl/tests/bridge_test.h"
 #include "backend/bridge/dml/executor/plan_executor.h"
 #include "backend/bridge/dml/mapper/mapper.h"
+#include "backend/bridge/dml/tuple/tuple_transformer.h"
+#include "backend/executor/logical_tile.h"
+#include "backend/expression/container_tuple.h"
 #include "backend/logging/log_manager.h"
 #include "backend/logging/checkpoint_manager.h"
 #include "backend/planner/seq_scan_plan.h"
@@ -82,8 +85,8 @@ bool syncronization_commit = false;
 static void peloton_process_status(const peloton_status &status,
                                    const PlanState *planstate);
 
-static void peloton_send_output(const peloton_status &status, bool sendTuples,
-                                DestReceiver *dest,
+static void peloton_send_output(peloton::executor::LogicalTile *logical_tile,
+                                TupleDesc tuple_desc, DestReceiver *dest,
                                 BackendContext *backend_state = nullptr);
 
 static void __attribute__((unused)) peloton_test_config();
@@ -252,19 +255,22 @@ void peloton_dml(const PlanState *planstate, bool sendTuples,
   std::vector<peloton::oid_t> target_list;
   std::vector<peloton::oid_t> qual;
 
-  // Execute the plantree mapped_plan_ptr.get()
+  // Execute the plantree mapped_plan_ptr.get(),
+  // sending the output to dest as soon as the plan produces it
   try {
     status = peloton::bridge::PlanExecutor::ExecutePlan(
-        mapped_plan_ptr.get(), param_values, tuple_desc);
+        mapped_plan_ptr.get(), param_values,
+        [&](peloton::executor::LogicalTile *logical_tile) {
+          if (sendTuples) {
+            peloton_send_output(logical_tile, tuple_desc, dest, backend_state);
+          }
+        });
   } catch (const std::exception &exception) {
     elog(ERROR, "Peloton exception :: %s", exception.what());
   }
 
   // Wait for the response and process it
   peloton_process_status(status, planstate);
-
-  // Send output to dest
-  peloton_send_output(status, sendTuples, dest, backend_state);
 }
 
 /* ----------
@@ -296,47 +302,35 @@ static void peloton_process_status(const peloton_status &status,
 /* ----------
  * peloton_send_output() -
  *
- *  Send the output to the receiver.
+ *  Send the tuples of a logical tile to the receiver.
  * ----------
  */
-void peloton_send_output(const peloton_status &status, bool sendTuples,
-                         DestReceiver *dest, BackendContext *backend_state) {
+void peloton_send_output(peloton::executor::LogicalTile *logical_tile,
+                         TupleDesc tuple_desc, DestReceiver *dest,
+                         BackendContext *backend_state) {
   TupleTableSlot *slot;
 
-  // Go over any result slots
-  if (status.m_result_slots != NULL) {
-    ListCell *lc;
-
-    foreach (lc, status.m_result_slots) {
-      slot = (TupleTableSlot *)lfirst(lc);
-
-      /*
-       * if the tuple is null, then we assume there is nothing more to
-       * process so we just end the loop...
-       */
-      if (TupIsNull(slot)) break;
-
-      /*
-       * If we are supposed to send the tuple somewhere, do so. (In
-       * practice, this is probably always the case at this point.)
-       */
-
-      // for memcached, directly call printtup
-      if (sendTuples && backend_state) {
-        printtup(slot, dest, backend_state);
-      } else if (sendTuples)
-        // otherwise use dest fp
-        (*dest->receiveSlot)(slot, dest, backend_state);
-
-      /*
-       * Free the underlying heap_tuple
-       * and the TupleTableSlot itself.
-       */
-      ExecDropSingleTupleTableSlot(slot);
-    }
-
-    // Clean up list
-    list_free(status.m_result_slots);
+  // Go over the logical tile
+  for (peloton::oid_t tuple_id : *logical_tile) {
+    peloton::expression::ContainerTuple<peloton::executor::LogicalTile>
+        cur_tuple(logical_tile, tuple_id);
+
+    slot = peloton::bridge::TupleTransformer::GetPostgresTuple(&cur_tuple,
+                                                               tuple_desc);
+    if (slot == nullptr) continue;
+
+    // for memcached, directly call printtup
+    if (backend_state) {
+      printtup(slot, dest, backend_state);
+    } else
+      // otherwise use dest fp
+      (*dest->receiveSlot)(slot, dest, backend_state);
+
+    /*
+     * Free the underlying heap_tuple
+     * and the TupleTableSlot itself.
+     */
+    ExecDropSingleTupleTableSlot(slot);
   }
 }
 
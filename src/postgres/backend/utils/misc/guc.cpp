@@ -437,11 +437,13 @@ static const struct config_enum_entry peloton_gc_mode_options[] = {
 typedef enum CheckpointType {
   CHECKPOINT_TYPE_INVALID,
   CHECKPOINT_TYPE_NORMAL,
+  CHECKPOINT_TYPE_IMAGE,
 } CheckpointType;
 
 static const struct config_enum_entry peloton_checkpoint_mode_options[] = {
     {"invalid", CHECKPOINT_TYPE_INVALID, false},
     {"normal", CHECKPOINT_TYPE_NORMAL, false},
+    {"image", CHECKPOINT_TYPE_IMAGE, false},
     {NULL, 0, false}};
 
 /*
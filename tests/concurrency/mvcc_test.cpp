@@ -12,6 +12,8 @@
 
 #include "harness.h"
 #include "concurrency/transaction_tests_util.h"
+#include "backend/concurrency/optimistic_rb_txn_manager.h"
+#include "backend/storage/rollback_segment.h"
 
 namespace peloton {
 
@@ -309,5 +311,162 @@ TEST_F(MVCCTest, VersionChainTest) {
   }
 
 }
+// Validate that the primary index references the newest version of every
+// tuple, which is what a newest-to-oldest chain requires
+static void ValidateIndex_NewestToOldest(storage::DataTable *table) {
+  auto &catalog_manager = catalog::Manager::GetInstance();
+  auto primary_index = table->GetIndex(0);
+
+  std::vector<ItemPointer> tuple_locations;
+  primary_index->ScanAllKeys(tuple_locations);
+  for (auto tuple_location : tuple_locations) {
+    auto tile_group_header =
+        catalog_manager.GetTileGroup(tuple_location.block)->GetHeader();
+    EXPECT_TRUE(
+        tile_group_header->GetNextItemPointer(tuple_location.offset).IsNull())
+        << "Index entry does not reference the newest version";
+  }
+}
+
+TEST_F(MVCCTest, NewestToOldestVersionChainTest) {
+  for (auto protocol : TEST_TYPES) {
+    // The rollback segment protocol updates in place
+    if (protocol == CONCURRENCY_TYPE_OCC_RB) continue;
+
+    concurrency::TransactionManagerFactory::Configure(
+        protocol, ISOLATION_LEVEL_TYPE_FULL, VERSION_ORDER_TYPE_N2O);
+
+    // Only the primary index walks the version chains
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    std::unique_ptr<storage::DataTable> table(TransactionTestsUtil::CreateTable(
+        10, "TEST_TABLE", INVALID_OID, INVALID_OID, 1234, true));
+
+    // update, read the new version from another txn
+    {
+      TransactionScheduler scheduler(2, table.get(), &txn_manager);
+      scheduler.Txn(0).Update(0, 1);
+      scheduler.Txn(0).Update(0, 2);
+      scheduler.Txn(0).Read(0);
+      scheduler.Txn(0).Commit();
+      scheduler.Txn(1).Read(0);
+      scheduler.Txn(1).Commit();
+
+      scheduler.Run();
+
+      EXPECT_EQ(2, scheduler.schedules[0].results[0]);
+      EXPECT_EQ(2, scheduler.schedules[1].results[0]);
+      ValidateMVCC_OldToNew(table.get());
+      ValidateIndex_NewestToOldest(table.get());
+    }
+
+    // an aborted update hands the index entry back to the old version
+    {
+      TransactionScheduler scheduler(2, table.get(), &txn_manager);
+      scheduler.Txn(0).Update(0, 100);
+      scheduler.Txn(0).Abort();
+      scheduler.Txn(1).Read(0);
+      scheduler.Txn(1).Commit();
+
+      scheduler.Run();
+
+      EXPECT_EQ(2, scheduler.schedules[1].results[0]);
+      ValidateMVCC_OldToNew(table.get());
+      ValidateIndex_NewestToOldest(table.get());
+    }
+
+    // delete, insert back, update, then read from another txn
+    {
+      TransactionScheduler scheduler(2, table.get(), &txn_manager);
+      scheduler.Txn(0).Delete(1);
+      scheduler.Txn(0).Read(1);
+      scheduler.Txn(0).Insert(1000, 0);
+      scheduler.Txn(0).Update(1000, 3);
+      scheduler.Txn(0).Commit();
+      scheduler.Txn(1).Read(1000);
+      scheduler.Txn(1).Commit();
+
+      scheduler.Run();
+
+      EXPECT_EQ(3, scheduler.schedules[1].results[0]);
+      ValidateMVCC_OldToNew(table.get());
+      ValidateIndex_NewestToOldest(table.get());
+    }
+
+    // concurrent transfers between random keys
+    {
+      const int num_txn = 5;
+      const int scale = 20;
+      const int num_key = 10;
+      srand(15721);
+
+      TransactionScheduler scheduler(num_txn, table.get(), &txn_manager);
+      scheduler.SetConcurrent(true);
+      for (int i = 0; i < num_txn; i++) {
+        for (int j = 0; j < scale; j++) {
+          int key1 = 2 + rand() % (num_key - 2);
+          int key2 = 2 + rand() % (num_key - 2);
+          int delta = rand() % 1000;
+          scheduler.Txn(i).ReadStore(key1, -delta);
+          scheduler.Txn(i).Update(key1, TXN_STORED_VALUE);
+          scheduler.Txn(i).ReadStore(key2, delta);
+          scheduler.Txn(i).Update(key2, TXN_STORED_VALUE);
+        }
+        scheduler.Txn(i).Commit();
+      }
+      scheduler.Run();
+
+      ValidateMVCC_OldToNew(table.get());
+      ValidateIndex_NewestToOldest(table.get());
+    }
+  }
+
+  concurrency::TransactionManagerFactory::Configure(
+      CONCURRENCY_TYPE_OPTIMISTIC, ISOLATION_LEVEL_TYPE_FULL,
+      VERSION_ORDER_TYPE_O2N);
+}
+
+TEST_F(MVCCTest, RollbackSegmentDeltaTest) {
+  concurrency::TransactionManagerFactory::Configure(CONCURRENCY_TYPE_OCC_RB,
+                                                    ISOLATION_LEVEL_TYPE_FULL);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  std::unique_ptr<storage::DataTable> table(
+      TransactionTestsUtil::CreateTable());
+
+  // Txn 1 keeps reading its snapshot while txn 0 updates the same tuple
+  // several times
+  TransactionScheduler scheduler(2, table.get(), &txn_manager);
+  scheduler.Txn(1).Read(0);
+  scheduler.Txn(0).Update(0, 1);
+  scheduler.Txn(0).Update(0, 2);
+  scheduler.Txn(0).Update(0, 3);
+  scheduler.Txn(0).Commit();
+  scheduler.Txn(1).Read(0);
+  scheduler.Txn(1).Commit();
+
+  scheduler.Run();
+
+  EXPECT_EQ(RESULT_SUCCESS, scheduler.schedules[0].txn_result);
+  EXPECT_EQ(0, scheduler.schedules[1].results[0]);
+  EXPECT_EQ(0, scheduler.schedules[1].results[1]);
+
+  // The master version is updated in place and the transaction saved the
+  // before image of the value column once. Reading a tile checks the
+  // rollback segments against the current transaction.
+  txn_manager.BeginTransaction();
+  auto tile_group = table->GetTileGroup(0);
+  EXPECT_EQ(3, tile_group->GetValue(0, 1).GetIntegerForTestsOnly());
+
+  auto &rb_txn_manager = concurrency::OptimisticRbTxnManager::GetInstance();
+  auto rb_seg = rb_txn_manager.GetRbSeg(tile_group->GetHeader(), 0);
+  EXPECT_TRUE(rb_seg != nullptr);
+  EXPECT_EQ(1, storage::RollbackSegmentPool::GetColCount(rb_seg));
+  EXPECT_TRUE(storage::RollbackSegmentPool::GetNextPtr(rb_seg) == nullptr);
+  txn_manager.CommitTransaction();
+
+  concurrency::TransactionManagerFactory::Configure(
+      CONCURRENCY_TYPE_OPTIMISTIC, ISOLATION_LEVEL_TYPE_FULL,
+      VERSION_ORDER_TYPE_O2N);
+}
+
 }  // End test namespace
 }  // End peloton namespace
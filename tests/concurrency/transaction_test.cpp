@@ -230,5 +230,238 @@ TEST_F(TransactionTests, AbortTest) {
   }
 }
 
+TEST_F(TransactionTests, ReadOnlyTransactionTest) {
+  for (auto test_type : TEST_TYPES) {
+    concurrency::TransactionManagerFactory::Configure(test_type);
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    std::unique_ptr<storage::DataTable> table(
+        TransactionTestsUtil::CreateTable());
+    {
+      TransactionScheduler scheduler(1, table.get(), &txn_manager);
+      scheduler.Txn(0).Update(0, 1);
+      scheduler.Txn(0).Commit();
+
+      scheduler.Run();
+
+      EXPECT_EQ(RESULT_SUCCESS, scheduler.schedules[0].txn_result);
+    }
+
+    // the snapshot is the last committed cid, the counter does not advance
+    cid_t next_cid = txn_manager.GetCurrentCommitId();
+    auto txn = txn_manager.BeginReadOnlyTransaction();
+    EXPECT_TRUE(txn->IsDeclaredReadOnly());
+    if (test_type != CONCURRENCY_TYPE_SSI) {
+      EXPECT_EQ(next_cid - 1, txn->GetBeginCommitId());
+      EXPECT_EQ(next_cid, txn_manager.GetCurrentCommitId());
+    }
+
+    // a writer is not held up by the snapshot, nor is it seen
+    {
+      TransactionScheduler scheduler(1, table.get(), &txn_manager);
+      scheduler.Txn(0).Update(0, 2);
+      scheduler.Txn(0).Commit();
+
+      scheduler.Run();
+
+      EXPECT_EQ(RESULT_SUCCESS, scheduler.schedules[0].txn_result);
+    }
+
+    int result;
+    EXPECT_TRUE(TransactionTestsUtil::ExecuteRead(txn, table.get(), 0, result));
+    EXPECT_EQ(1, result);
+    EXPECT_TRUE(txn->GetRWSet().empty());
+    EXPECT_EQ(RESULT_SUCCESS, txn_manager.CommitTransaction());
+  }
+
+  // with epoch timestamps the snapshot holds the earlier epochs
+  concurrency::TransactionManagerFactory::Configure(
+      CONCURRENCY_TYPE_OPTIMISTIC, ISOLATION_LEVEL_TYPE_FULL,
+      VERSION_ORDER_TYPE_O2N, TIMESTAMP_TYPE_EPOCH);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  std::unique_ptr<storage::DataTable> table(
+      TransactionTestsUtil::CreateTable());
+  // the scheduler thread sees the loaded tuples once their epoch is over
+  std::this_thread::sleep_for(std::chrono::milliseconds(3 * EPOCH_LENGTH));
+  {
+    TransactionScheduler scheduler(1, table.get(), &txn_manager);
+    scheduler.Txn(0).Update(0, 1);
+    scheduler.Txn(0).Commit();
+
+    scheduler.Run();
+
+    EXPECT_EQ(RESULT_SUCCESS, scheduler.schedules[0].txn_result);
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(3 * EPOCH_LENGTH));
+
+  auto txn = txn_manager.BeginReadOnlyTransaction();
+  EXPECT_GE(txn_manager.GetCurrentCommitId(), txn->GetBeginCommitId() + 1);
+  int result;
+  EXPECT_TRUE(TransactionTestsUtil::ExecuteRead(txn, table.get(), 0, result));
+  EXPECT_EQ(1, result);
+  EXPECT_EQ(RESULT_SUCCESS, txn_manager.CommitTransaction());
+  concurrency::TransactionManagerFactory::Configure(CONCURRENCY_TYPE_OPTIMISTIC);
+}
+
+// Commits of other workers are visible once their epoch is over
+static void WaitForNextEpochs() {
+  std::this_thread::sleep_for(std::chrono::milliseconds(3 * EPOCH_LENGTH));
+}
+
+TEST_F(TransactionTests, EpochTimestampTest) {
+  std::vector<ConcurrencyType> epoch_types = {
+      CONCURRENCY_TYPE_OPTIMISTIC, CONCURRENCY_TYPE_PESSIMISTIC,
+      CONCURRENCY_TYPE_EAGER_WRITE, CONCURRENCY_TYPE_OCC_RB};
+
+  for (auto test_type : epoch_types) {
+    concurrency::TransactionManagerFactory::Configure(
+        test_type, ISOLATION_LEVEL_TYPE_FULL, VERSION_ORDER_TYPE_O2N,
+        TIMESTAMP_TYPE_EPOCH);
+    EXPECT_EQ(TIMESTAMP_TYPE_EPOCH,
+              concurrency::TransactionManagerFactory::GetTimestampType());
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+    // The commit ids of a worker grow, and its next snapshot holds them
+    cid_t lower_bound = txn_manager.GetCurrentCommitId();
+    cid_t first_cid = txn_manager.GetNextCommitId();
+    cid_t second_cid = txn_manager.GetNextCommitId();
+    EXPECT_LE(lower_bound, first_cid);
+    EXPECT_LT(first_cid, second_cid);
+    size_t epoch_id;
+    cid_t begin_cid = txn_manager.GetNextBeginCommitId(epoch_id);
+    EXPECT_GE(begin_cid, second_cid);
+    concurrency::EpochManagerFactory::GetInstance().ExitEpoch(epoch_id);
+
+    std::unique_ptr<storage::DataTable> table(
+        TransactionTestsUtil::CreateTable());
+    WaitForNextEpochs();
+    {
+      TransactionScheduler scheduler(1, table.get(), &txn_manager);
+      scheduler.Txn(0).Update(0, 1);
+      scheduler.Txn(0).Read(0);
+      scheduler.Txn(0).Commit();
+
+      scheduler.Run();
+
+      EXPECT_EQ(RESULT_SUCCESS, scheduler.schedules[0].txn_result);
+      EXPECT_EQ(1, scheduler.schedules[0].results[0]);
+    }
+    WaitForNextEpochs();
+    {
+      TransactionScheduler scheduler(1, table.get(), &txn_manager);
+      scheduler.Txn(0).Read(0);
+      scheduler.Txn(0).Commit();
+
+      scheduler.Run();
+
+      EXPECT_EQ(RESULT_SUCCESS, scheduler.schedules[0].txn_result);
+      EXPECT_EQ(1, scheduler.schedules[0].results[0]);
+    }
+
+    LaunchParallelTest(8, TransactionTest, &txn_manager);
+  }
+
+  // the protocols ordered by their begin cids keep the global counter
+  concurrency::TransactionManagerFactory::Configure(
+      CONCURRENCY_TYPE_TO, ISOLATION_LEVEL_TYPE_FULL, VERSION_ORDER_TYPE_O2N,
+      TIMESTAMP_TYPE_EPOCH);
+  EXPECT_EQ(TIMESTAMP_TYPE_GLOBAL,
+            concurrency::TransactionManagerFactory::GetTimestampType());
+  concurrency::TransactionManagerFactory::Configure(CONCURRENCY_TYPE_OPTIMISTIC);
+}
+
+TEST_F(TransactionTests, EpochManagerTest) {
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  // the transactions of the earlier tests are dead
+  WaitForNextEpochs();
+  cid_t base_cid = epoch_manager.GetMaxDeadTxnCid();
+
+  // A transaction enters an epoch but draws its begin cid only after a
+  // transaction of a later epoch did
+  auto early_epoch = epoch_manager.EnterCurrentEpoch();
+  WaitForNextEpochs();
+
+  std::atomic<int> step(0);
+  std::thread late_thread([&] {
+    auto late_epoch = epoch_manager.EnterCurrentEpoch();
+    epoch_manager.SetEpochMaxCid(late_epoch, base_cid + 10);
+    step = 1;
+    while (step != 2) {
+      std::this_thread::yield();
+    }
+    epoch_manager.ExitEpoch(late_epoch);
+  });
+  while (step != 1) {
+    std::this_thread::yield();
+  }
+
+  // the slot is pending while the early transaction draws its begin cid
+  EXPECT_EQ(base_cid, epoch_manager.GetMaxDeadTxnCid());
+  epoch_manager.SetEpochMaxCid(early_epoch, base_cid + 20);
+  epoch_manager.ExitEpoch(early_epoch);
+  WaitForNextEpochs();
+
+  // the early epoch is dead, its cid is bounded by the running transaction
+  EXPECT_EQ(base_cid + 9, epoch_manager.GetMaxDeadTxnCid());
+
+  step = 2;
+  late_thread.join();
+  WaitForNextEpochs();
+  EXPECT_EQ(base_cid + 20, epoch_manager.GetMaxDeadTxnCid());
+}
+
+TEST_F(TransactionTests, ReadWriteSetTest) {
+  std::unique_ptr<storage::DataTable> table(
+      TransactionTestsUtil::CreateTable());
+  auto tile_group = table->GetTileGroup(0);
+  auto tile_group_header = tile_group->GetHeader();
+  oid_t tile_group_id = tile_group->GetTileGroupId();
+
+  // slots 0 and 1 hold committed tuples, slot 20 is not taken yet
+  ItemPointer updated(tile_group_id, 0);
+  ItemPointer read(tile_group_id, 1);
+  ItemPointer inserted(tile_group_id, 20);
+
+  concurrency::Transaction txn(START_TXN_ID, START_CID);
+  txn.RecordInsert(inserted, tile_group_header);
+  txn.RecordRead(read, tile_group_header);
+  txn.RecordRead(updated);
+  txn.RecordRead(read);
+  txn.RecordUpdate(updated, tile_group_header);
+  txn.RecordRead(inserted, tile_group_header);
+
+  EXPECT_FALSE(txn.IsReadOnly());
+  EXPECT_TRUE(txn.IsAccessed(read));
+  EXPECT_TRUE(txn.IsAccessed(inserted));
+  EXPECT_FALSE(txn.IsAccessed(ItemPointer(tile_group_id, 2)));
+
+  // the accesses to a tuple are merged, in the order of the slots
+  auto &rw_set = txn.GetRWSet();
+  EXPECT_EQ(3, rw_set.size());
+  EXPECT_EQ(0, rw_set[0].tuple_slot);
+  EXPECT_EQ(concurrency::RW_TYPE_UPDATE, rw_set[0].type);
+  EXPECT_EQ(1, rw_set[1].tuple_slot);
+  EXPECT_EQ(concurrency::RW_TYPE_READ, rw_set[1].type);
+  EXPECT_EQ(20, rw_set[2].tuple_slot);
+  EXPECT_EQ(concurrency::RW_TYPE_INSERT, rw_set[2].type);
+  for (auto &entry : rw_set) {
+    EXPECT_EQ(tile_group_id, entry.tile_group_id);
+    EXPECT_EQ(tile_group_header, entry.tile_group_header);
+  }
+
+  // deleting its own insert leaves nothing to install
+  EXPECT_TRUE(txn.RecordDelete(inserted, tile_group_header));
+  EXPECT_FALSE(txn.RecordDelete(updated, tile_group_header));
+  EXPECT_TRUE(txn.IsAccessed(inserted));
+  EXPECT_EQ(3, txn.GetRWSet().size());
+  EXPECT_EQ(concurrency::RW_TYPE_DELETE, txn.GetRWSet()[0].type);
+  EXPECT_EQ(concurrency::RW_TYPE_INS_DEL, txn.GetRWSet()[2].type);
+
+  // a reused transaction starts over
+  txn.Reset(START_TXN_ID + 1, START_CID + 1, false);
+  EXPECT_TRUE(txn.IsReadOnly());
+  EXPECT_TRUE(txn.GetRWSet().empty());
+  EXPECT_FALSE(txn.IsAccessed(read));
+}
+
 }  // End test namespace
 }  // End peloton namespace
@@ -0,0 +1,139 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// hash_table_test.cpp
+//
+// Identification: tests/executor/hash_table_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "harness.h"
+
+#include "backend/executor/hash_table.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Hash Table Tests
+//===--------------------------------------------------------------------===//
+
+class HashTableTests : public PelotonTest {};
+
+// Sends every key to the same slot, so that all of them collide
+struct CollidingHasher {
+  size_t operator()(const int &key __attribute__((unused))) const {
+    return 42;
+  }
+};
+
+TEST_F(HashTableTests, FindOrInsertTest) {
+  executor::HashTable<int, int> hash_table;
+  const int key_count = 10000;
+
+  EXPECT_TRUE(hash_table.IsEmpty());
+  EXPECT_TRUE(hash_table.Find(1) == nullptr);
+
+  for (int key = 0; key < key_count; key++) {
+    auto entry = hash_table.FindOrInsert(key, hash_table.Hash(key));
+    EXPECT_TRUE(entry.second);
+    entry.first = key * 2;
+  }
+
+  for (int key = 0; key < key_count; key++) {
+    auto entry = hash_table.FindOrInsert(key, hash_table.Hash(key));
+    EXPECT_FALSE(entry.second);
+    EXPECT_EQ(key * 2, entry.first);
+    hash_table[key]++;
+  }
+
+  EXPECT_EQ((size_t)key_count, hash_table.GetSize());
+  for (int key = 0; key < key_count; key++) {
+    auto value = hash_table.Find(key);
+    ASSERT_TRUE(value != nullptr);
+    EXPECT_EQ(key * 2 + 1, *value);
+  }
+  EXPECT_TRUE(hash_table.Find(key_count) == nullptr);
+  EXPECT_TRUE(hash_table.Find(-1) == nullptr);
+}
+
+TEST_F(HashTableTests, CollisionTest) {
+  executor::HashTable<int, int, CollidingHasher> hash_table;
+  const int key_count = 500;
+
+  for (int key = 0; key < key_count; key += 2) {
+    hash_table[key] = key;
+  }
+
+  for (int key = 0; key < key_count; key++) {
+    auto value = hash_table.Find(key);
+    if (key % 2 == 0) {
+      ASSERT_TRUE(value != nullptr);
+      EXPECT_EQ(key, *value);
+    } else {
+      EXPECT_TRUE(value == nullptr);
+    }
+  }
+}
+
+TEST_F(HashTableTests, StableEntriesTest) {
+  executor::HashTable<std::string, std::vector<int>> hash_table;
+  const int key_count = 5000;
+
+  // Values don't move while the table grows
+  std::vector<std::vector<int> *> values;
+  for (int key = 0; key < key_count; key++) {
+    auto &value = hash_table[std::to_string(key)];
+    value.push_back(key);
+    values.push_back(&value);
+  }
+
+  for (int key = 0; key < key_count; key++) {
+    EXPECT_EQ(values[key], hash_table.Find(std::to_string(key)));
+    EXPECT_EQ(key, values[key]->front());
+  }
+
+  // Entries are visited in insertion order
+  int key = 0;
+  for (auto &entry : hash_table) {
+    EXPECT_EQ(std::to_string(key), entry.key);
+    EXPECT_EQ(key, entry.value.front());
+    EXPECT_EQ(&entry, hash_table.FindEntry(entry.key));
+    key++;
+  }
+  EXPECT_EQ(key_count, key);
+  EXPECT_GT(hash_table.GetMemoryFootprint(), key_count * sizeof(std::string));
+}
+
+TEST_F(HashTableTests, DestructionTest) {
+  auto counter = std::make_shared<int>(0);
+
+  {
+    executor::HashTable<int, std::shared_ptr<int>> hash_table;
+    hash_table.Reserve(100);
+    for (int key = 0; key < 1000; key++) {
+      hash_table[key] = counter;
+    }
+    EXPECT_EQ(1001, counter.use_count());
+
+    // Moving the table hands over its entries
+    std::vector<executor::HashTable<int, std::shared_ptr<int>>> hash_tables;
+    hash_tables.push_back(std::move(hash_table));
+    EXPECT_TRUE(hash_table.IsEmpty());
+    EXPECT_EQ((size_t)1000, hash_tables[0].GetSize());
+    EXPECT_EQ(1001, counter.use_count());
+  }
+
+  // The values are destroyed along with the table
+  EXPECT_EQ(1, counter.use_count());
+}
+
+}  // End test namespace
+}  // End peloton namespace
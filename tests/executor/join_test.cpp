@@ -198,6 +198,23 @@ TEST_F(JoinTests, JoinPredicateTest) {
   }
 }
 
+TEST_F(JoinTests, ParallelHashJoinTest) {
+  // Build and probe the hash table with several workers
+  DEFAULT_QUERY_PARALLELISM = 4;
+
+  // Go over all join types
+  for (auto join_type : join_types) {
+    LOG_INFO("JOIN TYPE :: %d", join_type);
+    // Execute the join test
+    ExecuteJoinTest(PLAN_NODE_TYPE_HASHJOIN, join_type, BASIC_TEST);
+    ExecuteJoinTest(PLAN_NODE_TYPE_HASHJOIN, join_type, COMPLICATED_TEST);
+    ExecuteJoinTest(PLAN_NODE_TYPE_HASHJOIN, join_type, LEFT_TABLE_EMPTY);
+    ExecuteJoinTest(PLAN_NODE_TYPE_HASHJOIN, join_type, RIGHT_TABLE_EMPTY);
+  }
+
+  DEFAULT_QUERY_PARALLELISM = 1;
+}
+
 TEST_F(JoinTests, SpeedTest) {
   ExecuteJoinTest(PLAN_NODE_TYPE_HASHJOIN, JOIN_TYPE_OUTER, SPEED_TEST);
 
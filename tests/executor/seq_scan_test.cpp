@@ -167,6 +167,49 @@ expression::AbstractExpression *CreatePredicate(
   return predicate;
 }
 
+/**
+ * @brief Convenience method to create a predicate that matches the tuples
+ * in g_tuple_ids and can be evaluated a column at a time.
+ *
+ * The predicate is (a = 0) OR ((b >= 31) AND (b < 40.5) AND (32.0 >= c))
+ * over the first three columns of the table, matching tuples 0 and 3.
+ */
+expression::AbstractExpression *CreateVectorizablePredicate() {
+  auto a_equal = expression::ExpressionUtil::ComparisonFactory(
+      EXPRESSION_TYPE_COMPARE_EQUAL,
+      expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0, 0),
+      expression::ExpressionUtil::ConstantValueFactory(
+          ValueFactory::GetIntegerValue(0)));
+
+  auto b_greater = expression::ExpressionUtil::ComparisonFactory(
+      EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO,
+      expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0, 1),
+      expression::ExpressionUtil::ConstantValueFactory(
+          ValueFactory::GetIntegerValue(31)));
+
+  // Merged with the comparison above into a single range
+  auto b_less = expression::ExpressionUtil::ComparisonFactory(
+      EXPRESSION_TYPE_COMPARE_LESSTHAN,
+      expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0, 1),
+      expression::ExpressionUtil::ConstantValueFactory(
+          ValueFactory::GetDoubleValue(40.5)));
+
+  // Constant on the left side
+  auto c_less = expression::ExpressionUtil::ComparisonFactory(
+      EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO,
+      expression::ExpressionUtil::ConstantValueFactory(
+          ValueFactory::GetDoubleValue(32.0)),
+      expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_DOUBLE, 0, 2));
+
+  return expression::ExpressionUtil::ConjunctionFactory(
+      EXPRESSION_TYPE_CONJUNCTION_OR, a_equal,
+      expression::ExpressionUtil::ConjunctionFactory(
+          EXPRESSION_TYPE_CONJUNCTION_AND,
+          expression::ExpressionUtil::ConjunctionFactory(
+              EXPRESSION_TYPE_CONJUNCTION_AND, b_greater, b_less),
+          c_less));
+}
+
 /**
  * @brief Convenience method to extract next tile from executor.
  * @param executor Executor to be tested.
@@ -263,6 +306,70 @@ TEST_F(SeqScanTests, TwoTileGroupsWithPredicateTest) {
   txn_manager.CommitTransaction();
 }
 
+// Sequential scan of table with a predicate on fixed-width columns, that is
+// evaluated a column at a time.
+TEST_F(SeqScanTests, TwoTileGroupsWithVectorizedPredicateTest) {
+  // Create table.
+  std::unique_ptr<storage::DataTable> table(CreateTable());
+
+  // Column ids to be added to logical tile after scan.
+  std::vector<oid_t> column_ids({0, 1, 3});
+
+  // Create plan node.
+  planner::SeqScanPlan node(table.get(), CreateVectorizablePredicate(),
+                            column_ids);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  executor::SeqScanExecutor executor(&node, context.get());
+  RunTest(executor, table->GetTileGroupCount(), column_ids.size());
+
+  txn_manager.CommitTransaction();
+}
+
+// Sequential scan of table with predicate, with the tile groups scanned
+// by several workers.
+TEST_F(SeqScanTests, ParallelScanTest) {
+  // Create table.
+  std::unique_ptr<storage::DataTable> table(CreateTable());
+
+  // Column ids to be added to logical tile after scan.
+  std::vector<oid_t> column_ids({0, 1, 3});
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  // Both the tuple at a time and the vectorized predicates
+  planner::SeqScanPlan node(table.get(), CreatePredicate(g_tuple_ids),
+                            column_ids);
+  node.SetParallelism(4);
+
+  executor::SeqScanExecutor executor(&node, context.get());
+  RunTest(executor, table->GetTileGroupCount(), column_ids.size());
+
+  planner::SeqScanPlan vectorized_node(
+      table.get(), CreateVectorizablePredicate(), column_ids);
+  vectorized_node.SetParallelism(2);
+
+  executor::SeqScanExecutor vectorized_executor(&vectorized_node,
+                                                context.get());
+  RunTest(vectorized_executor, table->GetTileGroupCount(), column_ids.size());
+
+  // Stop before the end of the scan
+  executor::SeqScanExecutor stopped_executor(&node, context.get());
+  EXPECT_TRUE(stopped_executor.Init());
+  std::unique_ptr<executor::LogicalTile> result_tile(
+      GetNextTile(stopped_executor));
+  EXPECT_EQ(g_tuple_ids.size(), result_tile->GetTupleCount());
+
+  txn_manager.CommitTransaction();
+}
+
 // Sequential scan of logical tile with predicate.
 TEST_F(SeqScanTests, NonLeafNodePredicateTest) {
   // No table for this case as seq scan is not a leaf node.
@@ -0,0 +1,169 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// simd_filter_test.cpp
+//
+// Identification: tests/expression/simd_filter_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "harness.h"
+
+#include "backend/common/types.h"
+#include "backend/expression/simd_filter.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// SIMD Filter Tests
+//===--------------------------------------------------------------------===//
+
+class SimdFilterTests : public PelotonTest {};
+
+// Odd sizes exercise the scalar tail after the vector loop
+const oid_t column_length = 1001;
+
+std::vector<expression::SimdLevel> GetSimdLevels() {
+  std::vector<expression::SimdLevel> simd_levels;
+  auto detected_level = expression::SimdFilter::DetectSimdLevel();
+  for (int level = expression::SIMD_LEVEL_SCALAR; level <= detected_level;
+       level++) {
+    simd_levels.push_back(static_cast<expression::SimdLevel>(level));
+  }
+  return simd_levels;
+}
+
+template <typename ColumnType>
+std::vector<ColumnType> BuildIntegerColumn(const ColumnType null_value) {
+  std::vector<ColumnType> column;
+  for (oid_t tuple_itr = 0; tuple_itr < column_length; tuple_itr++) {
+    if (tuple_itr % 7 == 0) {
+      column.push_back(null_value);
+    } else {
+      column.push_back((ColumnType)(tuple_itr * 37 % 200) - 100);
+    }
+  }
+
+  // Extreme values next to the null sentinel
+  column[1] = std::numeric_limits<ColumnType>::max();
+  column[2] = null_value + 1;
+  return column;
+}
+
+template <typename ColumnType>
+void CheckIntegerRange(const std::vector<ColumnType> &column,
+                       const ColumnType lower, const ColumnType upper) {
+  for (auto simd_level : GetSimdLevels()) {
+    expression::SimdFilter::SetSimdLevel(simd_level);
+
+    for (oid_t begin : {0, 3}) {
+      std::vector<oid_t> positions(column_length);
+      auto position_count = expression::SimdFilter::FilterRange(
+          column.data(), begin, column_length, lower, upper, positions.data());
+      positions.resize(position_count);
+
+      std::vector<oid_t> expected_positions;
+      for (oid_t tuple_itr = begin; tuple_itr < column_length; tuple_itr++) {
+        if (column[tuple_itr] >= lower && column[tuple_itr] <= upper) {
+          expected_positions.push_back(tuple_itr);
+        }
+      }
+
+      EXPECT_EQ(expected_positions, positions);
+    }
+  }
+
+  expression::SimdFilter::SetSimdLevel(
+      expression::SimdFilter::DetectSimdLevel());
+}
+
+TEST_F(SimdFilterTests, IntegerRangeTest) {
+  auto column = BuildIntegerColumn<int32_t>(INT32_NULL);
+
+  CheckIntegerRange<int32_t>(column, -10, 10);
+  CheckIntegerRange<int32_t>(column, 5, 5);
+  CheckIntegerRange<int32_t>(column, 10, -10);
+  CheckIntegerRange<int32_t>(column, INT32_NULL + 1, 0);
+  CheckIntegerRange<int32_t>(column, 0, INT32_MAX);
+  CheckIntegerRange<int32_t>(column, INT32_NULL + 1, INT32_MAX);
+}
+
+TEST_F(SimdFilterTests, BigIntRangeTest) {
+  auto column = BuildIntegerColumn<int64_t>(INT64_NULL);
+
+  CheckIntegerRange<int64_t>(column, -10, 10);
+  CheckIntegerRange<int64_t>(column, -100, -100);
+  CheckIntegerRange<int64_t>(column, INT64_NULL + 1, 0);
+  CheckIntegerRange<int64_t>(column, 0, INT64_MAX);
+  CheckIntegerRange<int64_t>(column, INT64_NULL + 1, INT64_MAX);
+}
+
+TEST_F(SimdFilterTests, DoubleRangeTest) {
+  std::vector<double> column;
+  for (oid_t tuple_itr = 0; tuple_itr < column_length; tuple_itr++) {
+    if (tuple_itr % 7 == 0) {
+      column.push_back(DOUBLE_NULL);
+    } else if (tuple_itr % 11 == 0) {
+      column.push_back(std::nan(""));
+    } else {
+      column.push_back((tuple_itr * 37 % 200) / 4.0 - 25);
+    }
+  }
+  column[1] = std::numeric_limits<double>::infinity();
+  column[2] = -std::numeric_limits<double>::infinity();
+
+  std::vector<expression::RangeBoundType> bound_types = {
+      expression::RANGE_BOUND_NONE, expression::RANGE_BOUND_INCLUSIVE,
+      expression::RANGE_BOUND_EXCLUSIVE};
+  std::vector<std::pair<double, double>> bounds = {
+      {-2.5, 2.5}, {0.25, 0.25}, {10, -10}};
+
+  for (auto simd_level : GetSimdLevels()) {
+    expression::SimdFilter::SetSimdLevel(simd_level);
+
+    for (auto lower_type : bound_types) {
+      for (auto upper_type : bound_types) {
+        for (auto bound : bounds) {
+          std::vector<oid_t> positions(column_length);
+          auto position_count = expression::SimdFilter::FilterRange(
+              column.data(), 0, column_length, lower_type, bound.first,
+              upper_type, bound.second, positions.data());
+          positions.resize(position_count);
+
+          std::vector<oid_t> expected_positions;
+          for (oid_t tuple_itr = 0; tuple_itr < column_length; tuple_itr++) {
+            if (expression::SimdFilter::InRange(column[tuple_itr], lower_type,
+                                                bound.first, upper_type,
+                                                bound.second)) {
+              expected_positions.push_back(tuple_itr);
+            }
+          }
+
+          EXPECT_EQ(expected_positions, positions);
+        }
+      }
+    }
+  }
+
+  expression::SimdFilter::SetSimdLevel(
+      expression::SimdFilter::DetectSimdLevel());
+
+  // Null is outside of every range, NaN is below every lower bound
+  EXPECT_FALSE(expression::SimdFilter::InRange(
+      DOUBLE_NULL, expression::RANGE_BOUND_NONE, 0,
+      expression::RANGE_BOUND_NONE, 0));
+  EXPECT_FALSE(expression::SimdFilter::InRange(
+      std::nan(""), expression::RANGE_BOUND_INCLUSIVE, -1e300,
+      expression::RANGE_BOUND_NONE, 0));
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -10,6 +10,7 @@
 #include "concurrency/transaction_tests_util.h"
 #include "backend/gc/gc_manager.h"
 #include "backend/concurrency/epoch_manager.h"
+#include "backend/index/index.h"
 namespace peloton {
 
 namespace test {
@@ -152,6 +153,35 @@ TEST_F(GCTest, SimpleTest) {
 }
 
 
+// Reclaiming a version drops its index entries, the workers reclaim with
+// cooperative gc
+TEST_F(GCTest, IndexCleanupTest) {
+  std::unique_ptr<storage::DataTable> table(
+    TransactionTestsUtil::CreateTable(1, "TEST_TABLE", INVALID_OID, INVALID_OID, 1234, false));
+
+  auto index = table->GetIndex(0);
+  std::vector<ItemPointer> locations;
+  index->ScanAllKeys(locations);
+  EXPECT_EQ(1, locations.size());
+
+  // no gc thread, two queues taken in turns by the worker
+  gc::GCManager gc_manager(GC_TYPE_COOPERATIVE, 2);
+
+  auto tile_group_id = table->GetTileGroup(0)->GetTileGroupId();
+  gc_manager.RecycleTupleSlot(table->GetOid(), tile_group_id, 0, 0);
+
+  gc_manager.CooperativeGC();
+  gc_manager.CooperativeGC();
+
+  locations.clear();
+  index->ScanAllKeys(locations);
+  EXPECT_EQ(0, locations.size());
+
+  auto free_slot = gc_manager.ReturnFreeSlot(table->GetOid());
+  EXPECT_EQ(tile_group_id, free_slot.block);
+  EXPECT_EQ(0, free_slot.offset);
+}
+
 TEST_F(GCTest, StressTest) {
   concurrency::EpochManagerFactory::GetInstance().Reset();
 
@@ -36,14 +36,12 @@ ItemPointer item0(120, 5);
 ItemPointer item1(120, 7);
 ItemPointer item2(123, 19);
 
-index::Index *BuildIndex(const bool unique_keys) {
+index::Index *BuildIndex(const bool unique_keys,
+                         const IndexType index_type = INDEX_TYPE_BTREE) {
   // Build tuple and key schema
   std::vector<std::vector<std::string>> column_names;
   std::vector<catalog::Column> columns;
   std::vector<catalog::Schema *> schemas;
-  IndexType index_type = INDEX_TYPE_BTREE;
-  // FIXME: Try to use BWTREE
-  // index_type = INDEX_TYPE_BWTREE;
 
   catalog::Column column1(VALUE_TYPE_INTEGER, GetTypeSize(VALUE_TYPE_INTEGER),
                           "A", true);
@@ -644,5 +642,413 @@ TEST_F(IndexTests, NonUniqueKeyMultiThreadedStressTest2) {
   delete tuple_schema;
 }
 
+TEST_F(IndexTests, RangeScanTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::vector<ItemPointer> locations;
+
+  std::vector<IndexType> index_types = {INDEX_TYPE_BTREE, INDEX_TYPE_BWTREE,
+                                        INDEX_TYPE_BTREE_OLC};
+
+  for (auto index_type : index_types) {
+    // INDEX
+    std::unique_ptr<index::Index> index(BuildIndex(false, index_type));
+
+    std::unique_ptr<storage::Tuple> key(new storage::Tuple(key_schema, true));
+    key->SetValue(1, ValueFactory::GetStringValue("a"), pool);
+
+    for (oid_t key_itr = 0; key_itr < 100; key_itr++) {
+      key->SetValue(0, ValueFactory::GetIntegerValue(key_itr), pool);
+      index->InsertEntry(key.get(), ItemPointer(key_itr, 0));
+    }
+
+    std::vector<Value> values = {ValueFactory::GetIntegerValue(20),
+                                 ValueFactory::GetIntegerValue(29)};
+    std::vector<oid_t> key_column_ids = {0, 0};
+    std::vector<ExpressionType> inclusive = {
+        EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO,
+        EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO};
+    std::vector<ExpressionType> exclusive = {
+        EXPRESSION_TYPE_COMPARE_GREATERTHAN,
+        EXPRESSION_TYPE_COMPARE_LESSTHAN};
+
+    // FORWARD SCAN
+    index->Scan(values, key_column_ids, inclusive, SCAN_DIRECTION_TYPE_FORWARD,
+                locations);
+    EXPECT_EQ(locations.size(), 10);
+    for (oid_t location_itr = 0; location_itr < locations.size();
+         location_itr++) {
+      EXPECT_EQ(locations[location_itr].block, 20 + location_itr);
+    }
+    locations.clear();
+
+    index->Scan(values, key_column_ids, exclusive, SCAN_DIRECTION_TYPE_FORWARD,
+                locations);
+    EXPECT_EQ(locations.size(), 8);
+    EXPECT_EQ(locations.front().block, 21);
+    locations.clear();
+
+    // BACKWARD SCAN
+    index->Scan(values, key_column_ids, inclusive, SCAN_DIRECTION_TYPE_BACKWARD,
+                locations);
+    EXPECT_EQ(locations.size(), 10);
+    for (oid_t location_itr = 0; location_itr < locations.size();
+         location_itr++) {
+      EXPECT_EQ(locations[location_itr].block, 29 - location_itr);
+    }
+    locations.clear();
+
+    // LIMIT
+    index->Scan(values, key_column_ids, inclusive, SCAN_DIRECTION_TYPE_FORWARD,
+                locations, 3);
+    EXPECT_EQ(locations.size(), 3);
+    EXPECT_EQ(locations.back().block, 22);
+    locations.clear();
+
+    index->Scan(values, key_column_ids, inclusive, SCAN_DIRECTION_TYPE_BACKWARD,
+                locations, 3);
+    EXPECT_EQ(locations.size(), 3);
+    EXPECT_EQ(locations.back().block, 27);
+    locations.clear();
+
+    // Open ended ranges
+    index->Scan({ValueFactory::GetIntegerValue(95)}, {0},
+                {EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO},
+                SCAN_DIRECTION_TYPE_FORWARD, locations);
+    EXPECT_EQ(locations.size(), 5);
+    locations.clear();
+
+    index->Scan({ValueFactory::GetIntegerValue(5)}, {0},
+                {EXPRESSION_TYPE_COMPARE_LESSTHAN},
+                SCAN_DIRECTION_TYPE_BACKWARD, locations);
+    EXPECT_EQ(locations.size(), 5);
+    EXPECT_EQ(locations.front().block, 4);
+    locations.clear();
+
+    delete tuple_schema;
+  }
+}
+
+//===--------------------------------------------------------------------===//
+// BWTree Tests
+//===--------------------------------------------------------------------===//
+
+TEST_F(IndexTests, BWTreeBasicTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::vector<ItemPointer> locations;
+
+  // INDEX
+  std::unique_ptr<index::Index> index(BuildIndex(false, INDEX_TYPE_BWTREE));
+
+  std::unique_ptr<storage::Tuple> key0(new storage::Tuple(key_schema, true));
+
+  key0->SetValue(0, ValueFactory::GetIntegerValue(100), pool);
+  key0->SetValue(1, ValueFactory::GetStringValue("a"), pool);
+
+  // INSERT
+  index->InsertEntry(key0.get(), item0);
+
+  index->ScanKey(key0.get(), locations);
+  EXPECT_EQ(locations.size(), 1);
+  EXPECT_EQ(locations[0].block, item0.block);
+  locations.clear();
+
+  // DELETE
+  index->DeleteEntry(key0.get(), item0);
+
+  index->ScanKey(key0.get(), locations);
+  EXPECT_EQ(locations.size(), 0);
+  locations.clear();
+
+  delete tuple_schema;
+}
+
+TEST_F(IndexTests, BWTreeNonUniqueKeyMultiThreadedTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::vector<ItemPointer> locations;
+
+  // INDEX
+  std::unique_ptr<index::Index> index(BuildIndex(false, INDEX_TYPE_BWTREE));
+
+  // Parallel Test
+  size_t num_threads = 4;
+  size_t scale_factor = 1;
+  LaunchParallelTest(num_threads, InsertTest, index.get(), pool, scale_factor);
+
+  index->ScanAllKeys(locations);
+  EXPECT_EQ(locations.size(), 9 * num_threads);
+  locations.clear();
+
+  LaunchParallelTest(num_threads, DeleteTest, index.get(), pool, scale_factor);
+
+  // Checks
+  std::unique_ptr<storage::Tuple> key0(new storage::Tuple(key_schema, true));
+  std::unique_ptr<storage::Tuple> key1(new storage::Tuple(key_schema, true));
+  std::unique_ptr<storage::Tuple> key2(new storage::Tuple(key_schema, true));
+
+  key0->SetValue(0, ValueFactory::GetIntegerValue(100), pool);
+  key0->SetValue(1, ValueFactory::GetStringValue("a"), pool);
+  key1->SetValue(0, ValueFactory::GetIntegerValue(100), pool);
+  key1->SetValue(1, ValueFactory::GetStringValue("b"), pool);
+  key2->SetValue(0, ValueFactory::GetIntegerValue(100), pool);
+  key2->SetValue(1, ValueFactory::GetStringValue("c"), pool);
+
+  index->ScanKey(key0.get(), locations);
+  EXPECT_EQ(locations.size(), 0);
+  locations.clear();
+
+  index->ScanKey(key1.get(), locations);
+  EXPECT_EQ(locations.size(), 2 * num_threads);
+  locations.clear();
+
+  index->ScanKey(key2.get(), locations);
+  EXPECT_EQ(locations.size(), 1 * num_threads);
+  EXPECT_EQ(locations[0].block, item1.block);
+  locations.clear();
+
+  index->ScanAllKeys(locations);
+  EXPECT_EQ(locations.size(), 3 * num_threads);
+  locations.clear();
+
+  // FORWARD SCAN
+  index->Scan({key1->GetValue(0)}, {0}, {EXPRESSION_TYPE_COMPARE_EQUAL},
+              SCAN_DIRECTION_TYPE_FORWARD, locations);
+  EXPECT_EQ(locations.size(), 3 * num_threads);
+  locations.clear();
+
+  index->Scan(
+      {key1->GetValue(0), key1->GetValue(1)}, {0, 1},
+      {EXPRESSION_TYPE_COMPARE_EQUAL, EXPRESSION_TYPE_COMPARE_GREATERTHAN},
+      SCAN_DIRECTION_TYPE_FORWARD, locations);
+  EXPECT_EQ(locations.size(), 1 * num_threads);
+  locations.clear();
+
+  delete tuple_schema;
+}
+
+TEST_F(IndexTests, BWTreeMultiThreadedStressTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::vector<ItemPointer> locations;
+
+  // INDEX
+  std::unique_ptr<index::Index> index(BuildIndex(false, INDEX_TYPE_BWTREE));
+
+  // Parallel Test
+  // Enough keys to split and later merge leaf pages
+  size_t num_threads = 8;
+  size_t scale_factor = 200;
+  LaunchParallelTest(num_threads, InsertTest, index.get(), pool, scale_factor);
+
+  index->ScanAllKeys(locations);
+  EXPECT_EQ(locations.size(), 9 * num_threads * scale_factor);
+  locations.clear();
+
+  LaunchParallelTest(num_threads, DeleteTest, index.get(), pool, scale_factor);
+
+  index->ScanAllKeys(locations);
+  EXPECT_EQ(locations.size(), 3 * num_threads * scale_factor);
+  locations.clear();
+
+  std::unique_ptr<storage::Tuple> key1(new storage::Tuple(key_schema, true));
+  key1->SetValue(0, ValueFactory::GetIntegerValue(100 * scale_factor), pool);
+  key1->SetValue(1, ValueFactory::GetStringValue("b"), pool);
+
+  index->ScanKey(key1.get(), locations);
+  EXPECT_EQ(locations.size(), 2 * num_threads);
+  locations.clear();
+
+  // Reclaim whatever the consolidations left behind
+  index->Cleanup();
+
+  delete tuple_schema;
+}
+
+//===--------------------------------------------------------------------===//
+// B+tree OLC Tests
+//===--------------------------------------------------------------------===//
+
+TEST_F(IndexTests, BTreeOLCBasicTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::vector<ItemPointer> locations;
+
+  // INDEX
+  std::unique_ptr<index::Index> index(BuildIndex(false, INDEX_TYPE_BTREE_OLC));
+
+  std::unique_ptr<storage::Tuple> key0(new storage::Tuple(key_schema, true));
+
+  key0->SetValue(0, ValueFactory::GetIntegerValue(100), pool);
+  key0->SetValue(1, ValueFactory::GetStringValue("a"), pool);
+
+  // INSERT
+  index->InsertEntry(key0.get(), item0);
+
+  index->ScanKey(key0.get(), locations);
+  EXPECT_EQ(locations.size(), 1);
+  EXPECT_EQ(locations[0].block, item0.block);
+  locations.clear();
+
+  // DELETE
+  index->DeleteEntry(key0.get(), item0);
+
+  index->ScanKey(key0.get(), locations);
+  EXPECT_EQ(locations.size(), 0);
+  locations.clear();
+
+  delete tuple_schema;
+}
+
+TEST_F(IndexTests, BTreeOLCNonUniqueKeyMultiThreadedTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::vector<ItemPointer> locations;
+
+  // INDEX
+  std::unique_ptr<index::Index> index(BuildIndex(false, INDEX_TYPE_BTREE_OLC));
+
+  // Parallel Test
+  size_t num_threads = 4;
+  size_t scale_factor = 1;
+  LaunchParallelTest(num_threads, InsertTest, index.get(), pool, scale_factor);
+
+  index->ScanAllKeys(locations);
+  EXPECT_EQ(locations.size(), 9 * num_threads);
+  locations.clear();
+
+  LaunchParallelTest(num_threads, DeleteTest, index.get(), pool, scale_factor);
+
+  // Checks
+  std::unique_ptr<storage::Tuple> key0(new storage::Tuple(key_schema, true));
+  std::unique_ptr<storage::Tuple> key1(new storage::Tuple(key_schema, true));
+  std::unique_ptr<storage::Tuple> key2(new storage::Tuple(key_schema, true));
+
+  key0->SetValue(0, ValueFactory::GetIntegerValue(100), pool);
+  key0->SetValue(1, ValueFactory::GetStringValue("a"), pool);
+  key1->SetValue(0, ValueFactory::GetIntegerValue(100), pool);
+  key1->SetValue(1, ValueFactory::GetStringValue("b"), pool);
+  key2->SetValue(0, ValueFactory::GetIntegerValue(100), pool);
+  key2->SetValue(1, ValueFactory::GetStringValue("c"), pool);
+
+  index->ScanKey(key0.get(), locations);
+  EXPECT_EQ(locations.size(), 0);
+  locations.clear();
+
+  index->ScanKey(key1.get(), locations);
+  EXPECT_EQ(locations.size(), 2 * num_threads);
+  locations.clear();
+
+  index->ScanKey(key2.get(), locations);
+  EXPECT_EQ(locations.size(), 1 * num_threads);
+  EXPECT_EQ(locations[0].block, item1.block);
+  locations.clear();
+
+  index->ScanAllKeys(locations);
+  EXPECT_EQ(locations.size(), 3 * num_threads);
+  locations.clear();
+
+  // FORWARD SCAN
+  index->Scan({key1->GetValue(0)}, {0}, {EXPRESSION_TYPE_COMPARE_EQUAL},
+              SCAN_DIRECTION_TYPE_FORWARD, locations);
+  EXPECT_EQ(locations.size(), 3 * num_threads);
+  locations.clear();
+
+  index->Scan(
+      {key1->GetValue(0), key1->GetValue(1)}, {0, 1},
+      {EXPRESSION_TYPE_COMPARE_EQUAL, EXPRESSION_TYPE_COMPARE_GREATERTHAN},
+      SCAN_DIRECTION_TYPE_FORWARD, locations);
+  EXPECT_EQ(locations.size(), 1 * num_threads);
+  locations.clear();
+
+  delete tuple_schema;
+}
+
+TEST_F(IndexTests, BTreeOLCMultiThreadedStressTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::vector<ItemPointer> locations;
+
+  // INDEX
+  std::unique_ptr<index::Index> index(BuildIndex(false, INDEX_TYPE_BTREE_OLC));
+
+  // Parallel Test
+  // Enough keys to split leaf and inner nodes
+  size_t num_threads = 8;
+  size_t scale_factor = 200;
+  LaunchParallelTest(num_threads, InsertTest, index.get(), pool, scale_factor);
+
+  index->ScanAllKeys(locations);
+  EXPECT_EQ(locations.size(), 9 * num_threads * scale_factor);
+  locations.clear();
+
+  LaunchParallelTest(num_threads, DeleteTest, index.get(), pool, scale_factor);
+
+  index->ScanAllKeys(locations);
+  EXPECT_EQ(locations.size(), 3 * num_threads * scale_factor);
+  locations.clear();
+
+  std::unique_ptr<storage::Tuple> key1(new storage::Tuple(key_schema, true));
+  key1->SetValue(0, ValueFactory::GetIntegerValue(100 * scale_factor), pool);
+  key1->SetValue(1, ValueFactory::GetStringValue("b"), pool);
+
+  index->ScanKey(key1.get(), locations);
+  EXPECT_EQ(locations.size(), 2 * num_threads);
+  locations.clear();
+
+  delete tuple_schema;
+}
+
+TEST_F(IndexTests, BTreeOLCInPlaceUpdateTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::vector<ItemPointer> locations;
+  std::vector<ItemPointer *> location_ptrs;
+
+  // INDEX
+  std::unique_ptr<index::Index> index(BuildIndex(false, INDEX_TYPE_BTREE_OLC));
+
+  std::unique_ptr<storage::Tuple> key0(new storage::Tuple(key_schema, true));
+  std::unique_ptr<storage::Tuple> key1(new storage::Tuple(key_schema, true));
+
+  key0->SetValue(0, ValueFactory::GetIntegerValue(100), pool);
+  key0->SetValue(1, ValueFactory::GetStringValue("a"), pool);
+  key1->SetValue(0, ValueFactory::GetIntegerValue(100), pool);
+  key1->SetValue(1, ValueFactory::GetStringValue("b"), pool);
+
+  index->InsertEntry(key0.get(), item0);
+  index->InsertEntry(key1.get(), item1);
+
+  // The scan hands out the slots the item pointers are stored in
+  index->ScanKey(key0.get(), location_ptrs);
+  EXPECT_EQ(location_ptrs.size(), 1);
+  EXPECT_EQ(location_ptrs[0]->block, item0.block);
+  EXPECT_EQ(location_ptrs[0]->offset, item0.offset);
+
+  // Swing the entry to a newer version in place
+  EXPECT_FALSE(AtomicUpdateItemPointer(location_ptrs[0], item1, item2));
+  EXPECT_TRUE(AtomicUpdateItemPointer(location_ptrs[0], item0, item2));
+  location_ptrs.clear();
+
+  index->ScanKey(key0.get(), locations);
+  EXPECT_EQ(locations.size(), 1);
+  EXPECT_EQ(locations[0].block, item2.block);
+  EXPECT_EQ(locations[0].offset, item2.offset);
+  locations.clear();
+
+  // The other entry is untouched
+  index->ScanKey(key1.get(), locations);
+  EXPECT_EQ(locations.size(), 1);
+  EXPECT_EQ(locations[0].offset, item1.offset);
+  locations.clear();
+
+  // A removed entry can no longer be updated through its old slot
+  index->ScanAllKeys(location_ptrs);
+  EXPECT_EQ(location_ptrs.size(), 2);
+  index->DeleteEntry(key1.get(), item1);
+  EXPECT_FALSE(AtomicUpdateItemPointer(location_ptrs[1], item1, item0));
+  location_ptrs.clear();
+
+  index->ScanAllKeys(locations);
+  EXPECT_EQ(locations.size(), 1);
+  EXPECT_EQ(locations[0].offset, item2.offset);
+  locations.clear();
+
+  delete tuple_schema;
+}
+
 }  // End test namespace
 }  // End peloton namespace
\ No newline at end of file
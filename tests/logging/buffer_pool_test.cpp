@@ -12,6 +12,8 @@
 
 #include "harness.h"
 #include "backend/logging/circular_buffer_pool.h"
+#include "backend/concurrency/transaction_manager_factory.h"
+#include "backend/storage/table_factory.h"
 #include "logging/logging_tests_util.h"
 #include "executor/executor_tests_util.h"
 #include <stdlib.h>
@@ -155,6 +157,71 @@ TEST_F(BufferPoolTests, LargeTupleRecordTest) {
   EXPECT_EQ(success, true);
 }
 
+TEST_F(BufferPoolTests, InPlaceTupleRecordTest) {
+  size_t tile_group_size = TESTS_TUPLES_PER_TILEGROUP;
+
+  // the tuple records need the database of the table
+  catalog::Schema *table_schema = new catalog::Schema(
+      {ExecutorTestsUtil::GetColumnInfo(0), ExecutorTestsUtil::GetColumnInfo(1),
+       ExecutorTestsUtil::GetColumnInfo(2), ExecutorTestsUtil::GetColumnInfo(3)});
+  std::unique_ptr<storage::DataTable> table(storage::TableFactory::GetDataTable(
+      DEFAULT_DB_ID, INVALID_OID, table_schema, "TEST_TABLE",
+      tile_group_size, true, false));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), tile_group_size, false, false,
+                                   false);
+  txn_manager.CommitTransaction();
+
+  logging::WriteAheadBackendLogger backend_logger;
+  for (int i = 0; i < BUFFER_POOL_SIZE; i++) {
+    backend_logger.GrantEmptyBuffer(std::unique_ptr<logging::LogBuffer>(
+        new logging::LogBuffer(&backend_logger)));
+  }
+
+  // the records serialized in place must match the heap allocated ones
+  auto tile_group = table->GetTileGroup(0);
+  auto schema = table->GetSchema();
+  std::string expected;
+  for (oid_t tuple_slot = 0; tuple_slot < tile_group_size; tuple_slot++) {
+    cid_t commit_id = tuple_slot + 1;
+    ItemPointer location(tile_group->GetTileGroupId(), tuple_slot);
+    std::unique_ptr<storage::Tuple> tuple(new storage::Tuple(schema, true));
+    for (oid_t col = 0; col < schema->GetColumnCount(); col++) {
+      tuple->SetValue(col, tile_group->GetValue(tuple_slot, col),
+                      backend_logger.GetVarlenPool());
+    }
+
+    logging::TupleRecord insert_record(
+        LOGRECORD_TYPE_WAL_TUPLE_INSERT, commit_id, table->GetOid(), location,
+        INVALID_ITEMPOINTER, tuple.get(), tile_group->GetDatabaseId());
+    CopySerializeOutput output_buffer;
+    insert_record.Serialize(output_buffer);
+    expected.append(insert_record.GetMessage(),
+                    insert_record.GetMessageLength());
+    backend_logger.LogTuple(LOGRECORD_TYPE_TUPLE_INSERT, commit_id,
+                            tile_group.get(), location, INVALID_ITEMPOINTER);
+
+    logging::TupleRecord delete_record(
+        LOGRECORD_TYPE_WAL_TUPLE_DELETE, commit_id, table->GetOid(),
+        INVALID_ITEMPOINTER, location, nullptr, tile_group->GetDatabaseId());
+    delete_record.Serialize(output_buffer);
+    expected.append(delete_record.GetMessage(),
+                    delete_record.GetMessageLength());
+    backend_logger.LogTuple(LOGRECORD_TYPE_TUPLE_DELETE, commit_id,
+                            tile_group.get(), INVALID_ITEMPOINTER, location);
+  }
+
+  std::vector<std::unique_ptr<logging::LogBuffer>> log_buffers;
+  backend_logger.PrepareLogBuffers(log_buffers);
+  std::string logged;
+  for (auto &log_buffer : log_buffers) {
+    logged.append(log_buffer->GetData(), log_buffer->GetSize());
+  }
+  EXPECT_EQ(logged, expected);
+}
+
 TEST_F(BufferPoolTests, BufferPoolConcurrentTest) {
   unsigned int txn_count = 9999;
 
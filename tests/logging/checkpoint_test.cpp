@@ -15,6 +15,7 @@
 #include "backend/logging/logging_util.h"
 #include "backend/logging/loggers/wal_backend_logger.h"
 #include "backend/logging/checkpoint/simple_checkpoint.h"
+#include "backend/logging/checkpoint/image_checkpoint.h"
 #include "backend/bridge/dml/mapper/mapper.h"
 
 #include "backend/concurrency/transaction_manager_factory.h"
@@ -111,6 +112,98 @@ TEST_F(CheckpointTests, CheckpointIntegrationTest) {
   logging::LoggingUtil::RemoveDirectory("pl_checkpoint", false);
 }
 
+TEST_F(CheckpointTests, ImageCheckpointTest) {
+  logging::LoggingUtil::RemoveDirectory("pl_checkpoint", false);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.BeginTransaction();
+
+  size_t tile_group_size = TESTS_TUPLES_PER_TILEGROUP;
+  size_t table_tile_group_count = 3;
+
+  oid_t default_table_oid = 14;
+  storage::DataTable *target_table =
+      ExecutorTestsUtil::CreateTable(tile_group_size, false, default_table_oid);
+  ExecutorTestsUtil::PopulateTable(target_table,
+                                   tile_group_size * table_tile_group_count,
+                                   false, false, false);
+  txn_manager.CommitTransaction();
+
+  std::vector<oid_t> tile_group_ids;
+  for (oid_t tile_group_itr = 0; tile_group_itr < table_tile_group_count;
+       tile_group_itr++) {
+    tile_group_ids.push_back(
+        target_table->GetTileGroup(tile_group_itr)->GetTileGroupId());
+  }
+
+  auto &catalog_manager = catalog::Manager::GetInstance();
+  storage::Database *db(new storage::Database(DEFAULT_DB_ID));
+  db->AddTable(target_table);
+  catalog_manager.AddDatabase(db);
+
+  // create checkpoint
+  auto &checkpoint_manager = logging::CheckpointManager::GetInstance();
+  auto &log_manager = logging::LogManager::GetInstance();
+  log_manager.SetGlobalMaxFlushedCommitId(txn_manager.GetNextCommitId());
+  checkpoint_manager.Configure(CHECKPOINT_TYPE_IMAGE, false, 1);
+  checkpoint_manager.SetCheckpointParallelism(2);
+  checkpoint_manager.DestroyCheckpointers();
+  checkpoint_manager.InitCheckpointers();
+  auto checkpointer = reinterpret_cast<logging::ImageCheckpoint *>(
+      checkpoint_manager.GetCheckpointer(0));
+
+  checkpointer->DoCheckpoint();
+  EXPECT_EQ(checkpointer->GetTupleCount(),
+            tile_group_size * table_tile_group_count);
+
+  // restart with an empty table
+  catalog_manager.DropDatabaseWithOid(DEFAULT_DB_ID);
+  db = new storage::Database(DEFAULT_DB_ID);
+  db->AddTable(
+      ExecutorTestsUtil::CreateTable(tile_group_size, false, default_table_oid));
+  catalog_manager.AddDatabase(db);
+
+  checkpoint_manager.DestroyCheckpointers();
+  checkpoint_manager.InitCheckpointers();
+  auto recovery_checkpointer = reinterpret_cast<logging::ImageCheckpoint *>(
+      checkpoint_manager.GetCheckpointer(0));
+  recovery_checkpointer->DoRecovery();
+
+  // the tile groups are restored with their tuples in place
+  auto recovered_table = db->GetTableWithOid(default_table_oid);
+  EXPECT_EQ(recovery_checkpointer->GetTupleCount(),
+            tile_group_size * table_tile_group_count);
+  EXPECT_EQ(recovered_table->GetNumberOfTuples(),
+            tile_group_size * table_tile_group_count);
+
+  txn_manager.BeginTransaction();
+  for (oid_t tile_group_itr = 0; tile_group_itr < table_tile_group_count;
+       tile_group_itr++) {
+    auto tile_group = catalog_manager.GetTileGroup(tile_group_ids[tile_group_itr]);
+    ASSERT_TRUE(tile_group != nullptr);
+    EXPECT_EQ(tile_group->GetTableId(), default_table_oid);
+
+    for (oid_t tuple_slot = 0; tuple_slot < tile_group_size; tuple_slot++) {
+      oid_t row = tile_group_itr * tile_group_size + tuple_slot;
+      EXPECT_EQ(tile_group->GetHeader()->GetEndCommitId(tuple_slot), MAX_CID);
+      EXPECT_EQ(tile_group->GetValue(tuple_slot, 0).Compare(
+                    ValueFactory::GetIntegerValue(
+                        ExecutorTestsUtil::PopulatedValue(row, 0))),
+                VALUE_COMPARE_EQUAL);
+      EXPECT_EQ(tile_group->GetValue(tuple_slot, 3).Compare(
+                    ValueFactory::GetStringValue(std::to_string(
+                        ExecutorTestsUtil::PopulatedValue(row, 3)))),
+                VALUE_COMPARE_EQUAL);
+    }
+  }
+  txn_manager.CommitTransaction();
+
+  checkpoint_manager.SetCheckpointParallelism(1);
+  checkpoint_manager.Configure(CHECKPOINT_TYPE_NORMAL, false, 1);
+  checkpoint_manager.DestroyCheckpointers();
+  catalog_manager.DropDatabaseWithOid(DEFAULT_DB_ID);
+  logging::LoggingUtil::RemoveDirectory("pl_checkpoint", false);
+}
+
 TEST_F(CheckpointTests, CheckpointScanTest) {
   logging::LoggingUtil::RemoveDirectory("pl_checkpoint", false);
 
@@ -146,17 +239,12 @@ TEST_F(CheckpointTests, CheckpointScanTest) {
   auto simple_checkpointer =
       reinterpret_cast<logging::SimpleCheckpoint *>(checkpointer);
 
-  simple_checkpointer->SetLogger(new logging::WriteAheadBackendLogger());
   simple_checkpointer->SetStartCommitId(cid);
   simple_checkpointer->Scan(target_table.get(), DEFAULT_DB_ID);
 
   // verify results
-  auto records = simple_checkpointer->GetRecords();
-  EXPECT_EQ(records.size(),
+  EXPECT_EQ(simple_checkpointer->GetTupleCount(),
             TESTS_TUPLES_PER_TILEGROUP * table_tile_group_count);
-  for (unsigned int i = 0; i < records.size(); i++) {
-    EXPECT_EQ(records[i]->GetType(), LOGRECORD_TYPE_WAL_TUPLE_INSERT);
-  }
 }
 
 
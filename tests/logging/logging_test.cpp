@@ -314,6 +314,47 @@ TEST_F(LoggingTests, InsertUpdateDeleteTest) {
   scheduler.Cleanup();
 }
 
+TEST_F(LoggingTests, GroupCommitTest) {
+  std::unique_ptr<storage::DataTable> table(ExecutorTestsUtil::CreateTable(1));
+
+  auto &log_manager = logging::LogManager::GetInstance();
+
+  LoggingScheduler scheduler(2, 1, &log_manager, table.get());
+
+  scheduler.Init();
+  // Both commits are collected before the flush, they share one fsync
+  scheduler.BackendLogger(0, 0).Prepare();
+  scheduler.BackendLogger(0, 0).Begin(2);
+  scheduler.BackendLogger(0, 0).Insert(2);
+  scheduler.BackendLogger(0, 0).Commit(2);
+  scheduler.BackendLogger(0, 1).Prepare();
+  scheduler.BackendLogger(0, 1).Begin(3);
+  scheduler.BackendLogger(0, 1).Insert(3);
+  scheduler.BackendLogger(0, 1).Commit(3);
+  scheduler.FrontendLogger(0).Collect();
+  scheduler.FrontendLogger(0).Flush();
+  // A lone commit makes a group of its own
+  scheduler.BackendLogger(0, 0).Prepare();
+  scheduler.BackendLogger(0, 0).Begin(4);
+  scheduler.BackendLogger(0, 0).Insert(4);
+  scheduler.BackendLogger(0, 0).Commit(4);
+  scheduler.FrontendLogger(0).Collect();
+  scheduler.FrontendLogger(0).Flush();
+  scheduler.BackendLogger(0, 0).Done(1);
+  scheduler.BackendLogger(0, 1).Done(1);
+  scheduler.Run();
+
+  auto results = scheduler.frontend_threads[0].results;
+  EXPECT_EQ(3, results[0]);
+  EXPECT_EQ(4, results[1]);
+
+  auto frontend_logger = log_manager.GetFrontendLogger(0);
+  EXPECT_EQ(2, frontend_logger->GetFsyncCount());
+  EXPECT_EQ(3, frontend_logger->GetFlushedCommitCount());
+  EXPECT_DOUBLE_EQ(1.5, frontend_logger->GetCommitsPerFsync());
+  scheduler.Cleanup();
+}
+
 TEST_F(LoggingTests, BasicLogManagerTest) {
   peloton_logging_mode = LOGGING_TYPE_INVALID;
   auto &log_manager = logging::LogManager::GetInstance();
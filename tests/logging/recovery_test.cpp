@@ -24,6 +24,7 @@
 #include "backend/logging/loggers/wal_frontend_logger.h"
 #include "backend/storage/table_factory.h"
 #include "backend/logging/log_manager.h"
+#include "backend/logging/log_block.h"
 #include "backend/index/index.h"
 
 #include "backend/logging/logging_util.h"
@@ -97,6 +98,439 @@ std::vector<storage::Tuple *> BuildLoggingTuples(storage::DataTable *table,
   return tuples;
 }
 
+// Write a log record to the log file
+static void WriteLogRecord(logging::LogRecord &record, FILE *fp) {
+  CopySerializeOutput output_buffer;
+  record.Serialize(output_buffer);
+  fwrite(record.GetMessage(), sizeof(char), record.GetMessageLength(), fp);
+}
+
+TEST_F(RecoveryTests, ParallelRecoveryTest) {
+  auto &manager = catalog::Manager::GetInstance();
+  auto &log_manager = logging::LogManager::GetInstance();
+  std::string dir_name = logging::WriteAheadFrontendLogger::wal_directory_path;
+  const int num_rows = 5;
+
+  // The records of two tables are replayed by different workers. The
+  // database is dropped at the end, the index recovery goes over every
+  // database of the catalog.
+  auto table_a = ExecutorTestsUtil::CreateTable(1024, true, 1001);
+  auto table_b = ExecutorTestsUtil::CreateTable(1024, true, 1002);
+  storage::Database *db = new storage::Database(DEFAULT_DB_ID);
+  manager.AddDatabase(db);
+  db->AddTable(table_a);
+  db->AddTable(table_b);
+
+  auto tuples_a =
+      LoggingTestsUtil::BuildTuples(table_a, num_rows + 2, false, false);
+  auto tuples_b = LoggingTestsUtil::BuildTuples(table_b, num_rows, false, false);
+
+  logging::LoggingUtil::RemoveDirectory(dir_name.c_str(), false);
+  auto status = logging::LoggingUtil::CreateDirectory(dir_name.c_str(), 0700);
+  EXPECT_EQ(status, true);
+  log_manager.SetLogDirectoryName("./");
+
+  std::string file_name = dir_name + "/" + std::string("peloton_log_0.log");
+  FILE *fp = fopen(file_name.c_str(), "wb");
+  cid_t default_commit_id = INVALID_CID;
+  cid_t default_delimiter = INVALID_CID;
+  fwrite((void *)&default_commit_id, sizeof(default_commit_id), 1, fp);
+  fwrite((void *)&default_delimiter, sizeof(default_delimiter), 1, fp);
+
+  // txn 2 inserts into both tables
+  logging::TransactionRecord begin_2(LOGRECORD_TYPE_TRANSACTION_BEGIN, 2);
+  WriteLogRecord(begin_2, fp);
+  for (int i = 0; i < num_rows; i++) {
+    logging::TupleRecord insert_a(LOGRECORD_TYPE_WAL_TUPLE_INSERT, 2,
+                                  table_a->GetOid(), ItemPointer(1001, i),
+                                  INVALID_ITEMPOINTER, tuples_a[i].get(),
+                                  DEFAULT_DB_ID);
+    WriteLogRecord(insert_a, fp);
+    logging::TupleRecord insert_b(LOGRECORD_TYPE_WAL_TUPLE_INSERT, 2,
+                                  table_b->GetOid(), ItemPointer(2001, i),
+                                  INVALID_ITEMPOINTER, tuples_b[i].get(),
+                                  DEFAULT_DB_ID);
+    WriteLogRecord(insert_b, fp);
+  }
+  logging::TransactionRecord commit_2(LOGRECORD_TYPE_TRANSACTION_COMMIT, 2);
+  WriteLogRecord(commit_2, fp);
+  logging::TransactionRecord delimiter_2(LOGRECORD_TYPE_ITERATION_DELIMITER, 2);
+  WriteLogRecord(delimiter_2, fp);
+
+  // txn 3 updates a tuple of table a and deletes a tuple of table b
+  logging::TransactionRecord begin_3(LOGRECORD_TYPE_TRANSACTION_BEGIN, 3);
+  WriteLogRecord(begin_3, fp);
+  logging::TupleRecord update_a(LOGRECORD_TYPE_WAL_TUPLE_UPDATE, 3,
+                                table_a->GetOid(), ItemPointer(1002, 0),
+                                ItemPointer(1001, 0), tuples_a[num_rows].get(),
+                                DEFAULT_DB_ID);
+  WriteLogRecord(update_a, fp);
+  logging::TupleRecord delete_b(LOGRECORD_TYPE_WAL_TUPLE_DELETE, 3,
+                                table_b->GetOid(), INVALID_ITEMPOINTER,
+                                ItemPointer(2001, 1), nullptr, DEFAULT_DB_ID);
+  WriteLogRecord(delete_b, fp);
+  logging::TransactionRecord commit_3(LOGRECORD_TYPE_TRANSACTION_COMMIT, 3);
+  WriteLogRecord(commit_3, fp);
+  logging::TransactionRecord delimiter_3(LOGRECORD_TYPE_ITERATION_DELIMITER, 3);
+  WriteLogRecord(delimiter_3, fp);
+
+  // txn 4 never commits
+  logging::TransactionRecord begin_4(LOGRECORD_TYPE_TRANSACTION_BEGIN, 4);
+  WriteLogRecord(begin_4, fp);
+  logging::TupleRecord insert_a(LOGRECORD_TYPE_WAL_TUPLE_INSERT, 4,
+                                table_a->GetOid(), ItemPointer(1002, 1),
+                                INVALID_ITEMPOINTER,
+                                tuples_a[num_rows + 1].get(), DEFAULT_DB_ID);
+  WriteLogRecord(insert_a, fp);
+  fclose(fp);
+
+  log_manager.SetRecoveryParallelism(4);
+  log_manager.SetGlobalMaxFlushedIdForRecovery(4);
+
+  logging::WriteAheadFrontendLogger wal_fel;
+  wal_fel.DoRecovery();
+
+  EXPECT_EQ(num_rows, table_a->GetNumberOfTuples());
+  EXPECT_EQ(num_rows - 1, table_b->GetNumberOfTuples());
+
+  auto header_a = table_a->GetTileGroupById(1001)->GetHeader();
+  EXPECT_EQ(3, header_a->GetEndCommitId(0));
+  EXPECT_EQ(3, table_a->GetTileGroupById(1002)->GetHeader()->GetBeginCommitId(0));
+  EXPECT_EQ(3, table_b->GetTileGroupById(2001)->GetHeader()->GetEndCommitId(1));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.SetNextCid(10);
+  wal_fel.RecoverIndex();
+  for (oid_t index_itr = 0; index_itr < table_a->GetIndexCount(); index_itr++) {
+    EXPECT_EQ(num_rows, table_a->GetIndex(index_itr)->GetNumberOfTuples());
+  }
+  for (oid_t index_itr = 0; index_itr < table_b->GetIndexCount(); index_itr++) {
+    EXPECT_EQ(num_rows - 1, table_b->GetIndex(index_itr)->GetNumberOfTuples());
+  }
+
+  log_manager.SetRecoveryParallelism(1);
+  manager.DropDatabaseWithOid(DEFAULT_DB_ID);
+  status = logging::LoggingUtil::RemoveDirectory(dir_name.c_str(), false);
+  EXPECT_EQ(status, true);
+}
+
+TEST_F(RecoveryTests, MultipleStreamRecoveryTest) {
+  auto &manager = catalog::Manager::GetInstance();
+  auto &log_manager = logging::LogManager::GetInstance();
+  std::string dir_name = logging::WriteAheadFrontendLogger::wal_directory_path;
+  std::vector<std::string> stream_dir_names = {dir_name, dir_name + "1"};
+  const int num_rows = 5;
+
+  auto table = ExecutorTestsUtil::CreateTable(1024, true, 1001);
+  storage::Database *db = new storage::Database(DEFAULT_DB_ID);
+  manager.AddDatabase(db);
+  db->AddTable(table);
+
+  auto tuples = LoggingTestsUtil::BuildTuples(table, num_rows + 2, false, false);
+
+  log_manager.SetLogDirectoryName("./");
+  std::vector<FILE *> fps;
+  for (auto &stream_dir_name : stream_dir_names) {
+    logging::LoggingUtil::RemoveDirectory(stream_dir_name.c_str(), false);
+    auto status =
+        logging::LoggingUtil::CreateDirectory(stream_dir_name.c_str(), 0700);
+    EXPECT_EQ(status, true);
+
+    std::string file_name = stream_dir_name + "/" + "peloton_log_0.log";
+    FILE *fp = fopen(file_name.c_str(), "wb");
+    cid_t default_commit_id = INVALID_CID;
+    cid_t default_delimiter = INVALID_CID;
+    fwrite((void *)&default_commit_id, sizeof(default_commit_id), 1, fp);
+    fwrite((void *)&default_delimiter, sizeof(default_delimiter), 1, fp);
+    fps.push_back(fp);
+  }
+
+  // txn 2 inserts the tuples through the first stream
+  logging::TransactionRecord begin_2(LOGRECORD_TYPE_TRANSACTION_BEGIN, 2);
+  WriteLogRecord(begin_2, fps[0]);
+  for (int i = 0; i < num_rows; i++) {
+    logging::TupleRecord insert(LOGRECORD_TYPE_WAL_TUPLE_INSERT, 2,
+                                table->GetOid(), ItemPointer(1001, i),
+                                INVALID_ITEMPOINTER, tuples[i].get(),
+                                DEFAULT_DB_ID);
+    WriteLogRecord(insert, fps[0]);
+  }
+  logging::TransactionRecord commit_2(LOGRECORD_TYPE_TRANSACTION_COMMIT, 2);
+  WriteLogRecord(commit_2, fps[0]);
+
+  // txn 3 updates a tuple through the second stream
+  logging::TransactionRecord begin_3(LOGRECORD_TYPE_TRANSACTION_BEGIN, 3);
+  WriteLogRecord(begin_3, fps[1]);
+  logging::TupleRecord update_3(LOGRECORD_TYPE_WAL_TUPLE_UPDATE, 3,
+                                table->GetOid(), ItemPointer(1002, 0),
+                                ItemPointer(1001, 0), tuples[num_rows].get(),
+                                DEFAULT_DB_ID);
+  WriteLogRecord(update_3, fps[1]);
+  logging::TransactionRecord commit_3(LOGRECORD_TYPE_TRANSACTION_COMMIT, 3);
+  WriteLogRecord(commit_3, fps[1]);
+  logging::TransactionRecord delimiter_3(LOGRECORD_TYPE_ITERATION_DELIMITER, 3);
+  WriteLogRecord(delimiter_3, fps[1]);
+
+  // txn 4 updates the new version through the first stream
+  logging::TransactionRecord begin_4(LOGRECORD_TYPE_TRANSACTION_BEGIN, 4);
+  WriteLogRecord(begin_4, fps[0]);
+  logging::TupleRecord update_4(LOGRECORD_TYPE_WAL_TUPLE_UPDATE, 4,
+                                table->GetOid(), ItemPointer(1002, 1),
+                                ItemPointer(1002, 0),
+                                tuples[num_rows + 1].get(), DEFAULT_DB_ID);
+  WriteLogRecord(update_4, fps[0]);
+  logging::TransactionRecord commit_4(LOGRECORD_TYPE_TRANSACTION_COMMIT, 4);
+  WriteLogRecord(commit_4, fps[0]);
+  logging::TransactionRecord delimiter_4(LOGRECORD_TYPE_ITERATION_DELIMITER, 4);
+  WriteLogRecord(delimiter_4, fps[0]);
+
+  for (auto fp : fps) fclose(fp);
+
+  log_manager.Configure(LOGGING_TYPE_NVM_WAL, false, 2);
+  log_manager.SetGlobalMaxFlushedIdForRecovery(4);
+
+  // the streams are read on their own, then replayed in commit order
+  logging::WriteAheadFrontendLogger stream_0(false, 0);
+  logging::WriteAheadFrontendLogger stream_1(false, 1);
+  stream_0.DoRecovery();
+  stream_1.DoRecovery();
+  logging::WriteAheadFrontendLogger::ReplayRecoveredStreams(
+      {&stream_0, &stream_1});
+
+  EXPECT_EQ(num_rows, table->GetNumberOfTuples());
+  EXPECT_EQ(3, table->GetTileGroupById(1001)->GetHeader()->GetEndCommitId(0));
+  auto header = table->GetTileGroupById(1002)->GetHeader();
+  EXPECT_EQ(4, header->GetEndCommitId(0));
+  EXPECT_EQ(4, header->GetBeginCommitId(1));
+  EXPECT_EQ(MAX_CID, header->GetEndCommitId(1));
+
+  log_manager.Configure(LOGGING_TYPE_NVM_WAL, false, 1);
+  manager.DropDatabaseWithOid(DEFAULT_DB_ID);
+  for (auto &stream_dir_name : stream_dir_names) {
+    auto status =
+        logging::LoggingUtil::RemoveDirectory(stream_dir_name.c_str(), false);
+    EXPECT_EQ(status, true);
+  }
+}
+
+TEST_F(RecoveryTests, LogBlockTest) {
+  // the check value of CRC32C
+  EXPECT_EQ(0xE3069283, logging::LogBlock::Crc32c("123456789", 9));
+  EXPECT_EQ(logging::LogBlock::Crc32c("123456789", 9),
+            logging::LogBlock::Crc32c(
+                "56789", 5, logging::LogBlock::Crc32c("1234", 4)));
+
+  // The repetitive data is compressed into the first block, the random data
+  // is stored as is in the second one
+  std::string repetitive;
+  for (int i = 0; repetitive.size() < 4096; i++) {
+    repetitive += "tuple " + std::to_string(i % 16) + " of the log;";
+  }
+  std::string random(4096, 0);
+  for (auto &byte : random) {
+    byte = (char)(rand() % 256);
+  }
+
+  CopySerializeOutput output;
+  logging::LogBlock::Encode(repetitive.data(), repetitive.size(), output);
+  EXPECT_LT(output.Size(),
+            repetitive.size() / 2 + logging::LogBlock::header_size);
+  size_t first_block_size = output.Size();
+  logging::LogBlock::Encode(random.data(), random.size(), output);
+  EXPECT_EQ(first_block_size + random.size() + logging::LogBlock::header_size,
+            output.Size());
+
+  FILE *fp = tmpfile();
+  fwrite(output.Data(), sizeof(char), output.Size(), fp);
+  rewind(fp);
+  EXPECT_TRUE(logging::LogBlock::IsBlockStart(fp));
+  std::vector<char> decoded;
+  logging::LogBlock::Decode(fp, decoded);
+  EXPECT_EQ(repetitive + random, std::string(decoded.begin(), decoded.end()));
+
+  // a corrupted byte in the second block ends the log at the first one
+  fseek(fp, first_block_size + logging::LogBlock::header_size + 10, SEEK_SET);
+  fputc(random[10] ^ 1, fp);
+  rewind(fp);
+  logging::LogBlock::Decode(fp, decoded);
+  EXPECT_EQ(repetitive, std::string(decoded.begin(), decoded.end()));
+  fclose(fp);
+}
+
+// Add a log record to the records of a block
+static void AppendLogRecord(logging::LogRecord &record,
+                            std::vector<char> &records) {
+  CopySerializeOutput output_buffer;
+  record.Serialize(output_buffer);
+  records.insert(records.end(), record.GetMessage(),
+                 record.GetMessage() + record.GetMessageLength());
+}
+
+TEST_F(RecoveryTests, CompressedLogRecoveryTest) {
+  auto &manager = catalog::Manager::GetInstance();
+  auto &log_manager = logging::LogManager::GetInstance();
+  std::string dir_name = logging::WriteAheadFrontendLogger::wal_directory_path;
+  const int num_rows = 50;
+
+  auto table = ExecutorTestsUtil::CreateTable(1024, true, 1001);
+  storage::Database *db = new storage::Database(DEFAULT_DB_ID);
+  manager.AddDatabase(db);
+  db->AddTable(table);
+  auto tuples = LoggingTestsUtil::BuildTuples(table, num_rows, false, false);
+
+  logging::LoggingUtil::RemoveDirectory(dir_name.c_str(), false);
+  auto status = logging::LoggingUtil::CreateDirectory(dir_name.c_str(), 0700);
+  EXPECT_EQ(status, true);
+  log_manager.SetLogDirectoryName("./");
+
+  std::string file_name = dir_name + "/" + std::string("peloton_log_0.log");
+  FILE *fp = fopen(file_name.c_str(), "wb");
+  cid_t default_commit_id = INVALID_CID;
+  cid_t default_delimiter = INVALID_CID;
+  fwrite((void *)&default_commit_id, sizeof(default_commit_id), 1, fp);
+  fwrite((void *)&default_delimiter, sizeof(default_delimiter), 1, fp);
+
+  // every transaction inserts a tuple and is flushed in its own block
+  CopySerializeOutput blocks;
+  for (int i = 0; i < num_rows; i++) {
+    cid_t commit_id = i + 2;
+    std::vector<char> records;
+    logging::TransactionRecord begin(LOGRECORD_TYPE_TRANSACTION_BEGIN,
+                                     commit_id);
+    AppendLogRecord(begin, records);
+    logging::TupleRecord insert(LOGRECORD_TYPE_WAL_TUPLE_INSERT, commit_id,
+                                table->GetOid(), ItemPointer(1001, i),
+                                INVALID_ITEMPOINTER, tuples[i].get(),
+                                DEFAULT_DB_ID);
+    AppendLogRecord(insert, records);
+    logging::TransactionRecord commit(LOGRECORD_TYPE_TRANSACTION_COMMIT,
+                                      commit_id);
+    AppendLogRecord(commit, records);
+    logging::TransactionRecord delimiter(LOGRECORD_TYPE_ITERATION_DELIMITER,
+                                         commit_id);
+    AppendLogRecord(delimiter, records);
+    logging::LogBlock::Encode(records.data(), records.size(), blocks);
+  }
+  fwrite(blocks.Data(), sizeof(char), blocks.Size(), fp);
+
+  // the last block is torn by a crash
+  fwrite(blocks.Data(), sizeof(char), logging::LogBlock::header_size + 1, fp);
+  fclose(fp);
+
+  log_manager.SetRecoveryParallelism(4);
+  log_manager.SetGlobalMaxFlushedIdForRecovery(num_rows + 1);
+
+  logging::WriteAheadFrontendLogger wal_fel;
+  EXPECT_EQ(num_rows + 1, wal_fel.GetMaxDelimiterForRecovery());
+  wal_fel.DoRecovery();
+
+  EXPECT_EQ(num_rows, table->GetNumberOfTuples());
+
+  log_manager.SetRecoveryParallelism(1);
+  manager.DropDatabaseWithOid(DEFAULT_DB_ID);
+  status = logging::LoggingUtil::RemoveDirectory(dir_name.c_str(), false);
+  EXPECT_EQ(status, true);
+}
+
+TEST_F(RecoveryTests, LogSegmentRecyclingTest) {
+  auto &manager = catalog::Manager::GetInstance();
+  auto &log_manager = logging::LogManager::GetInstance();
+  std::string dir_name = logging::WriteAheadFrontendLogger::wal_directory_path;
+  const size_t segment_size = 64 * 1024;
+  struct stat stat_buf;
+
+  logging::LoggingUtil::RemoveDirectory(dir_name.c_str(), false);
+  log_manager.SetLogDirectoryName("./");
+  log_manager.SetLogSegmentCount(1);
+  log_manager.SetLogFileSizeLimit(segment_size / 1024);
+
+  // The log files are preallocated segments
+  {
+    logging::WriteAheadFrontendLogger wal_fel;
+    wal_fel.CreateNewLogFile(false);
+    wal_fel.CreateNewLogFile(true);
+    wal_fel.CreateNewLogFile(true);
+    EXPECT_EQ(0, stat((dir_name + "/peloton_log_0.log").c_str(), &stat_buf));
+    EXPECT_EQ(segment_size, stat_buf.st_size);
+
+    // The first stale file is zeroed for reuse, the ring is then full and
+    // the second one is deleted
+    wal_fel.TruncateLog(1);
+    EXPECT_NE(0, stat((dir_name + "/peloton_log_0.log").c_str(), &stat_buf));
+    EXPECT_NE(0, stat((dir_name + "/peloton_log_1.log").c_str(), &stat_buf));
+    EXPECT_EQ(0, stat((dir_name + "/peloton_free_segment_0.log").c_str(),
+                      &stat_buf));
+    EXPECT_EQ(segment_size, stat_buf.st_size);
+    EXPECT_EQ(1, wal_fel.GetFreeSegmentCount());
+  }
+
+  // the free segment is found again after a restart, then reused
+  {
+    logging::WriteAheadFrontendLogger wal_fel;
+    EXPECT_EQ(1, wal_fel.GetFreeSegmentCount());
+    wal_fel.CreateNewLogFile(false);
+    EXPECT_EQ(0, wal_fel.GetFreeSegmentCount());
+    EXPECT_NE(0, stat((dir_name + "/peloton_free_segment_0.log").c_str(),
+                      &stat_buf));
+    EXPECT_EQ(0, stat((dir_name + "/peloton_log_3.log").c_str(), &stat_buf));
+    EXPECT_EQ(segment_size, stat_buf.st_size);
+  }
+  logging::LoggingUtil::RemoveDirectory(dir_name.c_str(), false);
+
+  // Recovery reads the records of every segment up to its zeros
+  auto table = ExecutorTestsUtil::CreateTable(1024, true, 1001);
+  storage::Database *db = new storage::Database(DEFAULT_DB_ID);
+  manager.AddDatabase(db);
+  db->AddTable(table);
+  auto tuples = LoggingTestsUtil::BuildTuples(table, 2, false, false);
+  auto status = logging::LoggingUtil::CreateDirectory(dir_name.c_str(), 0700);
+  EXPECT_EQ(status, true);
+
+  for (int i = 0; i < 2; i++) {
+    cid_t commit_id = i + 2;
+    std::string file_name =
+        dir_name + "/peloton_log_" + std::to_string(i) + ".log";
+    FILE *fp = fopen(file_name.c_str(), "wb");
+    cid_t default_commit_id = INVALID_CID;
+    cid_t default_delimiter = INVALID_CID;
+    fwrite((void *)&default_commit_id, sizeof(default_commit_id), 1, fp);
+    fwrite((void *)&default_delimiter, sizeof(default_delimiter), 1, fp);
+
+    logging::TransactionRecord begin(LOGRECORD_TYPE_TRANSACTION_BEGIN,
+                                     commit_id);
+    WriteLogRecord(begin, fp);
+    logging::TupleRecord insert(LOGRECORD_TYPE_WAL_TUPLE_INSERT, commit_id,
+                                table->GetOid(), ItemPointer(1001, i),
+                                INVALID_ITEMPOINTER, tuples[i].get(),
+                                DEFAULT_DB_ID);
+    WriteLogRecord(insert, fp);
+    logging::TransactionRecord commit(LOGRECORD_TYPE_TRANSACTION_COMMIT,
+                                      commit_id);
+    WriteLogRecord(commit, fp);
+    logging::TransactionRecord delimiter(LOGRECORD_TYPE_ITERATION_DELIMITER,
+                                         commit_id);
+    WriteLogRecord(delimiter, fp);
+
+    std::vector<char> zeros(segment_size - ftell(fp), 0);
+    fwrite(zeros.data(), sizeof(char), zeros.size(), fp);
+    fclose(fp);
+  }
+
+  log_manager.SetGlobalMaxFlushedIdForRecovery(3);
+  {
+    logging::WriteAheadFrontendLogger wal_fel;
+    EXPECT_EQ(3, wal_fel.GetMaxDelimiterForRecovery());
+    wal_fel.DoRecovery();
+  }
+  EXPECT_EQ(2, table->GetNumberOfTuples());
+
+  log_manager.SetLogSegmentCount(0);
+  log_manager.SetLogFileSizeLimit(32768);
+  manager.DropDatabaseWithOid(DEFAULT_DB_ID);
+  status = logging::LoggingUtil::RemoveDirectory(dir_name.c_str(), false);
+  EXPECT_EQ(status, true);
+}
+
 TEST_F(RecoveryTests, RestartTest) {
   auto recovery_table = ExecutorTestsUtil::CreateTable(1024);
   auto &manager = catalog::Manager::GetInstance();